@@ -0,0 +1,148 @@
+"""Add pre-aggregated analytics rollup tables and backfill them.
+
+Revision ID: 0016
+Revises: 0015
+Create Date: 2026-04-07
+"""
+
+from __future__ import annotations
+
+import sqlalchemy as sa
+from alembic import op
+
+# revision identifiers, used by Alembic.
+revision = "0016"
+down_revision = "0015"
+branch_labels = None
+depends_on = None
+
+# Kept in sync with backend.persistence.analytics_rollup_repo.ROLLUP_METRICS.
+_INT_METRICS = (
+    "job_count",
+    "review_count",
+    "completed_count",
+    "failed_count",
+    "cancelled_count",
+    "running_count",
+    "merged_count",
+    "pr_created_count",
+    "discarded_count",
+    "verify_job_count",
+    "verify_turns",
+)
+_TOKEN_METRICS = (
+    "input_tokens",
+    "output_tokens",
+    "cache_read_tokens",
+    "duration_ms",
+)
+_TAIL_METRICS = (
+    "tool_call_count",
+    "tool_failure_count",
+    "agent_error_count",
+    "total_turns",
+    "diff_lines",
+)
+_METRICS = (*_INT_METRICS, "total_cost_usd", *_TOKEN_METRICS, "premium_requests", *_TAIL_METRICS)
+
+
+def _metric_columns() -> list[sa.Column]:
+    cols: list[sa.Column] = [sa.Column(m, sa.Integer, nullable=False, server_default="0") for m in _INT_METRICS]
+    cols.append(sa.Column("total_cost_usd", sa.Float, nullable=False, server_default="0.0"))
+    cols += [sa.Column(m, sa.Integer, nullable=False, server_default="0") for m in _TOKEN_METRICS]
+    cols.append(sa.Column("premium_requests", sa.Float, nullable=False, server_default="0.0"))
+    cols += [sa.Column(m, sa.Integer, nullable=False, server_default="0") for m in _TAIL_METRICS]
+    return cols
+
+
+def upgrade() -> None:
+    op.create_table(
+        "analytics_rollup_jobs",
+        sa.Column("job_id", sa.String, sa.ForeignKey("jobs.id"), primary_key=True),
+        sa.Column("day", sa.String, nullable=False),
+        sa.Column("hour", sa.String, nullable=False),
+        sa.Column("repo", sa.String, nullable=False, server_default=""),
+        sa.Column("model", sa.String, nullable=False, server_default=""),
+        sa.Column("sdk", sa.String, nullable=False, server_default=""),
+        *_metric_columns(),
+        sa.Column("updated_at", sa.DateTime(timezone=True), nullable=False),
+    )
+    op.create_table(
+        "analytics_rollups",
+        sa.Column("granularity", sa.String, primary_key=True),
+        sa.Column("bucket", sa.String, primary_key=True),
+        sa.Column("repo", sa.String, primary_key=True, server_default=""),
+        sa.Column("model", sa.String, primary_key=True, server_default=""),
+        sa.Column("sdk", sa.String, primary_key=True, server_default=""),
+        *_metric_columns(),
+        sa.Column("updated_at", sa.DateTime(timezone=True), nullable=False),
+    )
+    op.create_table(
+        "analytics_tool_rollups",
+        sa.Column("granularity", sa.String, primary_key=True),
+        sa.Column("bucket", sa.String, primary_key=True),
+        sa.Column("tool", sa.String, primary_key=True),
+        sa.Column("call_count", sa.Integer, nullable=False, server_default="0"),
+        sa.Column("failure_count", sa.Integer, nullable=False, server_default="0"),
+        sa.Column("total_duration_ms", sa.Float, nullable=False, server_default="0.0"),
+        sa.Column("updated_at", sa.DateTime(timezone=True), nullable=False),
+    )
+
+    # Backfill from existing telemetry so history is visible immediately.
+    metrics = ", ".join(_METRICS)
+    sums = ", ".join(f"SUM({m})" for m in _METRICS)
+    op.execute(f"""
+        INSERT INTO analytics_rollup_jobs (job_id, day, hour, repo, model, sdk, {metrics}, updated_at)
+        SELECT
+            s.job_id,
+            date(s.created_at),
+            strftime('%Y-%m-%dT%H', s.created_at),
+            s.repo, s.model, s.sdk,
+            1,
+            CASE WHEN s.status = 'review' THEN 1 ELSE 0 END,
+            CASE WHEN s.status = 'completed' THEN 1 ELSE 0 END,
+            CASE WHEN s.status = 'failed' THEN 1 ELSE 0 END,
+            CASE WHEN s.status = 'cancelled' THEN 1 ELSE 0 END,
+            CASE WHEN s.status = 'running' THEN 1 ELSE 0 END,
+            CASE WHEN j.resolution = 'merged' THEN 1 ELSE 0 END,
+            CASE WHEN j.resolution = 'pr_created' THEN 1 ELSE 0 END,
+            CASE WHEN j.resolution = 'discarded' THEN 1 ELSE 0 END,
+            CASE WHEN j.verify = 1 THEN 1 ELSE 0 END,
+            CASE WHEN j.verify = 1 THEN s.total_turns ELSE 0 END,
+            s.total_cost_usd,
+            s.input_tokens, s.output_tokens, s.cache_read_tokens, s.duration_ms,
+            s.premium_requests,
+            s.tool_call_count, s.tool_failure_count, s.agent_error_count, s.total_turns,
+            s.diff_lines_added + s.diff_lines_removed,
+            datetime('now')
+        FROM job_telemetry_summary s
+        LEFT JOIN jobs j ON j.id = s.job_id
+    """)  # noqa: S608
+    for granularity, key in (("day", "day"), ("hour", "hour")):
+        op.execute(f"""
+            INSERT INTO analytics_rollups (granularity, bucket, repo, model, sdk, {metrics}, updated_at)
+            SELECT '{granularity}', {key}, repo, model, sdk, {sums}, datetime('now')
+            FROM analytics_rollup_jobs
+            GROUP BY {key}, repo, model, sdk
+        """)  # noqa: S608
+    for granularity, bucket in (("day", "date(created_at)"), ("hour", "strftime('%Y-%m-%dT%H', created_at)")):
+        op.execute(f"""
+            INSERT INTO analytics_tool_rollups
+                (granularity, bucket, tool, call_count, failure_count, total_duration_ms, updated_at)
+            SELECT
+                '{granularity}', {bucket}, name, COUNT(*),
+                SUM(CASE WHEN json_extract(attrs_json, '$.success') = 0
+                         OR json_extract(attrs_json, '$.success') = 'false'
+                    THEN 1 ELSE 0 END),
+                COALESCE(SUM(duration_ms), 0),
+                datetime('now')
+            FROM job_telemetry_spans
+            WHERE span_type = 'tool'
+            GROUP BY {bucket}, name
+        """)  # noqa: S608
+
+
+def downgrade() -> None:
+    op.drop_table("analytics_tool_rollups")
+    op.drop_table("analytics_rollups")
+    op.drop_table("analytics_rollup_jobs")
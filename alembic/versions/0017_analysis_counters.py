@@ -0,0 +1,95 @@
+"""Add streaming statistical-analysis counters and backfill them.
+
+Revision ID: 0017
+Revises: 0016
+Create Date: 2026-04-08
+"""
+
+from __future__ import annotations
+
+import sqlalchemy as sa
+from alembic import op
+
+# revision identifiers, used by Alembic.
+revision = "0017"
+down_revision = "0016"
+branch_labels = None
+depends_on = None
+
+_JOB_DAY = "(SELECT date(s.created_at) FROM job_telemetry_summary s WHERE s.job_id = {alias}.job_id)"
+
+
+def upgrade() -> None:
+    op.create_table(
+        "analysis_job_contributions",
+        sa.Column("job_id", sa.String, sa.ForeignKey("jobs.id"), primary_key=True),
+        sa.Column("detector", sa.String, primary_key=True),
+        sa.Column("key", sa.String, primary_key=True),
+        sa.Column("day", sa.String, nullable=False),
+        sa.Column("events", sa.Integer, nullable=False, server_default="0"),
+        sa.Column("hits", sa.Integer, nullable=False, server_default="0"),
+        sa.Column("amount", sa.Float, nullable=False, server_default="0.0"),
+    )
+    op.create_table(
+        "analysis_counters",
+        sa.Column("detector", sa.String, primary_key=True),
+        sa.Column("key", sa.String, primary_key=True),
+        sa.Column("day", sa.String, primary_key=True),
+        sa.Column("events", sa.Integer, nullable=False, server_default="0"),
+        sa.Column("hits", sa.Integer, nullable=False, server_default="0"),
+        sa.Column("amount", sa.Float, nullable=False, server_default="0.0"),
+        sa.Column("jobs", sa.Integer, nullable=False, server_default="0"),
+        sa.Column("updated_at", sa.DateTime(timezone=True), nullable=False),
+    )
+    op.create_index("idx_analysis_counters_detector_day", "analysis_counters", ["detector", "day"])
+
+    # Backfill per-job contributions from existing telemetry, mirroring
+    # AnalysisCountersRepo.job_contributions.
+    f_day = _JOB_DAY.format(alias="f")
+    op.execute(f"""
+        INSERT INTO analysis_job_contributions (job_id, detector, key, day, events, hits, amount)
+        SELECT f.job_id, 'file_reread', f.file_path, COALESCE({f_day}, date(MIN(f.created_at))),
+               COUNT(*), 0, COALESCE(SUM(f.byte_count), 0)
+        FROM job_file_access_log f
+        WHERE f.access_type = 'read'
+        GROUP BY f.job_id, f.file_path
+    """)  # noqa: S608
+    t_day = _JOB_DAY.format(alias="t")
+    for detector, hits in (
+        (
+            "tool_failure",
+            "SUM(CASE WHEN json_extract(t.attrs_json, '$.success') = 0 "
+            "OR json_extract(t.attrs_json, '$.success') = 'false' THEN 1 ELSE 0 END)",
+        ),
+        ("retry_waste", "SUM(CASE WHEN t.is_retry = 1 THEN 1 ELSE 0 END)"),
+    ):
+        op.execute(f"""
+            INSERT INTO analysis_job_contributions (job_id, detector, key, day, events, hits, amount)
+            SELECT t.job_id, '{detector}', t.name, COALESCE({t_day}, date(MIN(t.created_at))),
+                   COUNT(*), {hits}, 0
+            FROM job_telemetry_spans t
+            WHERE t.span_type = 'tool'
+            GROUP BY t.job_id, t.name
+        """)  # noqa: S608
+    op.execute("""
+        INSERT INTO analysis_job_contributions (job_id, detector, key, day, events, hits, amount)
+        SELECT job_id, 'turn_escalation', job_id, date(created_at), 1, 0,
+               MAX(0, cost_second_half_usd - cost_first_half_usd)
+        FROM job_telemetry_summary
+        WHERE total_turns >= 6
+            AND cost_second_half_usd > 0
+            AND cost_first_half_usd > 0
+            AND (cost_second_half_usd / cost_first_half_usd) >= 2.0
+    """)
+    op.execute("""
+        INSERT INTO analysis_counters (detector, key, day, events, hits, amount, jobs, updated_at)
+        SELECT detector, key, day, SUM(events), SUM(hits), SUM(amount), COUNT(*), datetime('now')
+        FROM analysis_job_contributions
+        GROUP BY detector, key, day
+    """)
+
+
+def downgrade() -> None:
+    op.drop_index("idx_analysis_counters_detector_day", table_name="analysis_counters")
+    op.drop_table("analysis_counters")
+    op.drop_table("analysis_job_contributions")
@@ -0,0 +1,97 @@
+"""Add learned approval rules and record who resolved each approval.
+
+Backfills ``approval_rules`` from the operator decisions already stored in
+``approvals``.  Rows written before ``resolved_by`` existed cannot be told
+apart from trust grants, so they are all counted as operator decisions.
+
+Approvals recorded before ``tool`` existed get it from their description,
+which the adapters prefix with ``Bash:`` (Claude) and ``Run shell:``
+(Copilot).  Other tools are left NULL and never learned.
+
+Revision ID: 0018
+Revises: 0017
+Create Date: 2026-04-10
+"""
+
+from __future__ import annotations
+
+import json
+
+import sqlalchemy as sa
+from alembic import op
+
+# revision identifiers, used by Alembic.
+revision = "0018"
+down_revision = "0017"
+branch_labels = None
+depends_on = None
+
+
+# Kept in sync with backend.services.approval_rules.action_key.
+def _action_key(tool: str | None, proposed_action: str | None) -> str | None:
+    if not proposed_action:
+        return None
+    if tool == "shell":
+        return proposed_action.strip() or None
+    if tool != "Bash":
+        return None
+    try:
+        doc = json.loads(proposed_action)
+    except ValueError:
+        return None  # truncated Claude tool input
+    command = doc.get("command") if isinstance(doc, dict) else None
+    return (command.strip() or None) if isinstance(command, str) else None
+
+
+def upgrade() -> None:
+    op.add_column("approvals", sa.Column("resolved_by", sa.String, nullable=True))
+    op.add_column("approvals", sa.Column("tool", sa.String, nullable=True))
+    op.execute("UPDATE approvals SET tool = 'Bash' WHERE description LIKE 'Bash: %'")
+    op.execute("UPDATE approvals SET tool = 'shell' WHERE description LIKE 'Run shell: %'")
+    rules = op.create_table(
+        "approval_rules",
+        sa.Column("repo", sa.String, primary_key=True),
+        sa.Column("tool", sa.String, primary_key=True),
+        sa.Column("action", sa.Text, primary_key=True),
+        sa.Column("approvals", sa.Integer, nullable=False, server_default="0"),
+        sa.Column("rejections", sa.Integer, nullable=False, server_default="0"),
+        sa.Column("auto_approved", sa.Integer, nullable=False, server_default="0"),
+        sa.Column("last_decided_at", sa.DateTime(timezone=True), nullable=True),
+        sa.Column("last_applied_at", sa.DateTime(timezone=True), nullable=True),
+        sa.Column("revoked_at", sa.DateTime(timezone=True), nullable=True),
+    )
+
+    history = op.get_bind().execute(
+        sa.text("""
+            SELECT j.repo, a.tool, a.proposed_action, a.resolution, a.resolved_at
+            FROM approvals a JOIN jobs j ON j.id = a.job_id
+            WHERE a.resolution IS NOT NULL AND NOT a.requires_explicit_approval
+            ORDER BY a.resolved_at
+        """).columns(
+            sa.column("repo"),
+            sa.column("tool"),
+            sa.column("proposed_action"),
+            sa.column("resolution"),
+            sa.column("resolved_at", sa.DateTime(timezone=True)),
+        )
+    )
+    counts: dict[tuple[str, str, str], dict[str, object]] = {}
+    for repo, tool, proposed_action, resolution, resolved_at in history:
+        key = _action_key(tool, proposed_action)
+        if key is None:
+            continue
+        entry = counts.setdefault(
+            (repo, tool, key),
+            {"repo": repo, "tool": tool, "action": key, "approvals": 0, "rejections": 0, "last_decided_at": None},
+        )
+        entry["approvals" if resolution == "approved" else "rejections"] += 1  # type: ignore[operator]
+        entry["last_decided_at"] = resolved_at
+    if counts:
+        op.bulk_insert(rules, list(counts.values()))
+
+
+def downgrade() -> None:
+    op.drop_table("approval_rules")
+    with op.batch_alter_table("approvals") as batch:
+        batch.drop_column("tool")
+        batch.drop_column("resolved_by")
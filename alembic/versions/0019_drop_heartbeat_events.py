@@ -0,0 +1,28 @@
+"""Delete persisted session heartbeat events.
+
+Heartbeats are now broadcast only.  The rows written before that carry
+nothing replay needs.
+
+Revision ID: 0019
+Revises: 0018
+Create Date: 2026-04-11
+"""
+
+from __future__ import annotations
+
+import sqlalchemy as sa
+from alembic import op
+
+# revision identifiers, used by Alembic.
+revision = "0019"
+down_revision = "0018"
+branch_labels = None
+depends_on = None
+
+
+def upgrade() -> None:
+    op.get_bind().execute(sa.text("DELETE FROM events WHERE kind = 'SessionHeartbeat'"))
+
+
+def downgrade() -> None:
+    pass  # deleted heartbeats are not restored
@@ -0,0 +1,24 @@
+"""Index non-archived jobs by creation time for the reconnect snapshot.
+
+Revision ID: 0020
+Revises: 0019
+Create Date: 2026-04-12
+"""
+
+from __future__ import annotations
+
+from alembic import op
+
+# revision identifiers, used by Alembic.
+revision = "0020"
+down_revision = "0019"
+branch_labels = None
+depends_on = None
+
+
+def upgrade() -> None:
+    op.create_index("idx_jobs_active", "jobs", ["archived_at", "created_at", "id"])
+
+
+def downgrade() -> None:
+    op.drop_index("idx_jobs_active", table_name="jobs")
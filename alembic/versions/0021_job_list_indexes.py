@@ -0,0 +1,40 @@
+"""Composite job indexes for listings and a denormalized prompt preview.
+
+Listings filter on ``state IN (...)`` and/or ``archived_at`` and order by
+``(created_at, id)``; the indexes cover each combination, which makes the
+single-column ``idx_jobs_state`` redundant.  ``prompt_preview`` holds the
+first 200 characters of the prompt so list queries skip the TEXT column.
+
+Revision ID: 0021
+Revises: 0020
+Create Date: 2026-04-13
+"""
+
+from __future__ import annotations
+
+import sqlalchemy as sa
+
+from alembic import op
+
+# revision identifiers, used by Alembic.
+revision = "0021"
+down_revision = "0020"
+branch_labels = None
+depends_on = None
+
+
+def upgrade() -> None:
+    op.add_column("jobs", sa.Column("prompt_preview", sa.String(), nullable=True))
+    op.get_bind().execute(sa.text("UPDATE jobs SET prompt_preview = substr(prompt, 1, 200)"))
+    op.create_index("idx_jobs_created", "jobs", ["created_at", "id"])
+    op.create_index("idx_jobs_state_created", "jobs", ["state", "created_at", "id"])
+    # Absent on databases created from the models rather than by 0005
+    op.execute("DROP INDEX IF EXISTS idx_jobs_state")
+
+
+def downgrade() -> None:
+    op.create_index("idx_jobs_state", "jobs", ["state"])
+    op.drop_index("idx_jobs_state_created", table_name="jobs")
+    op.drop_index("idx_jobs_created", table_name="jobs")
+    with op.batch_alter_table("jobs") as batch:
+        batch.drop_column("prompt_preview")
@@ -0,0 +1,53 @@
+"""Aggregate file-access telemetry per job and file, backfilled from the raw log.
+
+Revision ID: 0022
+Revises: 0021
+Create Date: 2026-04-14
+"""
+
+from __future__ import annotations
+
+import sqlalchemy as sa
+from alembic import op
+
+# revision identifiers, used by Alembic.
+revision = "0022"
+down_revision = "0021"
+branch_labels = None
+depends_on = None
+
+
+def upgrade() -> None:
+    op.create_table(
+        "job_file_access_stats",
+        sa.Column("job_id", sa.String, sa.ForeignKey("jobs.id"), primary_key=True),
+        sa.Column("file_path", sa.String, primary_key=True),
+        sa.Column("read_count", sa.Integer, nullable=False, server_default="0"),
+        sa.Column("write_count", sa.Integer, nullable=False, server_default="0"),
+        sa.Column("read_bytes", sa.Integer, nullable=False, server_default="0"),
+        sa.Column("first_turn", sa.Integer, nullable=True),
+        sa.Column("last_turn", sa.Integer, nullable=True),
+        sa.Column("first_access_at", sa.DateTime(timezone=True), nullable=False),
+        sa.Column("last_access_at", sa.DateTime(timezone=True), nullable=False),
+    )
+    op.create_index("idx_file_access_stats_path", "job_file_access_stats", ["file_path"])
+    op.create_index("idx_file_access_stats_last", "job_file_access_stats", ["last_access_at"])
+
+    op.execute("""
+        INSERT INTO job_file_access_stats
+            (job_id, file_path, read_count, write_count, read_bytes,
+             first_turn, last_turn, first_access_at, last_access_at)
+        SELECT job_id, file_path,
+               SUM(CASE WHEN access_type = 'read' THEN 1 ELSE 0 END),
+               SUM(CASE WHEN access_type = 'write' THEN 1 ELSE 0 END),
+               COALESCE(SUM(CASE WHEN access_type = 'read' THEN byte_count END), 0),
+               MIN(turn_number), MAX(turn_number), MIN(created_at), MAX(created_at)
+        FROM job_file_access_log
+        GROUP BY job_id, file_path
+    """)
+
+
+def downgrade() -> None:
+    op.drop_index("idx_file_access_stats_last", table_name="job_file_access_stats")
+    op.drop_index("idx_file_access_stats_path", table_name="job_file_access_stats")
+    op.drop_table("job_file_access_stats")
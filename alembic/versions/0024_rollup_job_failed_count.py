@@ -0,0 +1,47 @@
+"""Count failed jobs by job state in the analytics rollups and backfill them.
+
+Revision ID: 0024
+Revises: 0023
+Create Date: 2026-04-17
+"""
+
+from __future__ import annotations
+
+import sqlalchemy as sa
+from alembic import op
+
+# revision identifiers, used by Alembic.
+revision = "0024"
+down_revision = "0023"
+branch_labels = None
+depends_on = None
+
+
+def upgrade() -> None:
+    for table in ("analytics_rollup_jobs", "analytics_rollups"):
+        op.add_column(table, sa.Column("job_failed_count", sa.Integer, nullable=False, server_default="0"))
+
+    # Mirrors the job_failed_count term of analytics_rollup_repo.contribution_select.
+    op.execute("""
+        UPDATE analytics_rollup_jobs
+        SET job_failed_count = 1
+        WHERE job_id IN (SELECT id FROM jobs WHERE state = 'failed')
+    """)
+    op.execute("""
+        UPDATE analytics_rollups
+        SET job_failed_count = COALESCE((
+            SELECT SUM(r.job_failed_count)
+            FROM analytics_rollup_jobs r
+            WHERE r.repo = analytics_rollups.repo
+                AND r.model = analytics_rollups.model
+                AND r.sdk = analytics_rollups.sdk
+                AND CASE WHEN analytics_rollups.granularity = 'day' THEN r.day ELSE r.hour END
+                    = analytics_rollups.bucket
+        ), 0)
+    """)
+
+
+def downgrade() -> None:
+    for table in ("analytics_rollups", "analytics_rollup_jobs"):
+        with op.batch_alter_table(table) as batch:
+            batch.drop_column("job_failed_count")
@@ -2,6 +2,7 @@
 
 from __future__ import annotations
 
+import functools
 import json
 from pathlib import Path
 from typing import Annotated, Any
@@ -11,26 +12,33 @@ from dishka.integrations.fastapi import DishkaRoute, FromDishka
 from fastapi import APIRouter, Query
 from sqlalchemy.ext.asyncio import AsyncSession
 
-from backend.models.api_schemas import ModelComparisonResponse, ScorecardResponse
+from backend.di import ReadSession
+from backend.models.api_schemas import BudgetSnapshot, ModelComparisonResponse, ScorecardResponse
+from backend.services.runtime_service import RuntimeService
 
 router = APIRouter(route_class=DishkaRoute, tags=["analytics"])
 log = structlog.get_logger()
 
 # ---------------------------------------------------------------------------
-# Model pricing — loaded once from the bundled JSON generated by
+# Model pricing — loaded on first use from the bundled JSON generated by
 # tools/update_model_pricing.py (sourced from LiteLLM community data).
 # ---------------------------------------------------------------------------
 
 _PRICING_PATH = Path(__file__).resolve().parent.parent / "data" / "model_pricing.json"
-_MODEL_PRICING: dict[str, dict[str, object]] = {}
 
-try:
-    _MODEL_PRICING = json.loads(_PRICING_PATH.read_text())
-    log.info("model_pricing_loaded", count=len(_MODEL_PRICING))
-except FileNotFoundError:
-    log.warning("model_pricing_file_missing", path=str(_PRICING_PATH))
-except Exception:
-    log.exception("model_pricing_load_error")
+
+@functools.cache
+def _model_pricing() -> dict[str, dict[str, object]]:
+    try:
+        pricing: dict[str, dict[str, object]] = json.loads(_PRICING_PATH.read_text())
+    except FileNotFoundError:
+        log.warning("model_pricing_file_missing", path=str(_PRICING_PATH))
+        return {}
+    except Exception:
+        log.exception("model_pricing_load_error")
+        return {}
+    log.info("model_pricing_loaded", count=len(pricing))
+    return pricing
 
 
 def _normalize_model_key(model: str) -> str:
@@ -42,7 +50,7 @@ def _normalize_model_key(model: str) -> str:
 
 @router.get("/analytics/overview")
 async def analytics_overview(
-    session: FromDishka[AsyncSession],
+    session: FromDishka[ReadSession],
     period: Annotated[int, Query(ge=1, le=365)] = 7,
 ) -> dict[str, object]:
     """Aggregate analytics over the given period (days)."""
@@ -87,7 +95,7 @@ async def analytics_overview(
 
 @router.get("/analytics/models")
 async def analytics_models(
-    session: FromDishka[AsyncSession],
+    session: FromDishka[ReadSession],
     period: Annotated[int, Query(ge=1, le=365)] = 7,
 ) -> dict[str, object]:
     """Per-model cost and usage breakdown."""
@@ -99,7 +107,7 @@ async def analytics_models(
 
 @router.get("/analytics/tools")
 async def analytics_tools(
-    session: FromDishka[AsyncSession],
+    session: FromDishka[ReadSession],
     period: Annotated[int, Query(ge=1, le=365)] = 30,
 ) -> dict[str, object]:
     """Tool performance stats (call counts, failure rates, latency)."""
@@ -111,7 +119,7 @@ async def analytics_tools(
 
 @router.get("/analytics/repos")
 async def analytics_repos(
-    session: FromDishka[AsyncSession],
+    session: FromDishka[ReadSession],
     period: Annotated[int, Query(ge=1, le=365)] = 7,
 ) -> dict[str, object]:
     """Per-repo cost and usage breakdown."""
@@ -123,7 +131,7 @@ async def analytics_repos(
 
 @router.get("/analytics/jobs")
 async def analytics_jobs(
-    session: FromDishka[AsyncSession],
+    session: FromDishka[ReadSession],
     period: Annotated[int, Query(ge=1, le=365)] = 7,
     sdk: str | None = None,
     model: str | None = None,
@@ -169,10 +177,10 @@ async def analytics_pricing(
         if not name:
             continue
         # Exact match first, then normalised
-        entry = _MODEL_PRICING.get(name)
+        entry = _model_pricing().get(name)
         if entry is None:
             norm = _normalize_model_key(name)
-            entry = _MODEL_PRICING.get(norm)
+            entry = _model_pricing().get(norm)
         result[name] = entry
     return result
 
@@ -185,7 +193,7 @@ async def analytics_pricing(
 @router.get("/analytics/cost-drivers/{job_id}")
 async def cost_drivers_for_job(
     job_id: str,
-    session: FromDishka[AsyncSession],
+    session: FromDishka[ReadSession],
 ) -> dict[str, object]:
     """Per-job cost attribution breakdown by dimension."""
     from backend.persistence.cost_attribution_repo import CostAttributionRepo
@@ -200,7 +208,7 @@ async def cost_drivers_for_job(
 
 @router.get("/analytics/cost-drivers")
 async def fleet_cost_drivers(
-    session: FromDishka[AsyncSession],
+    session: FromDishka[ReadSession],
     period: Annotated[int, Query(ge=1, le=365)] = 30,
     dimension: str | None = None,
 ) -> dict[str, object]:
@@ -218,7 +226,7 @@ async def fleet_cost_drivers(
 @router.get("/analytics/file-access/{job_id}")
 async def file_access_for_job(
     job_id: str,
-    session: FromDishka[AsyncSession],
+    session: FromDishka[ReadSession],
 ) -> dict[str, object]:
     """File access stats for a job — rereads, most-accessed files."""
     from backend.persistence.file_access_repo import FileAccessRepo
@@ -231,7 +239,7 @@ async def file_access_for_job(
 
 @router.get("/analytics/file-access")
 async def fleet_file_access(
-    session: FromDishka[AsyncSession],
+    session: FromDishka[ReadSession],
     period: Annotated[int, Query(ge=1, le=365)] = 30,
 ) -> dict[str, object]:
     """Fleet-wide most-accessed files across all jobs."""
@@ -244,7 +252,7 @@ async def fleet_file_access(
 @router.get("/analytics/turn-economics/{job_id}")
 async def turn_economics_for_job(
     job_id: str,
-    session: FromDishka[AsyncSession],
+    session: FromDishka[ReadSession],
 ) -> dict[str, object]:
     """Per-turn cost curve for a specific job."""
     from backend.persistence.cost_attribution_repo import CostAttributionRepo
@@ -271,7 +279,7 @@ async def turn_economics_for_job(
 
 @router.get("/analytics/scorecard", response_model=ScorecardResponse)
 async def analytics_scorecard(
-    session: FromDishka[AsyncSession],
+    session: FromDishka[ReadSession],
     period: Annotated[int, Query(ge=1, le=365)] = 7,
 ) -> ScorecardResponse:
     """Top-level scorecard: budget per SDK, activity with resolution, quota, cost trend."""
@@ -281,9 +289,20 @@ async def analytics_scorecard(
     return ScorecardResponse(**data)
 
 
+@router.get("/analytics/budget", response_model=BudgetSnapshot)
+async def analytics_budget(runtime_service: FromDishka[RuntimeService]) -> BudgetSnapshot:
+    """Live month-to-date spend vs. budget, served from the in-memory cost ledger."""
+    from backend.services.cost_ledger import current_month
+
+    ledger = runtime_service.cost_ledger
+    if ledger is None:
+        return BudgetSnapshot(month=current_month())
+    return BudgetSnapshot(**ledger.snapshot())
+
+
 @router.get("/analytics/model-comparison", response_model=ModelComparisonResponse)
 async def analytics_model_comparison(
-    session: FromDishka[AsyncSession],
+    session: FromDishka[ReadSession],
     period: Annotated[int, Query(ge=1, le=365)] = 30,
     repo: str | None = None,
 ) -> ModelComparisonResponse:
@@ -297,7 +316,7 @@ async def analytics_model_comparison(
 @router.get("/analytics/job-context/{job_id}")
 async def analytics_job_context(
     job_id: str,
-    session: FromDishka[AsyncSession],
+    session: FromDishka[ReadSession],
 ) -> dict[str, object]:
     """Per-job context: metrics + repo comparison + noteworthy flags."""
     from backend.persistence.telemetry_summary_repo import TelemetrySummaryRepo
@@ -315,7 +334,7 @@ async def analytics_job_context(
 
 @router.get("/analytics/observations")
 async def list_observations(
-    session: FromDishka[AsyncSession],
+    session: FromDishka[ReadSession],
     category: str | None = None,
     severity: str | None = None,
 ) -> dict[str, object]:
@@ -342,10 +361,11 @@ async def dismiss_observation(
 @router.post("/analytics/analyse")
 async def trigger_analysis(
     session: FromDishka[AsyncSession],
+    runtime_service: FromDishka[RuntimeService],
 ) -> dict[str, object]:
     """Manually trigger the statistical analysis pass."""
     from backend.services.statistical_analysis import run_analysis
 
-    count = await run_analysis(session)
+    count = await run_analysis(session, runtime_service.columnar_store)
     await session.commit()
     return {"observations_written": count}
@@ -9,7 +9,9 @@ from fastapi import APIRouter, HTTPException
 
 from backend.models.api_schemas import (
     ApprovalResponse,
+    ApprovalRuleResponse,
     ResolveApprovalRequest,
+    RevokeApprovalRuleRequest,
     SendMessageRequest,
     SendMessageResponse,
     TrustJobResponse,
@@ -33,6 +35,7 @@ def _to_response(a: Approval) -> ApprovalResponse:
         resolved_at=a.resolved_at,
         resolution=a.resolution,
         requires_explicit_approval=a.requires_explicit_approval,
+        resolved_by=a.resolved_by,
     )
 
 
@@ -67,6 +70,39 @@ async def trust_job(
     return TrustJobResponse(resolved=count)
 
 
+@router.get("/approvals/rules", response_model=list[ApprovalRuleResponse])
+async def list_approval_rules(
+    approval_service: FromDishka[ApprovalService],
+    repo: str | None = None,
+) -> list[ApprovalRuleResponse]:
+    """List learned approval rules — every command the operator has decided on, per repo."""
+    return [
+        ApprovalRuleResponse(
+            repo=r.repo,
+            tool=r.tool,
+            action=r.action,
+            approvals=r.approvals,
+            rejections=r.rejections,
+            auto_approved=r.auto_approved,
+            last_decided_at=r.last_decided_at,
+            last_applied_at=r.last_applied_at,
+            revoked_at=r.revoked_at,
+            active=approval_service.is_rule_active(r),
+        )
+        for r in approval_service.list_rules(repo)
+    ]
+
+
+@router.post("/approvals/rules/revoke", status_code=204)
+async def revoke_approval_rule(
+    body: RevokeApprovalRuleRequest,
+    approval_service: FromDishka[ApprovalService],
+) -> None:
+    """Stop auto-approving a command; it has to be approved again to be re-learned."""
+    if not await approval_service.revoke_rule(body.repo, body.tool, body.action):
+        raise HTTPException(status_code=404, detail="Approval rule not found")
+
+
 @router.post("/jobs/{job_id}/messages", response_model=SendMessageResponse)
 async def send_message(
     job_id: str,
@@ -3,6 +3,7 @@
 from __future__ import annotations
 
 import asyncio
+import contextlib
 from typing import TYPE_CHECKING
 
 import structlog
@@ -14,7 +15,7 @@ if TYPE_CHECKING:
     from collections.abc import AsyncGenerator
 from starlette.responses import StreamingResponse
 
-from backend.services.sse_manager import SSEConnection, SSEManager
+from backend.services.sse_manager import KEEPALIVE_FRAME, SSEConnection, SSEManager
 
 router = APIRouter(tags=["events"], route_class=DishkaRoute)
 
@@ -38,48 +39,8 @@ async def stream_events(
     conn = SSEConnection(job_id=job_id)
     sse_manager.register(conn)
 
-    async def event_generator() -> AsyncGenerator[str, None]:
-        try:
-            # Handle reconnection replay
-            if header_last_id is not None:
-                try:
-                    numeric_id = int(header_last_id)
-                    await sse_manager.replay_from_factory(
-                        conn,
-                        session_factory,
-                        numeric_id,
-                    )
-                except (ValueError, TypeError):
-                    structlog.get_logger().warning(
-                        "sse_replay_invalid_last_event_id",
-                        last_event_id=header_last_id,
-                        exc_info=True,
-                    )
-
-            # Send immediate heartbeat so the connection is established
-            # and proxies see data flowing immediately.
-            yield "event: session_heartbeat\ndata: {}\n\n"
-
-            while not conn.closed:
-                try:
-                    data = await asyncio.wait_for(conn.queue.get(), timeout=5.0)
-                    yield data
-                except TimeoutError:
-                    # Send a real SSE event as heartbeat — SSE comments
-                    # (: keepalive) are invisible to HTTP/2 proxies and
-                    # don't prevent idle stream timeouts.
-                    yield "event: session_heartbeat\ndata: {}\n\n"
-                except (asyncio.CancelledError, GeneratorExit):
-                    structlog.get_logger(__name__).debug(
-                        "sse_client_disconnected",
-                        job_id=job_id,
-                    )
-                    break
-        finally:
-            sse_manager.unregister(conn)
-
     return StreamingResponse(
-        event_generator(),
+        _event_stream(conn, sse_manager, session_factory, header_last_id),
         media_type="text/event-stream",
         headers={
             "Cache-Control": "no-cache, no-transform",
@@ -88,3 +49,61 @@ async def stream_events(
             "Transfer-Encoding": "chunked",
         },
     )
+
+
+async def _event_stream(
+    conn: SSEConnection,
+    sse_manager: SSEManager,
+    session_factory: async_sessionmaker,  # type: ignore[type-arg]
+    last_event_id: str | None,
+) -> AsyncGenerator[str, None]:
+    """Frames for one registered connection; unregisters it when the client goes away.
+
+    Reconnection replay runs as a task beside the drain loop, so snapshot
+    chunks and replayed events reach the client while later ones are still
+    being read instead of piling up in the connection queue.
+    """
+    log = structlog.get_logger(__name__)
+    replay: asyncio.Task[None] | None = None
+    try:
+        if last_event_id is not None:
+            try:
+                numeric_id = int(last_event_id)
+            except (ValueError, TypeError):
+                log.warning("sse_replay_invalid_last_event_id", last_event_id=last_event_id, exc_info=True)
+            else:
+                replay = asyncio.create_task(_replay(conn, sse_manager, session_factory, numeric_id), name="sse-replay")
+
+        # Send immediate heartbeat so the connection is established
+        # and proxies see data flowing immediately.
+        yield KEEPALIVE_FRAME
+
+        # Idle streams get keepalives from the manager's shared ticker
+        while not conn.closed:
+            try:
+                data = await conn.queue.get()
+                if conn.closed:
+                    break
+                yield data
+            except (asyncio.CancelledError, GeneratorExit):
+                log.debug("sse_client_disconnected", job_id=conn.job_id)
+                break
+    finally:
+        if replay is not None:
+            replay.cancel()
+            with contextlib.suppress(asyncio.CancelledError):
+                await replay
+        sse_manager.unregister(conn)
+
+
+async def _replay(
+    conn: SSEConnection,
+    sse_manager: SSEManager,
+    session_factory: async_sessionmaker,  # type: ignore[type-arg]
+    last_event_id: int,
+) -> None:
+    try:
+        await sse_manager.replay_from_factory(conn, session_factory, last_event_id)
+    except Exception:
+        # The live stream stays up; the client still gets new events
+        structlog.get_logger(__name__).warning("sse_replay_failed", last_event_id=last_event_id, exc_info=True)
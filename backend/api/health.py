@@ -8,8 +8,9 @@ from dishka.integrations.fastapi import DishkaRoute, FromDishka
 from fastapi import APIRouter
 
 from backend import __version__
-from backend.models.api_schemas import HealthResponse, HealthStatus
+from backend.models.api_schemas import HealthResponse, HealthStatus, RecoveryStatusResponse
 from backend.services.job_service import JobService
+from backend.services.runtime_service import RuntimeService
 from backend.services.sister_session import SisterSessionManager
 
 router = APIRouter(tags=["health"], route_class=DishkaRoute)
@@ -36,6 +37,22 @@ async def health(
     )
 
 
+@router.get("/health/recovery", response_model=RecoveryStatusResponse)
+async def recovery_status(
+    runtime_service: FromDishka[RuntimeService],
+) -> RecoveryStatusResponse:
+    """Return progress of the startup crash recovery."""
+    progress = runtime_service.recovery_progress()
+    return RecoveryStatusResponse(
+        in_progress=progress.in_progress,
+        total=progress.total,
+        recovered=progress.recovered,
+        failed=progress.failed,
+        started_at=progress.started_at,
+        finished_at=progress.finished_at,
+    )
+
+
 @router.get("/sister-sessions/metrics")
 async def sister_session_metrics(
     sister_sessions: FromDishka[SisterSessionManager],
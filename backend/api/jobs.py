@@ -12,7 +12,7 @@ from fastapi import APIRouter, HTTPException, Query
 from sqlalchemy.ext.asyncio import AsyncSession
 
 from backend.config import CPLConfig
-from backend.di import CachedModelsBySdk
+from backend.di import CachedModelsBySdk, ReadSession
 from backend.models.api_schemas import (
     ContinueJobRequest,
     CreateJobRequest,
@@ -20,6 +20,8 @@ from backend.models.api_schemas import (
     DiffFileModel,
     JobListResponse,
     JobResponse,
+    JobSummaryResponse,
+    JobWaterfallResponse,
     LogLinePayload,
     ModelInfoResponse,
     ProgressHeadlinePayload,
@@ -43,6 +45,7 @@ from backend.services.naming_service import NamingService
 from backend.services.runtime_service import RuntimeService
 from backend.services.tool_formatters import format_tool_display, format_tool_display_full
 from backend.services.sister_session import SisterSessionManager
+from backend.services.step_diff_cache import StepDiffCache
 
 if TYPE_CHECKING:
     from collections.abc import Callable
@@ -230,17 +233,19 @@ async def list_jobs(
     """List jobs with optional state filter and cursor pagination.
 
     Pass archived=true to list only archived jobs, archived=false to
-    exclude them. Default (None) returns all jobs.
+    exclude them. Default (None) returns all jobs.  Items carry a prompt
+    preview rather than the full prompt; ``GET /jobs/{job_id}`` has it.
     """
-    jobs, next_cursor, has_more = await svc.list_jobs(
+    jobs, next_cursor, has_more = await svc.list_job_summaries(
         state=state,
         limit=limit,
         cursor=cursor,
         archived=archived,
     )
     progress_by_job = await svc.list_latest_progress_previews([job.id for job in jobs])
+    previews = {job_id: (p.headline, p.summary) for job_id, p in progress_by_job.items()}
     return JobListResponse(
-        items=[_job_to_response(j, progress_by_job.get(j.id)) for j in jobs],
+        items=[JobSummaryResponse.from_summary(j, *previews.get(j.id, (None, None))) for j in jobs],
         cursor=next_cursor,
         has_more=has_more,
     )
@@ -566,14 +571,12 @@ async def get_step_diff(
     step_id: str,
     session: FromDishka[AsyncSession],
     svc: FromDishka[JobService],
-    config: FromDishka[CPLConfig],
-    event_bus: FromDishka[EventBus],
+    diff_cache: FromDishka[StepDiffCache],
 ) -> StepDiffPayload:
-    """Return the Git diff for a specific step."""
+    """Return the Git diff for a specific step (cached by commit pair)."""
     from sqlalchemy import select as _select
 
     from backend.models.db import StepRow
-    from backend.services.git_service import GitService
 
     result = await session.execute(_select(StepRow).where(StepRow.id == step_id))
     step = result.scalar_one_or_none()
@@ -586,14 +589,10 @@ async def get_step_diff(
     if not job.worktree_path:
         return StepDiffPayload(step_id=step_id, diff="", files_changed=0)
 
-    git = GitService(config)
-    diff_text = await git.diff_range(str(step.start_sha), str(step.end_sha), cwd=job.worktree_path)
-    files_changed = diff_text.count("\ndiff --git ") + (1 if diff_text.startswith("diff --git ") else 0)
-
-    from backend.services.diff_service import DiffService
-    changed_files = DiffService._parse_unified_diff(diff_text)
-
-    return StepDiffPayload(step_id=step_id, diff=diff_text, files_changed=files_changed, changed_files=changed_files)
+    diff = await diff_cache.get(job.repo, job.worktree_path, str(step.start_sha), str(step.end_sha))
+    return StepDiffPayload(
+        step_id=step_id, diff=diff.diff, files_changed=diff.files_changed, changed_files=diff.changed_files
+    )
 
 
 @router.get("/jobs/{job_id}/transcript/search", response_model=list[TranscriptSearchResult])
@@ -863,10 +862,33 @@ async def get_job_snapshot(
     return resp.model_dump(by_alias=True)
 
 
+@router.get("/jobs/{job_id}/telemetry/waterfall", response_model=JobWaterfallResponse)
+async def get_job_waterfall(
+    job_id: str,
+    session: FromDishka[ReadSession],
+) -> JobWaterfallResponse:
+    """Execution waterfall: where the job's wall-clock time went.
+
+    Sweeps LLM, tool and CodePlane-internal stage spans into one timeline and
+    attributes each instant to a single category (see
+    :mod:`backend.services.critical_path`).
+    """
+    from backend.persistence.telemetry_spans_repo import TelemetrySpansRepo
+    from backend.persistence.telemetry_summary_repo import TelemetrySummaryRepo
+    from backend.services.critical_path import build_waterfall
+
+    summary = await TelemetrySummaryRepo(session).get(job_id)
+    if summary is None:
+        raise HTTPException(status_code=404, detail=f"No telemetry for job {job_id}")
+    spans = await TelemetrySpansRepo(session).list_for_job(job_id)
+    waterfall = build_waterfall(spans, wall_ms=float(summary.get("duration_ms") or 0))
+    return JobWaterfallResponse.model_validate({"job_id": job_id, **waterfall.to_dict()})
+
+
 @router.get("/jobs/{job_id}/telemetry")
 async def get_job_telemetry(
     job_id: str,
-    session: FromDishka[AsyncSession],
+    session: FromDishka[ReadSession],
 ) -> dict[str, object]:
     """Get telemetry data for a job run.
 
@@ -0,0 +1,22 @@
+"""Prometheus/OpenMetrics scrape endpoint."""
+
+from __future__ import annotations
+
+from dishka.integrations.fastapi import DishkaRoute, FromDishka
+from fastapi import APIRouter, Response
+
+from backend.services import telemetry as tel
+from backend.services.job_service import JobService
+from backend.services.openmetrics import CONTENT_TYPE, render
+
+router = APIRouter(tags=["metrics"], route_class=DishkaRoute)
+
+
+@router.get("/metrics", include_in_schema=False)
+async def metrics(svc: FromDishka[JobService]) -> Response:
+    """OpenMetrics exposition of agent usage (``cp.*``) and runtime internals."""
+    # The queue lives in the database, so sample it here rather than in a
+    # (synchronous) observable-gauge callback.
+    tel.jobs_queued_gauge.set(await svc.count_queued_jobs())
+    data = tel.get_memory_reader().get_metrics_data()
+    return Response(content=render(data), media_type=CONTENT_TYPE)
@@ -36,7 +36,7 @@ from backend.models.api_schemas import (
 )
 from backend.services.git_service import GitError, GitService
 from backend.services.platform_adapter import PlatformRegistry, detect_platform
-from backend.services.runtime_service import DEFAULT_SELF_REVIEW_PROMPT, DEFAULT_VERIFY_PROMPT
+from backend.services.runtime_service import DEFAULT_SELF_REVIEW_PROMPT, DEFAULT_VERIFY_PROMPT, RuntimeService
 
 router = APIRouter(tags=["settings"], route_class=DishkaRoute)
 
@@ -78,8 +78,13 @@ async def get_settings(
 @router.put("/settings", response_model=SettingsResponse)
 async def update_settings(
     body: UpdateSettingsRequest,
+    runtime_service: FromDishka[RuntimeService],
 ) -> SettingsResponse:
-    """Update settings. Only provided fields are changed."""
+    """Update settings. Only provided fields are changed.
+
+    The running runtime adopts the saved capacity and budget settings, so
+    jobs held for capacity or budget are reconsidered immediately.
+    """
     config = load_config()
     updates = body.model_dump(exclude_none=True)
     if "max_concurrent_jobs" in updates:
@@ -109,6 +114,7 @@ async def update_settings(
     if "self_review_prompt" in updates:
         config.verification.self_review_prompt = updates["self_review_prompt"]
     save_config(config)
+    runtime_service.apply_config(config)
     return _config_to_response(config)
 
 
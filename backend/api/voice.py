@@ -1,15 +1,22 @@
-"""Voice transcription endpoint."""
+"""Voice transcription endpoints — one-shot upload and a streaming WebSocket."""
 
 from __future__ import annotations
 
 import asyncio
+import json
+import uuid
+from dataclasses import dataclass, field
 
+import structlog
 from dishka.integrations.fastapi import DishkaRoute, FromDishka
-from fastapi import APIRouter, HTTPException, UploadFile
+from fastapi import APIRouter, HTTPException, UploadFile, WebSocket, WebSocketDisconnect
 
 from backend.di import VoiceMaxBytes
 from backend.models.api_schemas import TranscribeResponse
-from backend.services.voice_service import VoiceService
+from backend.services.auth import check_websocket_auth, is_allowed_websocket_origin
+from backend.services.voice_service import VoiceBusyError, VoiceService
+
+log = structlog.get_logger()
 
 router = APIRouter(tags=["voice"], route_class=DishkaRoute)
 
@@ -30,7 +37,35 @@ _AUDIO_MAGIC: list[tuple[bytes, frozenset[str]]] = [
 
 _AUDIO_READ_CHUNK = 64 * 1024  # 64 KB
 
-_transcribe_semaphore = asyncio.Semaphore(2)
+
+@dataclass
+class _StreamState:
+    """Wiring for the WebSocket endpoint, which has no DI request scope; set during lifespan."""
+
+    service: VoiceService | None = field(default=None, repr=False)
+    max_bytes: int = 0
+
+
+_stream_state = _StreamState()
+
+
+def set_voice_service(service: VoiceService, max_bytes: int) -> None:
+    _stream_state.service = service
+    _stream_state.max_bytes = max_bytes
+
+
+def _matches_magic(data: bytes, base_type: str) -> bool:
+    """Whether *data* starts with a signature of the audio type *base_type*."""
+    for magic, types in _AUDIO_MAGIC:
+        if base_type in types:
+            # MP4 ftyp is at offset 4
+            if magic == b"ftyp":
+                matched = data[4:8] == magic if len(data) >= 8 else False
+            else:
+                matched = data[: len(magic)] == magic
+            if matched:
+                return True
+    return False
 
 
 @router.post("/voice/transcribe", response_model=TranscribeResponse)
@@ -68,24 +103,139 @@ async def transcribe(
     # Verify magic bytes match the declared content type to prevent spoofing
     if audio.content_type:
         base_type = audio.content_type.split(";")[0].strip()
-        matched = False
-        for magic, types in _AUDIO_MAGIC:
-            if base_type in types:
-                # MP4 ftyp is at offset 4
-                if magic == b"ftyp":
-                    matched = data[4:8] == magic if len(data) >= 8 else False
-                else:
-                    matched = data[: len(magic)] == magic
-                if matched:
-                    break
-        if not matched:
+        if not _matches_magic(data, base_type):
             raise HTTPException(status_code=415, detail="Audio content does not match declared type")
 
-    # Concurrency-limited, off-event-loop transcription
-    if _transcribe_semaphore._value == 0:  # noqa: SLF001
-        raise HTTPException(status_code=429, detail="Transcription busy, try again later")
-
-    async with _transcribe_semaphore:
-        text = await asyncio.to_thread(voice_service.transcribe, data)
+    # Runs in the resident worker; only a full queue is refused
+    try:
+        text = await voice_service.submit(data)
+    except VoiceBusyError:
+        raise HTTPException(status_code=429, detail="Transcription busy, try again later") from None
 
     return TranscribeResponse(text=text)
+
+
+@router.websocket("/voice/stream")
+async def transcribe_stream(ws: WebSocket) -> None:
+    """Stream audio while recording and receive partial transcripts.
+
+    Protocol:
+        Client → Server:
+            binary frames — consecutive chunks of one recording (e.g. a
+            MediaRecorder with a timeslice); together they form one file
+            { "type": "stop" } — recording finished
+
+        Server → Client:
+            { "type": "partial", "text": "..." } — hypothesis for the audio so far
+            { "type": "final", "text": "..." } — then the server closes
+            { "type": "error", "message": "..." }
+    """
+    client_host = ws.client.host if ws.client else None
+    origin = ws.headers.get("origin")
+    if not is_allowed_websocket_origin(origin):
+        log.warning("voice_ws_origin_rejected", origin=origin, client=client_host)
+        await ws.close(code=1008, reason="Origin not allowed")
+        return
+    if not check_websocket_auth(client_host=client_host, cookies=ws.cookies):
+        await ws.close(code=1008, reason="Authentication required")
+        return
+
+    service = _stream_state.service
+    if service is None:
+        await ws.close(code=1011, reason="Voice service not initialized")
+        return
+    await ws.accept()
+
+    stream_id = uuid.uuid4().hex
+    buffer = bytearray()
+    received = asyncio.Event()
+
+    async def _partials() -> None:
+        sent_for = 0
+        last_text = ""
+        while True:
+            await received.wait()
+            received.clear()
+            if len(buffer) == sent_for:
+                continue
+            sent_for = len(buffer)
+            try:
+                text = await service.submit_partial(stream_id, bytes(buffer))
+            except RuntimeError as exc:
+                # A prefix the decoder cannot read yet; the final result still comes
+                log.debug("voice_partial_failed", stream=stream_id[:8], error=str(exc))
+                text = None
+            if text is not None and text != last_text:
+                last_text = text
+                await ws.send_text(json.dumps({"type": "partial", "text": text}))
+            await asyncio.sleep(service.partial_interval_s)
+
+    async def _error(message: str) -> None:
+        await ws.send_text(json.dumps({"type": "error", "message": message}))
+
+    async def _stop_partials(task: asyncio.Task[None]) -> None:
+        task.cancel()
+        try:
+            await task
+        except asyncio.CancelledError:
+            pass
+        except Exception:
+            # e.g. a send after the client went away — must not mask the real exit
+            log.debug("voice_partials_failed", stream=stream_id[:8], exc_info=True)
+
+    partials: asyncio.Task[None] | None = None
+    try:
+        while True:
+            message = await ws.receive()
+            if message["type"] == "websocket.disconnect":
+                return
+            chunk = message.get("bytes")
+            if chunk:
+                if not buffer and not any(_matches_magic(chunk, t) for t in ALLOWED_AUDIO_TYPES):
+                    await _error("Unsupported audio format")
+                    await ws.close(code=1003)
+                    return
+                buffer += chunk
+                if len(buffer) > _stream_state.max_bytes:
+                    await _error(f"Audio exceeds {_stream_state.max_bytes // (1024 * 1024)} MB limit")
+                    await ws.close(code=1009)
+                    return
+                received.set()
+                if partials is None:
+                    partials = asyncio.create_task(_partials(), name=f"voice-partials-{stream_id[:8]}")
+                continue
+            try:
+                msg = json.loads(message.get("text") or "")
+            except json.JSONDecodeError:
+                await _error("Invalid JSON")
+                continue
+            if not isinstance(msg, dict) or msg.get("type") != "stop":
+                continue
+            if partials is not None:
+                await _stop_partials(partials)
+                partials = None
+            if not buffer:
+                await _error("Empty audio")
+                await ws.close()
+                return
+            try:
+                text = await service.submit(bytes(buffer))
+            except VoiceBusyError:
+                await _error("Transcription busy, try again later")
+                await ws.close(code=1013)
+                return
+            except RuntimeError as exc:
+                log.warning("voice_ws_transcribe_failed", stream=stream_id[:8], error=str(exc))
+                await _error("Transcription failed")
+                await ws.close(code=1011)
+                return
+            await ws.send_text(json.dumps({"type": "final", "text": text}))
+            await ws.close()
+            return
+    except WebSocketDisconnect:
+        log.debug("voice_ws_disconnected", stream=stream_id[:8])
+    except Exception:
+        log.warning("voice_ws_error", stream=stream_id[:8], exc_info=True)
+    finally:
+        if partials is not None:
+            await _stop_partials(partials)
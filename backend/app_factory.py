@@ -23,7 +23,19 @@ if TYPE_CHECKING:
     from starlette.responses import Response
 
 from backend import __version__
-from backend.api import analytics, approvals, artifacts, events, health, jobs, settings, terminal, voice, workspace
+from backend.api import (
+    analytics,
+    approvals,
+    artifacts,
+    events,
+    health,
+    jobs,
+    metrics,
+    settings,
+    terminal,
+    voice,
+    workspace,
+)
 from backend.lifespan import lifespan
 from backend.services.agent_adapter import SDKModelMismatchError
 from backend.services.approval_service import ApprovalAlreadyResolvedError, ApprovalNotFoundError
@@ -46,6 +58,39 @@ def get_allowed_ws_origins() -> set[str]:
     return _allowed_ws_origins
 
 
+def _add_security_headers(app: FastAPI, *, dev: bool, tunnel_origin: str | None) -> None:
+    """Add the standard hardening headers (CSP, nosniff, frame denial) to every response."""
+    csp_parts = [
+        "default-src 'self'",
+        "script-src 'self'",
+        "style-src 'self' 'unsafe-inline'",
+        "img-src 'self' data:",
+        "font-src 'self' data:",
+        "connect-src 'self'",
+    ]
+    if dev:
+        # Allow Vite HMR WebSocket and hot-update fetches
+        csp_parts.append("connect-src 'self' ws://localhost:5173 http://localhost:5173")
+    if tunnel_origin:
+        parsed = urlparse(tunnel_origin)
+        ws_scheme = "wss" if parsed.scheme == "https" else "ws"
+        ws_origin = f"{ws_scheme}://{parsed.netloc}"
+        csp_parts.append(f"connect-src 'self' {ws_origin} {tunnel_origin}")
+    csp_value = "; ".join(csp_parts)
+
+    @app.middleware("http")
+    async def _security_headers(request: Request, call_next: Callable[..., Awaitable[Response]]) -> Response:
+        response = await call_next(request)
+        response.headers["X-Content-Type-Options"] = "nosniff"
+        response.headers["X-Frame-Options"] = "DENY"
+        response.headers["Referrer-Policy"] = "no-referrer"
+        response.headers["Content-Security-Policy"] = csp_value
+        # Don't override Cache-Control for SSE or static assets that set their own
+        if "Cache-Control" not in response.headers:
+            response.headers["Cache-Control"] = "no-store"
+        return response
+
+
 def _configure_middleware(
     app: FastAPI,
     *,
@@ -102,53 +147,29 @@ def _configure_middleware(
             allow_headers=["Content-Type", "Authorization", "Last-Event-ID"],
         )
 
-    # --- Security headers middleware ---
-    csp_parts = [
-        "default-src 'self'",
-        "script-src 'self'",
-        "style-src 'self' 'unsafe-inline'",
-        "img-src 'self' data:",
-        "font-src 'self' data:",
-        "connect-src 'self'",
-    ]
-    if dev:
-        # Allow Vite HMR WebSocket and hot-update fetches
-        csp_parts.append("connect-src 'self' ws://localhost:5173 http://localhost:5173")
-    if tunnel_origin:
-        parsed = urlparse(tunnel_origin)
-        ws_scheme = "wss" if parsed.scheme == "https" else "ws"
-        ws_origin = f"{ws_scheme}://{parsed.netloc}"
-        csp_parts.append(f"connect-src 'self' {ws_origin} {tunnel_origin}")
-    csp_value = "; ".join(csp_parts)
-
-    @app.middleware("http")
-    async def _security_headers(request: Request, call_next: Callable[..., Awaitable[Response]]) -> Response:
-        response = await call_next(request)
-        response.headers["X-Content-Type-Options"] = "nosniff"
-        response.headers["X-Frame-Options"] = "DENY"
-        response.headers["Referrer-Policy"] = "no-referrer"
-        response.headers["Content-Security-Policy"] = csp_value
-        # Don't override Cache-Control for SSE or static assets that set their own
-        if "Cache-Control" not in response.headers:
-            response.headers["Cache-Control"] = "no-store"
-        return response
+    _add_security_headers(app, dev=dev, tunnel_origin=tunnel_origin)
 
     # Password auth — enabled when password is provided (tunnel mode or explicit)
     if password:
+        from backend.config import load_config
         from backend.services.auth import (
             auth_middleware,
             authenticate_login_request,
             authenticate_logout_request,
+            check_session_request,
+            has_bearer_token,
             is_request_authenticated,
             set_password,
         )
 
         set_password(password)
+        metrics_token = load_config().metrics.token
 
         from starlette.routing import Route
 
         app.routes.insert(0, Route("/api/auth/login", authenticate_login_request, methods=["POST"]))
         app.routes.insert(1, Route("/api/auth/logout", authenticate_logout_request, methods=["POST"]))
+        app.routes.insert(2, Route("/api/auth/session", check_session_request, methods=["GET"]))
 
         @app.middleware("http")
         async def _auth_gate(request: Request, call_next: Callable[..., Awaitable[Response]]) -> Response:
@@ -158,6 +179,9 @@ def _configure_middleware(
                 if not is_request_authenticated(request):
                     return JSONResponse({"detail": "Authentication required"}, status_code=401)
                 return await call_next(request)
+            # Remote Prometheus scrapers can't log in; they present metrics.token instead.
+            if request.url.path == "/metrics" and has_bearer_token(request, metrics_token):
+                return await call_next(request)
             return await auth_middleware(request, call_next)
 
 
@@ -174,6 +198,8 @@ def _register_routes(app: FastAPI) -> None:
     app.include_router(analytics.router, prefix="/api")
     # Terminal router has its own /api/terminal prefix
     app.include_router(terminal.router)
+    # Prometheus convention: scrape path at the root, not under /api
+    app.include_router(metrics.router)
 
 
 def _register_domain_exception_handlers(app: FastAPI) -> None:
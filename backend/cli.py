@@ -15,7 +15,8 @@ import click
 import structlog
 import uvicorn
 
-from backend.app_factory import create_app
+# Imported first so the startup profile clock covers loading the application
+from backend.startup_profile import profile as startup_profile  # isort: skip
 from backend.config import load_config
 from backend.logging_config import setup_logging
 from backend.persistence.database import run_migrations
@@ -141,6 +142,13 @@ def _cloudflare_access_enabled(tunnel_origin: str) -> bool:
 @click.option("--no-password", is_flag=True, help="Disable password auth (not allowed with --remote)")
 @click.option("--tunnel-name", default=None, help="Dev Tunnel name (default: random, reused across restarts)")
 @click.option("--skip-preflight", is_flag=True, help="Skip preflight checks")
+@click.option(
+    "--workers",
+    default=None,
+    type=click.IntRange(min=0),
+    help="Front processes serving HTTP/SSE next to one runtime process (default: from config or 0)",
+)
+@click.option("--profile-startup", is_flag=True, help="Print how long each startup phase took")
 def up(
     host: str | None,
     port: int | None,
@@ -151,18 +159,24 @@ def up(
     no_password: bool,
     tunnel_name: str | None,
     skip_preflight: bool,
+    workers: int | None,
+    profile_startup: bool,
 ) -> None:
     """Start the CodePlane server."""
+    startup_profile.enabled = profile_startup
+    startup_profile.phase_since("imports", 0.0)
     config = load_config()
     host = host or config.server.host
     port = port or config.server.port
+    workers = config.server.workers if workers is None else workers
 
     # Run preflight checks before starting
     if not skip_preflight:
         from backend.services.setup_service import validate_preflight
 
-        if not validate_preflight(port):
-            raise SystemExit(1)
+        with startup_profile.phase("preflight"):
+            if not validate_preflight(port):
+                raise SystemExit(1)
 
     if not remote and provider != "devtunnel":
         click.secho(
@@ -239,7 +253,8 @@ def up(
 
     # Build frontend (unless --dev, which uses Vite's hot-reload server separately)
     if not dev:
-        _build_frontend()
+        with startup_profile.phase("frontend_build"):
+            _build_frontend()
 
     # Configure logging before everything else so all startup messages are captured.
     # Create the console log now (TTY check) so the log handler can be wired in
@@ -253,10 +268,14 @@ def up(
         max_file_size_mb=config.logging.max_file_size_mb,
         backup_count=config.logging.backup_count,
         dashboard=dashboard,
+        log_format=config.logging.format,
+        queue_size=config.logging.queue_size,
+        debug_sample=config.logging.debug_sample,
     )
 
-    # Run Alembic migrations before starting the server
-    run_migrations()
+    # Run Alembic migrations before starting the server (a no-op check when current)
+    with startup_profile.phase("migrations"):
+        run_migrations(config=config.database)
 
     # Auto-generate password when binding to all interfaces without one set
     if host == "0.0.0.0" and not effective_password:  # noqa: S104
@@ -304,7 +323,10 @@ def up(
                 log.info("cloudflare_access_detected", msg="Disabling local password auth — Cloudflare Access is active")
                 effective_password = None
 
-    app = create_app(dev=dev, tunnel_origin=tunnel_origin, password=effective_password)
+    with startup_profile.phase("app_imports"):
+        from backend.app_factory import create_app
+    with startup_profile.phase("create_app"):
+        app = create_app(dev=dev, tunnel_origin=tunnel_origin, password=effective_password)
 
     # Stash banner info so lifespan can print it after services are ready.
     # Also stash the dashboard so lifespan can subscribe it to the EventBus
@@ -323,12 +345,35 @@ def up(
     # signal handlers via loop.add_signal_handler() which overrides any
     # signal.signal() handlers we set beforehand, so the only reliable way
     # to hook into the signal path is to wrap the Server's own callback.
-    uv_config = uvicorn.Config(
-        app,
-        host=host,
-        port=port,
-        log_level="warning" if dashboard else "info",
-    )
+    log_level = "warning" if dashboard else "info"
+    fronts: list[Any] = []
+    if workers:
+        # Multi-worker mode: this process becomes the runtime, served on a
+        # private Unix socket; front processes own host:port (see front_app).
+        from backend.front_app import EVENT_SOCKET_NAME, RUNTIME_SOCKET_NAME, FrontSettings, run_dir
+
+        sockets = run_dir()
+        runtime_socket = sockets / RUNTIME_SOCKET_NAME
+        app.state.event_socket_path = sockets / EVENT_SOCKET_NAME
+        runtime_socket.unlink(missing_ok=True)
+        uv_config = uvicorn.Config(
+            startup_profile.wrap(app), uds=str(runtime_socket), forwarded_allow_ips="*", log_level=log_level
+        )
+        fronts = _start_front_workers(
+            workers,
+            host=host,
+            port=port,
+            settings=FrontSettings(
+                runtime_socket=runtime_socket,
+                event_socket=app.state.event_socket_path,
+                auth_enabled=bool(effective_password),
+                dev=dev,
+                tunnel_origin=tunnel_origin,
+                log_level="warning",
+            ),
+        )
+    else:
+        uv_config = uvicorn.Config(startup_profile.wrap(app), host=host, port=port, log_level=log_level)
     server = uvicorn.Server(uv_config)
 
     if dashboard is not None:
@@ -345,10 +390,46 @@ def up(
     finally:
         if dashboard is not None:
             dashboard.stop()
+        _stop_front_workers(fronts)
         if tunnel_handle is not None:
             tunnel_handle.close()
 
 
+def _start_front_workers(count: int, *, host: str, port: int, settings: Any) -> list[Any]:
+    """Bind host:port once and spawn *count* front processes sharing the socket."""
+    import multiprocessing
+
+    from backend.front_app import run_front_worker
+
+    sock = uvicorn.Config("backend.front_app:create_front_app", host=host, port=port).bind_socket()
+    context = multiprocessing.get_context("spawn")
+    processes = []
+    for index in range(count):
+        process = context.Process(
+            target=run_front_worker,
+            args=(sock, settings),
+            name=f"codeplane-front-{index}",
+            daemon=True,
+        )
+        process.start()
+        processes.append(process)
+    sock.close()
+    log.info("front_workers_started", count=count, host=host, port=port)
+    return processes
+
+
+def _stop_front_workers(processes: list[Any], timeout_seconds: float = 10) -> None:
+    """SIGTERM the front processes, then SIGKILL any that outlive *timeout_seconds*."""
+    for process in processes:
+        if process.is_alive():
+            process.terminate()
+    for process in processes:
+        process.join(timeout_seconds)
+        if process.is_alive():
+            process.kill()
+            process.join()
+
+
 # ---------------------------------------------------------------------------
 # Connection info (on-demand via ``cpl info``)
 # ---------------------------------------------------------------------------
@@ -424,6 +505,34 @@ def info(host: str, port: int, tunnel_url: str | None, password: str | None) ->
     _print_connection_info(host=host, port=port, tunnel_url=tunnel_url, password=password)
 
 
+@cli.command("backfill-attribution")
+@click.option("--batch-size", default=500, type=int, show_default=True, help="Jobs recomputed per transaction")
+def backfill_attribution(batch_size: int) -> None:
+    """Recompute cost attribution for every historical job."""
+    import asyncio
+    import time
+
+    from backend.persistence.database import create_engine, create_session_factory
+    from backend.services.cost_attribution_batch import backfill_attribution as run_backfill
+    from backend.services.cost_attribution_batch import numpy_available
+
+    database = load_config().database
+    run_migrations(config=database)
+    if not numpy_available():
+        click.secho("NumPy not installed — using the per-job path (pip install 'codeplane[analytics]').", fg="yellow")
+
+    async def _run() -> int:
+        engine = create_engine(config=database)
+        try:
+            return await run_backfill(create_session_factory(engine), batch_size=batch_size)
+        finally:
+            await engine.dispose()
+
+    started = time.perf_counter()
+    jobs = asyncio.run(_run())
+    click.secho(f"Recomputed attribution for {jobs} jobs in {time.perf_counter() - started:.1f}s.", fg="green")
+
+
 @cli.command()
 def setup() -> None:
     """Interactive setup wizard — check dependencies, configure data directory, authenticate."""
@@ -665,6 +774,13 @@ def down(host: str | None, port: int | None, force: bool) -> None:
 @click.option("--no-password", is_flag=True, help="Disable password auth (not allowed with --remote)")
 @click.option("--tunnel-name", default=None, help="Dev Tunnel name (default: random, reused across restarts)")
 @click.option("--skip-preflight", is_flag=True, help="Skip preflight checks")
+@click.option(
+    "--workers",
+    default=None,
+    type=click.IntRange(min=0),
+    help="Front processes serving HTTP/SSE next to one runtime process (default: from config or 0)",
+)
+@click.option("--profile-startup", is_flag=True, help="Print how long each startup phase took")
 @click.option("--force", is_flag=True, help="Skip session pausing on shutdown")
 def restart(
     host: str | None,
@@ -676,6 +792,8 @@ def restart(
     no_password: bool,
     tunnel_name: str | None,
     skip_preflight: bool,
+    workers: int | None,
+    profile_startup: bool,
     force: bool,
 ) -> None:
     """Stop a running instance (if any) then start the server.
@@ -716,6 +834,10 @@ def restart(
         args.extend(["--tunnel-name", tunnel_name])
     if skip_preflight:
         args.append("--skip-preflight")
+    if workers is not None:
+        args.extend(["--workers", str(workers)])
+    if profile_startup:
+        args.append("--profile-startup")
 
     click.echo("Starting CodePlane…")
     import os
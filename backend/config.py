@@ -107,6 +107,7 @@ repos: []
 class ServerConfig:
     host: str = "127.0.0.1"
     port: int = 8080
+    workers: int = 0  # SSE/HTTP front processes; 0 serves everything from one process
 
 
 @dataclass
@@ -117,6 +118,7 @@ class RuntimeConfig:
     utility_model: str = "gpt-4o-mini"  # cheap/fast model for naming, summaries, etc.
     default_sdk: str = "copilot"  # copilot | claude
     suppressed_preflight_agent_prompts: list[str] = field(default_factory=list)
+    recovery_concurrency: int = 4  # jobs resumed in parallel after a crash or restart
 
 
 @dataclass
@@ -133,6 +135,9 @@ class LoggingConfig:
     file: str = "~/.codeplane/logs/server.log"
     max_file_size_mb: int = 50
     backup_count: int = 3
+    format: str = "kv"  # kv | json (one JSON object per line)
+    queue_size: int = 10_000  # records buffered for the file writer before dropping
+    debug_sample: dict[str, float] = field(default_factory=dict)  # logger prefix -> fraction of DEBUG kept
 
 
 @dataclass
@@ -188,6 +193,80 @@ class TelemetryConfig:
     claude_monthly_budget_usd: float = 0.0
     # Copilot entitlement auto-detected from SDK quota snapshots, but overridable.
     copilot_premium_entitlement: int = 0
+    # Live budget enforcement against the two monthly caps above (0 = unlimited).
+    # Past ``budget_soft_pct`` of a cap, new jobs for that SDK start on its
+    # ``budget_downgrade_models`` entry (sdk → model); at 100% running jobs are
+    # paused and queued jobs are held until the month rolls over.
+    budget_soft_pct: float = 80.0
+    budget_downgrade_models: dict[str, str] = field(default_factory=dict)
+    # Per-job hard cap in USD: a job crossing it is paused (0 = unlimited).
+    job_budget_usd: float = 0.0
+    # Optional columnar sink (requires the ``analytics`` extra, i.e. DuckDB).
+    # When set, spans and summaries are exported to day-partitioned Parquet
+    # under this directory and cross-job analysis queries run over it.
+    columnar_export_dir: str = ""
+    columnar_export_interval_s: int = 900
+    # File accesses are kept as per-job, per-file counters; this fraction of
+    # them is also logged individually to job_file_access_log (0 = none).
+    file_access_raw_sample_rate: float = 0.0
+
+
+@dataclass
+class DatabaseConfig:
+    """Database backend, SQLite connection profile and maintenance schedule."""
+
+    # SQLAlchemy URL of a shared PostgreSQL server (``postgresql://user:pw@host/db``).
+    # Empty uses the local SQLite file; ``CODEPLANE_DATABASE_URL`` overrides it.
+    url: str = ""
+    # Page cache per connection and memory-mapped I/O window (MiB).
+    cache_size_mb: int = 64
+    mmap_size_mb: int = 256
+    # Read-only pool used by analytics and telemetry reads.
+    read_pool_size: int = 8
+    # PASSIVE WAL checkpoint cadence and ``PRAGMA optimize`` cadence (seconds).
+    checkpoint_interval_s: int = 60
+    optimize_interval_s: int = 3600
+    # Log a warning when the WAL file grows past this (readers pinning old snapshots).
+    wal_warn_mb: int = 256
+
+
+@dataclass
+class ApprovalRulesConfig:
+    """Auto-approval of commands the operator keeps approving (REVIEW_AND_APPROVE).
+
+    Opt-in: migration 0018 backfills counts from past approvals, so enabling
+    it can auto-approve commands immediately.
+    """
+
+    enabled: bool = False
+    # Operator approvals of the exact same command in a repo, with no
+    # rejection, before further requests for it are approved instantly.
+    min_approvals: int = 10
+
+
+@dataclass
+class VoiceConfig:
+    """Resident speech-to-text worker (requires the ``voice`` extra)."""
+
+    model: str = "base.en"
+    # Load the model and run one warm-up pass right after startup; when off,
+    # the worker starts on the first transcription request instead.
+    preload: bool = True
+    # Requests transcribed concurrently by the worker (model replicas).
+    workers: int = 2
+    # Requests waiting or in flight before new ones get HTTP 429.
+    queue_limit: int = 16
+    # Seconds between partial hypotheses on the streaming WebSocket.
+    partial_interval_s: float = 1.0
+
+
+@dataclass
+class MetricsConfig:
+    """``GET /metrics`` scrape endpoint."""
+
+    # Bearer token that lets a remote Prometheus scrape /metrics when password
+    # auth is on (``Authorization: Bearer <token>``).  Empty = localhost only.
+    token: str = ""
 
 
 @dataclass
@@ -201,6 +280,10 @@ class CPLConfig:
     terminal: TerminalConfig = field(default_factory=TerminalConfig)
     verification: VerificationConfig = field(default_factory=VerificationConfig)
     telemetry: TelemetryConfig = field(default_factory=TelemetryConfig)
+    database: DatabaseConfig = field(default_factory=DatabaseConfig)
+    approval_rules: ApprovalRulesConfig = field(default_factory=ApprovalRulesConfig)
+    voice: VoiceConfig = field(default_factory=VoiceConfig)
+    metrics: MetricsConfig = field(default_factory=MetricsConfig)
     platforms: dict[str, PlatformConfig] = field(default_factory=dict)
     repos: list[str] = field(default_factory=list)
 
@@ -247,6 +330,10 @@ def load_config(path: Path | None = None) -> CPLConfig:
         terminal=_parse_section(raw, TerminalConfig, "terminal"),
         verification=_parse_section(raw, VerificationConfig, "verification"),
         telemetry=_parse_section(raw, TelemetryConfig, "telemetry"),
+        database=_parse_section(raw, DatabaseConfig, "database"),
+        approval_rules=_parse_section(raw, ApprovalRulesConfig, "approval_rules"),
+        voice=_parse_section(raw, VoiceConfig, "voice"),
+        metrics=_parse_section(raw, MetricsConfig, "metrics"),
         platforms=platforms,
         repos=[str(r) for r in raw.get("repos", []) if r is not None] if isinstance(raw.get("repos", []), list) else [],
     )
@@ -103,6 +103,21 @@ class ConsoleLog:
     ``None`` so the plain logging path continues unchanged.
     """
 
+    # The kinds _apply_event prints or tracks
+    EVENT_KINDS = frozenset(
+        {
+            DomainEventKind.job_created,
+            DomainEventKind.job_state_changed,
+            DomainEventKind.job_review,
+            DomainEventKind.job_completed,
+            DomainEventKind.job_failed,
+            DomainEventKind.job_canceled,
+            DomainEventKind.job_title_updated,
+            DomainEventKind.progress_headline,
+            DomainEventKind.approval_requested,
+        }
+    )
+
     def __init__(self, log_file_path: str | None = None) -> None:
         self._console = Console(stderr=True, highlight=False)
         self._jobs: dict[str, _JobInfo] = {}
@@ -23,11 +23,15 @@ from backend.services.platform_adapter import PlatformRegistry
 from backend.services.runtime_service import RuntimeService
 from backend.services.sse_manager import SSEManager
 from backend.services.sister_session import SisterSessionManager
+from backend.services.step_diff_cache import StepDiffCache
 from backend.services.voice_service import VoiceService
 
 # NewType wrappers for plain values that need unique DI keys
 CachedModelsBySdk = NewType("CachedModelsBySdk", dict[str, Any])
 VoiceMaxBytes = NewType("VoiceMaxBytes", int)
+# Sessions on the query_only pool — for read-only endpoints (analytics, telemetry)
+ReadSessionFactory = NewType("ReadSessionFactory", async_sessionmaker[AsyncSession])
+ReadSession = NewType("ReadSession", AsyncSession)
 
 
 class AppProvider(Provider):
@@ -39,6 +43,7 @@ class AppProvider(Provider):
 
     config = from_context(provides=CPLConfig)
     session_factory = from_context(provides=async_sessionmaker)
+    read_session_factory = from_context(provides=ReadSessionFactory)
     event_bus = from_context(provides=EventBus)
     sse_manager = from_context(provides=SSEManager)
     approval_service = from_context(provides=ApprovalService)
@@ -49,6 +54,7 @@ class AppProvider(Provider):
     voice_service = from_context(provides=VoiceService)
     cached_models = from_context(provides=CachedModelsBySdk)
     voice_max_bytes = from_context(provides=VoiceMaxBytes)
+    step_diff_cache = from_context(provides=StepDiffCache)
 
 
 class RequestProvider(Provider):
@@ -69,6 +75,11 @@ class RequestProvider(Provider):
                 await session.rollback()
                 raise
 
+    @provide
+    async def read_session(self, sf: ReadSessionFactory) -> AsyncIterator[ReadSession]:
+        async with sf() as session:
+            yield ReadSession(session)
+
     @provide
     def job_service(
         self,
@@ -0,0 +1,318 @@
+"""Front worker application for multi-worker mode (``cpl up --workers N``).
+
+The runtime process runs the full application (``app_factory.create_app``)
+on a private Unix socket.  N front processes share the public host:port.
+Each front:
+
+- serves ``/api/events`` itself, from a local :class:`SSEManager` fed by the
+  runtime's event socket (``services/event_socket.py``), replaying missed
+  events from a read-only database pool;
+- proxies every other HTTP request and WebSocket to the runtime socket,
+  streaming bodies both ways.
+
+Authentication stays in the runtime, which owns the session tokens.  The
+front replaces ``X-Forwarded-For`` with the real peer address, so the
+runtime's localhost and cookie checks see the browser, not the front.  For
+``/api/events`` the front asks the runtime (``GET /api/auth/session``) and
+caches positive answers briefly.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import contextlib
+import time
+from contextlib import asynccontextmanager
+from dataclasses import dataclass
+from typing import TYPE_CHECKING, Any
+
+import httpx
+import structlog
+import uvicorn
+from dishka import Provider, Scope, from_context, make_async_container
+from dishka.integrations.fastapi import ContainerMiddleware  # type: ignore[attr-defined]
+from fastapi import FastAPI
+from fastapi.responses import JSONResponse
+from sqlalchemy.ext.asyncio import async_sessionmaker
+from starlette.background import BackgroundTask
+from starlette.responses import StreamingResponse
+from starlette.routing import Route, WebSocketRoute
+
+from backend import __version__
+from backend.api import events
+from backend.app_factory import _add_security_headers
+from backend.config import CPLConfig, get_codeplane_dir, load_config
+from backend.persistence.database import create_read_engine, create_session_factory
+from backend.services.auth import COOKIE_NAME, is_localhost
+from backend.services.event_socket import EventSocketClient
+from backend.services.sse_manager import SSEManager
+
+if TYPE_CHECKING:
+    import socket
+    from collections.abc import AsyncGenerator, Awaitable, Callable
+    from pathlib import Path
+
+    from starlette.requests import Request
+    from starlette.responses import Response
+    from starlette.websockets import WebSocket
+
+log = structlog.get_logger()
+
+RUNTIME_SOCKET_NAME = "runtime.sock"
+EVENT_SOCKET_NAME = "events.sock"
+
+_AUTH_CACHE_TTL_S = 30.0
+# Hop-by-hop headers (RFC 9110 §7.6.1) are never forwarded; X-Forwarded-*
+# from the client is dropped so it cannot spoof its address to the runtime.
+_HOP_HEADERS = frozenset(
+    {
+        b"connection",
+        b"keep-alive",
+        b"proxy-authenticate",
+        b"proxy-authorization",
+        b"te",
+        b"trailer",
+        b"transfer-encoding",
+        b"upgrade",
+        b"host",
+    }
+)
+# The front's own server adds these to every response
+_RESPONSE_SKIP_HEADERS = _HOP_HEADERS | {b"date", b"server"}
+_WS_FORWARD_HEADERS = ("cookie", "user-agent", "accept-language")
+
+
+def run_dir() -> Path:
+    """Private directory holding the runtime and event sockets (mode 0700)."""
+    path = get_codeplane_dir() / "run"
+    path.mkdir(parents=True, exist_ok=True)
+    path.chmod(0o700)
+    return path
+
+
+@dataclass(frozen=True)
+class FrontSettings:
+    """Everything a spawned front worker needs (must stay picklable)."""
+
+    runtime_socket: Path
+    event_socket: Path
+    auth_enabled: bool
+    dev: bool = False
+    tunnel_origin: str | None = None
+    log_level: str = "warning"
+
+
+class FrontProvider(Provider):
+    """The subset of ``di.AppProvider`` the SSE route needs."""
+
+    scope = Scope.APP
+
+    config = from_context(provides=CPLConfig)
+    session_factory = from_context(provides=async_sessionmaker)
+    sse_manager = from_context(provides=SSEManager)
+
+
+class _SessionCache:
+    """Short-lived memo of session cookies the runtime has accepted."""
+
+    def __init__(self) -> None:
+        self._expiry: dict[str, float] = {}
+
+    def hit(self, token: str) -> bool:
+        expires = self._expiry.get(token)
+        if expires is None:
+            return False
+        if expires < time.monotonic():
+            del self._expiry[token]
+            return False
+        return True
+
+    def add(self, token: str) -> None:
+        now = time.monotonic()
+        if len(self._expiry) > 1024:
+            self._expiry = {t: e for t, e in self._expiry.items() if e >= now}
+        self._expiry[token] = now + _AUTH_CACHE_TTL_S
+
+
+def _peer(client: Any) -> str:
+    return client.host if client is not None else ""
+
+
+async def _sse_authorized(request: Request) -> bool:
+    if is_localhost(request):
+        return True
+    token = request.cookies.get(COOKIE_NAME)
+    if not token:
+        return False
+    cache: _SessionCache = request.app.state.session_cache
+    if cache.hit(token):
+        return True
+    runtime: httpx.AsyncClient = request.app.state.runtime
+    try:
+        resp = await runtime.get(
+            "/api/auth/session",
+            headers={"cookie": request.headers.get("cookie", ""), "x-forwarded-for": _peer(request.client)},
+        )
+    except httpx.TransportError:
+        return False
+    if resp.status_code != 204:
+        return False
+    cache.add(token)
+    return True
+
+
+async def _proxy_http(request: Request) -> Response:
+    runtime: httpx.AsyncClient = request.app.state.runtime
+    headers = [
+        (name, value)
+        for name, value in request.headers.raw
+        if name not in _HOP_HEADERS and not name.startswith(b"x-forwarded-")
+    ]
+    headers.append((b"x-forwarded-for", _peer(request.client).encode()))
+    headers.append((b"x-forwarded-proto", request.url.scheme.encode()))
+    target = request.scope.get("raw_path") or request.url.path.encode()
+    if query := request.scope.get("query_string"):
+        target += b"?" + query
+    has_body = "content-length" in request.headers or "transfer-encoding" in request.headers
+    upstream = runtime.build_request(
+        request.method,
+        httpx.URL(raw_path=target),
+        headers=headers,
+        content=request.stream() if has_body else None,
+    )
+    try:
+        resp = await runtime.send(upstream, stream=True)
+    except httpx.TransportError as exc:
+        log.warning("front_runtime_unreachable", path=request.url.path, error=str(exc))
+        return JSONResponse({"detail": "Runtime unavailable"}, status_code=503)
+    response = StreamingResponse(resp.aiter_raw(), status_code=resp.status_code, background=BackgroundTask(resp.aclose))
+    response.raw_headers = [
+        (name, value) for name, value in resp.headers.raw if name.lower() not in _RESPONSE_SKIP_HEADERS
+    ]
+    return response
+
+
+async def _proxy_websocket(ws: WebSocket) -> None:
+    from websockets.asyncio.client import unix_connect
+    from websockets.exceptions import ConnectionClosed, InvalidHandshake
+
+    settings: FrontSettings = ws.app.state.settings
+    uri = f"ws://codeplane{ws.url.path}" + (f"?{ws.url.query}" if ws.url.query else "")
+    headers = [(name, ws.headers[name]) for name in _WS_FORWARD_HEADERS if name in ws.headers]
+    headers.append(("x-forwarded-for", _peer(ws.client)))
+    try:
+        upstream = await unix_connect(
+            str(settings.runtime_socket),
+            uri,
+            origin=ws.headers.get("origin"),
+            subprotocols=ws.scope.get("subprotocols") or None,
+            additional_headers=headers,
+            max_size=None,
+        )
+    except (OSError, InvalidHandshake):
+        # The runtime refused the upgrade (origin or auth check) or is down
+        await ws.close(code=1008)
+        return
+
+    await ws.accept(subprotocol=upstream.subprotocol)
+
+    async def _to_runtime() -> None:
+        while True:
+            message = await ws.receive()
+            if message["type"] == "websocket.disconnect":
+                return
+            data = message.get("text")
+            await upstream.send(data if data is not None else message.get("bytes") or b"")
+
+    async def _to_client() -> None:
+        async for data in upstream:
+            if isinstance(data, str):
+                await ws.send_text(data)
+            else:
+                await ws.send_bytes(data)
+
+    pumps = [asyncio.create_task(_to_runtime()), asyncio.create_task(_to_client())]
+    try:
+        await asyncio.wait(pumps, return_when=asyncio.FIRST_COMPLETED)
+    finally:
+        for task in pumps:
+            task.cancel()
+        with contextlib.suppress(ConnectionClosed):
+            await upstream.close()
+        with contextlib.suppress(RuntimeError):
+            await ws.close(code=upstream.close_code or 1000)
+
+
+@asynccontextmanager
+async def _front_lifespan(app: FastAPI) -> AsyncGenerator[None, None]:
+    settings: FrontSettings = app.state.settings
+    config = load_config()
+    read_engine = create_read_engine(config=config.database)
+    sse_manager = SSEManager()
+    client = EventSocketClient(settings.event_socket, sse_manager)
+    consumer = asyncio.create_task(client.run(), name="event-socket-client")
+    app.state.runtime = httpx.AsyncClient(
+        transport=httpx.AsyncHTTPTransport(uds=str(settings.runtime_socket)),
+        base_url="http://codeplane",
+        timeout=httpx.Timeout(None, connect=5.0),
+        limits=httpx.Limits(max_connections=None, max_keepalive_connections=64),
+    )
+    app.state.session_cache = _SessionCache()
+    container = make_async_container(
+        FrontProvider(),
+        context={
+            CPLConfig: config,
+            async_sessionmaker: create_session_factory(read_engine),
+            SSEManager: sse_manager,
+        },
+    )
+    app.state.dishka_container = container
+
+    yield
+
+    await sse_manager.close_all()
+    consumer.cancel()
+    await container.close()
+    await app.state.runtime.aclose()
+    await read_engine.dispose()
+
+
+def create_front_app(settings: FrontSettings) -> FastAPI:
+    """Create the SSE-serving, runtime-proxying app for one front worker."""
+    # No local docs routes — /docs and /openapi.json are proxied like the rest
+    app = FastAPI(
+        title="CodePlane",
+        version=__version__,
+        lifespan=_front_lifespan,
+        docs_url=None,
+        redoc_url=None,
+        openapi_url=None,
+    )
+    app.state.settings = settings
+
+    app.add_middleware(ContainerMiddleware)
+    _add_security_headers(app, dev=settings.dev, tunnel_origin=settings.tunnel_origin)
+
+    if settings.auth_enabled:
+
+        @app.middleware("http")
+        async def _sse_auth_gate(request: Request, call_next: Callable[..., Awaitable[Response]]) -> Response:
+            if request.url.path == "/api/events" and not await _sse_authorized(request):
+                return JSONResponse({"detail": "Authentication required"}, status_code=401)
+            return await call_next(request)
+
+    app.include_router(events.router, prefix="/api")
+    methods = ["GET", "HEAD", "POST", "PUT", "PATCH", "DELETE", "OPTIONS"]
+    app.router.routes.append(Route("/{path:path}", _proxy_http, methods=methods))
+    app.router.routes.append(WebSocketRoute("/{path:path}", _proxy_websocket))
+    return app
+
+
+def run_front_worker(sock: socket.socket, settings: FrontSettings) -> None:
+    """Entry point of a spawned front process serving on the inherited *sock*."""
+    config = uvicorn.Config(
+        create_front_app(settings),
+        log_level=settings.log_level,
+        timeout_graceful_shutdown=5,
+    )
+    uvicorn.Server(config).run(sockets=[sock])
@@ -7,6 +7,9 @@ graceful shutdown.  Extracted from main.py to keep concerns separated.
 from __future__ import annotations
 
 import asyncio
+import importlib
+import time
+import contextlib
 from contextlib import asynccontextmanager
 from dataclasses import dataclass
 from pathlib import Path
@@ -17,34 +20,52 @@ from dishka import make_async_container
 from sqlalchemy.exc import OperationalError
 from sqlalchemy.ext.asyncio import async_sessionmaker
 
-from backend.config import MCP_PATH, VOICE_MAX_AUDIO_SIZE_MB, CPLConfig, load_config
-from backend.di import AppProvider, CachedModelsBySdk, RequestProvider, VoiceMaxBytes
+from backend import logging_config
+from backend.config import DEFAULT_DB_PATH, MCP_PATH, VOICE_MAX_AUDIO_SIZE_MB, CPLConfig, load_config
+from backend.di import AppProvider, CachedModelsBySdk, ReadSessionFactory, RequestProvider, VoiceMaxBytes
 from backend.models.events import DomainEventKind
-from backend.persistence.database import create_engine, create_session_factory
+from backend.persistence.database import (
+    create_engine,
+    create_read_engine,
+    create_session_factory,
+    create_writer_engine,
+    postgres_url,
+)
 from backend.persistence.event_repo import EventRepository
+from backend.persistence.sqlite_maintenance import SqliteMaintenance
 from backend.persistence.step_repo import StepRepository
+from backend.services import telemetry as tel
 from backend.services.adapter_registry import AdapterRegistry
+from backend.services.approval_rules import ApprovalRules
 from backend.services.approval_service import ApprovalService
+from backend.services.columnar_store import ColumnarStore
+from backend.services.cost_ledger import CostLedger
 from backend.services.diff_service import DiffService
 from backend.services.event_bus import EventBus
+from backend.services.event_socket import EventSocketServer
+from backend.services.file_access_tracker import get_file_access_tracker
 from backend.services.git_service import GitService
 from backend.services.merge_service import MergeService
+from backend.services.pg_event_relay import ControlChannel, PgEventRelay
 from backend.services.platform_adapter import PlatformRegistry
 from backend.services.retention_service import RetentionService
 from backend.services.runtime_service import RuntimeService
 from backend.services.sse_manager import SSEManager
 from backend.services.step_persistence import StepPersistenceSubscriber
 from backend.services.progress_tracking_service import ProgressTrackingService, _ProgressSubscriber
+from backend.services.step_diff_cache import StepDiffCache
 from backend.services.step_tracker import StepTracker
 from backend.services.summarization_service import SummarizationService
 from backend.services.sister_session import SisterSessionManager
+from backend.services.repo_registry import RepoRegistry, set_repo_registry
 from backend.services.voice_service import VoiceService
+from backend.startup_profile import profile as startup_profile
 
 if TYPE_CHECKING:
     from collections.abc import AsyncGenerator
 
     from fastapi import FastAPI
-    from sqlalchemy.ext.asyncio import AsyncSession
+    from sqlalchemy.ext.asyncio import AsyncEngine, AsyncSession
 
     from backend.models.events import DomainEvent
     from backend.services.terminal_service import TerminalService
@@ -96,6 +117,7 @@ class _CoreServices:
     merge_service: MergeService
     sister_sessions: SisterSessionManager
     runtime_service: RuntimeService
+    step_diff_cache: StepDiffCache
 
 
 # ---------------------------------------------------------------------------
@@ -105,17 +127,31 @@ class _CoreServices:
 
 def _init_event_infrastructure(
     session_factory: async_sessionmaker[AsyncSession],
+    write_session_factory: async_sessionmaker[AsyncSession] | None = None,
+    *,
+    serialize_writes: bool = True,
+    event_socket: EventSocketServer | None = None,
 ) -> tuple[EventBus, SSEManager, asyncio.Task[None]]:
     """Create event bus and SSE manager with persist-then-broadcast wiring.
 
-    Returns the event bus, SSE manager, and a background task that retries
-    events from the dead-letter queue.
+    Events are appended through *write_session_factory* (the single-writer
+    engine) when given.  *serialize_writes* funnels appends through one
+    in-process lock, which SQLite needs and PostgreSQL does not.  Every
+    broadcast is also published on *event_socket* for the SSE front workers
+    in multi-worker mode.  Returns the event bus, SSE manager, and a
+    background task that retries events from the dead-letter queue.
     """
+    event_session_factory = write_session_factory or session_factory
     event_bus = EventBus()
     sse_manager = SSEManager()
-    persist_lock = asyncio.Lock()
+    persist_lock = asyncio.Lock() if serialize_writes else None
     dead_letter: asyncio.Queue[tuple[DomainEvent, int]] = asyncio.Queue()
 
+    async def _broadcast(event: DomainEvent) -> None:
+        await sse_manager.broadcast_domain_event(event)
+        if event_socket is not None:
+            await event_socket.broadcast_domain_event(event)
+
     # Persist-then-broadcast subscriber: ensures event.db_id is set
     # (monotonic autoincrement) before SSE frames are built.
     async def _persist_and_broadcast(event: DomainEvent) -> None:
@@ -123,16 +159,24 @@ def _init_event_infrastructure(
         # immediately without writing to DB (the complete agent message
         # that follows is the canonical persisted record).
         if event.kind == DomainEventKind.transcript_updated and event.payload.get("role") == "agent_delta":
-            await sse_manager.broadcast_domain_event(event)
+            await _broadcast(event)
+            return
+        # budget_updated is a live view of the in-memory cost ledger; the
+        # spend it reflects is already persisted via telemetry summaries.
+        # session_heartbeat is pure liveness and has nothing to replay.
+        if event.kind in (DomainEventKind.budget_updated, DomainEventKind.session_heartbeat):
+            await _broadcast(event)
             return
 
+        started = time.monotonic()
         try:
             await _persist_event_with_retry(
                 event=event,
-                session_factory=session_factory,
+                session_factory=event_session_factory,
                 write_lock=persist_lock,
             )
         except Exception:
+            tel.event_persist_duration.record((time.monotonic() - started) * 1000, {"outcome": "error"})
             log.error(
                 "event_persist_failed_queued_for_retry",
                 event_id=event.event_id,
@@ -143,9 +187,12 @@ def _init_event_infrastructure(
             # Broadcast anyway so the SSE stream doesn't silently drop the
             # event; the client will get it without a db_id which means the
             # replay cursor won't cover it, but it's better than silence.
-            await sse_manager.broadcast_domain_event(event)
+            await _broadcast(event)
             return
-        await sse_manager.broadcast_domain_event(event)
+        tel.event_persist_duration.record((time.monotonic() - started) * 1000, {"outcome": "ok"})
+        await _broadcast(event)
+
+    tel.observe("cp.events.dead_letter", lambda: [(dead_letter.qsize(), {})])
 
     async def _dead_letter_retry_loop() -> None:
         """Background task: retry persisting events that failed initially."""
@@ -160,7 +207,7 @@ def _init_event_infrastructure(
             try:
                 await _persist_event_with_retry(
                     event=event,
-                    session_factory=session_factory,
+                    session_factory=event_session_factory,
                     write_lock=persist_lock,
                 )
                 log.info(
@@ -192,7 +239,7 @@ def _init_event_infrastructure(
     # Step persistence subscriber — persists step_started/step_completed events
     step_repo = StepRepository(session_factory)
     step_persistence = StepPersistenceSubscriber(step_repo)
-    event_bus.subscribe(step_persistence)
+    event_bus.subscribe(step_persistence, kinds=StepPersistenceSubscriber.EVENT_KINDS)
 
     retry_task = asyncio.create_task(_dead_letter_retry_loop(), name="dead-letter-retry")
     return event_bus, sse_manager, retry_task
@@ -202,15 +249,60 @@ def _is_sqlite_lock_error(exc: OperationalError) -> bool:
     return "database is locked" in str(exc).lower()
 
 
+def _register_runtime_metrics(
+    engines: dict[str, AsyncEngine],
+    event_bus: EventBus,
+    sse_manager: SSEManager,
+    runtime_service: RuntimeService,
+    maintenance: SqliteMaintenance | None = None,
+) -> None:
+    """Point the observable runtime gauges at live service state (read on each scrape)."""
+
+    def _sse() -> tuple[int, int, int, float]:
+        return sse_manager.queue_stats()
+
+    def _log_discarded() -> list[tuple[float, dict[str, str]]]:
+        dropped, sampled = logging_config.discard_counts()
+        return [(dropped, {"reason": "dropped"}), (sampled, {"reason": "sampled"})]
+
+    def _pool() -> list[tuple[float, dict[str, str]]]:
+        labels = {"size": "size", "checkedout": "checked_out", "overflow": "overflow"}
+        points = []
+        for pool_name, engine in engines.items():
+            pool: Any = engine.sync_engine.pool
+            for name, state in labels.items():
+                fn = getattr(pool, name, None)
+                if callable(fn):
+                    points.append((fn(), {"pool": pool_name, "state": state}))
+        return points
+
+    tel.observe(
+        "cp.jobs.active",
+        lambda: [
+            (runtime_service.running_count, {"state": "running"}),
+            (runtime_service.pending_count, {"state": "pending"}),
+        ],
+    )
+    tel.observe("cp.events.in_flight", lambda: [(event_bus.in_flight, {})])
+    tel.observe("cp.sse.connections", lambda: [(_sse()[0], {"scope": "job"}), (_sse()[1], {"scope": "global"})])
+    tel.observe("cp.sse.queue.depth", lambda: [(_sse()[2], {})])
+    tel.observe("cp.sse.queue.max_fill", lambda: [(_sse()[3], {})])
+    tel.observe("cp.db.pool", _pool)
+    tel.observe("cp.log.queue.depth", lambda: [(logging_config.queue_depth(), {})])
+    tel.observe("cp.log.discarded", _log_discarded)
+    if maintenance is not None:
+        tel.observe("cp.db.wal.bytes", lambda: [(maintenance.wal_bytes, {})])
+
+
 async def _persist_event_with_retry(
     *,
     event: DomainEvent,
     session_factory: async_sessionmaker[AsyncSession],
-    write_lock: asyncio.Lock,
+    write_lock: asyncio.Lock | None,
     max_attempts: int = _EVENT_PERSIST_MAX_ATTEMPTS,
     retry_delay_s: float = _EVENT_PERSIST_RETRY_DELAY_S,
 ) -> None:
-    async with write_lock:
+    async with write_lock or contextlib.nullcontext():
         for attempt in range(max_attempts):
             async with session_factory() as session:
                 repo = EventRepository(session)
@@ -237,7 +329,10 @@ async def _wire_core_services(
     config: CPLConfig,
 ) -> _CoreServices:
     """Instantiate and wire together the core application services."""
-    approval_service = ApprovalService(session_factory=session_factory)
+    # Commands the operator keeps approving are answered without asking
+    approval_rules = ApprovalRules(session_factory, config.approval_rules)
+    await approval_rules.load()
+    approval_service = ApprovalService(session_factory=session_factory, rules=approval_rules)
     adapter_registry = AdapterRegistry(
         approval_service=approval_service,
         event_bus=event_bus,
@@ -245,6 +340,9 @@ async def _wire_core_services(
     )
     git_service = GitService(config)
     diff_service = DiffService(git_service=git_service, event_bus=event_bus)
+    # Prefetches each finished step's diff so opening it is a cache hit
+    step_diff_cache = StepDiffCache(git_service=git_service, session_factory=session_factory)
+    event_bus.subscribe(step_diff_cache, kinds=StepDiffCache.EVENT_KINDS)
     platform_registry = PlatformRegistry(platform_configs=config.platforms)
     merge_service = MergeService(
         git_service=git_service,
@@ -274,7 +372,12 @@ async def _wire_core_services(
         sister_sessions=sister_sessions,
         event_bus=event_bus,
     )
-    event_bus.subscribe(_ProgressSubscriber(progress_tracking))
+    event_bus.subscribe(_ProgressSubscriber(progress_tracking), kinds=_ProgressSubscriber.EVENT_KINDS)
+
+    get_file_access_tracker().raw_sample_rate = config.telemetry.file_access_raw_sample_rate
+    cost_ledger = CostLedger(config.telemetry)
+    async with session_factory() as session:
+        await cost_ledger.load(session)
 
     runtime_service = RuntimeService(
         session_factory=session_factory,
@@ -292,10 +395,13 @@ async def _wire_core_services(
             git_service=git_service,
         ),
         progress_tracking=progress_tracking,
+        columnar_store=ColumnarStore.from_config(config),
+        cost_ledger=cost_ledger,
+        shared_database=postgres_url(config.database) is not None,
     )
 
-    # Recover orphaned jobs from a previous crash
-    await runtime_service.recover_on_startup()
+    # Recover orphaned jobs from a previous crash — resumes in the background
+    await runtime_service.start_recovery()
 
     return _CoreServices(
         approval_service=approval_service,
@@ -304,6 +410,7 @@ async def _wire_core_services(
         merge_service=merge_service,
         sister_sessions=sister_sessions,
         runtime_service=runtime_service,
+        step_diff_cache=step_diff_cache,
     )
 
 
@@ -312,21 +419,78 @@ class _OptionalServices:
     """Bundle of optional services and background handles for shutdown."""
 
     terminal_service: TerminalService | None
+    retention_service: RetentionService
     retention_task: asyncio.Task[None]
-    mcp_cleanup: Any
+    columnar_export_task: asyncio.Task[None] | None
+    mcp_app: _DeferredASGIApp
     voice_service: VoiceService
     voice_max_bytes: int
+    repo_registry: RepoRegistry
     cached_models_by_sdk: dict[str, list[dict[str, object]]]
 
 
+class _DeferredASGIApp:
+    """Mount point for a sub-app that is built after the server starts listening.
+
+    Answers 503 with ``Retry-After`` until :attr:`app` is set.
+    """
+
+    def __init__(self, name: str) -> None:
+        self.name = name
+        self.app: Any = None
+
+    async def __call__(self, scope: Any, receive: Any, send: Any) -> None:
+        if self.app is not None:
+            await self.app(scope, receive, send)
+            return
+        if scope["type"] != "http":
+            return
+        body = f"{self.name} is starting".encode()
+        await send(
+            {
+                "type": "http.response.start",
+                "status": 503,
+                "headers": [(b"content-type", b"text/plain"), (b"retry-after", b"1")],
+            }
+        )
+        await send({"type": "http.response.body", "body": body})
+
+
+async def _fetch_copilot_models() -> list[dict[str, object]]:
+    """List Copilot models, retrying since auth tokens may not be ready immediately."""
+    for _attempt in range(3):
+        try:
+            from copilot import CopilotClient
+
+            _model_client = CopilotClient()
+            await _model_client.start()
+            try:
+                copilot_models = [m.to_dict() for m in await _model_client.list_models()]
+                log.debug("copilot_models_cached", count=len(copilot_models))
+                return copilot_models
+            finally:
+                await _model_client.stop()
+        except Exception as exc:
+            if _attempt < 2:
+                log.debug("copilot_model_cache_retry", attempt=_attempt + 1, error=str(exc))
+                await asyncio.sleep(2)
+            else:
+                log.warning("copilot_model_cache_failed", error=str(exc))
+    return []
+
+
 async def _init_optional_services(
     app: FastAPI,
     config: CPLConfig,
     session_factory: async_sessionmaker[AsyncSession],
     services: _CoreServices,
 ) -> _OptionalServices:
-    """Initialise terminal, voice, retention, model cache, and MCP services."""
-    from backend.api import terminal
+    """Initialise terminal, voice, retention, model cache, and MCP services.
+
+    Only the cheap parts run here.  The model fetch, whisper preload,
+    retention sweep and MCP server are left to :func:`_start_deferred_services`.
+    """
+    from backend.api import terminal, voice
 
     # --- Terminal service ---
     terminal_service = None
@@ -343,32 +507,11 @@ async def _init_optional_services(
         log.debug("terminal_service_enabled", max_sessions=config.terminal.max_sessions)
 
     # --- Model list cache ---
-    # Fetch once at startup so the job-creation form renders instantly.
-    # Models are keyed by SDK id so the frontend can fetch per-SDK.
+    # Models are keyed by SDK id so the frontend can fetch per-SDK.  Copilot
+    # models are filled in by the deferred startup task; until then the
+    # /models endpoint fetches them live.
     cached_models_by_sdk: dict[str, list[dict[str, object]]] = {}
 
-    # Copilot models — retry up to 3 times since auth tokens may not be ready immediately
-    copilot_models: list[dict[str, object]] = []
-    for _attempt in range(3):
-        try:
-            from copilot import CopilotClient
-
-            _model_client = CopilotClient()
-            await _model_client.start()
-            try:
-                copilot_models = [m.to_dict() for m in await _model_client.list_models()]
-                log.debug("copilot_models_cached", count=len(copilot_models))
-            finally:
-                await _model_client.stop()
-            break  # success
-        except Exception as exc:
-            if _attempt < 2:
-                log.debug("copilot_model_cache_retry", attempt=_attempt + 1, error=str(exc))
-                await asyncio.sleep(2)
-            else:
-                log.warning("copilot_model_cache_failed", error=str(exc))
-    cached_models_by_sdk["copilot"] = copilot_models
-
     # Claude Code models — loaded from data/claude_models.json
     _claude_models_path = Path(__file__).resolve().parent / "data" / "claude_models.json"
     try:
@@ -380,12 +523,15 @@ async def _init_optional_services(
         log.warning("claude_models_load_failed", error=str(exc))
         cached_models_by_sdk["claude"] = []
 
-    # --- Voice service ---
-    voice_service = VoiceService()
-    # Pre-load the whisper model at startup so the first request is fast
-    log.debug("voice_model_preloading", model="base.en")
-    await asyncio.to_thread(voice_service._ensure_model)  # noqa: SLF001
+    # --- Voice service --- the worker process is started by the deferred task
+    voice_service = VoiceService(config.voice)
     voice_max_bytes = VOICE_MAX_AUDIO_SIZE_MB * 1024 * 1024
+    voice.set_voice_service(voice_service, voice_max_bytes)
+
+    # --- Repo registry --- globs are expanded and watched in the background
+    repo_registry = RepoRegistry()
+    await repo_registry.start()
+    set_repo_registry(repo_registry)
 
     # --- Retention service ---
     retention_service = RetentionService(
@@ -393,42 +539,129 @@ async def _init_optional_services(
         config=config,
     )
 
-    if config.retention.cleanup_on_startup:
-        await retention_service.run_cleanup()
-
     # Start daily retention background task
     retention_task = asyncio.create_task(
         retention_service.daily_loop(),
         name="retention-daily",
     )
 
-    # --- MCP server ---
-    from backend.mcp.server import create_mcp_server
+    # --- Columnar telemetry export (optional) ---
+    columnar_export_task = None
+    columnar_store = services.runtime_service.columnar_store
+    if columnar_store is not None:
+        columnar_export_task = asyncio.create_task(
+            columnar_store.export_loop(session_factory, config.telemetry.columnar_export_interval_s),
+            name="columnar-export",
+        )
+        log.debug("columnar_export_enabled", dir=str(columnar_store.root))
 
-    mcp_server = create_mcp_server(
-        session_factory=session_factory,
-        runtime_service=services.runtime_service,
-        approval_service=services.approval_service,
-        sister_sessions=services.sister_sessions,
-    )
-    mcp_app = mcp_server.streamable_http_app()
+    # --- MCP server --- mounted now, built once the listener is up
+    mcp_app = _DeferredASGIApp("MCP server")
     app.mount(MCP_PATH, mcp_app)
-    # Manually start the session manager's task group (sub-app lifespan
-    # doesn't fire when mounted during the parent's lifespan).
-    mcp_ctx = mcp_server.session_manager.run()
-    await mcp_ctx.__aenter__()
-    log.debug("mcp_server_mounted", path=MCP_PATH)
 
     return _OptionalServices(
         terminal_service=terminal_service,
+        retention_service=retention_service,
         retention_task=retention_task,
-        mcp_cleanup=mcp_ctx,
+        columnar_export_task=columnar_export_task,
+        mcp_app=mcp_app,
         voice_service=voice_service,
         voice_max_bytes=voice_max_bytes,
+        repo_registry=repo_registry,
         cached_models_by_sdk=cached_models_by_sdk,
     )
 
 
+async def _serve_mcp(
+    session_factory: async_sessionmaker[AsyncSession],
+    services: _CoreServices,
+    sse_manager: SSEManager,
+    mount: _DeferredASGIApp,
+    ready: asyncio.Event,
+) -> None:
+    """Build the MCP server, hand it to *mount* and run its session manager until cancelled."""
+    try:
+        started = startup_profile.now()
+        # FastMCP pulls in pydantic-settings, starlette and httpx — import off the loop
+        mcp_module = await asyncio.to_thread(importlib.import_module, "backend.mcp.server")
+        mcp_server = mcp_module.create_mcp_server(
+            session_factory=session_factory,
+            runtime_service=services.runtime_service,
+            approval_service=services.approval_service,
+            sister_sessions=services.sister_sessions,
+            sse_manager=sse_manager,
+        )
+        mcp_app = mcp_server.streamable_http_app()
+        # Manually start the session manager's task group (sub-app lifespan
+        # doesn't fire when mounted during the parent's lifespan).  Its
+        # cancel scope must be exited by the task that entered it, so this
+        # task owns it until shutdown.
+        async with mcp_server.session_manager.run():
+            mount.app = mcp_app
+            startup_profile.phase_since("deferred:mcp_server", started)
+            log.debug("mcp_server_mounted", path=MCP_PATH)
+            ready.set()
+            await asyncio.Event().wait()
+    except Exception as exc:
+        log.warning("deferred_startup_failed", service="mcp_server", error=str(exc), exc_info=True)
+    finally:
+        ready.set()
+
+
+async def _start_deferred_services(
+    config: CPLConfig,
+    session_factory: async_sessionmaker[AsyncSession],
+    services: _CoreServices,
+    sse_manager: SSEManager,
+    optional: _OptionalServices,
+) -> None:
+    """Bring up services no request needs to be served, after startup completes.
+
+    Each step is independent: a failure is logged and the rest still run.
+    Runs for the life of the server because it owns the MCP session manager.
+    """
+    started = startup_profile.now()
+
+    async def _models() -> None:
+        phase = startup_profile.now()
+        optional.cached_models_by_sdk["copilot"] = await _fetch_copilot_models()
+        startup_profile.phase_since("deferred:copilot_models", phase)
+
+    async def _voice() -> None:
+        # Start the resident worker and warm the model so the first transcription is fast
+        if config.voice.preload:
+            phase = startup_profile.now()
+            log.debug("voice_model_preloading", model=config.voice.model)
+            await optional.voice_service.start()
+            startup_profile.phase_since("deferred:voice_model", phase)
+
+    async def _retention() -> None:
+        if config.retention.cleanup_on_startup:
+            phase = startup_profile.now()
+            await optional.retention_service.run_cleanup()
+            startup_profile.phase_since("deferred:retention_cleanup", phase)
+
+    mcp_ready = asyncio.Event()
+    mcp_task = asyncio.create_task(
+        _serve_mcp(session_factory, services, sse_manager, optional.mcp_app, mcp_ready),
+        name="mcp-server",
+    )
+    try:
+        names = ("copilot_models", "voice_model", "retention_cleanup")
+        results = await asyncio.gather(_models(), _voice(), _retention(), return_exceptions=True)
+        for name, result in zip(names, results, strict=True):
+            if isinstance(result, Exception):
+                log.warning("deferred_startup_failed", service=name, error=str(result), exc_info=result)
+        await mcp_ready.wait()
+        startup_profile.phase_since("deferred", started)
+        startup_profile.report_deferred()
+        await mcp_task
+    finally:
+        mcp_task.cancel()
+        with contextlib.suppress(asyncio.CancelledError):
+            await mcp_task
+
+
 # ---------------------------------------------------------------------------
 # Lifespan context manager
 # ---------------------------------------------------------------------------
@@ -437,27 +670,84 @@ async def _init_optional_services(
 @asynccontextmanager
 async def lifespan(app: FastAPI) -> AsyncGenerator[None, None]:
     """Manage engine lifecycle — create on startup, dispose on shutdown."""
-    engine = create_engine()
+    config = load_config()
+    engines_started = startup_profile.now()
+    # General read/write pool, a single-connection writer for the event log,
+    # and a query_only pool for analytics reads.  PostgreSQL handles concurrent
+    # writers itself, so it gets no writer engine, write lock or SQLite upkeep.
+    pg_url = postgres_url(config.database)
+    engine = create_engine(config=config.database)
+    writer_engine = engine if pg_url else create_writer_engine(config=config.database)
+    read_engine = create_read_engine(config=config.database)
     session_factory = create_session_factory(engine)
+    read_session_factory = create_session_factory(read_engine)
+    maintenance: SqliteMaintenance | None = None
+    background: list[asyncio.Task[None]] = []
+    if not pg_url:
+        maintenance = SqliteMaintenance(engine, DEFAULT_DB_PATH, config.database)
+        background.append(asyncio.create_task(maintenance.loop(), name="sqlite-maintenance"))
+    file_access_flush_task = asyncio.create_task(
+        get_file_access_tracker().flush_loop(session_factory),
+        name="file-access-flush",
+    )
 
-    event_bus, sse_manager, dead_letter_task = _init_event_infrastructure(session_factory)
+    # Multi-worker mode: SSE clients are served by front worker processes,
+    # which receive events over a Unix socket (see ``cpl up --workers``).
+    startup_profile.phase_since("lifespan:engines", engines_started)
+    event_socket: EventSocketServer | None = None
+    event_socket_path = getattr(app.state, "event_socket_path", None)
+    if event_socket_path is not None:
+        event_socket = EventSocketServer(event_socket_path)
+        await event_socket.start()
+
+    with startup_profile.phase("lifespan:event_infrastructure"):
+        event_bus, sse_manager, dead_letter_task = _init_event_infrastructure(
+            session_factory,
+            create_session_factory(writer_engine),
+            serialize_writes=not pg_url,
+            event_socket=event_socket,
+        )
+    relay: PgEventRelay | None = None
+    if pg_url:
+        relay = PgEventRelay(pg_url, session_factory, event_socket or sse_manager)
+        background.append(asyncio.create_task(relay.run(), name="pg-event-relay"))
+    engines = {"main": engine, "read": read_engine}
+    if writer_engine is not engine:
+        engines["write"] = writer_engine
 
     # Wire the console dashboard (present only when stderr is an interactive TTY)
     # to the event bus so job state and progress updates appear in the live panel.
     dashboard = getattr(app.state, "dashboard", None)
     if dashboard is not None:
-        event_bus.subscribe(dashboard.handle_event)
-
-    config = load_config()
-    services = await _wire_core_services(session_factory, event_bus, config)
-
-    optional = await _init_optional_services(
-        app,
-        config,
-        session_factory,
-        services,
+        event_bus.subscribe(dashboard.handle_event, kinds=dashboard.EVENT_KINDS)
+
+    with startup_profile.phase("lifespan:core_services"):
+        services = await _wire_core_services(session_factory, event_bus, config)
+    if relay is not None:
+        # Other processes may drive some jobs: forward requests for those, and
+        # serve theirs.  Leases on this process's own jobs are kept alive.
+        control = ControlChannel(session_factory)
+        services.runtime_service.forward_control = control.send
+        services.approval_service.forward_control = control.send
+        for op in ("cancel", "message", "trust", "approval_resolved", "rules_changed"):
+            relay.on_control(op, services.runtime_service.handle_control)
+        background.append(asyncio.create_task(services.runtime_service.lease_loop(), name="job-leases"))
+    _register_runtime_metrics(
+        engines,
+        event_bus,
+        sse_manager,
+        services.runtime_service,
+        maintenance,
     )
 
+    with startup_profile.phase("lifespan:optional_services"):
+        optional = await _init_optional_services(
+            app,
+            config,
+            session_factory,
+            services,
+        )
+
     # Build the dishka DI container with all services as context values
     container = make_async_container(
         AppProvider(),
@@ -465,6 +755,7 @@ async def lifespan(app: FastAPI) -> AsyncGenerator[None, None]:
         context={
             CPLConfig: config,
             async_sessionmaker: session_factory,
+            ReadSessionFactory: ReadSessionFactory(read_session_factory),
             EventBus: event_bus,
             SSEManager: sse_manager,
             ApprovalService: services.approval_service,
@@ -475,6 +766,7 @@ async def lifespan(app: FastAPI) -> AsyncGenerator[None, None]:
             VoiceService: optional.voice_service,
             CachedModelsBySdk: CachedModelsBySdk(optional.cached_models_by_sdk),
             VoiceMaxBytes: VoiceMaxBytes(optional.voice_max_bytes),
+            StepDiffCache: services.step_diff_cache,
         },
     )
     app.state.dishka_container = container
@@ -498,6 +790,13 @@ async def lifespan(app: FastAPI) -> AsyncGenerator[None, None]:
             )
         dashboard.start()
 
+    # Everything below the HTTP surface is up; the rest warms in the background.
+    startup_profile.ready()
+    deferred_task = asyncio.create_task(
+        _start_deferred_services(config, session_factory, services, sse_manager, optional),
+        name="deferred-startup",
+    )
+
     yield
 
     # Shutdown in reverse initialisation order.
@@ -505,12 +804,34 @@ async def lifespan(app: FastAPI) -> AsyncGenerator[None, None]:
     if dashboard is not None:
         dashboard.stop()
     await container.close()
-    await optional.mcp_cleanup.__aexit__(None, None, None)
+    deferred_task.cancel()
+    with contextlib.suppress(asyncio.CancelledError):
+        await deferred_task
     optional.retention_task.cancel()
+    if optional.columnar_export_task is not None:
+        optional.columnar_export_task.cancel()
     dead_letter_task.cancel()
     if optional.terminal_service is not None:
         await optional.terminal_service.shutdown()
+    await optional.voice_service.close()
+    set_repo_registry(None)
+    await optional.repo_registry.close()
     await services.sister_sessions.shutdown()
     await services.runtime_service.shutdown()
+    file_access_flush_task.cancel()
+    with contextlib.suppress(asyncio.CancelledError):
+        await file_access_flush_task
+    await get_file_access_tracker().flush(session_factory)
+    await services.step_diff_cache.close()
     await sse_manager.close_all()
-    await engine.dispose()
+    if event_socket is not None:
+        await event_socket.close()
+    for task in background:
+        task.cancel()
+    if maintenance is not None:
+        try:
+            await maintenance.optimize()
+        except Exception:
+            log.debug("sqlite_optimize_on_shutdown_failed", exc_info=True)
+    for pool in engines.values():
+        await pool.dispose()
@@ -3,6 +3,12 @@
 Configures structlog + stdlib logging with rotating file handler and
 console handler with noise filtering.
 
+The file handler sits behind a bounded queue: the calling thread (usually
+the event loop) only enqueues the record, and a listener thread formats it
+and writes it, including rotation.  A full queue drops the record instead of
+blocking, and DEBUG records from chatty loggers can be sampled before they
+are queued.  Both are counted (``discard_counts``) and exported as metrics.
+
 When a ``ConsoleLog`` is supplied to ``setup_logging`` the plain stderr
 handler is replaced with a ``ConsoleLogHandler`` that suppresses
 everything below ERROR on the console (all levels still reach the log
@@ -11,14 +17,22 @@ file) and prints errors as structured lines.
 
 from __future__ import annotations
 
+import atexit
+import functools
+import json
 import logging
 import logging.handlers
+import queue
+from dataclasses import dataclass
+from datetime import UTC, datetime
 from pathlib import Path
-from typing import TYPE_CHECKING
+from typing import TYPE_CHECKING, Any
 
 import structlog
 
 if TYPE_CHECKING:
+    from structlog.typing import EventDict
+
     from backend.console_dashboard import ConsoleLog
 
 _LOG_LEVEL_MAP: dict[str, int] = {
@@ -58,19 +72,120 @@ class _ConsoleNoiseFilter(logging.Filter):
         return not any(record.name.startswith(prefix) for prefix in _CONSOLE_NOISE_PREFIXES)
 
 
+@dataclass
+class _DiscardCounts:
+    dropped: int = 0  # queue full
+    sampled: int = 0  # removed by DEBUG sampling
+
+
+_counts = _DiscardCounts()
+_listener: logging.handlers.QueueListener | None = None
+_queue: queue.Queue[logging.LogRecord] | None = None
+
+
+class _BoundedQueueHandler(logging.handlers.QueueHandler):
+    """Non-blocking ``QueueHandler``: a full queue drops the record and counts it."""
+
+    def prepare(self, record: logging.LogRecord) -> logging.LogRecord:
+        # The listener thread owns formatting.  structlog records carry their
+        # event dict in ``msg``, which the stdlib prepare() would stringify.
+        return record
+
+    def enqueue(self, record: logging.LogRecord) -> None:
+        try:
+            self.queue.put_nowait(record)
+        except queue.Full:
+            _counts.dropped += 1
+
+
+class _DebugSampler(logging.Filter):
+    """Keep one in N DEBUG records per logger, from ``{logger_prefix: rate}``.
+
+    The longest matching prefix wins.  A rate of 0.01 keeps every 100th
+    record, 0 drops them all, and 1 keeps them all.  Other levels always pass.
+    """
+
+    def __init__(self, rates: dict[str, float]) -> None:
+        super().__init__()
+        self._rules = sorted(rates.items(), key=lambda item: len(item[0]), reverse=True)
+        self._every: dict[str, int] = {}
+        self._seen: dict[str, int] = {}
+
+    def _interval(self, name: str) -> int:
+        for prefix, rate in self._rules:
+            if name == prefix or name.startswith(prefix + "."):
+                return max(1, round(1 / rate)) if rate > 0 else 0
+        return 1
+
+    def filter(self, record: logging.LogRecord) -> bool:
+        if record.levelno != logging.DEBUG or not self._rules:
+            return True
+        every = self._every.get(record.name)
+        if every is None:
+            every = self._every[record.name] = self._interval(record.name)
+        if every == 1:
+            return True
+        if every:
+            seen = self._seen.get(record.name, 0)
+            self._seen[record.name] = seen + 1
+            if seen % every == 0:
+                return True
+        _counts.sampled += 1
+        return False
+
+
+def _record_timestamp(_logger: Any, _name: str, event_dict: EventDict) -> EventDict:
+    record = event_dict.get("_record")
+    if record is not None:
+        created = datetime.fromtimestamp(record.created, tz=UTC)
+        event_dict["timestamp"] = created.isoformat().replace("+00:00", "Z")
+    return event_dict
+
+
+def discard_counts() -> tuple[int, int]:
+    """``(dropped, sampled)`` file-log records since startup."""
+    return _counts.dropped, _counts.sampled
+
+
+def queue_depth() -> int:
+    """Records waiting for the file-writer thread."""
+    return _queue.qsize() if _queue is not None else 0
+
+
+def _stop_listener() -> None:
+    """Flush queued records and stop the writer thread (idempotent)."""
+    global _listener  # noqa: PLW0603
+    if _listener is not None:
+        _listener.stop()
+        for handler in _listener.handlers:
+            handler.close()
+        _listener = None
+
+
+atexit.register(_stop_listener)
+
+
 def setup_logging(
     log_file: str,
     console_level: str = "info",
     max_file_size_mb: int = 50,
     backup_count: int = 3,
     dashboard: ConsoleLog | None = None,
+    *,
+    log_format: str = "kv",
+    queue_size: int = 10_000,
+    debug_sample: dict[str, float] | None = None,
 ) -> None:
     """Configure structlog + stdlib logging.
 
     Strategy
     --------
     * **File handler** — always at DEBUG verbosity so every log line is
-      persisted.  Uses a rotating handler (``max_file_size_mb`` × ``backup_count``).
+      persisted.  Uses a rotating handler (``max_file_size_mb`` × ``backup_count``)
+      driven by a listener thread behind a ``queue_size``-record queue.
+      ``log_format`` is ``kv`` (sorted key=value) or ``json`` (one ASCII
+      JSON object per line, cheaper to render).  ``debug_sample`` maps
+      logger prefixes to the fraction of their DEBUG records kept.
     * **Console handler** — two modes:
 
       - *Plain mode* (``dashboard=None``): respects ``console_level`` from
@@ -86,20 +201,41 @@ def setup_logging(
     log_path = Path(log_file).expanduser().resolve()
     log_path.parent.mkdir(parents=True, exist_ok=True)
 
+    # format_exc_info renders tracebacks where the exception is still live:
+    # on the calling thread, before the record is queued.
     shared_processors: list[structlog.typing.Processor] = [
         structlog.stdlib.add_log_level,
         structlog.stdlib.add_logger_name,
         structlog.processors.TimeStamper(fmt="iso"),
+        structlog.processors.format_exc_info,
     ]
 
+    # stdlib records are pre-chained on the listener thread; stamp them with
+    # their creation time rather than the time they were written.
+    foreign_processors: list[structlog.typing.Processor] = [
+        structlog.stdlib.add_log_level,
+        structlog.stdlib.add_logger_name,
+        _record_timestamp,
+        structlog.processors.format_exc_info,
+    ]
+
+    file_renderer: structlog.typing.Processor
+    if log_format == "json":
+        # ASCII-only with repr() for bytes and other non-JSON values, so
+        # every record stays on one line whatever it carries.
+        file_renderer = structlog.processors.JSONRenderer(
+            serializer=functools.partial(json.dumps, default=repr, separators=(",", ":"))
+        )
+    else:
+        file_renderer = structlog.processors.KeyValueRenderer(
+            key_order=["timestamp", "level", "logger", "event"],
+            sort_keys=True,
+        )
     file_formatter = structlog.stdlib.ProcessorFormatter(
-        foreign_pre_chain=shared_processors,
+        foreign_pre_chain=foreign_processors,
         processors=[
             structlog.stdlib.ProcessorFormatter.remove_processors_meta,
-            structlog.processors.KeyValueRenderer(
-                key_order=["timestamp", "level", "logger", "event"],
-                sort_keys=True,
-            ),
+            file_renderer,
         ],
     )
     console_formatter = structlog.stdlib.ProcessorFormatter(
@@ -110,7 +246,8 @@ def setup_logging(
         ],
     )
 
-    # File handler: DEBUG, rotating per config
+    # File handler: DEBUG, rotating per config, written by the listener thread
+    _stop_listener()
     file_handler = logging.handlers.RotatingFileHandler(
         log_path,
         maxBytes=max_file_size_mb * 1024 * 1024,
@@ -120,6 +257,15 @@ def setup_logging(
     file_handler.setLevel(logging.DEBUG)
     file_handler.setFormatter(file_formatter)
 
+    global _listener, _queue  # noqa: PLW0603
+    _queue = queue.Queue(maxsize=queue_size)
+    queue_handler = _BoundedQueueHandler(_queue)
+    queue_handler.setLevel(logging.DEBUG)
+    if debug_sample:
+        queue_handler.addFilter(_DebugSampler(debug_sample))
+    _listener = logging.handlers.QueueListener(_queue, file_handler, respect_handler_level=True)
+    _listener.start()
+
     # Console handler: structured console log or plain stderr
     if dashboard is not None:
         from backend.console_dashboard import ConsoleLogHandler
@@ -140,7 +286,7 @@ def setup_logging(
     root_logger = logging.getLogger()
     root_logger.setLevel(logging.DEBUG)  # let handlers decide what to suppress
     root_logger.handlers.clear()
-    root_logger.addHandler(file_handler)
+    root_logger.addHandler(queue_handler)
     root_logger.addHandler(console_handler)
 
     # Suppress chatty third-party loggers from polluting the debug file
@@ -8,18 +8,39 @@ to focused modules:
 * ``lifespan`` — startup/shutdown, service wiring, background tasks
 * ``logging_config`` — structlog + stdlib logging setup
 * ``cli`` — Click commands (up, setup, doctor, version) and tunnel management
+
+``app`` and ``create_app`` are resolved on first access so that ``cpl``
+commands do not pay for importing and building the FastAPI application.
 """
 
 from __future__ import annotations
 
-from backend.app_factory import create_app
+from typing import TYPE_CHECKING, Any
+
 from backend.cli import cli
 from backend.logging_config import _ConsoleNoiseFilter, setup_logging
 
-# Default app instance for ``uvicorn backend.main:app``
-app = create_app()
+if TYPE_CHECKING:
+    from fastapi import FastAPI
+
+    from backend.app_factory import create_app
+
+    app: FastAPI
 
 __all__ = ["_ConsoleNoiseFilter", "app", "cli", "create_app", "setup_logging"]
 
+
+def __getattr__(name: str) -> Any:
+    # Default app instance for ``uvicorn backend.main:app``
+    if name in ("app", "create_app"):
+        from backend.app_factory import create_app
+
+        globals()["create_app"] = create_app
+        if name == "app":
+            globals()["app"] = create_app()
+        return globals()[name]
+    raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
+
+
 if __name__ == "__main__":
     cli()
@@ -5,14 +5,22 @@ layer, and return the result — same principle as the REST route handlers.
 
 Tools use an ``action`` parameter to multiplex related operations under a
 single tool name, keeping the total tool count low for LLM clients.
+
+Orchestrating agents drive many jobs at once, so ``codeplane_job`` takes
+lists (``jobs`` for create, ``job_ids`` for get/cancel) and has an
+``events`` long-poll, and ``codeplane_workspace`` reads several files per
+call.  Batched items run concurrently, each in its own session.
 """
 
 from __future__ import annotations
 
+import asyncio
 import contextlib
+import json
+import threading
 import time
 from pathlib import Path
-from typing import TYPE_CHECKING, Any, Literal, TypeAlias
+from typing import TYPE_CHECKING, Any, Literal, NotRequired, TypeAlias
 
 import structlog
 from mcp.server.fastmcp import FastMCP
@@ -33,6 +41,7 @@ from backend.models.api_schemas import (
     HealthStatus,
     JobListResponse,
     JobResponse,
+    JobSummaryResponse,
     RegisterRepoResponse,
     RepoDetailResponse,
     RepoListResponse,
@@ -43,6 +52,7 @@ from backend.models.api_schemas import (
     WorkspaceListResponse,
 )
 from backend.persistence.artifact_repo import ArtifactRepository
+from backend.persistence.event_repo import EventRepository
 from backend.persistence.job_repo import JobRepository
 from backend.services.agent_adapter import SDKModelMismatchError
 from backend.services.artifact_service import ArtifactService
@@ -54,6 +64,7 @@ from backend.services.job_service import (
     StateConflictError,
 )
 from backend.services.platform_adapter import detect_platform as _detect_platform
+from backend.services.sse_manager import MAX_REPLAY_EVENTS, parse_sse_frame
 
 if TYPE_CHECKING:
     from sqlalchemy.ext.asyncio import AsyncSession, async_sessionmaker
@@ -63,6 +74,7 @@ if TYPE_CHECKING:
     from backend.services.approval_service import ApprovalService
     from backend.services.runtime_service import RuntimeService
     from backend.services.sister_session import SisterSessionManager
+    from backend.services.sse_manager import SSEManager
 
 log = structlog.get_logger()
 
@@ -70,6 +82,16 @@ log = structlog.get_logger()
 # This module is imported during app startup so the value is accurate.
 _start_time = time.monotonic()
 
+# Batch limits: items per call, items in flight at once, and the total bytes
+# a multi-file workspace read may return.
+_MAX_BATCH = 50
+_BATCH_CONCURRENCY = 8
+_MAX_READ_FILES = 100
+_MAX_FILE_BYTES = 5 * 1024 * 1024
+_MAX_READ_BYTES = 20 * 1024 * 1024
+# Longest an ``events`` call may block waiting for something to happen.
+_MAX_EVENT_WAIT_S = 60.0
+
 
 # ---------------------------------------------------------------------------
 # MCP tool return-type helpers
@@ -82,6 +104,20 @@ class McpErrorDict(TypedDict):
     error: str
 
 
+class McpJobSpec(TypedDict):
+    """One job in a batch ``create``."""
+
+    repo: str
+    prompt: str
+    base_ref: NotRequired[str]
+    branch: NotRequired[str]
+    model: NotRequired[str]
+    sdk: NotRequired[str]
+
+
+_JOB_SPEC_KEYS = frozenset(McpJobSpec.__annotations__)
+
+
 # MCP tool handlers return JSON-serializable dicts produced by Pydantic's
 # ``model_dump(mode="json")``.  The broad ``dict[str, Any]`` component
 # reflects Pydantic's own return signature; ``McpErrorDict`` captures the
@@ -96,6 +132,7 @@ _session_factory: async_sessionmaker[AsyncSession] | None = None
 _runtime_service: RuntimeService | None = None
 _approval_service: ApprovalService | None = None
 _sister_sessions: SisterSessionManager | None = None
+_sse_manager: SSEManager | None = None
 
 
 def _get_session_factory() -> async_sessionmaker[AsyncSession]:
@@ -167,19 +204,165 @@ def _job_to_response(job: Job) -> McpToolResult:
     return resp.model_dump(mode="json")
 
 
+async def _run_batch(items: list[Any], handler: Any) -> McpToolResult:
+    """Run *handler* over *items* with bounded concurrency; per-item errors stay per item."""
+    if not items:
+        return {"error": "batch is empty"}
+    if len(items) > _MAX_BATCH:
+        return {"error": f"At most {_MAX_BATCH} items per batch"}
+    slots = asyncio.Semaphore(_BATCH_CONCURRENCY)
+
+    async def _one(item: Any) -> McpToolResult:
+        async with slots:
+            try:
+                result: McpToolResult = await handler(item)
+            except Exception as exc:
+                # One bad item must not discard the results of its siblings
+                log.warning("mcp_batch_item_failed", exc_info=True)
+                return {"error": str(exc) or type(exc).__name__}
+            return result
+
+    return {"results": list(await asyncio.gather(*(_one(item) for item in items)))}
+
+
+async def _create_job(
+    config: CPLConfig,
+    *,
+    repo: str | None = None,
+    prompt: str | None = None,
+    base_ref: str | None = None,
+    branch: str | None = None,
+    model: str | None = None,
+    sdk: str | None = None,
+) -> McpToolResult:
+    if not repo or not prompt:
+        return {"error": "repo and prompt are required for create"}
+    async with _get_session_factory()() as session:
+        svc = _make_job_service(session, config)
+        try:
+            job = await svc.create_job(
+                repo=repo,
+                prompt=prompt,
+                base_ref=base_ref,
+                branch=branch,
+                model=model,
+                sdk=sdk,
+            )
+        except RepoNotAllowedError as exc:
+            return {"error": str(exc)}
+        except SDKModelMismatchError as exc:
+            return {"error": str(exc)}
+        await session.commit()
+        runtime = _get_runtime()
+        await runtime.start_or_enqueue(job)
+        job = await svc.get_job(job.id)
+    return CreateJobResponse(
+        id=job.id,
+        state=job.state,
+        branch=job.branch,
+        worktree_path=job.worktree_path,
+        sdk=job.sdk,
+        created_at=job.created_at,
+    ).model_dump(mode="json")
+
+
+async def _create_job_from_spec(config: CPLConfig, spec: Any) -> McpToolResult:
+    """Validate one batch ``create`` item before spreading it into :func:`_create_job`."""
+    if not isinstance(spec, dict):
+        return {"error": "each job must be an object"}
+    unknown = sorted(str(key) for key in spec if key not in _JOB_SPEC_KEYS)
+    if unknown:
+        return {"error": f"unknown job fields: {', '.join(unknown)}"}
+    if any(value is not None and not isinstance(value, str) for value in spec.values()):
+        return {"error": "job fields must be strings"}
+    return await _create_job(config, **spec)
+
+
+async def _get_job(config: CPLConfig, job_id: str) -> McpToolResult:
+    async with _get_session_factory()() as session:
+        svc = _make_job_service(session, config)
+        try:
+            job = await svc.get_job(job_id)
+        except JobNotFoundError as exc:
+            return {"error": str(exc), "job_id": job_id}
+    return _job_to_response(job)
+
+
+async def _cancel_job(config: CPLConfig, job_id: str) -> McpToolResult:
+    async with _get_session_factory()() as session:
+        svc = _make_job_service(session, config)
+        try:
+            job = await svc.cancel_job(job_id)
+        except (JobNotFoundError, StateConflictError) as exc:
+            return {"error": str(exc), "job_id": job_id}
+    runtime = _get_runtime()
+    await runtime.cancel(job_id)
+    return _job_to_response(job)
+
+
+async def _job_events(job_id: str | None, cursor: str | None, wait_s: float, limit: int) -> McpToolResult:
+    """Events after *cursor* (an SSE event id), long-polling up to *wait_s* for the first one.
+
+    Without a cursor the call starts from the latest event, so the first
+    call only establishes a position.  A ``snapshot`` entry comes first when
+    the gap is too large or too old to replay, as on an SSE reconnect.
+    """
+    if _sse_manager is None:
+        return {"error": "Event streaming is not available"}
+    sf = _get_session_factory()
+    if cursor:
+        try:
+            after = int(cursor)
+        except ValueError:
+            return {"error": f"Invalid cursor: {cursor}"}
+    else:
+        async with sf() as session:
+            after = await EventRepository(session).latest_id(job_id)
+    frames = await _sse_manager.collect_since(sf, after, job_id=job_id, wait_s=min(max(wait_s, 0.0), _MAX_EVENT_WAIT_S))
+
+    clamped_limit = min(max(limit, 1), MAX_REPLAY_EVENTS)
+    events: list[dict[str, Any]] = []
+    seen: set[int] = set()
+    next_cursor = after
+    has_more = False
+    for frame in frames:
+        parsed = parse_sse_frame(frame)
+        if parsed is None:
+            continue
+        sse_id, event_type, data = parsed
+        if sse_id is None and event_type != "snapshot":
+            continue
+        numeric_id = int(sse_id) if sse_id is not None and sse_id.isdigit() else None
+        if numeric_id is not None and numeric_id not in seen:
+            # A derived state frame shares its source event's id; keep the pair together
+            if len(seen) >= clamped_limit:
+                has_more = True
+                break
+            seen.add(numeric_id)
+            next_cursor = max(next_cursor, numeric_id)
+        events.append({"id": sse_id, "event": event_type, "data": json.loads(data)})
+    if not seen and any(e["event"] == "snapshot" for e in events):
+        # Everything missed was summarised by the snapshot; continue from the head
+        async with sf() as session:
+            next_cursor = await EventRepository(session).latest_id(job_id)
+    return {"events": events, "cursor": str(next_cursor), "has_more": has_more}
+
+
 def create_mcp_server(
     *,
     session_factory: async_sessionmaker[AsyncSession],
     runtime_service: RuntimeService,
     approval_service: ApprovalService,
     sister_sessions: SisterSessionManager | None = None,
+    sse_manager: SSEManager | None = None,
 ) -> FastMCP:
     """Create and configure the MCP server with all CodePlane tools."""
-    global _session_factory, _runtime_service, _approval_service, _sister_sessions  # noqa: PLW0603
+    global _session_factory, _runtime_service, _approval_service, _sister_sessions, _sse_manager  # noqa: PLW0603
     _session_factory = session_factory
     _runtime_service = runtime_service
     _approval_service = approval_service
     _sister_sessions = sister_sessions
+    _sse_manager = sse_manager
 
     mcp = FastMCP(
         "CodePlane",
@@ -210,19 +393,26 @@ def _register_job_tool(mcp: FastMCP) -> None:
         title="Manage Coding Jobs",
         annotations=ToolAnnotations(title="Manage Coding Jobs", destructiveHint=True, openWorldHint=True),
         description=(
-            "Manage coding jobs. Actions: create, list, get, cancel, rerun, message."
+            "Manage coding jobs. Actions: create, list, get, cancel, rerun, message, events."
             "\n\n"
             "- create: repo (required), prompt (required), base_ref, branch"
+            " — or jobs: [{repo, prompt, base_ref, branch, model, sdk}, ...] to create many"
             "\n- list: state (filter), limit (default 50), cursor"
-            "\n- get: job_id (required)"
-            "\n- cancel: job_id (required)"
+            "\n- get: job_id (required) — or job_ids: [...] to inspect many"
+            "\n- cancel: job_id (required) — or job_ids: [...] to cancel many"
             "\n- rerun: job_id (required)"
             "\n- message: job_id (required), content (required, max 10000 chars)"
+            "\n- events: job_id (optional scope), cursor (from the previous call; omit to start now),"
+            " wait_s (block up to this many seconds, max 60, for the first new event), limit (default 50)"
+            "\n\n"
+            "Batches run concurrently (max 50 items) and return {results: [...]} in input order."
         ),
     )
     async def codeplane_job(
-        action: Literal["create", "list", "get", "cancel", "rerun", "message"],
+        action: Literal["create", "list", "get", "cancel", "rerun", "message", "events"],
         job_id: str | None = None,
+        job_ids: list[str] | None = None,
+        jobs: list[McpJobSpec] | None = None,
         repo: str | None = None,
         prompt: str | None = None,
         content: str | None = None,
@@ -233,94 +423,45 @@ def _register_job_tool(mcp: FastMCP) -> None:
         state: str | None = None,
         limit: int = 50,
         cursor: str | None = None,
+        wait_s: float = 0.0,
     ) -> McpToolResult:
         sf = _get_session_factory()
         config = load_config()
 
         if action == "create":
-            if not repo or not prompt:
-                return {"error": "repo and prompt are required for create"}
-            async with sf() as session:
-                svc = _make_job_service(session, config)
-                try:
-                    job = await svc.create_job(
-                        repo=repo,
-                        prompt=prompt,
-                        base_ref=base_ref,
-                        branch=branch,
-                        model=model,
-                        sdk=sdk,
-                    )
-                except RepoNotAllowedError as exc:
-                    return {"error": str(exc)}
-                except SDKModelMismatchError as exc:
-                    return {"error": str(exc)}
-                await session.commit()
-                runtime = _get_runtime()
-                await runtime.start_or_enqueue(job)
-                job = await svc.get_job(job.id)
-            return CreateJobResponse(
-                id=job.id,
-                state=job.state,
-                branch=job.branch,
-                worktree_path=job.worktree_path,
-                sdk=job.sdk,
-                created_at=job.created_at,
-            ).model_dump(mode="json")
+            if jobs is not None:
+                return await _run_batch(jobs, lambda spec: _create_job_from_spec(config, spec))
+            return await _create_job(
+                config, repo=repo, prompt=prompt, base_ref=base_ref, branch=branch, model=model, sdk=sdk
+            )
 
         if action == "list":
             async with sf() as session:
                 svc = _make_job_service(session, config)
-                jobs, next_cursor, has_more = await svc.list_jobs(
+                page, next_cursor, has_more = await svc.list_job_summaries(
                     state=state,
                     limit=min(max(limit, 1), 100),
                     cursor=cursor,
                 )
             return JobListResponse(
-                items=[
-                    JobResponse(
-                        id=j.id,
-                        repo=j.repo,
-                        prompt=j.prompt,
-                        state=j.state,
-                        base_ref=j.base_ref,
-                        worktree_path=j.worktree_path,
-                        branch=j.branch,
-                        created_at=j.created_at,
-                        updated_at=j.updated_at,
-                        completed_at=j.completed_at,
-                        pr_url=j.pr_url,
-                        sdk=j.sdk,
-                    )
-                    for j in jobs
-                ],
+                items=[JobSummaryResponse.from_summary(j) for j in page],
                 cursor=next_cursor,
                 has_more=has_more,
             ).model_dump(mode="json")
 
         if action == "get":
+            if job_ids is not None:
+                return await _run_batch(job_ids, lambda jid: _get_job(config, jid))
             if not job_id:
                 return {"error": "job_id is required for get"}
-            async with sf() as session:
-                svc = _make_job_service(session, config)
-                try:
-                    job = await svc.get_job(job_id)
-                except JobNotFoundError as exc:
-                    return {"error": str(exc)}
-            return _job_to_response(job)
+            return await _get_job(config, job_id)
 
         if action == "cancel":
+            if job_ids is not None:
+                return await _run_batch(job_ids, lambda jid: _cancel_job(config, jid))
             if not job_id:
                 return {"error": "job_id is required for cancel"}
-            async with sf() as session:
-                svc = _make_job_service(session, config)
-                try:
-                    job = await svc.cancel_job(job_id)
-                except (JobNotFoundError, StateConflictError) as exc:
-                    return {"error": str(exc)}
-            runtime = _get_runtime()
-            await runtime.cancel(job_id)
-            return _job_to_response(job)
+            return await _cancel_job(config, job_id)
 
         if action == "rerun":
             if not job_id:
@@ -357,7 +498,10 @@ def _register_job_tool(mcp: FastMCP) -> None:
                 timestamp=datetime.now(UTC),
             ).model_dump(mode="json")
 
-        return {"error": f"Unknown action: {action}. Use: create, list, get, cancel, rerun, message"}
+        if action == "events":
+            return await _job_events(job_id, cursor, wait_s, limit)
+
+        return {"error": f"Unknown action: {action}. Use: create, list, get, cancel, rerun, message, events"}
 
 
 # ---------------------------------------------------------------------------
@@ -414,7 +558,7 @@ def _register_approval_tool(mcp: FastMCP) -> None:
             )
 
             try:
-                a = await svc.resolve(approval_id, resolution)
+                a = await svc.resolve(approval_id, resolution, resolved_by="mcp")
             except ApprovalNotFoundError as exc:
                 return {"error": str(exc)}
             except ApprovalAlreadyResolvedError as exc:
@@ -447,13 +591,15 @@ def _register_workspace_tool(mcp: FastMCP) -> None:
             "Browse a job's worktree. Actions: list, read."
             "\n\n"
             "- list: job_id (required), path (default ''), cursor, limit (default 200)"
-            "\n- read: job_id (required), path (required)"
+            "\n- read: job_id (required), path (required) — or paths: [...] to read up to 100 files"
+            " (20 MB in total) in one call"
         ),
     )
     async def codeplane_workspace(
         action: Literal["list", "read"],
         job_id: str | None = None,
         path: str = "",
+        paths: list[str] | None = None,
         cursor: str | None = None,
         limit: int = 200,
     ) -> McpToolResult:
@@ -517,25 +663,70 @@ def _register_workspace_tool(mcp: FastMCP) -> None:
             ).model_dump(mode="json")
 
         if action == "read":
+            if paths is not None:
+                if len(paths) > _MAX_READ_FILES:
+                    return {"error": f"At most {_MAX_READ_FILES} paths per read"}
+                return {"files": await _read_workspace_files(worktree, paths)}
             if not path:
                 return {"error": "path is required for read"}
-            file_path = (worktree / path).resolve()
-            if not file_path.is_relative_to(worktree):
-                return {"error": "Invalid path"}
-            if not file_path.is_file():
-                return {"error": "File not found"}
-            max_file_size = 5 * 1024 * 1024
-            if file_path.stat().st_size > max_file_size:
-                return {"error": "File too large to preview (>5 MB)"}
-            try:
-                file_content = file_path.read_text(encoding="utf-8", errors="replace")
-            except (PermissionError, OSError):
-                return {"error": "Cannot read file"}
-            return {"path": path, "content": file_content}
+            result = _read_workspace_file(worktree, path)
+            return {"error": result["error"]} if "error" in result else result
 
         return {"error": f"Unknown action: {action}. Use: list, read"}
 
 
+class _ReadBudget:
+    """Byte budget shared by the concurrent reads of one batch call."""
+
+    def __init__(self, total: int) -> None:
+        self._left = total
+        self._lock = threading.Lock()
+
+    def take(self, size: int) -> bool:
+        with self._lock:
+            if size > self._left:
+                return False
+            self._left -= size
+            return True
+
+    def give(self, size: int) -> None:
+        with self._lock:
+            self._left += size
+
+
+def _read_workspace_file(worktree: Path, path: str, budget: _ReadBudget | None = None) -> dict[str, Any]:
+    """Read one worktree file as text, refusing paths outside it and files over the *budget* left."""
+    file_path = (worktree / path).resolve()
+    if not file_path.is_relative_to(worktree):
+        return {"path": path, "error": "Invalid path"}
+    if not file_path.is_file():
+        return {"path": path, "error": "File not found"}
+    size = file_path.stat().st_size
+    if size > _MAX_FILE_BYTES:
+        return {"path": path, "error": "File too large to preview (>5 MB)"}
+    # Reserve before reading so concurrent reads cannot overrun the budget together
+    if budget is not None and not budget.take(size):
+        return {"path": path, "error": "Read budget for this call exhausted"}
+    try:
+        return {"path": path, "content": file_path.read_text(encoding="utf-8", errors="replace")}
+    except (PermissionError, OSError):
+        if budget is not None:
+            budget.give(size)
+        return {"path": path, "error": "Cannot read file"}
+
+
+async def _read_workspace_files(worktree: Path, paths: list[str]) -> list[dict[str, Any]]:
+    """Read *paths* concurrently off the event loop, within ``_MAX_READ_BYTES`` overall."""
+    slots = asyncio.Semaphore(_BATCH_CONCURRENCY)
+    budget = _ReadBudget(_MAX_READ_BYTES)
+
+    async def _one(rel: str) -> dict[str, Any]:
+        async with slots:
+            return await asyncio.to_thread(_read_workspace_file, worktree, rel, budget)
+
+    return list(await asyncio.gather(*(_one(rel) for rel in paths)))
+
+
 # ---------------------------------------------------------------------------
 # Artifacts
 # ---------------------------------------------------------------------------
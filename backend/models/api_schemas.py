@@ -3,7 +3,7 @@
 from __future__ import annotations
 
 from datetime import UTC, datetime  # noqa: TC003 — Pydantic resolves annotations at runtime
-from typing import Any, Literal
+from typing import TYPE_CHECKING, Any, Literal
 
 from pydantic import BaseModel, ConfigDict, Field, model_validator
 from pydantic.alias_generators import to_camel
@@ -14,6 +14,9 @@ from backend.models.domain import (  # noqa: TC001 — Pydantic resolves annotat
     Resolution,
 )
 
+if TYPE_CHECKING:
+    from backend.models.domain import JobSummary
+
 
 class CamelModel(BaseModel):
     """Base model that serializes field names to camelCase.
@@ -275,8 +278,74 @@ class JobResponse(CamelModel):
     parent_job_id: str | None = None
 
 
+class JobSummaryResponse(CamelModel):
+    """A job as listed (``GET /jobs``, the fleet snapshot) — :class:`JobResponse` without prompt texts.
+
+    ``prompt_preview`` holds the first 200 characters of the prompt.
+    Clients fetch ``GET /api/jobs/{id}`` for the full job when it is opened.
+    """
+
+    id: str
+    repo: str
+    title: str | None = None
+    state: JobState
+    base_ref: str
+    worktree_path: str | None
+    branch: str | None
+    permission_mode: PermissionMode | None = None
+    created_at: datetime
+    updated_at: datetime
+    completed_at: datetime | None
+    pr_url: str | None = None
+    merge_status: str | None = None
+    resolution: Resolution | None = None
+    archived_at: datetime | None = None
+    failure_reason: str | None = None
+    progress_headline: str | None = None
+    progress_summary: str | None = None
+    model: str | None = None
+    sdk: str = "copilot"
+    worktree_name: str | None = None
+    parent_job_id: str | None = None
+    prompt_preview: str = ""
+
+    @classmethod
+    def from_summary(
+        cls,
+        job: JobSummary,
+        progress_headline: str | None = None,
+        progress_summary: str | None = None,
+    ) -> JobSummaryResponse:
+        """The single mapping from a listed :class:`JobSummary`, shared by REST, SSE and MCP."""
+        return cls(
+            id=job.id,
+            repo=job.repo,
+            title=job.title,
+            state=job.state,
+            base_ref=job.base_ref,
+            worktree_path=job.worktree_path,
+            branch=job.branch,
+            permission_mode=job.permission_mode,
+            created_at=job.created_at,
+            updated_at=job.updated_at,
+            completed_at=job.completed_at,
+            pr_url=job.pr_url,
+            merge_status=job.merge_status,
+            resolution=job.resolution,
+            archived_at=job.archived_at,
+            failure_reason=job.failure_reason,
+            progress_headline=progress_headline,
+            progress_summary=progress_summary,
+            model=job.model,
+            sdk=job.sdk,
+            worktree_name=job.worktree_name,
+            parent_job_id=job.parent_job_id,
+            prompt_preview=job.prompt_preview,
+        )
+
+
 class JobListResponse(CamelModel):
-    items: list[JobResponse]
+    items: list[JobSummaryResponse]
     cursor: str | None
     has_more: bool
 
@@ -303,6 +372,31 @@ class ApprovalResponse(CamelModel):
     # True when this approval was triggered by a hard-blocked operation (e.g.
     # git reset --hard) that cannot be auto-resolved by a trust grant.
     requires_explicit_approval: bool = False
+    # operator | trust | mcp | rule
+    resolved_by: str | None = None
+
+
+class ApprovalRuleResponse(CamelModel):
+    """A command the operator has approved or rejected in a repo, with its counters."""
+
+    repo: str
+    # Bash (Claude) or shell (Copilot)
+    tool: str
+    action: str
+    approvals: int
+    rejections: int
+    auto_approved: int
+    last_decided_at: datetime | None
+    last_applied_at: datetime | None
+    revoked_at: datetime | None
+    # True when matching requests are currently approved without asking
+    active: bool
+
+
+class RevokeApprovalRuleRequest(CamelModel):
+    repo: str
+    tool: str
+    action: str
 
 
 class ArtifactResponse(CamelModel):
@@ -353,6 +447,17 @@ class HealthResponse(CamelModel):
     queued_jobs: int
 
 
+class RecoveryStatusResponse(CamelModel):
+    """Progress of resuming jobs left active by the previous server process."""
+
+    in_progress: bool
+    total: int
+    recovered: int
+    failed: int
+    started_at: datetime | None
+    finished_at: datetime | None
+
+
 class RegisterRepoResponse(CamelModel):
     path: str
     source: str
@@ -460,6 +565,10 @@ class ApprovalResolvedPayload(CamelModel):
     approval_id: str
     resolution: ApprovalResolution
     timestamp: datetime
+    # Set when a learned approval rule answered without asking the operator
+    auto_approved: bool = False
+    description: str | None = None
+    proposed_action: str | None = None
 
 
 class DiffUpdatePayload(CamelModel):
@@ -467,10 +576,19 @@ class DiffUpdatePayload(CamelModel):
     changed_files: list[DiffFileModel]
 
 
-class SessionHeartbeatPayload(CamelModel):
+class HeartbeatJob(CamelModel):
     job_id: str
     session_id: str
+    idle_s: float  # seconds since the job's agent last produced output
+
+
+class SessionHeartbeatPayload(CamelModel):
+    """Liveness frame.  The runtime-wide frame leaves ``job_id`` empty and lists every running job."""
+
+    job_id: str
+    session_id: str = ""
     timestamp: datetime
+    jobs: list[HeartbeatJob] = Field(default_factory=list)
 
 
 class MergeCompletedPayload(CamelModel):
@@ -602,9 +720,47 @@ class TelemetryUpdatedPayload(CamelModel):
     timestamp: datetime
 
 
+class BudgetLimitStatus(CamelModel):
+    """Month-to-date spend for one SDK against its configured cap."""
+
+    sdk: str
+    unit: str  # usd | premium_requests
+    spent: float = 0.0
+    limit: float = 0.0  # 0 = unlimited
+    status: str = "ok"  # ok | soft | exhausted
+
+
+class BudgetSnapshot(CamelModel):
+    """In-memory cost ledger state (``GET /analytics/budget`` and ``budget_updated`` SSE)."""
+
+    month: str
+    total_cost_usd: float = 0.0
+    sdks: list[BudgetLimitStatus] = []
+    repos: dict[str, float] = {}
+
+
+class BudgetUpdatedPayload(BudgetSnapshot):
+    job_id: str
+    job_cost_usd: float = 0.0
+    job_limit_usd: float = 0.0
+    job_status: str = "ok"
+    timestamp: datetime
+
+
 class SnapshotPayload(CamelModel):
-    jobs: list[JobResponse]
+    """Fleet state sent to a reconnecting client whose replay gap is too large.
+
+    Large fleets arrive as several frames, newest jobs first.  ``chunk`` counts
+    from 0; the frame with ``final`` set carries the pending approvals, and
+    jobs not listed in any chunk are gone.  On a job-scoped stream ``job_id``
+    is set and the snapshot covers that job alone.
+    """
+
+    jobs: list[JobSummaryResponse]
     pending_approvals: list[ApprovalResponse]
+    chunk: int = 0
+    final: bool = True
+    job_id: str | None = None
 
 
 class JobSnapshotResponse(CamelModel):
@@ -843,8 +999,38 @@ class JobContextResponse(CamelModel):
     flags: list[JobContextFlag] = []
 
 
+class WaterfallBarModel(CamelModel):
+    name: str
+    category: str  # approval | llm | tool | overhead | queue
+    start_ms: float
+    duration_ms: float
+    critical_ms: float = 0.0
+
+
+class CriticalSegmentModel(CamelModel):
+    category: str  # approval | llm | tool | overhead | queue | idle
+    name: str
+    start_ms: float
+    end_ms: float
+
+
+class JobWaterfallResponse(CamelModel):
+    """Per-job execution waterfall and critical-path breakdown (``GET /jobs/{id}/telemetry/waterfall``)."""
+
+    job_id: str
+    start_ms: float = 0.0
+    wall_ms: float = 0.0
+    codeplane_ms: float = 0.0
+    codeplane_pct: float = 0.0
+    breakdown: dict[str, float] = {}
+    overhead_stages: dict[str, float] = {}
+    bars: list[WaterfallBarModel] = []
+    critical_path: list[CriticalSegmentModel] = []
+
+
 class StepPayload(CamelModel):
     """Step data for REST API and SSE."""
+
     step_id: str
     step_number: int
     job_id: str
@@ -867,12 +1053,14 @@ class StepPayload(CamelModel):
 
 class StepTitlePayload(CamelModel):
     """SSE payload for step title generation."""
+
     step_id: str
     title: str
 
 
 class StepGroupPayload(CamelModel):
     """SSE payload for step grouping updates."""
+
     job_id: str
     group_id: str
     headline: str
@@ -882,6 +1070,7 @@ class StepGroupPayload(CamelModel):
 
 class PlanStepPayload(CamelModel):
     """SSE payload for unified plan-step updates."""
+
     job_id: str
     plan_step_id: str
     label: str
@@ -899,6 +1088,7 @@ class PlanStepPayload(CamelModel):
 
 class StepDiffPayload(CamelModel):
     """Response for step-scoped Git diff."""
+
     step_id: str
     diff: str
     files_changed: int
@@ -907,6 +1097,7 @@ class StepDiffPayload(CamelModel):
 
 class TranscriptSearchResult(CamelModel):
     """A transcript event matching a search query."""
+
     seq: int
     role: str
     content: str
@@ -2,26 +2,43 @@
 
 from __future__ import annotations
 
+from typing import TYPE_CHECKING
+
 from sqlalchemy import Boolean, Column, DateTime, Float, ForeignKey, Index, Integer, String, Text
+from sqlalchemy.dialects.postgresql import JSONB
 from sqlalchemy.orm import DeclarativeBase
 
-from backend.models.domain import PermissionMode
+if TYPE_CHECKING:
+    from sqlalchemy.engine.default import DefaultExecutionContext
+
+from backend.models.domain import PROMPT_PREVIEW_CHARS, PermissionMode
 
 # All DateTime columns use timezone=True so timestamps are stored
 # and retrieved as timezone-aware UTC values, never naive.
 TZDateTime = DateTime(timezone=True)
 
+# JSON documents: TEXT on SQLite, JSONB on PostgreSQL.  Repositories write
+# serialized strings and read back through ``persistence.dialect.load_json``,
+# since the PostgreSQL driver returns JSONB values already decoded.
+JSONText = Text().with_variant(JSONB(), "postgresql")
+
 
 class Base(DeclarativeBase):
     pass
 
 
+def _prompt_preview(context: DefaultExecutionContext) -> str:
+    return str(context.get_current_parameters()["prompt"])[:PROMPT_PREVIEW_CHARS]  # type: ignore[no-untyped-call]
+
+
 class JobRow(Base):
     __tablename__ = "jobs"
 
     id = Column(String, primary_key=True)
     repo = Column(String, nullable=False)
     prompt = Column(Text, nullable=False)
+    # Denormalized head of ``prompt`` so listings never read the full TEXT
+    prompt_preview = Column(String, nullable=True, default=_prompt_preview)
     state = Column(String, nullable=False)
     base_ref = Column(String, nullable=False)
     branch = Column(String, nullable=True)
@@ -49,6 +66,18 @@ class JobRow(Base):
     completed_at = Column(TZDateTime, nullable=True)
     version = Column(Integer, nullable=False, default=1, server_default="1")
     parent_job_id = Column(String, ForeignKey("jobs.id"), nullable=True)
+    # Server process driving the job and until when its claim holds (see JobRepository.claim_lease)
+    owner = Column(String, nullable=True)
+    lease_expires_at = Column(TZDateTime, nullable=True)
+
+    # Listings order by (created_at, id) and page with it as the keyset cursor
+    __table_args__ = (
+        Index("idx_jobs_created", "created_at", "id"),
+        # ``state IN (...)`` — board columns, recovery, queue and health counts
+        Index("idx_jobs_state_created", "state", "created_at", "id"),
+        # Archived or not — the fleet snapshot sent on SSE reconnect and history
+        Index("idx_jobs_active", "archived_at", "created_at", "id"),
+    )
 
 
 class EventRow(Base):
@@ -77,6 +106,32 @@ class ApprovalRow(Base):
     # Hard-blocked operations (e.g. git reset --hard) set this to True so that
     # blanket trust grants cannot auto-resolve them.
     requires_explicit_approval = Column(Boolean, nullable=False, server_default="0")
+    # Who resolved it: operator | trust | rule (NULL while pending and for history
+    # recorded before this column existed)
+    resolved_by = Column(String, nullable=True)
+    # Claude tool name or Copilot permission kind that asked (Bash, Edit, shell, write, ...)
+    tool = Column(String, nullable=True)
+
+
+class ApprovalRuleRow(Base):
+    """Operator decisions counted per (repo, tool, exact command) — the learned allowlist.
+
+    A rule auto-approves once ``approvals`` reaches the configured threshold
+    with no ``rejections``.  Revoking zeroes both counters, so the command
+    has to be learned again.
+    """
+
+    __tablename__ = "approval_rules"
+
+    repo = Column(String, primary_key=True)
+    tool = Column(String, primary_key=True)
+    action = Column(Text, primary_key=True)
+    approvals = Column(Integer, nullable=False, default=0, server_default="0")
+    rejections = Column(Integer, nullable=False, default=0, server_default="0")
+    auto_approved = Column(Integer, nullable=False, default=0, server_default="0")
+    last_decided_at = Column(TZDateTime, nullable=True)
+    last_applied_at = Column(TZDateTime, nullable=True)
+    revoked_at = Column(TZDateTime, nullable=True)
 
 
 class ArtifactRow(Base):
@@ -123,12 +178,10 @@ class StepRow(Base):
     duration_ms = Column(Integer, nullable=True)
     start_sha = Column(String(40), nullable=True)
     end_sha = Column(String(40), nullable=True)
-    files_read = Column(Text, nullable=True)    # JSON array
+    files_read = Column(Text, nullable=True)  # JSON array
     files_written = Column(Text, nullable=True)  # JSON array
 
-    __table_args__ = (
-        Index("ix_steps_job_number", "job_id", "step_number"),
-    )
+    __table_args__ = (Index("ix_steps_job_number", "job_id", "step_number"),)
 
 
 class JobTelemetrySummaryRow(Base):
@@ -194,7 +247,7 @@ class JobTelemetrySpanRow(Base):
     name = Column(String, nullable=False)
     started_at = Column(Text, nullable=False)  # float stored as text
     duration_ms = Column(Text, nullable=False)
-    attrs_json = Column(Text, nullable=False)
+    attrs_json = Column(JSONText, nullable=False)
     created_at = Column(TZDateTime, nullable=False)
     # Cost analytics columns (migration 0008)
     tool_category = Column(String, nullable=True)
@@ -221,7 +274,7 @@ class JobTelemetrySpanRow(Base):
 
 
 class JobFileAccessRow(Base):
-    """Per-file read/write access log for cost analytics."""
+    """Raw per-access log — written only for a sample of accesses (see JobFileAccessStatsRow)."""
 
     __tablename__ = "job_file_access_log"
 
@@ -240,6 +293,27 @@ class JobFileAccessRow(Base):
     )
 
 
+class JobFileAccessStatsRow(Base):
+    """Per-job, per-file access counters for cost analytics, flushed in batches."""
+
+    __tablename__ = "job_file_access_stats"
+
+    job_id = Column(String, ForeignKey("jobs.id"), primary_key=True)
+    file_path = Column(String, primary_key=True)
+    read_count = Column(Integer, nullable=False, default=0, server_default="0")
+    write_count = Column(Integer, nullable=False, default=0, server_default="0")
+    read_bytes = Column(Integer, nullable=False, default=0, server_default="0")
+    first_turn = Column(Integer, nullable=True)
+    last_turn = Column(Integer, nullable=True)
+    first_access_at = Column(TZDateTime, nullable=False)
+    last_access_at = Column(TZDateTime, nullable=False)
+
+    __table_args__ = (
+        Index("idx_file_access_stats_path", "file_path"),
+        Index("idx_file_access_stats_last", "last_access_at"),
+    )
+
+
 class CostAttributionRow(Base):
     """Per-job cost breakdown by dimension (phase, tool category, turn)."""
 
@@ -271,7 +345,7 @@ class CostObservationRow(Base):
     severity = Column(String, nullable=False)
     title = Column(String, nullable=False)
     detail = Column(Text, nullable=False)
-    evidence_json = Column(Text, nullable=False)
+    evidence_json = Column(JSONText, nullable=False)
     job_count = Column(Integer, nullable=False, default=0, server_default="0")
     total_waste_usd = Column(Float, nullable=False, default=0.0, server_default="0.0")
     first_seen_at = Column(TZDateTime, nullable=False)
@@ -282,3 +356,125 @@ class CostObservationRow(Base):
         Index("idx_obs_category", "category"),
         Index("idx_obs_severity", "severity"),
     )
+
+
+class AnalyticsRollupJobRow(Base):
+    """Last contribution of each job to ``analytics_rollups`` — used to apply deltas."""
+
+    __tablename__ = "analytics_rollup_jobs"
+
+    job_id = Column(String, ForeignKey("jobs.id"), primary_key=True)
+    day = Column(String, nullable=False)
+    hour = Column(String, nullable=False)
+    repo = Column(String, nullable=False, default="")
+    model = Column(String, nullable=False, default="")
+    sdk = Column(String, nullable=False, default="")
+    job_count = Column(Integer, nullable=False, default=0, server_default="0")
+    review_count = Column(Integer, nullable=False, default=0, server_default="0")
+    completed_count = Column(Integer, nullable=False, default=0, server_default="0")
+    failed_count = Column(Integer, nullable=False, default=0, server_default="0")
+    cancelled_count = Column(Integer, nullable=False, default=0, server_default="0")
+    running_count = Column(Integer, nullable=False, default=0, server_default="0")
+    merged_count = Column(Integer, nullable=False, default=0, server_default="0")
+    pr_created_count = Column(Integer, nullable=False, default=0, server_default="0")
+    discarded_count = Column(Integer, nullable=False, default=0, server_default="0")
+    job_failed_count = Column(Integer, nullable=False, default=0, server_default="0")
+    verify_job_count = Column(Integer, nullable=False, default=0, server_default="0")
+    verify_turns = Column(Integer, nullable=False, default=0, server_default="0")
+    total_cost_usd = Column(Float, nullable=False, default=0.0, server_default="0.0")
+    input_tokens = Column(Integer, nullable=False, default=0, server_default="0")
+    output_tokens = Column(Integer, nullable=False, default=0, server_default="0")
+    cache_read_tokens = Column(Integer, nullable=False, default=0, server_default="0")
+    duration_ms = Column(Integer, nullable=False, default=0, server_default="0")
+    premium_requests = Column(Float, nullable=False, default=0.0, server_default="0.0")
+    tool_call_count = Column(Integer, nullable=False, default=0, server_default="0")
+    tool_failure_count = Column(Integer, nullable=False, default=0, server_default="0")
+    agent_error_count = Column(Integer, nullable=False, default=0, server_default="0")
+    total_turns = Column(Integer, nullable=False, default=0, server_default="0")
+    diff_lines = Column(Integer, nullable=False, default=0, server_default="0")
+    updated_at = Column(TZDateTime, nullable=False)
+
+
+class AnalyticsRollupRow(Base):
+    """Job telemetry summed per (granularity, bucket, repo, model, sdk).
+
+    ``granularity`` is ``day`` (bucket ``YYYY-MM-DD``) or ``hour``
+    (bucket ``YYYY-MM-DDTHH``), both in UTC.
+    """
+
+    __tablename__ = "analytics_rollups"
+
+    granularity = Column(String, primary_key=True)
+    bucket = Column(String, primary_key=True)
+    repo = Column(String, primary_key=True, default="")
+    model = Column(String, primary_key=True, default="")
+    sdk = Column(String, primary_key=True, default="")
+    job_count = Column(Integer, nullable=False, default=0, server_default="0")
+    review_count = Column(Integer, nullable=False, default=0, server_default="0")
+    completed_count = Column(Integer, nullable=False, default=0, server_default="0")
+    failed_count = Column(Integer, nullable=False, default=0, server_default="0")
+    cancelled_count = Column(Integer, nullable=False, default=0, server_default="0")
+    running_count = Column(Integer, nullable=False, default=0, server_default="0")
+    merged_count = Column(Integer, nullable=False, default=0, server_default="0")
+    pr_created_count = Column(Integer, nullable=False, default=0, server_default="0")
+    discarded_count = Column(Integer, nullable=False, default=0, server_default="0")
+    job_failed_count = Column(Integer, nullable=False, default=0, server_default="0")
+    verify_job_count = Column(Integer, nullable=False, default=0, server_default="0")
+    verify_turns = Column(Integer, nullable=False, default=0, server_default="0")
+    total_cost_usd = Column(Float, nullable=False, default=0.0, server_default="0.0")
+    input_tokens = Column(Integer, nullable=False, default=0, server_default="0")
+    output_tokens = Column(Integer, nullable=False, default=0, server_default="0")
+    cache_read_tokens = Column(Integer, nullable=False, default=0, server_default="0")
+    duration_ms = Column(Integer, nullable=False, default=0, server_default="0")
+    premium_requests = Column(Float, nullable=False, default=0.0, server_default="0.0")
+    tool_call_count = Column(Integer, nullable=False, default=0, server_default="0")
+    tool_failure_count = Column(Integer, nullable=False, default=0, server_default="0")
+    agent_error_count = Column(Integer, nullable=False, default=0, server_default="0")
+    total_turns = Column(Integer, nullable=False, default=0, server_default="0")
+    diff_lines = Column(Integer, nullable=False, default=0, server_default="0")
+    updated_at = Column(TZDateTime, nullable=False)
+
+
+class AnalyticsToolRollupRow(Base):
+    """Tool span counters per (granularity, bucket, tool)."""
+
+    __tablename__ = "analytics_tool_rollups"
+
+    granularity = Column(String, primary_key=True)
+    bucket = Column(String, primary_key=True)
+    tool = Column(String, primary_key=True)
+    call_count = Column(Integer, nullable=False, default=0, server_default="0")
+    failure_count = Column(Integer, nullable=False, default=0, server_default="0")
+    total_duration_ms = Column(Float, nullable=False, default=0.0, server_default="0.0")
+    updated_at = Column(TZDateTime, nullable=False)
+
+
+class AnalysisJobContributionRow(Base):
+    """What each job last contributed to ``analysis_counters`` — used to apply deltas."""
+
+    __tablename__ = "analysis_job_contributions"
+
+    job_id = Column(String, ForeignKey("jobs.id"), primary_key=True)
+    detector = Column(String, primary_key=True)
+    key = Column(String, primary_key=True)
+    day = Column(String, nullable=False)
+    events = Column(Integer, nullable=False, default=0, server_default="0")
+    hits = Column(Integer, nullable=False, default=0, server_default="0")
+    amount = Column(Float, nullable=False, default=0.0, server_default="0.0")
+
+
+class AnalysisCounterRow(Base):
+    """Per-day counters for the streaming statistical-analysis detectors."""
+
+    __tablename__ = "analysis_counters"
+
+    detector = Column(String, primary_key=True)
+    key = Column(String, primary_key=True)
+    day = Column(String, primary_key=True)
+    events = Column(Integer, nullable=False, default=0, server_default="0")
+    hits = Column(Integer, nullable=False, default=0, server_default="0")
+    amount = Column(Float, nullable=False, default=0.0, server_default="0.0")
+    jobs = Column(Integer, nullable=False, default=0, server_default="0")
+    updated_at = Column(TZDateTime, nullable=False)
+
+    __table_args__ = (Index("idx_analysis_counters_detector_day", "detector", "day"),)
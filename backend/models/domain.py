@@ -128,6 +128,7 @@ class SessionEventKind(StrEnum):
     file_changed = "file_changed"
     approval_request = "approval_request"
     model_downgraded = "model_downgraded"
+    usage = "usage"
     done = "done"
     error = "error"
 
@@ -152,6 +153,10 @@ class SessionConfig:
     blocking_permission_handler: object = None
     # Set when resuming a job to reconnect to an existing Copilot SDK session
     resume_sdk_session_id: str | None = None
+    # Monotonic clock reading that span offsets are measured from.  Set by
+    # RuntimeService at job start so adapter spans and internal stage spans
+    # share one timeline across every session of the run.
+    span_origin: float | None = None
 
 
 @dataclass
@@ -213,6 +218,64 @@ class Job:
     parent_job_id: str | None = None
 
 
+# Length of ``JobSummary.prompt_preview`` — enough for a card, a history row and search
+PROMPT_PREVIEW_CHARS = 200
+
+
+@dataclass
+class JobSummary:
+    """The fields of a :class:`Job` needed to list it — no prompt texts."""
+
+    id: str
+    repo: str
+    state: JobState
+    base_ref: str
+    branch: str | None
+    worktree_path: str | None
+    created_at: datetime
+    updated_at: datetime
+    completed_at: datetime | None = None
+    pr_url: str | None = None
+    merge_status: str | None = None
+    resolution: Resolution | None = None
+    archived_at: datetime | None = None
+    title: str | None = None
+    worktree_name: str | None = None
+    permission_mode: PermissionMode = PermissionMode.full_auto
+    model: str | None = None
+    sdk: str = "copilot"
+    failure_reason: str | None = None
+    parent_job_id: str | None = None
+    prompt_preview: str = ""
+    """The first :data:`PROMPT_PREVIEW_CHARS` characters of the prompt."""
+
+    @classmethod
+    def from_job(cls, job: Job) -> JobSummary:
+        return cls(
+            id=job.id,
+            repo=job.repo,
+            state=job.state,
+            base_ref=job.base_ref,
+            branch=job.branch,
+            worktree_path=job.worktree_path,
+            created_at=job.created_at,
+            updated_at=job.updated_at,
+            completed_at=job.completed_at,
+            pr_url=job.pr_url,
+            merge_status=job.merge_status,
+            resolution=job.resolution,
+            archived_at=job.archived_at,
+            title=job.title,
+            worktree_name=job.worktree_name,
+            permission_mode=job.permission_mode,
+            model=job.model,
+            sdk=job.sdk,
+            failure_reason=job.failure_reason,
+            parent_job_id=job.parent_job_id,
+            prompt_preview=job.prompt[:PROMPT_PREVIEW_CHARS],
+        )
+
+
 @dataclass
 class Approval:
     """Domain representation of an approval request."""
@@ -228,6 +291,25 @@ class Approval:
     # git reset --hard) and MUST NOT be auto-resolved by a blanket trust grant.
     # The operator must explicitly click Approve for each occurrence.
     requires_explicit_approval: bool = False
+    # operator | trust | mcp | rule — None while pending or for older history
+    resolved_by: str | None = None
+    # Claude tool name or Copilot permission kind that asked — None for older history
+    tool: str | None = None
+
+
+@dataclass
+class ApprovalRule:
+    """Operator decisions on one exact command by one tool in one repo (a learned allowlist entry)."""
+
+    repo: str
+    tool: str
+    action: str
+    approvals: int = 0
+    rejections: int = 0
+    auto_approved: int = 0
+    last_decided_at: datetime | None = None
+    last_applied_at: datetime | None = None
+    revoked_at: datetime | None = None
 
 
 @dataclass
@@ -43,6 +43,7 @@ class DomainEventKind(StrEnum):
     step_title_generated = "StepTitleGenerated"
     step_group_updated = "StepGroupUpdated"
     plan_step_updated = "PlanStepUpdated"
+    budget_updated = "BudgetUpdated"
 
 
 # ---------------------------------------------------------------------------
@@ -125,9 +126,16 @@ class JobFailedPayloadDict(TypedDict, total=False):
     reason: str
 
 
+class HeartbeatJobDict(TypedDict):
+    job_id: str
+    session_id: str
+    idle_s: float
+
+
 class SessionHeartbeatPayloadDict(TypedDict, total=False):
     session_id: str
     timestamp: str
+    jobs: list[HeartbeatJobDict]  # runtime-wide frame: every running job
 
 
 class MergeCompletedPayloadDict(TypedDict, total=False):
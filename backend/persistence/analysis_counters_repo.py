@@ -0,0 +1,238 @@
+"""Persistence for incrementally maintained statistical-analysis counters.
+
+``analysis_counters`` holds per-day sums for each (detector, key) — e.g.
+``("file_reread", "src/app.py")`` or ``("tool_failure", "bash")``.
+``analysis_job_contributions`` records what each job last added, so
+re-running a job (resume → finalize again) replaces its contribution
+instead of double-counting it.
+
+Every job's contribution is bucketed under the day its telemetry summary was
+created, so ``SUM(jobs)`` over a window is a distinct-job count.
+"""
+
+from __future__ import annotations
+
+from datetime import UTC, datetime
+from typing import Any
+
+from sqlalchemy import text
+
+from backend.persistence.dialect import day_days_ago, day_of, json_is_false
+from backend.persistence.repository import BaseRepository
+
+DETECTOR_FILE_REREAD = "file_reread"
+DETECTOR_TOOL_FAILURE = "tool_failure"
+DETECTOR_RETRY_WASTE = "retry_waste"
+DETECTOR_TURN_ESCALATION = "turn_escalation"
+
+# Retained window for all detectors.
+WINDOW_DAYS = 30
+
+
+class AnalysisCountersRepo(BaseRepository):
+    """Delta-maintained counters backing the streaming detectors."""
+
+    async def job_contributions(self, job_id: str) -> list[dict[str, Any]]:
+        """Compute a job's current contribution to every detector from its own rows."""
+        params = {"job_id": job_id}
+        day_sql = day_of("created_at", self._dialect)
+        day_result = await self._session.execute(
+            text(f"SELECT {day_sql} AS day FROM job_telemetry_summary WHERE job_id = :job_id"),  # noqa: S608
+            params,
+        )
+        day_row = day_result.mappings().first()
+        day = day_row["day"] if day_row else datetime.now(UTC).date().isoformat()
+
+        rows: list[dict[str, Any]] = []
+        reads = await self._session.execute(
+            text("""
+                SELECT file_path, read_count AS events, read_bytes AS amount
+                FROM job_file_access_stats
+                WHERE job_id = :job_id AND read_count > 0
+            """),
+            params,
+        )
+        for r in reads.mappings().all():
+            rows.append(
+                {
+                    "detector": DETECTOR_FILE_REREAD,
+                    "key": r["file_path"],
+                    "events": r["events"],
+                    "hits": 0,
+                    "amount": float(r["amount"]),
+                }
+            )
+
+        tools = await self._session.execute(
+            text(f"""
+                SELECT
+                    name,
+                    COUNT(*) AS calls,
+                    SUM(CASE WHEN {json_is_false("attrs_json", "success", self._dialect)}
+                        THEN 1 ELSE 0 END) AS failures,
+                    SUM(CASE WHEN is_retry = TRUE THEN 1 ELSE 0 END) AS retries
+                FROM job_telemetry_spans
+                WHERE job_id = :job_id AND span_type = 'tool'
+                GROUP BY name
+            """),  # noqa: S608
+            params,
+        )
+        for r in tools.mappings().all():
+            rows.append(
+                {
+                    "detector": DETECTOR_TOOL_FAILURE,
+                    "key": r["name"],
+                    "events": r["calls"],
+                    "hits": r["failures"],
+                    "amount": 0.0,
+                }
+            )
+            rows.append(
+                {
+                    "detector": DETECTOR_RETRY_WASTE,
+                    "key": r["name"],
+                    "events": r["calls"],
+                    "hits": r["retries"],
+                    "amount": 0.0,
+                }
+            )
+
+        escalation = await self._session.execute(
+            text("""
+                SELECT cost_second_half_usd - cost_first_half_usd AS waste
+                FROM job_telemetry_summary
+                WHERE job_id = :job_id
+                    AND total_turns >= 6
+                    AND cost_second_half_usd > 0
+                    AND cost_first_half_usd > 0
+                    AND (cost_second_half_usd / cost_first_half_usd) >= 2.0
+            """),
+            params,
+        )
+        esc = escalation.mappings().first()
+        if esc is not None:
+            rows.append(
+                {
+                    "detector": DETECTOR_TURN_ESCALATION,
+                    "key": job_id,
+                    "events": 1,
+                    "hits": 0,
+                    "amount": max(0.0, float(esc["waste"])),
+                }
+            )
+
+        for row in rows:
+            row["day"] = day
+        return rows
+
+    async def replace_job(self, job_id: str, contributions: list[dict[str, Any]]) -> set[tuple[str, str]]:
+        """Swap a job's previous contribution for *contributions*.
+
+        Returns the (detector, key) pairs whose counters changed.
+        """
+        previous = await self._session.execute(
+            text("""
+                SELECT detector, key, day, events, hits, amount
+                FROM analysis_job_contributions
+                WHERE job_id = :job_id
+            """),
+            {"job_id": job_id},
+        )
+        old = [dict(r) for r in previous.mappings().all()]
+        now = datetime.now(UTC).isoformat()
+
+        for row in old:
+            await self._add(row, sign=-1, now=now)
+        for row in contributions:
+            await self._add(row, sign=1, now=now)
+
+        await self._session.execute(
+            text("DELETE FROM analysis_job_contributions WHERE job_id = :job_id"),
+            {"job_id": job_id},
+        )
+        if contributions:
+            await self._session.execute(
+                text("""
+                    INSERT INTO analysis_job_contributions (job_id, detector, key, day, events, hits, amount)
+                    VALUES (:job_id, :detector, :key, :day, :events, :hits, :amount)
+                """),
+                [{**row, "job_id": job_id} for row in contributions],
+            )
+        touched = {(r["detector"], r["key"], r["day"]) for r in (*old, *contributions)}
+        if touched:
+            await self._session.execute(
+                text("""
+                    DELETE FROM analysis_counters
+                    WHERE detector = :detector AND key = :key AND day = :day AND jobs <= 0
+                """),
+                [{"detector": d, "key": k, "day": day} for d, k, day in touched],
+            )
+        await self._session.flush()
+        return {(d, k) for d, k, _ in touched}
+
+    async def prune_expired(self) -> int:
+        """Drop counters and job contributions for days outside the retained window."""
+        cutoff = day_days_ago(WINDOW_DAYS, self._dialect)
+        result = await self._session.execute(
+            text(f"DELETE FROM analysis_counters WHERE day < {cutoff}")  # noqa: S608
+        )
+        await self._session.execute(
+            text(f"DELETE FROM analysis_job_contributions WHERE day < {cutoff}")  # noqa: S608
+        )
+        return int(result.rowcount or 0)  # type: ignore[attr-defined]
+
+    async def _add(self, row: dict[str, Any], *, sign: int, now: str) -> None:
+        await self._session.execute(
+            text("""
+                INSERT INTO analysis_counters (detector, key, day, events, hits, amount, jobs, updated_at)
+                VALUES (:detector, :key, :day, :events, :hits, :amount, :jobs, :now)
+                ON CONFLICT(detector, key, day) DO UPDATE SET
+                    events = analysis_counters.events + excluded.events,
+                    hits = analysis_counters.hits + excluded.hits,
+                    amount = analysis_counters.amount + excluded.amount,
+                    jobs = analysis_counters.jobs + excluded.jobs,
+                    updated_at = excluded.updated_at
+            """),
+            {
+                "detector": row["detector"],
+                "key": row["key"],
+                "day": row["day"],
+                "events": sign * int(row["events"] or 0),
+                "hits": sign * int(row["hits"] or 0),
+                "amount": sign * float(row["amount"] or 0),
+                "jobs": sign,
+                "now": now,
+            },
+        )
+
+    async def window_totals(self, detector: str, key: str) -> dict[str, Any]:
+        """Sum a (detector, key) counter over the retained window."""
+        result = await self._session.execute(
+            text(f"""
+                SELECT
+                    COALESCE(SUM(events), 0) AS events,
+                    COALESCE(SUM(hits), 0) AS hits,
+                    COALESCE(SUM(amount), 0) AS amount,
+                    COALESCE(SUM(jobs), 0) AS jobs
+                FROM analysis_counters
+                WHERE detector = :detector AND key = :key
+                    AND day >= {day_days_ago(WINDOW_DAYS, self._dialect)}
+            """),  # noqa: S608
+            {"detector": detector, "key": key},
+        )
+        return dict(result.mappings().first() or {})
+
+    async def top_keys(self, detector: str, *, limit: int = 20) -> list[dict[str, Any]]:
+        """Return the keys with the largest ``amount`` in the retained window."""
+        result = await self._session.execute(
+            text(f"""
+                SELECT key, SUM(amount) AS amount
+                FROM analysis_counters
+                WHERE detector = :detector AND day >= {day_days_ago(WINDOW_DAYS, self._dialect)}
+                GROUP BY key
+                ORDER BY amount DESC
+                LIMIT :limit
+            """),  # noqa: S608
+            {"detector": detector, "limit": limit},
+        )
+        return [dict(r) for r in result.mappings().all()]
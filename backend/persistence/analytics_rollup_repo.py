@@ -0,0 +1,203 @@
+"""Persistence for the pre-aggregated analytics rollup tables.
+
+The analytics dashboard reads from ``analytics_rollups`` (per
+granularity/bucket/repo/model/sdk) and ``analytics_tool_rollups`` (per
+granularity/bucket/tool) instead of scanning raw telemetry on every request.
+
+Job rollups are maintained by delta: ``analytics_rollup_jobs`` records what
+each job last contributed, so refreshing a job subtracts the old contribution
+and adds the new one.  Refreshing is therefore idempotent and safe to call on
+every summary/resolution change.  Tool rollups are append-only counters fed
+by span inserts.
+"""
+
+from __future__ import annotations
+
+from datetime import UTC, datetime
+from typing import Any
+
+from sqlalchemy import text
+
+from backend.persistence.dialect import SQLITE, day_days_ago, day_of, hour_days_ago, hour_of
+from backend.persistence.repository import BaseRepository
+
+# Additive columns shared by ``analytics_rollup_jobs`` and ``analytics_rollups``.
+ROLLUP_METRICS: tuple[str, ...] = (
+    "job_count",
+    "review_count",
+    "completed_count",
+    "failed_count",
+    "cancelled_count",
+    "running_count",
+    "merged_count",
+    "pr_created_count",
+    "discarded_count",
+    "job_failed_count",
+    "verify_job_count",
+    "verify_turns",
+    "total_cost_usd",
+    "input_tokens",
+    "output_tokens",
+    "cache_read_tokens",
+    "duration_ms",
+    "premium_requests",
+    "tool_call_count",
+    "tool_failure_count",
+    "agent_error_count",
+    "total_turns",
+    "diff_lines",
+)
+
+# Windows of this many days or fewer are served from hourly buckets so that
+# "last 24h" does not round out to two whole days.
+HOURLY_MAX_PERIOD_DAYS = 2
+
+
+def contribution_select(dialect: str = SQLITE) -> str:
+    """SELECT list computing one job's contribution.
+
+    Reads ``job_telemetry_summary s`` joined to ``jobs j``.  ``failed_count``
+    follows the telemetry summary status; ``job_failed_count`` follows the
+    job's own state, which is what the model comparison reports.  The 0016
+    and 0024 migration backfills keep their own frozen copies of this logic
+    (migrations must not import application code), so changes here need a
+    new migration to re-derive existing rows.
+    """
+    return f"""
+    s.job_id AS job_id,
+    {day_of("s.created_at", dialect)} AS day,
+    {hour_of("s.created_at", dialect)} AS hour,
+    s.repo AS repo,
+    s.model AS model,
+    s.sdk AS sdk,
+    1 AS job_count,
+    CASE WHEN s.status = 'review' THEN 1 ELSE 0 END AS review_count,
+    CASE WHEN s.status = 'completed' THEN 1 ELSE 0 END AS completed_count,
+    CASE WHEN s.status = 'failed' THEN 1 ELSE 0 END AS failed_count,
+    CASE WHEN s.status = 'cancelled' THEN 1 ELSE 0 END AS cancelled_count,
+    CASE WHEN s.status = 'running' THEN 1 ELSE 0 END AS running_count,
+    CASE WHEN j.resolution = 'merged' THEN 1 ELSE 0 END AS merged_count,
+    CASE WHEN j.resolution = 'pr_created' THEN 1 ELSE 0 END AS pr_created_count,
+    CASE WHEN j.resolution = 'discarded' THEN 1 ELSE 0 END AS discarded_count,
+    CASE WHEN j.state = 'failed' THEN 1 ELSE 0 END AS job_failed_count,
+    CASE WHEN j.verify = TRUE THEN 1 ELSE 0 END AS verify_job_count,
+    CASE WHEN j.verify = TRUE THEN s.total_turns ELSE 0 END AS verify_turns,
+    s.total_cost_usd AS total_cost_usd,
+    s.input_tokens AS input_tokens,
+    s.output_tokens AS output_tokens,
+    s.cache_read_tokens AS cache_read_tokens,
+    s.duration_ms AS duration_ms,
+    s.premium_requests AS premium_requests,
+    s.tool_call_count AS tool_call_count,
+    s.tool_failure_count AS tool_failure_count,
+    s.agent_error_count AS agent_error_count,
+    s.total_turns AS total_turns,
+    s.diff_lines_added + s.diff_lines_removed AS diff_lines
+"""
+
+
+def rollup_window(period_days: int, dialect: str = SQLITE) -> tuple[str, str]:
+    """Return ``(granularity, bucket_floor_sql)`` for an analytics period."""
+    days = int(period_days)
+    if days <= HOURLY_MAX_PERIOD_DAYS:
+        return "hour", hour_days_ago(days, dialect)
+    return "day", day_days_ago(days, dialect)
+
+
+class AnalyticsRollupRepo(BaseRepository):
+    """Incremental maintenance of the analytics rollup tables."""
+
+    async def refresh_job(self, job_id: str) -> None:
+        """Re-derive a job's contribution and apply the delta to the rollups."""
+        current = await self._session.execute(
+            text(f"""
+                SELECT {contribution_select(self._dialect)}
+                FROM job_telemetry_summary s
+                LEFT JOIN jobs j ON j.id = s.job_id
+                WHERE s.job_id = :job_id
+            """),  # noqa: S608
+            {"job_id": job_id},
+        )
+        new = current.mappings().first()
+        if new is None:
+            return
+
+        previous = await self._session.execute(
+            text("SELECT * FROM analytics_rollup_jobs WHERE job_id = :job_id"),
+            {"job_id": job_id},
+        )
+        old = previous.mappings().first()
+        if old is not None and all(old[k] == new[k] for k in ("day", "hour", "repo", "model", "sdk", *ROLLUP_METRICS)):
+            return
+
+        now = datetime.now(UTC).isoformat()
+        if old is not None:
+            await self._apply(old, sign=-1, now=now)
+        await self._apply(new, sign=1, now=now)
+
+        columns = ("job_id", "day", "hour", "repo", "model", "sdk", *ROLLUP_METRICS)
+        cols = ", ".join(columns)
+        vals = ", ".join(f":{c}" for c in columns)
+        updates = ", ".join(f"{c} = excluded.{c}" for c in (*columns[1:], "updated_at"))
+        await self._session.execute(
+            text(f"""
+                INSERT INTO analytics_rollup_jobs ({cols}, updated_at) VALUES ({vals}, :now)
+                ON CONFLICT(job_id) DO UPDATE SET {updates}
+            """),  # noqa: S608
+            {**dict(new), "now": now},
+        )
+        await self._session.flush()
+
+    async def _apply(self, contribution: Any, *, sign: int, now: str) -> None:
+        """Add (``sign=1``) or remove (``sign=-1``) a contribution in both granularities."""
+        metric_cols = ", ".join(ROLLUP_METRICS)
+        metric_vals = ", ".join(f":{m}" for m in ROLLUP_METRICS)
+        updates = ", ".join(f"{m} = analytics_rollups.{m} + excluded.{m}" for m in ROLLUP_METRICS)
+        params: dict[str, Any] = {m: sign * (contribution[m] or 0) for m in ROLLUP_METRICS}
+        params.update(
+            repo=contribution["repo"] or "",
+            model=contribution["model"] or "",
+            sdk=contribution["sdk"] or "",
+            now=now,
+        )
+        for granularity, bucket in (("day", contribution["day"]), ("hour", contribution["hour"])):
+            await self._session.execute(
+                text(f"""
+                    INSERT INTO analytics_rollups
+                        (granularity, bucket, repo, model, sdk, {metric_cols}, updated_at)
+                    VALUES
+                        (:granularity, :bucket, :repo, :model, :sdk, {metric_vals}, :now)
+                    ON CONFLICT(granularity, bucket, repo, model, sdk) DO UPDATE SET
+                        {updates},
+                        updated_at = excluded.updated_at
+                """),  # noqa: S608
+                {**params, "granularity": granularity, "bucket": bucket},
+            )
+
+    async def record_tool_call(self, *, name: str, duration_ms: float, failed: bool, created_at: str) -> None:
+        """Count one tool span into the daily and hourly tool rollups."""
+        params: dict[str, Any] = {
+            "tool": name,
+            "duration_ms": float(duration_ms or 0),
+            "failed": 1 if failed else 0,
+            "created_at": created_at,
+        }
+        for granularity, bucket_sql in (
+            ("day", day_of(":created_at", self._dialect)),
+            ("hour", hour_of(":created_at", self._dialect)),
+        ):
+            await self._session.execute(
+                text(f"""
+                    INSERT INTO analytics_tool_rollups
+                        (granularity, bucket, tool, call_count, failure_count, total_duration_ms, updated_at)
+                    VALUES
+                        (:granularity, {bucket_sql}, :tool, 1, :failed, :duration_ms, :created_at)
+                    ON CONFLICT(granularity, bucket, tool) DO UPDATE SET
+                        call_count = analytics_tool_rollups.call_count + 1,
+                        failure_count = analytics_tool_rollups.failure_count + excluded.failure_count,
+                        total_duration_ms = analytics_tool_rollups.total_duration_ms + excluded.total_duration_ms,
+                        updated_at = excluded.updated_at
+                """),  # noqa: S608
+                {**params, "granularity": granularity},
+            )
+        await self._session.flush()
@@ -30,6 +30,8 @@ class ApprovalRepository(BaseRepository):
             resolved_at=cast("datetime | None", row.resolved_at),
             resolution=cast("str | None", row.resolution),
             requires_explicit_approval=cast("bool", row.requires_explicit_approval or False),
+            resolved_by=cast("str | None", row.resolved_by),
+            tool=cast("str | None", row.tool),
         )
 
     async def create(self, approval: Approval) -> Approval:
@@ -43,6 +45,8 @@ class ApprovalRepository(BaseRepository):
             resolved_at=approval.resolved_at,
             resolution=approval.resolution,
             requires_explicit_approval=approval.requires_explicit_approval,
+            resolved_by=approval.resolved_by,
+            tool=approval.tool,
         )
         self._session.add(row)
         await self._session.flush()
@@ -75,6 +79,7 @@ class ApprovalRepository(BaseRepository):
         approval_id: str,
         resolution: str,
         resolved_at: datetime,
+        resolved_by: str | None = None,
     ) -> Approval | None:
         """Mark an approval as resolved atomically. Returns updated approval or None.
 
@@ -84,7 +89,7 @@ class ApprovalRepository(BaseRepository):
         stmt = (
             update(ApprovalRow)
             .where(ApprovalRow.id == approval_id, ApprovalRow.resolution.is_(None))
-            .values(resolution=resolution, resolved_at=resolved_at)
+            .values(resolution=resolution, resolved_at=resolved_at, resolved_by=resolved_by)
         )
         result = await self._session.execute(stmt)
         # CursorResult.rowcount is always present but not in the generic type stub
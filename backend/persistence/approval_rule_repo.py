@@ -0,0 +1,78 @@
+"""Learned approval rule persistence — per-(repo, tool, command) decision counters."""
+
+from __future__ import annotations
+
+from typing import TYPE_CHECKING, Any, cast
+
+from sqlalchemy import select, update
+from sqlalchemy.dialects import postgresql, sqlite
+
+from backend.models.db import ApprovalRuleRow
+from backend.models.domain import ApprovalRule
+from backend.persistence.dialect import POSTGRESQL
+from backend.persistence.repository import BaseRepository
+
+if TYPE_CHECKING:
+    from datetime import datetime
+
+
+class ApprovalRuleRepository(BaseRepository):
+    """Database access for the learned approval allowlist."""
+
+    @staticmethod
+    def _to_domain(row: ApprovalRuleRow) -> ApprovalRule:
+        return ApprovalRule(
+            repo=cast("str", row.repo),
+            tool=cast("str", row.tool),
+            action=cast("str", row.action),
+            approvals=cast("int", row.approvals or 0),
+            rejections=cast("int", row.rejections or 0),
+            auto_approved=cast("int", row.auto_approved or 0),
+            last_decided_at=cast("datetime | None", row.last_decided_at),
+            last_applied_at=cast("datetime | None", row.last_applied_at),
+            revoked_at=cast("datetime | None", row.revoked_at),
+        )
+
+    async def list_all(self) -> list[ApprovalRule]:
+        result = await self._session.execute(select(ApprovalRuleRow))
+        return [self._to_domain(row) for row in result.scalars().all()]
+
+    async def record_decision(self, repo: str, tool: str, action: str, *, approved: bool, at: datetime) -> None:
+        """Count one operator decision on *action* by *tool* in *repo*."""
+        insert = postgresql.insert if self._dialect == POSTGRESQL else sqlite.insert
+        stmt: Any = insert(ApprovalRuleRow).values(
+            repo=repo,
+            tool=tool,
+            action=action,
+            approvals=1 if approved else 0,
+            rejections=0 if approved else 1,
+            auto_approved=0,
+            last_decided_at=at,
+        )
+        table = ApprovalRuleRow.__table__.c
+        stmt = stmt.on_conflict_do_update(
+            index_elements=[table.repo, table.tool, table.action],
+            set_={
+                "approvals": table.approvals + stmt.excluded.approvals,
+                "rejections": table.rejections + stmt.excluded.rejections,
+                "last_decided_at": stmt.excluded.last_decided_at,
+            },
+        )
+        await self._session.execute(stmt)
+
+    async def record_applied(self, repo: str, tool: str, action: str, *, at: datetime) -> None:
+        """Count one request auto-approved by the rule."""
+        await self._session.execute(
+            update(ApprovalRuleRow)
+            .where(ApprovalRuleRow.repo == repo, ApprovalRuleRow.tool == tool, ApprovalRuleRow.action == action)
+            .values(auto_approved=ApprovalRuleRow.auto_approved + 1, last_applied_at=at)
+        )
+
+    async def revoke(self, repo: str, tool: str, action: str, *, at: datetime) -> bool:
+        """Zero the decision counters so the rule must be learned again."""
+        result = await self._session.execute(
+            update(ApprovalRuleRow)
+            .where(ApprovalRuleRow.repo == repo, ApprovalRuleRow.tool == tool, ApprovalRuleRow.action == action)
+            .values(approvals=0, rejections=0, revoked_at=at)
+        )
+        return cast("int", result.rowcount) > 0  # type: ignore[attr-defined]
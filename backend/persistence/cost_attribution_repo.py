@@ -9,8 +9,9 @@ from __future__ import annotations
 from datetime import UTC, datetime
 from typing import Any
 
-from sqlalchemy import text
+from sqlalchemy import bindparam, text
 
+from backend.persistence.dialect import now_minus_days
 from backend.persistence.repository import BaseRepository
 
 
@@ -81,6 +82,49 @@ class CostAttributionRepo(BaseRepository):
             )
         await self._session.flush()
 
+    async def delete_for_jobs(self, job_ids: list[str]) -> None:
+        """Remove all attribution rows for *job_ids* (before a recompute)."""
+        if not job_ids:
+            return
+        await self._session.execute(
+            text("DELETE FROM job_cost_attribution WHERE job_id IN :job_ids").bindparams(
+                bindparam("job_ids", expanding=True)
+            ),
+            {"job_ids": job_ids},
+        )
+        await self._session.flush()
+
+    async def insert_many(self, rows: list[dict[str, Any]]) -> None:
+        """Insert attribution rows for many jobs in one executemany round-trip.
+
+        Each row must carry its own ``job_id``.
+        """
+        if not rows:
+            return
+        now = datetime.now(UTC).isoformat()
+        await self._session.execute(
+            text("""
+                INSERT INTO job_cost_attribution
+                    (job_id, dimension, bucket, cost_usd, input_tokens, output_tokens, call_count, created_at)
+                VALUES
+                    (:job_id, :dimension, :bucket, :cost_usd, :input_tokens, :output_tokens, :call_count, :now)
+            """),
+            [
+                {
+                    "job_id": row["job_id"],
+                    "dimension": row.get("dimension", ""),
+                    "bucket": row.get("bucket", ""),
+                    "cost_usd": row.get("cost_usd", 0.0),
+                    "input_tokens": row.get("input_tokens", 0),
+                    "output_tokens": row.get("output_tokens", 0),
+                    "call_count": row.get("call_count", 0),
+                    "now": now,
+                }
+                for row in rows
+            ],
+        )
+        await self._session.flush()
+
     async def for_job(self, job_id: str) -> list[dict[str, Any]]:
         """Fetch all attribution rows for a job."""
         result = await self._session.execute(
@@ -114,7 +158,7 @@ class CostAttributionRepo(BaseRepository):
                     COUNT(DISTINCT job_id) as job_count
                 FROM job_cost_attribution
                 WHERE dimension = :dimension
-                    AND created_at >= datetime('now', '-{int(period_days)} days')
+                    AND created_at >= {now_minus_days(period_days, self._dialect)}
                 GROUP BY bucket
                 ORDER BY cost_usd DESC
                 LIMIT :limit
@@ -137,7 +181,7 @@ class CostAttributionRepo(BaseRepository):
                     COUNT(DISTINCT job_id) as job_count,
                     AVG(cost_usd) as avg_cost_per_job
                 FROM job_cost_attribution
-                WHERE created_at >= datetime('now', '-{int(period_days)} days')
+                WHERE created_at >= {now_minus_days(period_days, self._dialect)}
                 GROUP BY dimension, bucket
                 ORDER BY cost_usd DESC
                 LIMIT 100
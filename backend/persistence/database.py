@@ -1,17 +1,30 @@
-"""Database engine, session management, and migration runner."""
+"""Database engine, session management, and migration runner.
+
+SQLite (the default, one local file) or a shared PostgreSQL server when
+``database.url`` / ``CODEPLANE_DATABASE_URL`` is set.
+"""
 
 from __future__ import annotations
 
+import contextlib
+import os
 from pathlib import Path
 from typing import TYPE_CHECKING, Any
 
+import structlog
 from sqlalchemy import event as sa_event
+from sqlalchemy import make_url
 from sqlalchemy.ext.asyncio import AsyncEngine, AsyncSession, async_sessionmaker, create_async_engine
 
-from backend.config import CODEPLANE_DIR, DEFAULT_DB_PATH
+from backend.config import CODEPLANE_DIR, DEFAULT_DB_PATH, DatabaseConfig
 
 if TYPE_CHECKING:
-    from collections.abc import AsyncGenerator
+    from collections.abc import AsyncGenerator, Callable
+
+
+log = structlog.get_logger()
+
+DATABASE_URL_ENV = "CODEPLANE_DATABASE_URL"
 
 
 def get_database_url(db_path: Path | None = None) -> str:
@@ -20,20 +33,122 @@ def get_database_url(db_path: Path | None = None) -> str:
     return f"sqlite+aiosqlite:///{path}"
 
 
+def postgres_url(config: DatabaseConfig | None = None) -> str | None:
+    """Async PostgreSQL URL from ``CODEPLANE_DATABASE_URL`` or ``database.url``; None means SQLite."""
+    raw = os.environ.get(DATABASE_URL_ENV) or (config.url if config else "")
+    if not raw:
+        return None
+    url = make_url(raw)
+    if url.get_backend_name() != "postgresql":
+        raise ValueError(f"Unsupported database URL {url.render_as_string()!r}: only postgresql is supported")
+    return url.set(drivername="postgresql+psycopg").render_as_string(hide_password=False)
+
+
+def is_postgres(config: DatabaseConfig | None = None) -> bool:
+    """Whether the server runs against a shared PostgreSQL database."""
+    return postgres_url(config) is not None
+
+
+def _create_postgres_engine(url: str, *, pool_size: int, read_only: bool = False) -> AsyncEngine:
+    # The server runs its own MVCC, so there is no single-writer engine and no
+    # maintenance loop; every session gets a pooled connection.
+    options = "-c timezone=UTC"
+    if read_only:
+        options += " -c default_transaction_read_only=on"
+    return create_async_engine(
+        url,
+        echo=False,
+        pool_size=pool_size,
+        max_overflow=pool_size * 2,
+        pool_timeout=60,
+        pool_pre_ping=True,
+        connect_args={"options": options},
+    )
+
+
 def _set_sqlite_pragmas(dbapi_conn: Any, _connection_record: Any) -> None:
-    """Enable WAL mode and foreign keys for every connection."""
+    """Enable WAL mode and foreign keys for every connection.
+
+    ``synchronous=NORMAL`` is safe under WAL: a commit survives an application
+    crash and only an OS crash can roll back the most recent transactions.
+    """
     cursor = dbapi_conn.cursor()
     cursor.execute("PRAGMA journal_mode=WAL")
     cursor.execute("PRAGMA foreign_keys=ON")
     cursor.execute("PRAGMA busy_timeout=5000")
+    cursor.execute("PRAGMA synchronous=NORMAL")
+    cursor.execute("PRAGMA temp_store=MEMORY")
     cursor.close()
 
 
-def create_engine(db_path: Path | None = None) -> AsyncEngine:
-    """Create an async SQLAlchemy engine."""
+def _connection_profile(config: DatabaseConfig, *, read_only: bool = False) -> Callable[[Any, Any], None]:
+    """Connect hook applying the base pragmas plus the configured cache/mmap sizes."""
+
+    def _apply(dbapi_conn: Any, connection_record: Any) -> None:
+        _set_sqlite_pragmas(dbapi_conn, connection_record)
+        cursor = dbapi_conn.cursor()
+        # Negative cache_size is in KiB rather than pages
+        cursor.execute(f"PRAGMA cache_size=-{config.cache_size_mb * 1024}")
+        cursor.execute(f"PRAGMA mmap_size={config.mmap_size_mb * 1024 * 1024}")
+        if read_only:
+            cursor.execute("PRAGMA query_only=ON")
+        cursor.close()
+
+    return _apply
+
+
+def create_engine(db_path: Path | None = None, config: DatabaseConfig | None = None) -> AsyncEngine:
+    """Create the general-purpose async SQLAlchemy engine (reads and writes)."""
+    pg_url = postgres_url(config) if db_path is None else None
+    if pg_url:
+        return _create_postgres_engine(pg_url, pool_size=10)
     url = get_database_url(db_path)
     engine = create_async_engine(url, echo=False, pool_size=10, max_overflow=20, pool_timeout=60)
-    sa_event.listen(engine.sync_engine, "connect", _set_sqlite_pragmas)
+    sa_event.listen(engine.sync_engine, "connect", _connection_profile(config or DatabaseConfig()))
+    return engine
+
+
+def create_writer_engine(db_path: Path | None = None, config: DatabaseConfig | None = None) -> AsyncEngine:
+    """Create the single-connection writer engine for the hot write path.
+
+    Writes through it queue on one connection instead of racing for the
+    SQLite write lock, and every transaction starts with ``BEGIN IMMEDIATE``
+    so the lock is taken up front — a deferred transaction that upgrades from
+    read to write fails with ``database is locked`` without honouring
+    ``busy_timeout``.
+    """
+    url = get_database_url(db_path)
+    engine = create_async_engine(url, echo=False, pool_size=1, max_overflow=0, pool_timeout=60)
+    profile = _connection_profile(config or DatabaseConfig())
+
+    def _on_connect(dbapi_conn: Any, connection_record: Any) -> None:
+        profile(dbapi_conn, connection_record)
+        # Hand transaction control to SQLAlchemy so the begin hook below owns BEGIN
+        dbapi_conn.isolation_level = None
+
+    def _on_begin(conn: Any) -> None:
+        conn.exec_driver_sql("BEGIN IMMEDIATE")
+
+    sa_event.listen(engine.sync_engine, "connect", _on_connect)
+    sa_event.listen(engine.sync_engine, "begin", _on_begin)
+    return engine
+
+
+def create_read_engine(db_path: Path | None = None, config: DatabaseConfig | None = None) -> AsyncEngine:
+    """Create the read-only pool (``query_only``) for analytics and telemetry reads."""
+    config = config or DatabaseConfig()
+    pg_url = postgres_url(config) if db_path is None else None
+    if pg_url:
+        return _create_postgres_engine(pg_url, pool_size=config.read_pool_size, read_only=True)
+    url = get_database_url(db_path)
+    engine = create_async_engine(
+        url,
+        echo=False,
+        pool_size=config.read_pool_size,
+        max_overflow=config.read_pool_size,
+        pool_timeout=60,
+    )
+    sa_event.listen(engine.sync_engine, "connect", _connection_profile(config, read_only=True))
     return engine
 
 
@@ -55,16 +170,114 @@ async def get_session(
             raise
 
 
-def run_migrations(db_path: Path | None = None) -> None:
-    """Run Alembic migrations programmatically at startup."""
+_ALEMBIC_DIR = Path(__file__).resolve().parents[2] / "alembic"
+
+
+def _alembic_head(script_location: Path = _ALEMBIC_DIR) -> str | None:
+    """Return the single head revision by reading the revision files, or None if unsure.
+
+    Parses ``revision`` / ``down_revision`` with :mod:`ast` instead of
+    importing alembic and executing every migration module.
+    """
+    import ast
+
+    revisions: set[str] = set()
+    parents: set[str] = set()
+    for path in (script_location / "versions").glob("*.py"):
+        try:
+            tree = ast.parse(path.read_text())
+        except (OSError, SyntaxError):
+            return None
+        values: dict[str, Any] = {}
+        for node in tree.body:
+            if isinstance(node, ast.Assign) and len(node.targets) == 1:
+                target, value = node.targets[0], node.value
+            elif isinstance(node, ast.AnnAssign) and node.value is not None:
+                target, value = node.target, node.value
+            else:
+                continue
+            if isinstance(target, ast.Name) and target.id in ("revision", "down_revision"):
+                try:
+                    values[target.id] = ast.literal_eval(value)
+                except ValueError:
+                    return None
+        if not isinstance(values.get("revision"), str):
+            continue  # not a revision file
+        revisions.add(values["revision"])
+        down = values.get("down_revision")
+        parents.update([down] if isinstance(down, str) else down or ())
+    heads = revisions - parents
+    return next(iter(heads)) if len(heads) == 1 else None
+
+
+def _sqlite_revision(db_path: Path) -> str | None:
+    """Return the revision stamped in *db_path*, or None if it has none yet."""
+    import sqlite3
+
+    if not db_path.exists():
+        return None
+    try:
+        with contextlib.closing(sqlite3.connect(f"file:{db_path}?mode=ro", uri=True)) as conn:
+            rows = conn.execute("SELECT version_num FROM alembic_version").fetchall()
+    except sqlite3.Error:
+        return None
+    return rows[0][0] if len(rows) == 1 else None
+
+
+def run_migrations(db_path: Path | None = None, config: DatabaseConfig | None = None) -> None:
+    """Run Alembic migrations programmatically at startup.
+
+    Alembic is not imported at all when the database is already at head.
+    """
     CODEPLANE_DIR.mkdir(parents=True, exist_ok=True)
 
+    pg_url = postgres_url(config) if db_path is None else None
+    sqlite_path = db_path or DEFAULT_DB_PATH
+    if not pg_url and (head := _alembic_head()) is not None and _sqlite_revision(sqlite_path) == head:
+        log.debug("migrations_up_to_date", revision=head)
+        return
+
     from alembic.config import Config
 
     from alembic import command
 
     alembic_cfg = Config()
-    repo_root = Path(__file__).resolve().parents[2]
-    alembic_cfg.set_main_option("script_location", str(repo_root / "alembic"))
-    alembic_cfg.set_main_option("sqlalchemy.url", f"sqlite:///{db_path or DEFAULT_DB_PATH}")
+    alembic_cfg.set_main_option("script_location", str(_ALEMBIC_DIR))
+    if pg_url:
+        alembic_cfg.set_main_option("sqlalchemy.url", pg_url.replace("%", "%%"))
+        _bootstrap_postgres(pg_url, alembic_cfg)
+        return
+    alembic_cfg.set_main_option("sqlalchemy.url", f"sqlite:///{sqlite_path}")
     command.upgrade(alembic_cfg, "head")
+
+
+def _bootstrap_postgres(url: str, alembic_cfg: Any) -> None:
+    """Create a fresh PostgreSQL schema from the ORM models, then migrate as usual.
+
+    The historical revisions rebuild SQLite tables in batch mode and cannot
+    replay on PostgreSQL, so an empty database is created from the current
+    models and stamped at head; later revisions apply with ``upgrade``.
+    """
+    from sqlalchemy import create_engine as sa_create_engine
+    from sqlalchemy import inspect, text
+
+    from alembic import command
+    from backend.models.db import Base
+
+    current: list[str] = []
+    engine = sa_create_engine(url)
+    try:
+        with engine.begin() as conn:
+            fresh = not inspect(conn).has_table("alembic_version")
+            if fresh:
+                Base.metadata.create_all(conn)
+            else:
+                current = list(conn.execute(text("SELECT version_num FROM alembic_version")).scalars())
+    finally:
+        engine.dispose()
+    if fresh:
+        command.stamp(alembic_cfg, "head")
+    elif (head := _alembic_head()) is None or current != [head]:
+        command.upgrade(alembic_cfg, "head")
+    else:
+        log.debug("migrations_up_to_date", revision=head)
@@ -0,0 +1,101 @@
+"""SQL fragments that differ between the SQLite and PostgreSQL backends.
+
+Repositories write raw ``text()`` SQL; the handful of constructs with no
+common spelling (relative timestamps, day/hour bucket strings, JSON field
+access) are built here from the session's dialect name.  The SQLite output
+is exactly what the repositories used before PostgreSQL was supported.
+
+Day and hour buckets are ``YYYY-MM-DD`` / ``YYYY-MM-DDTHH`` strings in UTC on
+both backends so rollup tables compare and sort the same way.
+"""
+
+from __future__ import annotations
+
+import json
+from typing import TYPE_CHECKING, Any
+
+from sqlalchemy import cast, func
+from sqlalchemy.dialects.postgresql import JSONB
+
+if TYPE_CHECKING:
+    from sqlalchemy.ext.asyncio import AsyncSession
+    from sqlalchemy.sql.elements import ColumnElement
+
+SQLITE = "sqlite"
+POSTGRESQL = "postgresql"
+
+_PG_DAY = "YYYY-MM-DD"
+_PG_HOUR = 'YYYY-MM-DD"T"HH24'
+
+
+def dialect_of(session: AsyncSession) -> str:
+    """Dialect name (``sqlite`` / ``postgresql``) of the engine behind *session*."""
+    return session.get_bind().dialect.name
+
+
+def now_minus_days(days: int, dialect: str) -> str:
+    """Timestamp *days* ago, for comparing against ``created_at`` columns."""
+    if dialect == POSTGRESQL:
+        return f"(now() - interval '{int(days)} days')"
+    return f"datetime('now', '-{int(days)} days')"
+
+
+def day_days_ago(days: int, dialect: str) -> str:
+    """Day bucket string of the date *days* ago."""
+    if dialect == POSTGRESQL:
+        return f"to_char((now() AT TIME ZONE 'UTC') - interval '{int(days)} days', '{_PG_DAY}')"
+    return f"date('now', '-{int(days)} days')"
+
+
+def hour_days_ago(days: int, dialect: str) -> str:
+    """Hour bucket string of the hour *days* ago."""
+    if dialect == POSTGRESQL:
+        return f"to_char((now() AT TIME ZONE 'UTC') - interval '{int(days)} days', '{_PG_HOUR}')"
+    return f"strftime('%Y-%m-%dT%H', 'now', '-{int(days)} days')"
+
+
+def day_of(expr: str, dialect: str) -> str:
+    """Day bucket string of a timestamp column or ``:param``."""
+    if dialect == POSTGRESQL:
+        return f"to_char(CAST({expr} AS timestamptz) AT TIME ZONE 'UTC', '{_PG_DAY}')"
+    return f"date({expr})"
+
+
+def hour_of(expr: str, dialect: str) -> str:
+    """Hour bucket string of a timestamp column or ``:param``."""
+    if dialect == POSTGRESQL:
+        return f"to_char(CAST({expr} AS timestamptz) AT TIME ZONE 'UTC', '{_PG_HOUR}')"
+    return f"strftime('%Y-%m-%dT%H', {expr})"
+
+
+def json_number(column: str, key: str, dialect: str) -> str:
+    """Numeric JSON field of *column* (NULL when absent or not a number)."""
+    if dialect == POSTGRESQL:
+        doc = f"CAST({column} AS jsonb)"
+        number = f"CAST({doc} ->> '{key}' AS double precision)"
+        return f"(CASE WHEN jsonb_typeof({doc} -> '{key}') = 'number' THEN {number} END)"
+    return f"json_extract({column}, '$.{key}')"
+
+
+def json_is_false(column: str, key: str, dialect: str) -> str:
+    """Condition true when the JSON field is ``false`` (or ``0`` / ``"false"``)."""
+    if dialect == POSTGRESQL:
+        return f"(CAST({column} AS jsonb) ->> '{key}') IN ('false', '0')"
+    return f"(json_extract({column}, '$.{key}') = 0 OR json_extract({column}, '$.{key}') = 'false')"
+
+
+def json_text_expr(column: Any, key: str, dialect: str) -> ColumnElement[Any]:
+    """SQLAlchemy expression for a JSON field of *column* as text."""
+    if dialect == POSTGRESQL:
+        field: ColumnElement[Any] = cast(column, JSONB)[key].astext
+        return field
+    return func.json_extract(column, f"$.{key}")
+
+
+def load_json(value: Any, default: Any = None) -> Any:
+    """Decode a JSON column value; JSONB values arrive already decoded."""
+    if value is None or value == "":
+        return default
+    if isinstance(value, (str, bytes, bytearray)):
+        return json.loads(value)
+    return value
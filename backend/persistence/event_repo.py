@@ -3,15 +3,22 @@
 from __future__ import annotations
 
 import json
+import uuid
 from datetime import datetime  # noqa: TC003 — used in cast() string arg
-from typing import cast
+from typing import Any, cast
 
-from sqlalchemy import func, select
+from sqlalchemy import func, select, text
 
 from backend.models.db import EventRow
 from backend.models.events import DomainEvent, DomainEventKind
+from backend.persistence.dialect import POSTGRESQL, json_text_expr
 from backend.persistence.repository import BaseRepository
 
+# PostgreSQL NOTIFY channel carrying ``{"id", "origin"}`` for every appended event.
+EVENT_CHANNEL = "codeplane_events"
+# Identifies this server process so it can skip its own notifications.
+PROCESS_ORIGIN = uuid.uuid4().hex
+
 
 class EventRepository(BaseRepository):
     """Database access for domain event records."""
@@ -42,8 +49,19 @@ class EventRepository(BaseRepository):
         await self._session.flush()
         db_id = cast("int", row.id)
         event.db_id = db_id
+        if self._dialect == POSTGRESQL:
+            # Delivered on commit; other server processes relay it to their SSE clients
+            await self._session.execute(
+                text("SELECT pg_notify(:channel, :payload)"),
+                {"channel": EVENT_CHANNEL, "payload": json.dumps({"id": db_id, "origin": PROCESS_ORIGIN})},
+            )
         return db_id
 
+    async def get(self, db_id: int) -> DomainEvent | None:
+        """Load one event by its autoincrement DB id."""
+        row = await self._session.get(EventRow, db_id)
+        return self._to_domain(row) if row is not None else None
+
     async def list_after(
         self,
         after_id: int,
@@ -58,6 +76,13 @@ class EventRepository(BaseRepository):
         result = await self._session.execute(stmt)
         return [self._to_domain(row) for row in result.scalars().all()]
 
+    async def latest_id(self, job_id: str | None = None) -> int:
+        """Highest event id so far (0 when there are none), optionally scoped to a job."""
+        stmt: Any = select(func.max(EventRow.id))
+        if job_id is not None:
+            stmt = stmt.where(EventRow.job_id == job_id)
+        return cast("int | None", (await self._session.execute(stmt)).scalar()) or 0
+
     async def list_by_job(
         self,
         job_id: str,
@@ -109,6 +134,29 @@ class EventRepository(BaseRepository):
             )
         return previews
 
+    async def list_latest_payloads(self, job_ids: list[str], kind: DomainEventKind) -> dict[str, dict[str, Any]]:
+        """Return the payload of the most recent *kind* event for each requested job."""
+        if not job_ids:
+            return {}
+
+        latest_ids = (
+            select(
+                EventRow.job_id.label("job_id"),
+                func.max(EventRow.id).label("latest_id"),
+            )
+            .where(EventRow.job_id.in_(job_ids))
+            .where(EventRow.kind == kind.value)
+            .group_by(EventRow.job_id)
+            .subquery()
+        )
+
+        stmt = select(EventRow).join(latest_ids, EventRow.id == latest_ids.c.latest_id)
+        result = await self._session.execute(stmt)
+        return {
+            cast("str", row.job_id): cast("dict[str, Any]", json.loads(cast("str", row.payload)))
+            for row in result.scalars().all()
+        }
+
     async def search_transcript(
         self,
         job_id: str,
@@ -118,7 +166,7 @@ class EventRepository(BaseRepository):
         limit: int = 50,
     ) -> list[DomainEvent]:
         """Full-text search within a job's transcript events."""
-        from sqlalchemy import func, or_
+        from sqlalchemy import or_
 
         stmt = (
             select(EventRow)
@@ -135,9 +183,9 @@ class EventRepository(BaseRepository):
 
         # Search only content-bearing fields, not the entire JSON payload
         like_pattern = f"%{query}%"
-        content_field = func.json_extract(EventRow.payload, "$.content")
-        tool_name_field = func.json_extract(EventRow.payload, "$.tool_name")
-        tool_display_field = func.json_extract(EventRow.payload, "$.tool_display")
+        content_field = json_text_expr(EventRow.payload, "content", self._dialect)
+        tool_name_field = json_text_expr(EventRow.payload, "tool_name", self._dialect)
+        tool_display_field = json_text_expr(EventRow.payload, "tool_display", self._dialect)
         stmt = stmt.where(
             or_(
                 content_field.ilike(like_pattern),
@@ -1,6 +1,9 @@
 """Persistence for file access tracking.
 
-Records every file read/write by tool calls for redundant I/O analysis.
+Counts file reads/writes by tool calls per job and file for redundant I/O
+analysis.  Counters arrive in batches from
+:class:`~backend.services.file_access_tracker.FileAccessTracker`; the raw
+per-access log only receives a configurable sample.
 """
 
 from __future__ import annotations
@@ -8,13 +11,35 @@ from __future__ import annotations
 from datetime import UTC, datetime
 from typing import Any
 
-from sqlalchemy import text
+from sqlalchemy import bindparam, text
 
+from backend.persistence.dialect import now_minus_days
 from backend.persistence.repository import BaseRepository
 
+# A NULL on either side keeps the other value (``NULL < x`` is not true)
+_MERGE_COUNTS_SQL = """
+    INSERT INTO job_file_access_stats
+        (job_id, file_path, read_count, write_count, read_bytes,
+         first_turn, last_turn, first_access_at, last_access_at)
+    VALUES
+        (:job_id, :file_path, :read_count, :write_count, :read_bytes,
+         :first_turn, :last_turn, :first_access_at, :last_access_at)
+    ON CONFLICT(job_id, file_path) DO UPDATE SET
+        read_count = job_file_access_stats.read_count + excluded.read_count,
+        write_count = job_file_access_stats.write_count + excluded.write_count,
+        read_bytes = job_file_access_stats.read_bytes + excluded.read_bytes,
+        first_turn = CASE
+            WHEN job_file_access_stats.first_turn IS NULL OR excluded.first_turn < job_file_access_stats.first_turn
+            THEN excluded.first_turn ELSE job_file_access_stats.first_turn END,
+        last_turn = CASE
+            WHEN job_file_access_stats.last_turn IS NULL OR excluded.last_turn > job_file_access_stats.last_turn
+            THEN excluded.last_turn ELSE job_file_access_stats.last_turn END,
+        last_access_at = excluded.last_access_at
+"""
+
 
 class FileAccessRepo(BaseRepository):
-    """Append-only log of file reads and writes per job."""
+    """Per-job file access counters, plus a sampled log of individual accesses."""
 
     async def record(
         self,
@@ -23,28 +48,32 @@ class FileAccessRepo(BaseRepository):
         file_path: str,
         access_type: str,
         turn_number: int | None = None,
-        span_id: int | None = None,
         byte_count: int | None = None,
     ) -> None:
-        """Insert a single file access event."""
+        """Count a single file access."""
         now = datetime.now(UTC).isoformat()
-        await self._session.execute(
-            text("""
-                INSERT INTO job_file_access_log
-                    (job_id, file_path, access_type, turn_number, span_id, byte_count, created_at)
-                VALUES
-                    (:job_id, :file_path, :access_type, :turn_number, :span_id, :byte_count, :now)
-            """),
-            {
-                "job_id": job_id,
-                "file_path": file_path,
-                "access_type": access_type,
-                "turn_number": turn_number,
-                "span_id": span_id,
-                "byte_count": byte_count,
-                "now": now,
-            },
+        is_read = access_type == "read"
+        await self.merge_counts(
+            [
+                {
+                    "job_id": job_id,
+                    "file_path": file_path,
+                    "read_count": 1 if is_read else 0,
+                    "write_count": 0 if is_read else 1,
+                    "read_bytes": (byte_count or 0) if is_read else 0,
+                    "first_turn": turn_number,
+                    "last_turn": turn_number,
+                    "first_access_at": now,
+                    "last_access_at": now,
+                }
+            ]
         )
+
+    async def merge_counts(self, rows: list[dict[str, Any]]) -> None:
+        """Add per-(job, file) counter deltas in one batched upsert."""
+        if not rows:
+            return
+        await self._session.execute(text(_MERGE_COUNTS_SQL), rows)
         await self._session.flush()
 
     async def record_batch(
@@ -53,18 +82,18 @@ class FileAccessRepo(BaseRepository):
         job_id: str,
         entries: list[dict[str, Any]],
     ) -> None:
-        """Insert multiple file access events in a single batch."""
+        """Insert multiple raw file access events in a single batch."""
         if not entries:
             return
         now = datetime.now(UTC).isoformat()
-        for entry in entries:
-            await self._session.execute(
-                text("""
-                    INSERT INTO job_file_access_log
-                        (job_id, file_path, access_type, turn_number, span_id, byte_count, created_at)
-                    VALUES
-                        (:job_id, :file_path, :access_type, :turn_number, :span_id, :byte_count, :now)
-                """),
+        await self._session.execute(
+            text("""
+                INSERT INTO job_file_access_log
+                    (job_id, file_path, access_type, turn_number, span_id, byte_count, created_at)
+                VALUES
+                    (:job_id, :file_path, :access_type, :turn_number, :span_id, :byte_count, :created_at)
+            """),
+            [
                 {
                     "job_id": job_id,
                     "file_path": entry.get("file_path", ""),
@@ -72,9 +101,11 @@ class FileAccessRepo(BaseRepository):
                     "turn_number": entry.get("turn_number"),
                     "span_id": entry.get("span_id"),
                     "byte_count": entry.get("byte_count"),
-                    "now": now,
-                },
-            )
+                    "created_at": entry.get("created_at", now),
+                }
+                for entry in entries
+            ],
+        )
         await self._session.flush()
 
     async def reread_stats(self, job_id: str) -> dict[str, Any]:
@@ -82,38 +113,54 @@ class FileAccessRepo(BaseRepository):
         result = await self._session.execute(
             text("""
                 SELECT
-                    COUNT(*) as total_accesses,
-                    COUNT(DISTINCT file_path) as unique_files,
-                    SUM(CASE WHEN access_type = 'read' THEN 1 ELSE 0 END) as total_reads,
-                    SUM(CASE WHEN access_type = 'write' THEN 1 ELSE 0 END) as total_writes
-                FROM job_file_access_log
+                    COALESCE(SUM(read_count + write_count), 0) as total_accesses,
+                    COUNT(*) as unique_files,
+                    COALESCE(SUM(read_count), 0) as total_reads,
+                    COALESCE(SUM(write_count), 0) as total_writes,
+                    COALESCE(SUM(read_count), 0)
+                        - SUM(CASE WHEN read_count > 0 THEN 1 ELSE 0 END) as reread_count
+                FROM job_file_access_stats
                 WHERE job_id = :job_id
             """),
             {"job_id": job_id},
         )
         row = result.mappings().first()
-        if not row:
-            return {
-                "total_accesses": 0,
-                "unique_files": 0,
-                "total_reads": 0,
-                "total_writes": 0,
-                "reread_count": 0,
-            }
-
-        stats = dict(row)
-
-        # Count rereads: files read more than once
-        reread_result = await self._session.execute(
+        stats = dict(row) if row else {}
+        # reread_count is NULL when the job has no rows at all
+        return {
+            "total_accesses": stats.get("total_accesses") or 0,
+            "unique_files": stats.get("unique_files") or 0,
+            "total_reads": stats.get("total_reads") or 0,
+            "total_writes": stats.get("total_writes") or 0,
+            "reread_count": stats.get("reread_count") or 0,
+        }
+
+    async def reread_stats_for_jobs(self, job_ids: list[str]) -> dict[str, dict[str, Any]]:
+        """Batch form of :meth:`reread_stats` — one grouped query for many jobs.
+
+        Jobs without any recorded access are omitted.
+        """
+        if not job_ids:
+            return {}
+        result = await self._session.execute(
             text("""
-                SELECT COUNT(*) - COUNT(DISTINCT file_path) as reread_count
-                FROM job_file_access_log
-                WHERE job_id = :job_id AND access_type = 'read'
-            """),
-            {"job_id": job_id},
+                SELECT
+                    job_id,
+                    SUM(read_count + write_count) as total_accesses,
+                    COUNT(*) as unique_files,
+                    SUM(read_count) as total_reads,
+                    SUM(write_count) as total_writes,
+                    SUM(read_count) - SUM(CASE WHEN read_count > 0 THEN 1 ELSE 0 END) as reread_count
+                FROM job_file_access_stats
+                WHERE job_id IN :job_ids
+                GROUP BY job_id
+            """).bindparams(bindparam("job_ids", expanding=True)),
+            {"job_ids": job_ids},
         )
-        reread_row = reread_result.mappings().first()
-        stats["reread_count"] = reread_row["reread_count"] if reread_row else 0
+        stats: dict[str, dict[str, Any]] = {}
+        for r in result.mappings().all():
+            row = dict(r)
+            stats[row.pop("job_id")] = row
         return stats
 
     async def most_accessed_files(
@@ -126,17 +173,17 @@ class FileAccessRepo(BaseRepository):
             where += " AND job_id = :job_id"
             params["job_id"] = job_id
         else:
-            where += f" AND created_at >= datetime('now', '-{int(period_days)} days')"
+            where += f" AND last_access_at >= {now_minus_days(period_days, self._dialect)}"
 
         result = await self._session.execute(
             text(f"""
                 SELECT
                     file_path,
-                    COUNT(*) as access_count,
-                    SUM(CASE WHEN access_type = 'read' THEN 1 ELSE 0 END) as read_count,
-                    SUM(CASE WHEN access_type = 'write' THEN 1 ELSE 0 END) as write_count,
+                    SUM(read_count + write_count) as access_count,
+                    SUM(read_count) as read_count,
+                    SUM(write_count) as write_count,
                     COUNT(DISTINCT job_id) as job_count
-                FROM job_file_access_log
+                FROM job_file_access_stats
                 {where}
                 GROUP BY file_path
                 ORDER BY access_count DESC
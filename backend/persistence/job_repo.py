@@ -2,17 +2,25 @@
 
 from __future__ import annotations
 
+import base64
+from datetime import datetime
 from typing import TYPE_CHECKING, Any, cast
 
-from sqlalchemy import and_, or_, select
+from sqlalchemy import and_, func, or_, select
 
 from backend.models.db import DiffSnapshotRow, JobRow
-from backend.models.domain import Job, JobState, PermissionMode, Resolution
+from backend.models.domain import Job, JobState, JobSummary, PermissionMode, Resolution
+from backend.persistence.analytics_rollup_repo import AnalyticsRollupRepo
+from backend.persistence.event_repo import PROCESS_ORIGIN
 from backend.persistence.repository import BaseRepository
 
 if TYPE_CHECKING:
     import builtins
-    from datetime import datetime
+
+# How long a server process's claim on a job holds without being renewed.
+LEASE_TTL_S = 60.0
+
+_ACTIVE_STATES = (JobState.running, JobState.waiting_for_approval)
 
 
 def _safe_job_state(raw: str) -> JobState:
@@ -23,6 +31,47 @@ def _safe_job_state(raw: str) -> JobState:
         return JobState.queued
 
 
+_SUMMARY_COLUMNS = (
+    JobRow.id,
+    JobRow.repo,
+    JobRow.state,
+    JobRow.base_ref,
+    JobRow.branch,
+    JobRow.worktree_path,
+    JobRow.created_at,
+    JobRow.updated_at,
+    JobRow.completed_at,
+    JobRow.pr_url,
+    JobRow.merge_status,
+    JobRow.resolution,
+    JobRow.archived_at,
+    JobRow.title,
+    JobRow.worktree_name,
+    JobRow.permission_mode,
+    JobRow.model,
+    JobRow.sdk,
+    JobRow.failure_reason,
+    JobRow.parent_job_id,
+    JobRow.prompt_preview,
+)
+
+
+def encode_job_cursor(created_at: datetime, job_id: str) -> str:
+    """Opaque listing cursor: the next page starts after this job."""
+    raw = f"{created_at.isoformat()}|{job_id}".encode()
+    return base64.urlsafe_b64encode(raw).decode().rstrip("=")
+
+
+def decode_job_cursor(cursor: str) -> tuple[datetime, str] | None:
+    """The ``(created_at, id)`` keyset in *cursor*, or None if it is a bare job id."""
+    try:
+        raw = base64.urlsafe_b64decode(cursor + "=" * (-len(cursor) % 4)).decode()
+        created_at, sep, job_id = raw.partition("|")
+        return (datetime.fromisoformat(created_at), job_id) if sep else None
+    except ValueError:  # binascii.Error and UnicodeDecodeError included
+        return None
+
+
 class JobRepository(BaseRepository):
     """Database access for job records."""
 
@@ -128,19 +177,10 @@ class JobRepository(BaseRepository):
             return None
         return self._to_domain(row)
 
-    async def list(  # noqa: A003
-        self,
-        state: str | None = None,
-        limit: int = 50,
-        cursor: str | None = None,
-        include_archived: bool | None = None,
-    ) -> list[Job]:
-        """List jobs, optionally filtered by state, with cursor-based pagination.
-
-        Args:
-            include_archived: None = all jobs, False = exclude archived, True = only archived.
-        """
-        stmt = select(JobRow).order_by(JobRow.created_at.desc(), JobRow.id.desc())
+    @staticmethod
+    def _listing(stmt: Any, state: str | None, cursor: str | None, include_archived: bool | None, limit: int) -> Any:
+        """Apply the listing filters, ``(created_at, id)`` order and keyset cursor to *stmt*."""
+        stmt = stmt.order_by(JobRow.created_at.desc(), JobRow.id.desc())
         if state is not None:
             states = [s.strip() for s in state.split(",")]
             stmt = stmt.where(JobRow.state.in_(states))
@@ -149,18 +189,82 @@ class JobRepository(BaseRepository):
         elif include_archived is True:
             stmt = stmt.where(JobRow.archived_at.is_not(None))
         if cursor is not None:
-            # Keyset pagination: look up the cursor row's created_at for proper ordering
-            cursor_time = select(JobRow.created_at).where(JobRow.id == cursor).scalar_subquery()
+            cursor_time: Any
+            keyset = decode_job_cursor(cursor)
+            if keyset is not None:
+                cursor_time, cursor_id = keyset
+            else:
+                # A bare job id, as issued before cursors carried the keyset
+                cursor_time = select(JobRow.created_at).where(JobRow.id == cursor).scalar_subquery()
+                cursor_id = cursor
             stmt = stmt.where(
                 or_(
                     JobRow.created_at < cursor_time,
-                    and_(JobRow.created_at == cursor_time, JobRow.id < cursor),
+                    and_(JobRow.created_at == cursor_time, JobRow.id < cursor_id),
                 )
             )
-        stmt = stmt.limit(limit)
+        return stmt.limit(limit)
+
+    async def list(  # noqa: A003
+        self,
+        state: str | None = None,
+        limit: int = 50,
+        cursor: str | None = None,
+        include_archived: bool | None = None,
+    ) -> list[Job]:
+        """List jobs, optionally filtered by state, with cursor-based pagination.
+
+        Args:
+            include_archived: None = all jobs, False = exclude archived, True = only archived.
+        """
+        stmt = self._listing(select(JobRow), state, cursor, include_archived, limit)
         result = await self._session.execute(stmt)
         return [self._to_domain(row) for row in result.scalars().all()]
 
+    async def list_summaries(
+        self,
+        state: str | None = None,
+        limit: int = 50,
+        cursor: str | None = None,
+        include_archived: bool | None = None,
+    ) -> builtins.list[JobSummary]:
+        """Like :meth:`list`, reading only the columns a listing shows — no prompt texts."""
+        stmt = self._listing(select(*_SUMMARY_COLUMNS), state, cursor, include_archived, limit)
+        result = await self._session.execute(stmt)
+        return [
+            JobSummary(
+                id=row.id,
+                repo=row.repo,
+                state=_safe_job_state(row.state),
+                base_ref=row.base_ref,
+                branch=row.branch,
+                worktree_path=row.worktree_path,
+                created_at=row.created_at,
+                updated_at=row.updated_at,
+                completed_at=row.completed_at,
+                pr_url=row.pr_url,
+                merge_status=row.merge_status,
+                resolution=Resolution(row.resolution) if row.resolution else None,
+                archived_at=row.archived_at,
+                title=row.title,
+                worktree_name=row.worktree_name,
+                permission_mode=PermissionMode(row.permission_mode or "full_auto"),
+                model=row.model,
+                sdk=row.sdk or "copilot",
+                failure_reason=row.failure_reason,
+                parent_job_id=row.parent_job_id,
+                prompt_preview=row.prompt_preview or "",
+            )
+            for row in result.all()
+        ]
+
+    async def count(self, state: str | None = None) -> int:
+        """Number of jobs, optionally in one of the comma-separated *state* values."""
+        stmt = select(func.count()).select_from(JobRow)
+        if state is not None:
+            stmt = stmt.where(JobRow.state.in_([s.strip() for s in state.split(",")]))
+        return int((await self._session.execute(stmt)).scalar_one())
+
     async def update_state(
         self,
         job_id: str,
@@ -176,6 +280,7 @@ class JobRepository(BaseRepository):
         if failure_reason is not None:
             updates["failure_reason"] = failure_reason
         await self._update_row(job_id, **updates)
+        await AnalyticsRollupRepo(self._session).refresh_job(job_id)
 
     async def update_pr_url(self, job_id: str, pr_url: str) -> None:
         """Store the PR URL on a job row."""
@@ -211,6 +316,7 @@ class JobRepository(BaseRepository):
             pr_url=None,
             updated_at=datetime.now(UTC),
         )
+        await AnalyticsRollupRepo(self._session).refresh_job(job_id)
 
     async def reset_for_recovery(
         self,
@@ -260,6 +366,7 @@ class JobRepository(BaseRepository):
             pr_url=pr_url,
             updated_at=datetime.now(UTC),
         )
+        await AnalyticsRollupRepo(self._session).refresh_job(job_id)
 
     async def update_worktree_path(self, job_id: str, worktree_path: str) -> None:
         """Update the worktree path (e.g. after re-creating a cleaned-up worktree)."""
@@ -271,6 +378,7 @@ class JobRepository(BaseRepository):
         if pr_url is not None:
             updates["pr_url"] = pr_url
         await self._update_row(job_id, **updates)
+        await AnalyticsRollupRepo(self._session).refresh_job(job_id)
 
     async def update_archived_at(self, job_id: str, archived_at: datetime | None) -> None:
         """Set or clear the archived_at timestamp."""
@@ -280,37 +388,45 @@ class JobRepository(BaseRepository):
         """Persist or clear the Copilot SDK session ID for future resumption."""
         await self._update_row(job_id, sdk_session_id=sdk_session_id)
 
-    async def claim_for_start(self, job_id: str) -> bool:
+    async def claim_for_start(self, job_id: str, *, honor_leases: bool = True) -> bool:
         """Atomically claim a job for execution using a DB-level compare-and-swap.
 
-        Sets state to 'running' only if the current state allows starting.
-        Returns True if this call won the race, False if another caller
+        Sets state to 'running' and takes the job's lease only if the current
+        state allows starting and no other live server process holds the
+        lease (a queued job is never leased, so exactly one process dequeues
+        it).  Returns True if this call won the race, False if another caller
         already claimed the job.
         """
-        from datetime import UTC, datetime
+        from datetime import UTC, datetime, timedelta
 
         from sqlalchemy import update
 
+        now = datetime.now(UTC)
+        conditions = [
+            JobRow.id == job_id,
+            JobRow.state.in_(
+                [
+                    JobState.queued,
+                    JobState.running,
+                    # Active review state allowed for resume
+                    JobState.review,
+                    # Terminal states allowed for resume
+                    JobState.completed,
+                    JobState.failed,
+                    JobState.canceled,
+                ]
+            ),
+        ]
+        if honor_leases:
+            conditions.append(or_(JobRow.state == JobState.queued, self._lease_free(now)))
         stmt = (
             update(JobRow)
-            .where(
-                JobRow.id == job_id,
-                JobRow.state.in_(
-                    [
-                        JobState.queued,
-                        JobState.running,
-                        # Active review state allowed for resume
-                        JobState.review,
-                        # Terminal states allowed for resume
-                        JobState.completed,
-                        JobState.failed,
-                        JobState.canceled,
-                    ]
-                ),
-            )
+            .where(*conditions)
             .values(
                 state=JobState.running,
-                updated_at=datetime.now(UTC),
+                owner=PROCESS_ORIGIN,
+                lease_expires_at=now + timedelta(seconds=LEASE_TTL_S),
+                updated_at=now,
                 version=JobRow.version + 1,
             )
         )
@@ -318,6 +434,93 @@ class JobRepository(BaseRepository):
         await self._session.flush()
         return int(result.rowcount) > 0  # type: ignore[attr-defined]
 
+    @staticmethod
+    def _lease_free(now: datetime) -> Any:
+        """Rows no other live process holds: unowned, ours, or with a lapsed lease."""
+        return or_(
+            JobRow.owner.is_(None),
+            JobRow.owner == PROCESS_ORIGIN,
+            JobRow.lease_expires_at.is_(None),
+            JobRow.lease_expires_at < now,
+        )
+
+    async def claim_lease(self, job_id: str, *, honor_leases: bool = True) -> bool:
+        """Take over an active (running / waiting_for_approval) job for recovery.
+
+        Returns False when the job is not active or another live server
+        process holds its lease.
+        """
+        from datetime import UTC, datetime, timedelta
+
+        from sqlalchemy import update
+
+        now = datetime.now(UTC)
+        conditions = [JobRow.id == job_id, JobRow.state.in_(_ACTIVE_STATES)]
+        if honor_leases:
+            conditions.append(self._lease_free(now))
+        result = await self._session.execute(
+            update(JobRow)
+            .where(*conditions)
+            .values(owner=PROCESS_ORIGIN, lease_expires_at=now + timedelta(seconds=LEASE_TTL_S))
+        )
+        await self._session.flush()
+        return int(result.rowcount) > 0  # type: ignore[attr-defined]
+
+    async def renew_leases(self, job_ids: builtins.list[str]) -> None:
+        """Extend this process's leases on *job_ids*."""
+        from datetime import UTC, datetime, timedelta
+
+        from sqlalchemy import update
+
+        if not job_ids:
+            return
+        await self._session.execute(
+            update(JobRow)
+            .where(JobRow.id.in_(job_ids), JobRow.owner == PROCESS_ORIGIN)
+            .values(lease_expires_at=datetime.now(UTC) + timedelta(seconds=LEASE_TTL_S))
+        )
+        await self._session.flush()
+
+    async def release_leases(self, job_ids: builtins.list[str]) -> None:
+        """Give up this process's leases on *job_ids* so any process may pick them up."""
+        from sqlalchemy import update
+
+        if not job_ids:
+            return
+        await self._session.execute(
+            update(JobRow)
+            .where(JobRow.id.in_(job_ids), JobRow.owner == PROCESS_ORIGIN)
+            .values(owner=None, lease_expires_at=None)
+        )
+        await self._session.flush()
+
+    async def lease_holder(self, job_id: str) -> str | None:
+        """The server process holding a live lease on the job, or None."""
+        from datetime import UTC, datetime
+
+        result = await self._session.execute(
+            select(JobRow.owner).where(JobRow.id == job_id, JobRow.lease_expires_at >= datetime.now(UTC))
+        )
+        return result.scalar_one_or_none()
+
+    async def list_unleased_active(self) -> builtins.list[Job]:
+        """Active jobs that no live server process holds — orphans of a stopped process."""
+        from datetime import UTC, datetime
+
+        result = await self._session.execute(
+            select(JobRow)
+            .where(JobRow.state.in_(_ACTIVE_STATES), self._lease_free(datetime.now(UTC)))
+            .order_by(JobRow.created_at, JobRow.id)
+        )
+        return [self._to_domain(row) for row in result.scalars().all()]
+
+    async def states_of(self, job_ids: builtins.list[str]) -> dict[str, JobState]:
+        """Current state of each of *job_ids* that exists."""
+        if not job_ids:
+            return {}
+        result = await self._session.execute(select(JobRow.id, JobRow.state).where(JobRow.id.in_(job_ids)))
+        return {row.id: _safe_job_state(row.state) for row in result}
+
     async def update_title_and_branch(self, job_id: str, title: str | None = None, branch: str | None = None) -> None:
         """Update the title and/or branch of a job (used by async naming)."""
         updates: dict[str, Any] = {}
@@ -8,6 +8,7 @@ from typing import Any
 
 from sqlalchemy import text
 
+from backend.persistence.dialect import load_json
 from backend.persistence.repository import BaseRepository
 
 
@@ -69,7 +70,7 @@ class ObservationsRepo(BaseRepository):
                          job_count, total_waste_usd, first_seen_at, last_seen_at, dismissed)
                     VALUES
                         (:category, :severity, :title, :detail, :evidence_json,
-                         :job_count, :total_waste_usd, :now, :now, 0)
+                         :job_count, :total_waste_usd, :now, :now, FALSE)
                 """),
                 {
                     "category": category,
@@ -92,7 +93,7 @@ class ObservationsRepo(BaseRepository):
         limit: int = 50,
     ) -> list[dict[str, Any]]:
         """List non-dismissed observations, most severe first."""
-        conditions = ["dismissed = 0"]
+        conditions = ["dismissed = FALSE"]
         params: dict[str, Any] = {"limit": limit}
         if category:
             conditions.append("category = :category")
@@ -118,14 +119,14 @@ class ObservationsRepo(BaseRepository):
         rows = []
         for r in result.mappings().all():
             row = dict(r)
-            row["evidence"] = json.loads(row.pop("evidence_json", "{}"))
+            row["evidence"] = load_json(row.pop("evidence_json", None), {})
             rows.append(row)
         return rows
 
     async def dismiss(self, observation_id: int) -> None:
         """Mark an observation as dismissed."""
         await self._session.execute(
-            text("UPDATE cost_observations SET dismissed = 1 WHERE id = :id"),
+            text("UPDATE cost_observations SET dismissed = TRUE WHERE id = :id"),
             {"id": observation_id},
         )
         await self._session.flush()
@@ -4,6 +4,8 @@ from __future__ import annotations
 
 from typing import TYPE_CHECKING
 
+from backend.persistence.dialect import dialect_of
+
 if TYPE_CHECKING:
     from sqlalchemy.ext.asyncio import AsyncSession
 
@@ -13,3 +15,8 @@ class BaseRepository:
 
     def __init__(self, session: AsyncSession) -> None:
         self._session = session
+
+    @property
+    def _dialect(self) -> str:
+        """Dialect name of the bound engine, for :mod:`backend.persistence.dialect` fragments."""
+        return dialect_of(self._session)
@@ -0,0 +1,92 @@
+"""Background SQLite upkeep: WAL checkpoints, ``PRAGMA optimize`` and WAL size monitoring.
+
+SQLite's automatic checkpoint runs inside whichever commit crosses the
+1000-page threshold, so a writer occasionally pays for it.  Running a
+PASSIVE checkpoint on a timer keeps the WAL short without blocking anyone:
+it copies what it can and stops at pages still needed by open readers.  A
+WAL that keeps growing means a reader is pinning an old snapshot — that is
+logged rather than forced, since a blocking checkpoint would stall writers.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import time
+from pathlib import Path
+from typing import TYPE_CHECKING
+
+import structlog
+from sqlalchemy import text
+
+if TYPE_CHECKING:
+    from sqlalchemy.ext.asyncio import AsyncEngine
+
+    from backend.config import DatabaseConfig
+
+log = structlog.get_logger()
+
+
+class SqliteMaintenance:
+    """Periodic checkpoint / optimize loop for the file-backed database."""
+
+    def __init__(self, engine: AsyncEngine, db_path: Path, config: DatabaseConfig) -> None:
+        self._engine = engine
+        self._wal_path = Path(f"{db_path}-wal")
+        self._config = config
+        self._wal_warned = False
+
+    @property
+    def wal_bytes(self) -> int:
+        """Current size of the ``-wal`` file (0 when absent)."""
+        try:
+            return self._wal_path.stat().st_size
+        except OSError:
+            return 0
+
+    async def checkpoint(self) -> tuple[int, int, int]:
+        """Run ``wal_checkpoint(PASSIVE)``; returns ``(busy, wal_frames, checkpointed_frames)``."""
+        async with self._engine.connect() as conn:
+            row = (await conn.execute(text("PRAGMA wal_checkpoint(PASSIVE)"))).one()
+        return int(row[0]), int(row[1]), int(row[2])
+
+    async def optimize(self, *, on_open: bool = False) -> None:
+        """Run ``PRAGMA optimize`` (the 0x10002 variant on first open, per the SQLite docs)."""
+        pragma = "PRAGMA optimize=0x10002" if on_open else "PRAGMA optimize"
+        async with self._engine.connect() as conn:
+            await conn.execute(text(pragma))
+            await conn.commit()
+
+    async def run_once(self) -> None:
+        """One checkpoint pass plus the WAL size check."""
+        busy, frames, done = await self.checkpoint()
+        wal_bytes = self.wal_bytes
+        log.debug("sqlite_wal_checkpoint", busy=busy, wal_frames=frames, checkpointed=done, wal_bytes=wal_bytes)
+        limit = self._config.wal_warn_mb * 1024 * 1024
+        if limit and wal_bytes > limit:
+            if not self._wal_warned:
+                log.warning(
+                    "sqlite_wal_oversized",
+                    wal_mb=round(wal_bytes / 1024 / 1024, 1),
+                    wal_frames=frames,
+                    checkpointed=done,
+                )
+            self._wal_warned = True
+        else:
+            self._wal_warned = False
+
+    async def loop(self) -> None:
+        """Run forever; designed to be launched as a background task."""
+        try:
+            await self.optimize(on_open=True)
+        except Exception:
+            log.warning("sqlite_optimize_failed", exc_info=True)
+        last_optimize = time.monotonic()
+        while True:
+            await asyncio.sleep(self._config.checkpoint_interval_s)
+            try:
+                await self.run_once()
+                if time.monotonic() - last_optimize >= self._config.optimize_interval_s:
+                    await self.optimize()
+                    last_optimize = time.monotonic()
+            except Exception:
+                log.warning("sqlite_maintenance_failed", exc_info=True)
@@ -11,11 +11,18 @@ import json
 from datetime import UTC, datetime
 from typing import Any
 
-from sqlalchemy import text
+from sqlalchemy import bindparam, text
 
+from backend.persistence.analytics_rollup_repo import AnalyticsRollupRepo, rollup_window
+from backend.persistence.dialect import json_number, load_json
 from backend.persistence.repository import BaseRepository
 
 
+def _tool_failed(success: Any) -> bool:
+    """Mirror of ``dialect.json_is_false``: ``false``, ``0`` and ``"false"`` all mark a failure."""
+    return success is False or success == 0 or success == "false"
+
+
 class TelemetrySpansRepo(BaseRepository):
     """Append-only insert of individual LLM/tool call spans."""
 
@@ -62,6 +69,7 @@ class TelemetrySpansRepo(BaseRepository):
                      :input_tokens, :output_tokens, :cache_read_tokens, :cache_write_tokens,
                      :cost_usd, :tool_args_json, :result_size_bytes, :error_kind,
                      :now)
+                RETURNING id
             """),
             {
                 "job_id": job_id,
@@ -87,9 +95,16 @@ class TelemetrySpansRepo(BaseRepository):
                 "now": now,
             },
         )
+        inserted_id = result.scalar_one()
         await self._session.flush()
-        inserted_id = getattr(result, "lastrowid", None)
-        return int(inserted_id or 0)
+        if span_type == "tool":
+            await AnalyticsRollupRepo(self._session).record_tool_call(
+                name=name,
+                duration_ms=duration_ms,
+                failed=_tool_failed((attrs or {}).get("success")),
+                created_at=now,
+            )
+        return int(inserted_id)
 
     async def list_for_job(self, job_id: str) -> list[dict[str, Any]]:
         """Return all spans for a job, ordered by start time."""
@@ -110,29 +125,67 @@ class TelemetrySpansRepo(BaseRepository):
         rows = []
         for r in result.mappings().all():
             row = dict(r)
-            row["attrs"] = json.loads(row.pop("attrs_json", "{}"))
+            row["attrs"] = load_json(row.pop("attrs_json", None), {})
             if row.get("is_retry") is not None:
                 row["is_retry"] = bool(row["is_retry"])
             rows.append(row)
         return rows
 
-    async def tool_stats(self, *, period_days: int = 30) -> list[dict[str, Any]]:
-        """Aggregate tool performance stats for analytics."""
+    async def job_ids_with_spans(self) -> list[str]:
+        """Return every job id that has at least one span, in id order."""
+        result = await self._session.execute(
+            text("SELECT DISTINCT job_id FROM job_telemetry_spans ORDER BY job_id"),
+        )
+        return [str(r[0]) for r in result.all()]
+
+    async def attribution_columns(self, job_ids: list[str]) -> list[tuple[Any, ...]]:
+        """Return the span fields cost attribution needs for many jobs at once.
+
+        Rows are ``(job_id, span_type, name, turn_number, execution_phase,
+        cost_usd, input_tokens, output_tokens)``, grouped by job and ordered
+        by start time within each job.  Cost and token columns fall back to
+        the legacy ``attrs_json`` values the same way the per-job path does.
+        """
+        if not job_ids:
+            return []
+        d = self._dialect
         result = await self._session.execute(
             text(f"""
                 SELECT
-                    name,
-                    COUNT(*) as count,
-                    AVG(duration_ms) as avg_duration_ms,
-                    SUM(duration_ms) as total_duration_ms,
-                    SUM(CASE WHEN json_extract(attrs_json, '$.success') = 0
-                             OR json_extract(attrs_json, '$.success') = 'false'
-                        THEN 1 ELSE 0 END) as failure_count
+                    job_id,
+                    span_type,
+                    COALESCE(name, '') AS name,
+                    turn_number,
+                    COALESCE(execution_phase, '') AS execution_phase,
+                    COALESCE(NULLIF(cost_usd, 0), {json_number("attrs_json", "cost", d)}, 0) AS cost_usd,
+                    COALESCE(NULLIF(input_tokens, 0), {json_number("attrs_json", "input_tokens", d)}, 0)
+                        AS input_tokens,
+                    COALESCE(NULLIF(output_tokens, 0), {json_number("attrs_json", "output_tokens", d)}, 0)
+                        AS output_tokens
                 FROM job_telemetry_spans
-                WHERE span_type = 'tool'
-                    AND created_at >= datetime('now', '-{int(period_days)} days')
-                GROUP BY name
+                WHERE job_id IN :job_ids
+                ORDER BY job_id, started_at, id
+            """).bindparams(bindparam("job_ids", expanding=True)),  # noqa: S608
+            {"job_ids": job_ids},
+        )
+        return [tuple(r) for r in result.all()]
+
+    async def tool_stats(self, *, period_days: int = 30) -> list[dict[str, Any]]:
+        """Aggregate tool performance stats for analytics (served from tool rollups)."""
+        granularity, floor = rollup_window(period_days, self._dialect)
+        result = await self._session.execute(
+            text(f"""
+                SELECT
+                    tool as name,
+                    SUM(call_count) as count,
+                    SUM(total_duration_ms) * 1.0 / NULLIF(SUM(call_count), 0) as avg_duration_ms,
+                    SUM(total_duration_ms) as total_duration_ms,
+                    SUM(failure_count) as failure_count
+                FROM analytics_tool_rollups
+                WHERE granularity = :granularity AND bucket >= {floor}
+                GROUP BY tool
                 ORDER BY count DESC
-            """),
+            """),  # noqa: S608
+            {"granularity": granularity},
         )
         return [dict(r) for r in result.mappings().all()]
@@ -2,6 +2,10 @@
 
 Each adapter ``record_*()`` call triggers an atomic upsert so the row is
 always up-to-date.  No timers, no flush intervals.
+
+Cross-job analytics queries read from the rollup tables maintained by
+:class:`AnalyticsRollupRepo`; the job's rollup contribution is refreshed when
+the job starts, finalizes, and when post-job stats are written.
 """
 
 from __future__ import annotations
@@ -11,8 +15,24 @@ from typing import Any
 
 from sqlalchemy import text
 
+from backend.persistence.analytics_rollup_repo import AnalyticsRollupRepo, rollup_window
+from backend.persistence.dialect import day_days_ago, now_minus_days
 from backend.persistence.repository import BaseRepository
 
+_SET_TURN_STATS_SQL = """
+    UPDATE job_telemetry_summary SET
+        unique_files_read   = :unique_files_read,
+        file_reread_count   = :file_reread_count,
+        peak_turn_cost_usd  = :peak_turn_cost_usd,
+        avg_turn_cost_usd   = :avg_turn_cost_usd,
+        cost_first_half_usd = :cost_first_half_usd,
+        cost_second_half_usd= :cost_second_half_usd,
+        diff_lines_added    = :diff_lines_added,
+        diff_lines_removed  = :diff_lines_removed,
+        updated_at          = :now
+    WHERE job_id = :job_id
+"""
+
 
 class TelemetrySummaryRepo(BaseRepository):
     """Event-driven upserts into ``job_telemetry_summary``."""
@@ -59,6 +79,7 @@ class TelemetrySummaryRepo(BaseRepository):
             {"job_id": job_id, "sdk": sdk, "model": model, "repo": repo, "branch": branch, "now": now},
         )
         await self._session.flush()
+        await AnalyticsRollupRepo(self._session).refresh_job(job_id)
 
     async def increment(
         self,
@@ -209,6 +230,7 @@ class TelemetrySummaryRepo(BaseRepository):
             {"job_id": job_id, "status": status, "duration_ms": duration_ms, "now": now},
         )
         await self._session.flush()
+        await AnalyticsRollupRepo(self._session).refresh_job(job_id)
 
     async def set_turn_stats(
         self,
@@ -226,19 +248,7 @@ class TelemetrySummaryRepo(BaseRepository):
         """Set computed turn economics stats (called by post-job attribution)."""
         now = datetime.now(UTC).isoformat()
         await self._session.execute(
-            text("""
-                UPDATE job_telemetry_summary SET
-                    unique_files_read   = :unique_files_read,
-                    file_reread_count   = :file_reread_count,
-                    peak_turn_cost_usd  = :peak_turn_cost_usd,
-                    avg_turn_cost_usd   = :avg_turn_cost_usd,
-                    cost_first_half_usd = :cost_first_half_usd,
-                    cost_second_half_usd= :cost_second_half_usd,
-                    diff_lines_added    = :diff_lines_added,
-                    diff_lines_removed  = :diff_lines_removed,
-                    updated_at          = :now
-                WHERE job_id = :job_id
-            """),
+            text(_SET_TURN_STATS_SQL),
             {
                 "job_id": job_id,
                 "unique_files_read": unique_files_read,
@@ -253,6 +263,21 @@ class TelemetrySummaryRepo(BaseRepository):
             },
         )
         await self._session.flush()
+        await AnalyticsRollupRepo(self._session).refresh_job(job_id)
+
+    async def set_turn_stats_many(self, stats: list[dict[str, Any]]) -> None:
+        """Batch form of :meth:`set_turn_stats`: one executemany for many jobs.
+
+        Each dict carries ``job_id`` plus the :meth:`set_turn_stats` keyword fields.
+        """
+        if not stats:
+            return
+        now = datetime.now(UTC).isoformat()
+        await self._session.execute(text(_SET_TURN_STATS_SQL), [{**row, "now": now} for row in stats])
+        await self._session.flush()
+        rollups = AnalyticsRollupRepo(self._session)
+        for row in stats:
+            await rollups.refresh_job(row["job_id"])
 
     async def get(self, job_id: str) -> dict[str, Any] | None:
         """Load summary row as a plain dict.  Returns None if not found."""
@@ -265,6 +290,27 @@ class TelemetrySummaryRepo(BaseRepository):
             return None
         return dict(row)
 
+    async def month_to_date(self, month_start: str) -> list[dict[str, Any]]:
+        """Per-sdk/repo spend of jobs created on or after *month_start* (``YYYY-MM-DD``).
+
+        Read straight from the summaries rather than the rollups so that jobs
+        still running (not yet finalized into the rollups) are included.
+        """
+        result = await self._session.execute(
+            text("""
+                SELECT sdk, repo,
+                       SUM(total_cost_usd) AS cost_usd,
+                       SUM(input_tokens) AS input_tokens,
+                       SUM(output_tokens) AS output_tokens,
+                       SUM(premium_requests) AS premium_requests
+                FROM job_telemetry_summary
+                WHERE created_at >= :month_start
+                GROUP BY sdk, repo
+            """),
+            {"month_start": month_start},
+        )
+        return [dict(r) for r in result.mappings().all()]
+
     async def query(
         self,
         *,
@@ -282,7 +328,7 @@ class TelemetrySummaryRepo(BaseRepository):
         conditions: list[str] = []
         params: dict[str, Any] = {"limit": limit, "offset": offset}
         if period_days is not None:
-            conditions.append(f"created_at >= datetime('now', '-{int(period_days)} days')")
+            conditions.append(f"created_at >= {now_minus_days(period_days, self._dialect)}")
         if sdk:
             conditions.append("sdk = :sdk")
             params["sdk"] = sdk
@@ -312,28 +358,30 @@ class TelemetrySummaryRepo(BaseRepository):
 
     async def aggregate(self, *, period_days: int = 7) -> dict[str, Any]:
         """Return aggregate stats for the analytics overview."""
+        granularity, floor = rollup_window(period_days, self._dialect)
         result = await self._session.execute(
             text(f"""
                 SELECT
-                    COUNT(*) as total_jobs,
-                    SUM(CASE WHEN status = 'review' THEN 1 ELSE 0 END) as review,
-                    SUM(CASE WHEN status = 'completed' THEN 1 ELSE 0 END) as completed,
-                    SUM(CASE WHEN status IN ('review', 'completed') THEN 1 ELSE 0 END) as succeeded,
-                    SUM(CASE WHEN status = 'failed' THEN 1 ELSE 0 END) as failed,
-                    SUM(CASE WHEN status = 'cancelled' THEN 1 ELSE 0 END) as cancelled,
-                    SUM(CASE WHEN status = 'running' THEN 1 ELSE 0 END) as running,
+                    COALESCE(SUM(job_count), 0) as total_jobs,
+                    SUM(review_count) as review,
+                    SUM(completed_count) as completed,
+                    SUM(review_count + completed_count) as succeeded,
+                    SUM(failed_count) as failed,
+                    SUM(cancelled_count) as cancelled,
+                    SUM(running_count) as running,
                     COALESCE(SUM(total_cost_usd), 0) as total_cost_usd,
                     COALESCE(SUM(input_tokens + output_tokens), 0) as total_tokens,
-                    COALESCE(AVG(duration_ms), 0) as avg_duration_ms,
+                    COALESCE(SUM(duration_ms) * 1.0 / NULLIF(SUM(job_count), 0), 0) as avg_duration_ms,
                     COALESCE(SUM(premium_requests), 0) as total_premium_requests,
                     COALESCE(SUM(tool_call_count), 0) as total_tool_calls,
                     COALESCE(SUM(tool_failure_count), 0) as total_tool_failures,
                     COALESCE(SUM(agent_error_count), 0) as total_agent_errors,
                     COALESCE(SUM(cache_read_tokens), 0) as total_cache_read,
                     COALESCE(SUM(input_tokens), 0) as total_input_tokens
-                FROM job_telemetry_summary
-                WHERE created_at >= datetime('now', '-{int(period_days)} days')
-            """),
+                FROM analytics_rollups
+                WHERE granularity = :granularity AND bucket >= {floor}
+            """),  # noqa: S608
+            {"granularity": granularity},
         )
         row = result.mappings().first()
         return dict(row) if row else {}
@@ -343,60 +391,65 @@ class TelemetrySummaryRepo(BaseRepository):
         result = await self._session.execute(
             text(f"""
                 SELECT
-                    date(created_at) as date,
+                    bucket as date,
                     COALESCE(SUM(total_cost_usd), 0) as cost,
-                    COUNT(*) as jobs
-                FROM job_telemetry_summary
-                WHERE created_at >= datetime('now', '-{int(period_days)} days')
-                GROUP BY date(created_at)
-                ORDER BY date(created_at)
-            """),
+                    SUM(job_count) as jobs
+                FROM analytics_rollups
+                WHERE granularity = 'day' AND bucket >= {day_days_ago(period_days, self._dialect)}
+                GROUP BY bucket
+                HAVING SUM(job_count) > 0
+                ORDER BY bucket
+            """),  # noqa: S608
         )
         return [dict(r) for r in result.mappings().all()]
 
     async def cost_by_repo(self, *, period_days: int = 7) -> list[dict[str, Any]]:
         """Return per-repo cost / job count / token breakdown."""
+        granularity, floor = rollup_window(period_days, self._dialect)
         result = await self._session.execute(
             text(f"""
                 SELECT
                     repo,
-                    COUNT(*) as job_count,
-                    SUM(CASE WHEN status IN ('review', 'completed') THEN 1 ELSE 0 END) as succeeded,
-                    SUM(CASE WHEN status = 'failed' THEN 1 ELSE 0 END) as failed,
+                    SUM(job_count) as job_count,
+                    SUM(review_count + completed_count) as succeeded,
+                    SUM(failed_count) as failed,
                     COALESCE(SUM(total_cost_usd), 0) as total_cost_usd,
                     COALESCE(SUM(input_tokens + output_tokens), 0) as total_tokens,
                     COALESCE(SUM(tool_call_count), 0) as tool_calls,
-                    COALESCE(AVG(duration_ms), 0) as avg_duration_ms,
+                    COALESCE(SUM(duration_ms) * 1.0 / NULLIF(SUM(job_count), 0), 0) as avg_duration_ms,
                     COALESCE(SUM(premium_requests), 0) as premium_requests
-                FROM job_telemetry_summary
-                WHERE created_at >= datetime('now', '-{int(period_days)} days')
+                FROM analytics_rollups
+                WHERE granularity = :granularity AND bucket >= {floor}
                 GROUP BY repo
+                HAVING SUM(job_count) > 0
                 ORDER BY total_cost_usd DESC
-            """),
+            """),  # noqa: S608
+            {"granularity": granularity},
         )
         return [dict(r) for r in result.mappings().all()]
 
     async def cost_by_model(self, *, period_days: int = 7) -> list[dict[str, Any]]:
         """Return per-model cost / job count / token breakdown with normalized metrics."""
+        granularity, floor = rollup_window(period_days, self._dialect)
         result = await self._session.execute(
             text(f"""
                 SELECT
                     model,
                     sdk,
-                    COUNT(*) as job_count,
+                    SUM(job_count) as job_count,
                     COALESCE(SUM(total_cost_usd), 0) as total_cost_usd,
                     COALESCE(SUM(input_tokens + output_tokens), 0) as total_tokens,
                     COALESCE(SUM(input_tokens), 0) as input_tokens,
                     COALESCE(SUM(output_tokens), 0) as output_tokens,
                     COALESCE(SUM(cache_read_tokens), 0) as cache_read_tokens,
-                    COALESCE(AVG(duration_ms), 0) as avg_duration_ms,
+                    COALESCE(SUM(duration_ms) * 1.0 / NULLIF(SUM(job_count), 0), 0) as avg_duration_ms,
                     COALESCE(SUM(premium_requests), 0) as premium_requests,
                     COALESCE(SUM(total_turns), 0) as total_turns,
                     COALESCE(SUM(tool_call_count), 0) as total_tool_calls,
-                    COALESCE(SUM(diff_lines_added + diff_lines_removed), 0) as total_diff_lines,
+                    COALESCE(SUM(diff_lines), 0) as total_diff_lines,
                     -- Normalized metrics
-                    CASE WHEN COUNT(*) > 0
-                        THEN COALESCE(SUM(total_cost_usd), 0) / COUNT(*)
+                    CASE WHEN SUM(job_count) > 0
+                        THEN COALESCE(SUM(total_cost_usd), 0) / SUM(job_count)
                         ELSE 0 END as cost_per_job,
                     CASE WHEN SUM(duration_ms) > 0
                         THEN COALESCE(SUM(total_cost_usd), 0) / (SUM(duration_ms) / 60000.0)
@@ -407,8 +460,8 @@ class TelemetrySummaryRepo(BaseRepository):
                     CASE WHEN SUM(tool_call_count) > 0
                         THEN COALESCE(SUM(total_cost_usd), 0) / SUM(tool_call_count)
                         ELSE 0 END as cost_per_tool_call,
-                    CASE WHEN SUM(diff_lines_added + diff_lines_removed) > 0
-                        THEN COALESCE(SUM(total_cost_usd), 0) / SUM(diff_lines_added + diff_lines_removed)
+                    CASE WHEN SUM(diff_lines) > 0
+                        THEN COALESCE(SUM(total_cost_usd), 0) / SUM(diff_lines)
                         ELSE 0 END as cost_per_diff_line,
                     CASE WHEN SUM(input_tokens + output_tokens) > 0
                         THEN COALESCE(SUM(total_cost_usd), 0) / (SUM(input_tokens + output_tokens) / 1000000.0)
@@ -416,12 +469,14 @@ class TelemetrySummaryRepo(BaseRepository):
                     CASE WHEN SUM(total_cost_usd) > 0
                         THEN COALESCE(SUM(cache_read_tokens), 0) * 1.0 / NULLIF(SUM(input_tokens), 0)
                         ELSE 0 END as cache_hit_rate
-                FROM job_telemetry_summary
-                WHERE created_at >= datetime('now', '-{int(period_days)} days')
+                FROM analytics_rollups
+                WHERE granularity = :granularity AND bucket >= {floor}
                     AND model != ''
                 GROUP BY model, sdk
+                HAVING SUM(job_count) > 0
                 ORDER BY total_cost_usd DESC
-            """),
+            """),  # noqa: S608
+            {"granularity": granularity},
         )
         return [dict(r) for r in result.mappings().all()]
 
@@ -432,7 +487,8 @@ class TelemetrySummaryRepo(BaseRepository):
     async def scorecard(self, *, period_days: int = 7) -> dict[str, Any]:
         """Budget per SDK, activity with resolution, quota, cost trend.
 
-        Joins ``jobs`` table for resolution data that telemetry_summary lacks.
+        Activity reflects live job state so it is read from ``jobs``; budget
+        and cost trend come from the rollups.
         """
         activity = await self._session.execute(
             text(f"""
@@ -446,24 +502,27 @@ class TelemetrySummaryRepo(BaseRepository):
                     SUM(CASE WHEN j.state = 'failed' THEN 1 ELSE 0 END) as failed,
                     SUM(CASE WHEN j.state = 'canceled' THEN 1 ELSE 0 END) as cancelled
                 FROM jobs j
-                WHERE j.created_at >= datetime('now', '-{int(period_days)} days')
+                WHERE j.created_at >= {now_minus_days(period_days, self._dialect)}
             """),
         )
         activity_row = dict(activity.mappings().first() or {})
 
+        granularity, floor = rollup_window(period_days, self._dialect)
         budget = await self._session.execute(
             text(f"""
                 SELECT
-                    t.sdk,
-                    COALESCE(SUM(t.total_cost_usd), 0) as total_cost_usd,
-                    COALESCE(SUM(t.premium_requests), 0) as premium_requests,
-                    COUNT(*) as job_count,
-                    COALESCE(AVG(t.total_cost_usd), 0) as avg_cost_per_job,
-                    COALESCE(AVG(t.duration_ms), 0) as avg_duration_ms
-                FROM job_telemetry_summary t
-                WHERE t.created_at >= datetime('now', '-{int(period_days)} days')
-                GROUP BY t.sdk
-            """),
+                    sdk,
+                    COALESCE(SUM(total_cost_usd), 0) as total_cost_usd,
+                    COALESCE(SUM(premium_requests), 0) as premium_requests,
+                    SUM(job_count) as job_count,
+                    COALESCE(SUM(total_cost_usd) / NULLIF(SUM(job_count), 0), 0) as avg_cost_per_job,
+                    COALESCE(SUM(duration_ms) * 1.0 / NULLIF(SUM(job_count), 0), 0) as avg_duration_ms
+                FROM analytics_rollups
+                WHERE granularity = :granularity AND bucket >= {floor}
+                GROUP BY sdk
+                HAVING SUM(job_count) > 0
+            """),  # noqa: S608
+            {"granularity": granularity},
         )
         budget_rows = [dict(r) for r in budget.mappings().all()]
 
@@ -491,53 +550,58 @@ class TelemetrySummaryRepo(BaseRepository):
         }
 
     async def model_comparison(self, *, period_days: int = 30, repo: str | None = None) -> list[dict[str, Any]]:
-        """Per-model stats joined with resolution data from jobs table."""
+        """Per-model stats including resolution outcomes, read from the rollups.
+
+        ``failed`` counts jobs whose state is ``failed``, as it did before the
+        rollups, not jobs whose telemetry summary finished as failed.
+        """
+        granularity, floor = rollup_window(period_days, self._dialect)
         repo_filter = ""
-        params: dict[str, Any] = {}
+        params: dict[str, Any] = {"granularity": granularity}
         if repo:
-            repo_filter = "AND j.repo = :repo"
+            repo_filter = "AND repo = :repo"
             params["repo"] = repo
 
         result = await self._session.execute(
             text(f"""
                 SELECT
-                    t.model,
-                    t.sdk,
-                    COUNT(*) as job_count,
-                    COALESCE(AVG(t.total_cost_usd), 0) as avg_cost,
-                    COALESCE(AVG(t.duration_ms), 0) as avg_duration_ms,
-                    COALESCE(SUM(t.total_cost_usd), 0) as total_cost_usd,
-                    COALESCE(SUM(t.premium_requests), 0) as premium_requests,
-                    SUM(CASE WHEN j.resolution = 'merged' THEN 1 ELSE 0 END) as merged,
-                    SUM(CASE WHEN j.resolution = 'pr_created' THEN 1 ELSE 0 END) as pr_created,
-                    SUM(CASE WHEN j.resolution = 'discarded' THEN 1 ELSE 0 END) as discarded,
-                    SUM(CASE WHEN j.state = 'failed' THEN 1 ELSE 0 END) as failed,
-                    AVG(CASE WHEN j.verify = 1 THEN t.total_turns ELSE NULL END) as avg_verify_turns,
-                    SUM(CASE WHEN j.verify = 1 THEN 1 ELSE 0 END) as verify_job_count,
-                    COALESCE(AVG(t.diff_lines_added + t.diff_lines_removed), 0) as avg_diff_lines,
-                    CASE WHEN SUM(t.input_tokens) > 0
-                        THEN COALESCE(SUM(t.cache_read_tokens), 0) * 1.0 / SUM(t.input_tokens)
+                    model,
+                    sdk,
+                    SUM(job_count) as job_count,
+                    COALESCE(SUM(total_cost_usd) / NULLIF(SUM(job_count), 0), 0) as avg_cost,
+                    COALESCE(SUM(duration_ms) * 1.0 / NULLIF(SUM(job_count), 0), 0) as avg_duration_ms,
+                    COALESCE(SUM(total_cost_usd), 0) as total_cost_usd,
+                    COALESCE(SUM(premium_requests), 0) as premium_requests,
+                    SUM(merged_count) as merged,
+                    SUM(pr_created_count) as pr_created,
+                    SUM(discarded_count) as discarded,
+                    SUM(job_failed_count) as failed,
+                    SUM(verify_turns) * 1.0 / NULLIF(SUM(verify_job_count), 0) as avg_verify_turns,
+                    SUM(verify_job_count) as verify_job_count,
+                    COALESCE(SUM(diff_lines) * 1.0 / NULLIF(SUM(job_count), 0), 0) as avg_diff_lines,
+                    CASE WHEN SUM(input_tokens) > 0
+                        THEN COALESCE(SUM(cache_read_tokens), 0) * 1.0 / SUM(input_tokens)
                         ELSE 0 END as cache_hit_rate,
-                    CASE WHEN COUNT(*) > 0
-                        THEN COALESCE(SUM(t.total_cost_usd), 0) / COUNT(*)
+                    CASE WHEN SUM(job_count) > 0
+                        THEN COALESCE(SUM(total_cost_usd), 0) / SUM(job_count)
                         ELSE 0 END as cost_per_job,
-                    CASE WHEN SUM(t.duration_ms) > 0
-                        THEN COALESCE(SUM(t.total_cost_usd), 0) / (SUM(t.duration_ms) / 60000.0)
+                    CASE WHEN SUM(duration_ms) > 0
+                        THEN COALESCE(SUM(total_cost_usd), 0) / (SUM(duration_ms) / 60000.0)
                         ELSE 0 END as cost_per_minute,
-                    CASE WHEN SUM(t.total_turns) > 0
-                        THEN COALESCE(SUM(t.total_cost_usd), 0) / SUM(t.total_turns)
+                    CASE WHEN SUM(total_turns) > 0
+                        THEN COALESCE(SUM(total_cost_usd), 0) / SUM(total_turns)
                         ELSE 0 END as cost_per_turn,
-                    CASE WHEN SUM(t.tool_call_count) > 0
-                        THEN COALESCE(SUM(t.total_cost_usd), 0) / SUM(t.tool_call_count)
+                    CASE WHEN SUM(tool_call_count) > 0
+                        THEN COALESCE(SUM(total_cost_usd), 0) / SUM(tool_call_count)
                         ELSE 0 END as cost_per_tool_call
-                FROM job_telemetry_summary t
-                JOIN jobs j ON j.id = t.job_id
-                WHERE t.created_at >= datetime('now', '-{int(period_days)} days')
-                    AND t.model != ''
+                FROM analytics_rollups
+                WHERE granularity = :granularity AND bucket >= {floor}
+                    AND model != ''
                     {repo_filter}
-                GROUP BY t.model, t.sdk
-                ORDER BY COUNT(*) DESC
-            """),
+                GROUP BY model, sdk
+                HAVING SUM(job_count) > 0
+                ORDER BY SUM(job_count) DESC
+            """),  # noqa: S608
             params,
         )
         return [dict(r) for r in result.mappings().all()]
@@ -0,0 +1,146 @@
+"""Approval rules learned from operator decisions.
+
+In REVIEW_AND_APPROVE mode every non-read-only command waits for a human.
+Agents repeat the same commands, the same test or build invocation, many
+times across jobs.  Every operator decision on a command is counted per
+(repo, tool, exact command).  Once a command has ``min_approvals`` approvals
+and no rejection in that repo, new requests for it are approved instantly.
+
+Only shell commands are learned: requests from Claude's ``Bash`` tool and
+Copilot's ``shell`` permission kind.  Other tools are never learned, even when
+their input carries a ``command`` field.  For Copilot the command is
+``full_command_text``.  For Claude it is the ``command`` field of the tool
+input.  That input is stored as JSON cut to a fixed length.  A cut document no
+longer parses, and its prefix could stand for many different commands, so it
+is never learned.  The following are never learned or auto-approved either:
+
+* hard-gated commands (``git merge``/``pull``/``rebase``/``cherry-pick``,
+  ``git reset --hard``);
+* approvals flagged ``requires_explicit_approval``;
+* decisions made by a trust grant or over MCP, rather than by the operator.
+
+A single rejection disables the rule.  Revoking a rule zeroes its counters,
+so the command has to be learned again.
+"""
+
+from __future__ import annotations
+
+import json
+from datetime import UTC, datetime
+from typing import TYPE_CHECKING
+
+import structlog
+
+from backend.models.domain import ApprovalRule
+from backend.persistence.approval_rule_repo import ApprovalRuleRepository
+from backend.services.permission_policy import is_hard_gated
+
+if TYPE_CHECKING:
+    from sqlalchemy.ext.asyncio import AsyncSession, async_sessionmaker
+
+    from backend.config import ApprovalRulesConfig
+
+log = structlog.get_logger()
+
+
+# Claude tool name / Copilot permission kind of the requests that run a shell command
+CLAUDE_SHELL_TOOL = "Bash"
+COPILOT_SHELL_KIND = "shell"
+
+
+def action_key(tool: str | None, proposed_action: str | None) -> str | None:
+    """The exact command an approval is about, or None when it is not a shell command."""
+    if not proposed_action:
+        return None
+    if tool == COPILOT_SHELL_KIND:
+        return proposed_action.strip() or None
+    if tool != CLAUDE_SHELL_TOOL:
+        return None
+    try:
+        doc = json.loads(proposed_action)
+    except ValueError:
+        return None  # truncated: the command is not known exactly
+    command = doc.get("command") if isinstance(doc, dict) else None
+    return (command.strip() or None) if isinstance(command, str) else None
+
+
+class ApprovalRules:
+    """In-memory view of the learned allowlist, written through to the database."""
+
+    def __init__(self, session_factory: async_sessionmaker[AsyncSession], config: ApprovalRulesConfig) -> None:
+        self._session_factory = session_factory
+        self._enabled = config.enabled
+        self._min_approvals = max(1, config.min_approvals)
+        self._rules: dict[tuple[str, str, str], ApprovalRule] = {}
+
+    async def load(self) -> None:
+        async with self._session_factory() as session:
+            rules = await ApprovalRuleRepository(session).list_all()
+        self._rules = {(r.repo, r.tool, r.action): r for r in rules}
+        log.debug("approval_rules_loaded", rules=len(self._rules), active=sum(map(self.is_active, rules)))
+
+    def is_active(self, rule: ApprovalRule) -> bool:
+        return (
+            self._enabled
+            and rule.approvals >= self._min_approvals
+            and rule.rejections == 0
+            and not is_hard_gated(rule.action)
+        )
+
+    def match(self, repo: str, tool: str | None, proposed_action: str | None) -> ApprovalRule | None:
+        """The active rule that auto-approves *proposed_action* by *tool* in *repo*, if any."""
+        key = action_key(tool, proposed_action)
+        if tool is None or key is None:
+            return None
+        rule = self._rules.get((repo, tool, key))
+        return rule if rule is not None and self.is_active(rule) else None
+
+    async def record_decision(self, repo: str, tool: str | None, proposed_action: str | None, resolution: str) -> None:
+        """Count an operator decision towards (or against) a rule."""
+        key = action_key(tool, proposed_action)
+        if tool is None or key is None or is_hard_gated(key):
+            return
+        now = datetime.now(UTC)
+        approved = resolution == "approved"
+        async with self._session_factory() as session:
+            await ApprovalRuleRepository(session).record_decision(repo, tool, key, approved=approved, at=now)
+            await session.commit()
+        rule = self._rules.setdefault((repo, tool, key), ApprovalRule(repo=repo, tool=tool, action=key))
+        was_active = self.is_active(rule)
+        if approved:
+            rule.approvals += 1
+        else:
+            rule.rejections += 1
+        rule.last_decided_at = now
+        if self.is_active(rule) and not was_active:
+            log.info("approval_rule_learned", repo=repo, tool=tool, action=key[:200], approvals=rule.approvals)
+        elif was_active and not self.is_active(rule):
+            log.info("approval_rule_disabled", repo=repo, tool=tool, action=key[:200])
+
+    async def record_applied(self, rule: ApprovalRule) -> None:
+        now = datetime.now(UTC)
+        async with self._session_factory() as session:
+            await ApprovalRuleRepository(session).record_applied(rule.repo, rule.tool, rule.action, at=now)
+            await session.commit()
+        rule.auto_approved += 1
+        rule.last_applied_at = now
+
+    def list_rules(self, repo: str | None = None) -> list[ApprovalRule]:
+        """All counted commands, most approved first."""
+        rules = [r for r in self._rules.values() if repo is None or r.repo == repo]
+        return sorted(rules, key=lambda r: (r.repo, -r.approvals, r.tool, r.action))
+
+    async def revoke(self, repo: str, tool: str, action: str) -> bool:
+        """Stop auto-approving *action* by *tool* in *repo* until it is learned again."""
+        now = datetime.now(UTC)
+        async with self._session_factory() as session:
+            found = await ApprovalRuleRepository(session).revoke(repo, tool, action, at=now)
+            await session.commit()
+        rule = self._rules.get((repo, tool, action))
+        if rule is not None:
+            rule.approvals = 0
+            rule.rejections = 0
+            rule.revoked_at = now
+        if found:
+            log.info("approval_rule_revoked", repo=repo, tool=tool, action=action[:200])
+        return found
@@ -5,16 +5,20 @@ from __future__ import annotations
 import asyncio
 import uuid
 from datetime import UTC, datetime
-from typing import TYPE_CHECKING
+from typing import TYPE_CHECKING, cast
 
 import structlog
 
 from backend.models.domain import Approval
 
 if TYPE_CHECKING:
+    from collections.abc import Awaitable, Callable, Collection
+
     from sqlalchemy.ext.asyncio import AsyncSession, async_sessionmaker
 
+    from backend.models.domain import ApprovalRule
     from backend.persistence.approval_repo import ApprovalRepository
+    from backend.services.approval_rules import ApprovalRules
 
 log = structlog.get_logger()
 
@@ -33,10 +37,21 @@ class ApprovalService:
     Holds in-memory asyncio.Future objects keyed by approval_id so the
     runtime can await the operator's decision while the SDK blocks on
     its permission callback.
+
+    With *rules* set, requests matching a learned approval rule are resolved
+    as approved on creation; the runtime picks them up via
+    :meth:`pop_auto_resolution` instead of waiting for the operator.
     """
 
-    def __init__(self, session_factory: async_sessionmaker[AsyncSession]) -> None:
+    def __init__(
+        self,
+        session_factory: async_sessionmaker[AsyncSession],
+        rules: ApprovalRules | None = None,
+    ) -> None:
         self._session_factory = session_factory
+        self._rules = rules
+        # approval_id → rule that auto-approved it, until the runtime records it
+        self._auto_resolved: dict[str, ApprovalRule] = {}
         self._pending_futures: dict[str, asyncio.Future[str]] = {}
         self._approval_to_job: dict[str, str] = {}  # approval_id → job_id
         # approval_ids that require explicit operator approval and must not be
@@ -47,6 +62,9 @@ class ApprovalService:
         # operator must re-trust after a restart rather than having stale
         # blanket approvals persist across sessions.
         self._trusted_jobs: set[str] = set()
+        # With a shared database the waiting future may live in another
+        # server process; decisions are forwarded there (set by the lifespan).
+        self.forward_control: Callable[..., Awaitable[None]] | None = None
 
     def _make_repo(self, session: AsyncSession) -> ApprovalRepository:
         from backend.persistence.approval_repo import ApprovalRepository
@@ -59,6 +77,7 @@ class ApprovalService:
         description: str,
         proposed_action: str | None = None,
         *,
+        tool: str | None = None,
         requires_explicit_approval: bool = False,
     ) -> Approval:
         """Persist a new approval request and create an in-memory future for it.
@@ -67,6 +86,11 @@ class ApprovalService:
         auto-resolved by a blanket trust grant — the operator must explicitly
         click Approve for each occurrence.  Use this for hard-blocked operations
         such as ``git reset --hard``.
+
+        *tool* is the Claude tool name or Copilot permission kind asking.
+        Only shell requests (``Bash`` / ``shell``) are learned and matched.
+        Requests matching a learned approval rule are stored already approved
+        and their future is resolved before this returns.
         """
         approval_id = str(uuid.uuid4())
         now = datetime.now(UTC)
@@ -77,8 +101,17 @@ class ApprovalService:
             proposed_action=proposed_action,
             requested_at=now,
             requires_explicit_approval=requires_explicit_approval,
+            tool=tool,
         )
+        rule: ApprovalRule | None = None
         async with self._session_factory() as session:
+            if self._rules is not None and not requires_explicit_approval:
+                repo_path = await self._job_repo_path(session, job_id)
+                rule = self._rules.match(repo_path, tool, proposed_action) if repo_path else None
+            if rule is not None:
+                approval.resolution = "approved"
+                approval.resolved_at = now
+                approval.resolved_by = "rule"
             repo = self._make_repo(session)
             await repo.create(approval)
             await session.commit()
@@ -91,6 +124,19 @@ class ApprovalService:
         if requires_explicit_approval:
             self._explicit_approval_ids.add(approval_id)
 
+        if rule is not None and self._rules is not None:
+            future.set_result("approved")
+            self._auto_resolved[approval_id] = rule
+            await self._rules.record_applied(rule)
+            log.info(
+                "approval_auto_resolved",
+                approval_id=approval_id,
+                job_id=job_id,
+                repo=rule.repo,
+                approvals=rule.approvals,
+            )
+            return approval
+
         log.info(
             "approval_created",
             approval_id=approval_id,
@@ -99,27 +145,52 @@ class ApprovalService:
         )
         return approval
 
-    async def resolve(self, approval_id: str, resolution: str) -> Approval:
-        """Resolve an approval and unblock the waiting runtime future."""
+    async def _job_repo_path(self, session: AsyncSession, job_id: str) -> str | None:
+        from sqlalchemy import select
+
+        from backend.models.db import JobRow
+
+        repo_path = await session.scalar(select(JobRow.repo).where(JobRow.id == job_id))
+        return cast("str | None", repo_path)
+
+    async def resolve(self, approval_id: str, resolution: str, *, resolved_by: str = "operator") -> Approval:
+        """Resolve an approval and unblock the waiting runtime future.
+
+        *resolved_by* is recorded on the approval.  Only ``"operator"``
+        decisions count towards learned approval rules.
+        """
         now = datetime.now(UTC)
+        repo_path: str | None = None
         async with self._session_factory() as session:
             repo = self._make_repo(session)
             # Atomic update: only succeeds if resolution IS NULL
-            updated = await repo.resolve(approval_id, resolution, now)
+            updated = await repo.resolve(approval_id, resolution, now, resolved_by=resolved_by)
             if updated is None:
                 # Either not found or already resolved — check which
                 existing = await repo.get(approval_id)
                 if existing is None:
                     raise ApprovalNotFoundError(f"Approval {approval_id} not found")
                 raise ApprovalAlreadyResolvedError(f"Approval {approval_id} already resolved as {existing.resolution}")
+            learn = self._rules is not None and resolved_by == "operator" and not updated.requires_explicit_approval
+            if learn:
+                repo_path = await self._job_repo_path(session, updated.job_id)
             await session.commit()
 
+        if repo_path and self._rules is not None:
+            try:
+                await self._rules.record_decision(repo_path, updated.tool, updated.proposed_action, resolution)
+            except Exception:
+                log.warning("approval_rule_record_failed", approval_id=approval_id, exc_info=True)
+            if resolution != "approved":
+                await self._announce_rules_changed()
+
         # Resolve the in-memory future so the runtime unblocks
-        future = self._pending_futures.pop(approval_id, None)
-        self._approval_to_job.pop(approval_id, None)
-        self._explicit_approval_ids.discard(approval_id)
-        if future is not None and not future.done():
-            future.set_result(resolution)
+        if not self.settle(approval_id, resolution) and self.forward_control is not None:
+            try:
+                await self.forward_control("approval_resolved", approval_id=approval_id, resolution=resolution)
+            except Exception:
+                # The owning process's lease tick still picks the decision up
+                log.warning("approval_forward_failed", approval_id=approval_id, exc_info=True)
 
         log.info(
             "approval_resolved",
@@ -128,6 +199,31 @@ class ApprovalService:
         )
         return updated
 
+    def settle(self, approval_id: str, resolution: str) -> bool:
+        """Unblock the runtime waiting on an already-persisted decision.
+
+        Returns False when no future for *approval_id* is waiting in this process.
+        """
+        future = self._pending_futures.pop(approval_id, None)
+        self._approval_to_job.pop(approval_id, None)
+        self._explicit_approval_ids.discard(approval_id)
+        if future is None or future.done():
+            return False
+        future.set_result(resolution)
+        return True
+
+    async def settle_resolved(self) -> int:
+        """Settle waiting futures whose approval was decided through another server process."""
+        waiting = [
+            aid for aid, fut in self._pending_futures.items() if not fut.done() and aid not in self._auto_resolved
+        ]
+        if not waiting:
+            return 0
+        async with self._session_factory() as session:
+            repo = self._make_repo(session)
+            decided = [a for a in [await repo.get(aid) for aid in waiting] if a is not None and a.resolution]
+        return sum(self.settle(a.id, cast("str", a.resolution)) for a in decided)
+
     async def wait_for_resolution(self, approval_id: str) -> str:
         """Block until the operator resolves the approval. Returns resolution string."""
         future = self._pending_futures.get(approval_id)
@@ -150,6 +246,8 @@ class ApprovalService:
     def cleanup_job(self, job_id: str) -> None:
         """Cancel any pending futures for a job (e.g. on job cancel/fail)."""
         self._trusted_jobs.discard(job_id)
+        for aid in [aid for aid in self._auto_resolved if self._approval_to_job.get(aid) == job_id]:
+            self.pop_auto_resolution(aid)
         to_remove = [
             aid
             for aid, fut in self._pending_futures.items()
@@ -166,18 +264,21 @@ class ApprovalService:
         """Return True if the operator has approved all for this job."""
         return job_id in self._trusted_jobs
 
-    async def recover_pending_approvals(self) -> int:
+    async def recover_pending_approvals(self, job_ids: Collection[str] | None = None) -> int:
         """Recreate in-memory futures for approvals that survived a server restart.
 
         Called during ``recover_on_startup()`` so that any job still in
         ``waiting_for_approval`` state can be unblocked when the operator
-        resolves the approval through the API.
+        resolves the approval through the API.  With *job_ids* only those
+        jobs' approvals are restored — the jobs this process recovers.
 
         Returns the number of futures recreated.
         """
         async with self._session_factory() as session:
             repo = self._make_repo(session)
             pending = await repo.list_pending()
+        if job_ids is not None:
+            pending = [a for a in pending if a.job_id in job_ids]
 
         loop = asyncio.get_running_loop()
         recovered = 0
@@ -193,12 +294,13 @@ class ApprovalService:
             log.info("approvals_recovered", count=recovered)
         return recovered
 
-    async def trust_job(self, job_id: str) -> int:
+    async def trust_job(self, job_id: str, *, forward: bool = True) -> int:
         """Mark a job as trusted and approve all its pending requests.
 
         Approvals that were created with *requires_explicit_approval=True*
         (e.g. ``git reset --hard``) are intentionally skipped — those must
-        always be resolved by the operator individually.
+        always be resolved by the operator individually.  When nothing is
+        waiting here the grant is forwarded to the process driving the job.
 
         Returns the number of approvals that were auto-resolved.
         """
@@ -216,10 +318,54 @@ class ApprovalService:
         ]
         for aid in pending_ids:
             try:
-                await self.resolve(aid, "approved")
+                await self.resolve(aid, "approved", resolved_by="trust")
                 resolved_count += 1
             except (ApprovalNotFoundError, ApprovalAlreadyResolvedError):
                 pass
 
+        if forward and resolved_count == 0 and self.forward_control is not None:
+            await self.forward_control("trust", job_id=job_id)
+            resolved_count = sum(not a.requires_explicit_approval for a in await self.list_pending(job_id))
+
         log.info("job_trusted", job_id=job_id, resolved=resolved_count)
         return resolved_count
+
+    def pop_auto_resolution(self, approval_id: str) -> ApprovalRule | None:
+        """Return the rule that auto-approved *approval_id*, forgetting the approval.
+
+        Returns None when the approval is waiting for a decision.
+        """
+        rule = self._auto_resolved.pop(approval_id, None)
+        if rule is not None:
+            self._pending_futures.pop(approval_id, None)
+            self._approval_to_job.pop(approval_id, None)
+        return rule
+
+    def list_rules(self, repo: str | None = None) -> list[ApprovalRule]:
+        """Learned approval rules, active or not."""
+        return self._rules.list_rules(repo) if self._rules is not None else []
+
+    def is_rule_active(self, rule: ApprovalRule) -> bool:
+        return self._rules is not None and self._rules.is_active(rule)
+
+    async def revoke_rule(self, repo: str, tool: str, action: str) -> bool:
+        """Stop auto-approving *action* by *tool* in *repo*.  Returns False if no rule exists."""
+        if self._rules is None or not await self._rules.revoke(repo, tool, action):
+            return False
+        await self._announce_rules_changed()
+        return True
+
+    async def reload_rules(self) -> None:
+        """Re-read the learned rules, picking up decisions made through other server processes."""
+        if self._rules is not None:
+            await self._rules.load()
+
+    async def _announce_rules_changed(self) -> None:
+        """Tell other server processes to stop applying a rule this process just disabled."""
+        if self.forward_control is None:
+            return
+        try:
+            await self.forward_control("rules_changed")
+        except Exception:
+            # Their next lease tick reloads the rules anyway
+            log.warning("approval_rules_forward_failed", exc_info=True)
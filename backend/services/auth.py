@@ -44,7 +44,7 @@ from urllib.parse import urlparse
 
 import structlog
 from starlette.requests import Request  # noqa: TC002
-from starlette.responses import HTMLResponse, JSONResponse, Response  # noqa: TC002
+from starlette.responses import HTMLResponse, JSONResponse, Response
 
 log = structlog.get_logger()
 
@@ -155,6 +155,14 @@ def is_localhost(request: Request) -> bool:
     return host in LOCALHOST_ADDRS
 
 
+def has_bearer_token(request: Request, expected: str) -> bool:
+    """Check ``Authorization: Bearer <token>`` against *expected* (never matches an empty token)."""
+    if not expected:
+        return False
+    scheme, _, token = request.headers.get("authorization", "").partition(" ")
+    return scheme.lower() == "bearer" and hmac.compare_digest(token.strip().encode(), expected.encode())
+
+
 def is_request_authenticated(request: Request) -> bool:
     """Check if a request is authenticated via localhost or valid session cookie.
 
@@ -189,6 +197,21 @@ def _record_ws_attempt(ip: str) -> None:
     _ws_auth_attempts[ip].append(time.monotonic())
 
 
+def is_allowed_websocket_origin(origin: str | None) -> bool:
+    """Whether a WebSocket handshake from *origin* may proceed.
+
+    Rejecting foreign origins stops a malicious page from connecting to a
+    local CodePlane instance.  Localhost and the configured origins pass.
+    """
+    if not origin:
+        return True
+    if (urlparse(origin).hostname or "") in LOCALHOST_ADDRS:
+        return True
+    from backend.app_factory import get_allowed_ws_origins
+
+    return origin in get_allowed_ws_origins()
+
+
 def check_websocket_auth(*, client_host: str | None, cookies: dict[str, str]) -> bool:
     """Validate authentication for a WebSocket connection.
 
@@ -324,6 +347,17 @@ async def authenticate_logout_request(request: Request) -> Response:
     return response
 
 
+async def check_session_request(request: Request) -> Response:
+    """Handle GET /api/auth/session — 204 when authenticated, else 401.
+
+    Used by SSE front workers, which hold no session tokens of their own,
+    to authorize ``/api/events`` against the runtime process.
+    """
+    if is_request_authenticated(request):
+        return Response(status_code=204)
+    return JSONResponse({"detail": "Authentication required"}, status_code=401)
+
+
 async def auth_middleware(request: Request, call_next: Any) -> Response:
     """Middleware that enforces password auth when enabled.
 
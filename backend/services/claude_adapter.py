@@ -30,6 +30,7 @@ from backend.models.domain import (
     SessionEventKind,
 )
 from backend.services.agent_adapter import CODEPLANE_SYSTEM_PROMPT, AgentAdapterInterface, CompletionResult, normalize_model_name
+from backend.services.file_access_tracker import get_file_access_tracker
 from backend.services.permission_policy import is_git_reset_hard
 
 if TYPE_CHECKING:
@@ -234,10 +235,6 @@ class ClaudeAdapter(AgentAdapterInterface):
                     await TelemetrySummaryRepo(session).set_model(**kwargs)
                 elif fn_name == "set_quota":
                     await TelemetrySummaryRepo(session).set_quota(**kwargs)
-                elif fn_name == "record_file_access":
-                    from backend.persistence.file_access_repo import FileAccessRepo
-
-                    await FileAccessRepo(session).record(**kwargs)
                 await session.commit()
         except Exception:
             log.debug("telemetry_db_write_failed", fn=fn_name, exc_info=True)
@@ -357,6 +354,7 @@ class ClaudeAdapter(AgentAdapterInterface):
                     job_id=job_id,
                     description=description,
                     proposed_action=json.dumps(input_data, default=str)[:_TOOL_ACTION_MAX],
+                    tool=tool_name,
                     requires_explicit_approval=True,
                 )
                 self._enqueue(
@@ -414,6 +412,7 @@ class ClaudeAdapter(AgentAdapterInterface):
                 job_id=job_id,
                 description=description,
                 proposed_action=json.dumps(input_data, default=str)[:_TOOL_ACTION_MAX],
+                tool=tool_name,
             )
 
             # Emit approval_request event
@@ -832,16 +831,19 @@ class ClaudeAdapter(AgentAdapterInterface):
                     file_rw_increment["file_read_count"] = 1
                 else:
                     file_rw_increment["file_write_count"] = 1
+                # Counted in memory; the tracker's batched flush writes them
+                tracker = get_file_access_tracker()
+                flush_due = False
                 for fpath in paths:
-                    self._schedule_db_write(
-                        self._db_write(
-                            "record_file_access",
-                            job_id=job_id,
-                            file_path=fpath,
-                            access_type=access_type,
-                            turn_number=turn_num,
-                        )
+                    flush_due = tracker.record(
+                        job_id,
+                        fpath,
+                        access_type,
+                        turn_number=turn_num,
+                        byte_count=result_size if len(paths) == 1 else None,
                     )
+                if flush_due and self._session_factory is not None:
+                    self._schedule_db_write(tracker.flush(self._session_factory))
 
                 # Emit file_changed events for successful writes so the runtime
                 # service can trigger diff recalculation (mirrors CopilotAdapter's
@@ -978,6 +980,19 @@ class ClaudeAdapter(AgentAdapterInterface):
                     cost_usd=float(total_cost_usd),
                 )
             )
+            # Live spend for the runtime cost ledger
+            self._enqueue(
+                session_id,
+                SessionEvent(
+                    kind=SessionEventKind.usage,
+                    payload={
+                        "model": model,
+                        "input_tokens": int(input_tokens),
+                        "output_tokens": int(output_tokens),
+                        "cost_usd": float(total_cost_usd),
+                    },
+                ),
+            )
 
         self._enqueue_log(
             session_id,
@@ -1013,7 +1028,7 @@ class ClaudeAdapter(AgentAdapterInterface):
 
         if config.job_id:
             self._session_to_job[session_id] = config.job_id
-            self._job_start_times.setdefault(config.job_id, time.monotonic())
+            self._job_start_times.setdefault(config.job_id, config.span_origin or time.monotonic())
             if config.model:
                 self._requested_models[config.job_id] = config.model
 
@@ -0,0 +1,275 @@
+"""Optional columnar sink for cross-job telemetry analysis.
+
+When ``telemetry.columnar_export_dir`` is configured and DuckDB is installed
+(``pip install codeplane[analytics]``), spans and job summaries are exported
+incrementally to Parquet files partitioned by day::
+
+    <dir>/spans/day=YYYY-MM-DD/part-<first_id>-<last_id>.parquet
+    <dir>/summaries/day=YYYY-MM-DD/part-0.parquet
+
+Spans are append-only, so they are exported past a span-id watermark.
+Summaries mutate until a job finishes, so every day partition touched since
+the last export is rewritten in full.
+
+Fleet-wide analysis queries run through an embedded DuckDB connection over
+those files, with ``attrs_json`` already flattened into typed columns.
+Callers treat any failure as "columnar path unavailable" and fall back to
+SQLite.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import json
+import os
+from pathlib import Path
+from typing import TYPE_CHECKING, Any
+
+import structlog
+from sqlalchemy import text
+
+from backend.persistence.dialect import day_of, dialect_of, load_json
+
+if TYPE_CHECKING:
+    from sqlalchemy.ext.asyncio import AsyncSession, async_sessionmaker
+
+    from backend.config import CPLConfig
+
+log = structlog.get_logger()
+
+_STATE_FILE = "_export_state.json"
+_SPAN_BATCH = 50_000
+
+_SPAN_COLUMNS: tuple[tuple[str, str], ...] = (
+    ("id", "BIGINT"),
+    ("job_id", "VARCHAR"),
+    ("span_type", "VARCHAR"),
+    ("name", "VARCHAR"),
+    ("duration_ms", "DOUBLE"),
+    ("success", "BOOLEAN"),
+    ("is_retry", "BOOLEAN"),
+    ("tool_category", "VARCHAR"),
+    ("execution_phase", "VARCHAR"),
+    ("turn_number", "INTEGER"),
+    ("input_tokens", "BIGINT"),
+    ("output_tokens", "BIGINT"),
+    ("cost_usd", "DOUBLE"),
+    ("created_at", "VARCHAR"),
+)
+
+_SUMMARY_COLUMNS: tuple[tuple[str, str], ...] = (
+    ("job_id", "VARCHAR"),
+    ("sdk", "VARCHAR"),
+    ("model", "VARCHAR"),
+    ("repo", "VARCHAR"),
+    ("status", "VARCHAR"),
+    ("created_at", "VARCHAR"),
+    ("duration_ms", "BIGINT"),
+    ("input_tokens", "BIGINT"),
+    ("output_tokens", "BIGINT"),
+    ("total_cost_usd", "DOUBLE"),
+    ("total_turns", "INTEGER"),
+    ("tool_call_count", "INTEGER"),
+    ("tool_failure_count", "INTEGER"),
+    ("cost_first_half_usd", "DOUBLE"),
+    ("cost_second_half_usd", "DOUBLE"),
+)
+
+
+def duckdb_available() -> bool:
+    """Return True if the optional DuckDB dependency can be imported."""
+    try:
+        import duckdb  # noqa: F401
+    except ImportError:
+        return False
+    return True
+
+
+def _parse_success(attrs_json: str | dict[str, Any] | None) -> bool | None:
+    try:
+        value = (load_json(attrs_json) or {}).get("success")
+    except (ValueError, AttributeError):
+        return None
+    if value is None:
+        return None
+    if isinstance(value, str):
+        return value.lower() != "false"
+    return bool(value)
+
+
+class ColumnarStore:
+    """Parquet export plus DuckDB query engine over the exported files."""
+
+    def __init__(self, root: Path) -> None:
+        self._root = root
+        self._lock = asyncio.Lock()
+
+    @classmethod
+    def from_config(cls, config: CPLConfig) -> ColumnarStore | None:
+        """Build a store if configured and DuckDB is installed, else None."""
+        export_dir = config.telemetry.columnar_export_dir
+        if not export_dir:
+            return None
+        if not duckdb_available():
+            log.warning("columnar_export_disabled", reason="duckdb not installed", dir=export_dir)
+            return None
+        return cls(Path(export_dir).expanduser())
+
+    @property
+    def root(self) -> Path:
+        return self._root
+
+    # ------------------------------------------------------------------
+    # Export
+    # ------------------------------------------------------------------
+
+    async def export(self, session: AsyncSession) -> int:
+        """Export spans and summaries changed since the last run. Returns spans written."""
+        async with self._lock:
+            state = self._load_state()
+            written = await self._export_spans(session, state)
+            await self._export_summaries(session, state)
+            self._save_state(state)
+            return written
+
+    async def export_loop(self, session_factory: async_sessionmaker[AsyncSession], interval_s: int) -> None:
+        """Export periodically. Designed to be launched as a background task."""
+        while True:
+            try:
+                async with session_factory() as session:
+                    written = await self.export(session)
+                if written:
+                    log.debug("columnar_export_complete", spans=written)
+            except Exception:
+                log.warning("columnar_export_failed", exc_info=True)
+            await asyncio.sleep(interval_s)
+
+    async def _export_spans(self, session: AsyncSession, state: dict[str, Any]) -> int:
+        written = 0
+        while True:
+            result = await session.execute(
+                text("""
+                    SELECT id, job_id, span_type, name, duration_ms, attrs_json, is_retry,
+                           tool_category, execution_phase, turn_number,
+                           input_tokens, output_tokens, cost_usd, created_at
+                    FROM job_telemetry_spans
+                    WHERE id > :after
+                    ORDER BY id
+                    LIMIT :limit
+                """),
+                {"after": int(state.get("span_id", 0)), "limit": _SPAN_BATCH},
+            )
+            rows = result.mappings().all()
+            if not rows:
+                return written
+
+            by_day: dict[str, list[tuple[Any, ...]]] = {}
+            for r in rows:
+                created = str(r["created_at"])
+                by_day.setdefault(created[:10], []).append(
+                    (
+                        r["id"],
+                        r["job_id"],
+                        r["span_type"],
+                        r["name"],
+                        float(r["duration_ms"] or 0),
+                        _parse_success(r["attrs_json"]),
+                        bool(r["is_retry"]),
+                        r["tool_category"],
+                        r["execution_phase"],
+                        r["turn_number"],
+                        r["input_tokens"],
+                        r["output_tokens"],
+                        r["cost_usd"],
+                        created,
+                    )
+                )
+            for day, day_rows in by_day.items():
+                target = self._root / "spans" / f"day={day}" / f"part-{day_rows[0][0]}-{day_rows[-1][0]}.parquet"
+                await asyncio.to_thread(_write_parquet, target, _SPAN_COLUMNS, day_rows)
+            state["span_id"] = int(rows[-1]["id"])
+            written += len(rows)
+
+    async def _export_summaries(self, session: AsyncSession, state: dict[str, Any]) -> None:
+        since = str(state.get("summary_updated_at") or "1970-01-01T00:00:00+00:00")
+        day = day_of("created_at", dialect_of(session))
+        changed = await session.execute(
+            text(f"""
+                SELECT {day} AS day, MAX(updated_at) AS last_update
+                FROM job_telemetry_summary
+                WHERE updated_at >= :since
+                GROUP BY {day}
+            """),  # noqa: S608
+            {"since": since},
+        )
+        days = changed.mappings().all()
+        if not days:
+            return
+        cols = ", ".join(name for name, _ in _SUMMARY_COLUMNS)
+        for d in days:
+            result = await session.execute(
+                text(f"SELECT {cols} FROM job_telemetry_summary WHERE {day} = :day"),  # noqa: S608
+                {"day": d["day"]},
+            )
+            rows = [tuple(r) for r in result.all()]
+            target = self._root / "summaries" / f"day={d['day']}" / "part-0.parquet"
+            await asyncio.to_thread(_write_parquet, target, _SUMMARY_COLUMNS, rows)
+        state["summary_updated_at"] = max(str(d["last_update"]) for d in days)
+
+    def _load_state(self) -> dict[str, Any]:
+        path = self._root / _STATE_FILE
+        try:
+            data = json.loads(path.read_text())
+        except (OSError, ValueError):
+            return {}
+        return data if isinstance(data, dict) else {}
+
+    def _save_state(self, state: dict[str, Any]) -> None:
+        self._root.mkdir(parents=True, exist_ok=True)
+        tmp = self._root / f"{_STATE_FILE}.tmp"
+        tmp.write_text(json.dumps(state))
+        os.replace(tmp, self._root / _STATE_FILE)
+
+    # ------------------------------------------------------------------
+    # Query
+    # ------------------------------------------------------------------
+
+    async def query(self, sql: str, params: list[Any] | None = None) -> list[dict[str, Any]]:
+        """Run *sql* against the ``spans`` and ``summaries`` views."""
+        return await asyncio.to_thread(self._query_sync, sql, params or [])
+
+    def _query_sync(self, sql: str, params: list[Any]) -> list[dict[str, Any]]:
+        import duckdb
+
+        con = duckdb.connect(":memory:")
+        try:
+            for view in ("spans", "summaries"):
+                if not any((self._root / view).glob("*/*.parquet")):
+                    continue
+                pattern = (self._root / view / "*" / "*.parquet").as_posix()
+                con.execute(
+                    f"CREATE VIEW {view} AS SELECT * FROM read_parquet('{pattern}', "  # noqa: S608
+                    "hive_partitioning = true, union_by_name = true)"
+                )
+            cur = con.execute(sql, params)
+            names = [c[0] for c in cur.description or []]
+            return [dict(zip(names, row, strict=True)) for row in cur.fetchall()]
+        finally:
+            con.close()
+
+
+def _write_parquet(target: Path, columns: tuple[tuple[str, str], ...], rows: list[tuple[Any, ...]]) -> None:
+    """Write *rows* to a Parquet file atomically via DuckDB."""
+    import duckdb
+
+    target.parent.mkdir(parents=True, exist_ok=True)
+    tmp = target.with_suffix(".parquet.tmp")
+    con = duckdb.connect(":memory:")
+    try:
+        con.execute("CREATE TABLE t (" + ", ".join(f"{n} {t}" for n, t in columns) + ")")
+        if rows:
+            con.executemany(f"INSERT INTO t VALUES ({', '.join('?' for _ in columns)})", rows)  # noqa: S608
+        con.execute(f"COPY t TO '{tmp.as_posix()}' (FORMAT PARQUET)")
+    finally:
+        con.close()
+    os.replace(tmp, target)
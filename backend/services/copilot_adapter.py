@@ -17,6 +17,7 @@ from backend.models.domain import (
     SessionEventKind,
 )
 from backend.services.agent_adapter import CODEPLANE_SYSTEM_PROMPT, AgentAdapterInterface, CompletionResult, normalize_model_name
+from backend.services.file_access_tracker import get_file_access_tracker
 from backend.services.permission_policy import (
     PolicyDecision,
     evaluate,
@@ -72,6 +73,8 @@ class CopilotAdapter(AgentAdapterInterface):
         self._last_telemetry_broadcast: dict[str, float] = {}
         # Cost analytics: per-job turn counter, phase, retry tracker
         self._turn_counters: dict[str, int] = {}
+        # Live premium-request booking: account-wide quota usage last seen
+        self._premium_used_seen: float | None = None
         self._current_phases: dict[str, str] = {}
         self._retry_trackers: dict[str, RetryTracker] = {}
 
@@ -94,12 +97,12 @@ class CopilotAdapter(AgentAdapterInterface):
 
         self._fallback_turn_ids[job_id] = str(_uuid.uuid4())
 
-    def set_job_id(self, session_id: str, job_id: str) -> None:
+    def set_job_id(self, session_id: str, job_id: str, span_origin: float | None = None) -> None:
         """Associate a session with a job for telemetry routing."""
         import time as _time
 
         self._session_to_job[session_id] = job_id
-        self._job_start_times.setdefault(job_id, _time.monotonic())
+        self._job_start_times.setdefault(job_id, span_origin or _time.monotonic())
 
     def _schedule_db_write(self, coro: Any) -> None:  # noqa: ANN401
         """Schedule an async DB write from a synchronous SDK callback."""
@@ -130,10 +133,6 @@ class CopilotAdapter(AgentAdapterInterface):
                     await TelemetrySummaryRepo(session).set_context(**kwargs)
                 elif fn_name == "set_quota":
                     await TelemetrySummaryRepo(session).set_quota(**kwargs)
-                elif fn_name == "record_file_access":
-                    from backend.persistence.file_access_repo import FileAccessRepo
-
-                    await FileAccessRepo(session).record(**kwargs)
                 await session.commit()
         except Exception:
             log.debug("telemetry_db_write_failed", fn=fn_name, exc_info=True)
@@ -252,6 +251,7 @@ class CopilotAdapter(AgentAdapterInterface):
                 job_id=job_id,
                 description=description,
                 proposed_action=request.full_command_text,
+                tool=kind_val,
                 requires_explicit_approval=True,
             )
             event_queue = self._queues.get(sid)
@@ -367,6 +367,7 @@ class CopilotAdapter(AgentAdapterInterface):
             job_id=job_id,
             description=description,
             proposed_action=request.full_command_text,
+            tool=kind_val,
         )
 
         # Emit approval_request event so RuntimeService transitions state
@@ -499,6 +500,18 @@ class CopilotAdapter(AgentAdapterInterface):
                 total_turns=1,
             )
         )
+        # Live spend for the runtime cost ledger
+        queue.put_nowait(
+            SessionEvent(
+                kind=SessionEventKind.usage,
+                payload={
+                    "model": actual_model,
+                    "input_tokens": input_toks,
+                    "output_tokens": output_toks,
+                    "cost_usd": cost,
+                },
+            )
+        )
 
         # Advance turn counter for this job
         turn_num = self._turn_counters.get(job_id, 0) + 1
@@ -553,6 +566,8 @@ class CopilotAdapter(AgentAdapterInterface):
                     "is_unlimited": bool(getattr(snap, "is_unlimited_entitlement", False)),
                     "reset_date": str(getattr(snap, "reset_date", "") or ""),
                 }
+                if key == "premium_interactions":
+                    self._book_premium_from_quota(job_id, used, queue)
                 # OTEL gauges
                 tel.quota_used_gauge.set(used, {"job_id": job_id, "sdk": "copilot", "resource": key})
                 tel.quota_entitlement_gauge.set(entitlement, {"job_id": job_id, "sdk": "copilot", "resource": key})
@@ -566,6 +581,27 @@ class CopilotAdapter(AgentAdapterInterface):
                 )
             )
 
+    def _book_premium_from_quota(
+        self,
+        job_id: str,
+        used: float,
+        queue: asyncio.Queue[SessionEvent | None],
+    ) -> None:
+        """Stream premium-request spend to the cost ledger as the quota moves.
+
+        The SDK only reports a session's premium requests at shutdown, but
+        every usage event carries the account-wide quota.  An increase since
+        the last snapshot may come from any session, so it is booked as
+        unattributed: it counts towards the monthly cap but not towards the
+        job that saw it.  ``session.shutdown`` books each job's exact total.
+        """
+        previous, self._premium_used_seen = self._premium_used_seen, used
+        if previous is None or used <= previous:
+            return  # first sighting or quota reset: just take the baseline
+        queue.put_nowait(
+            SessionEvent(kind=SessionEventKind.usage, payload={"unattributed_premium_requests": used - previous})
+        )
+
     def _handle_tool_start(self, data: Any, job_id: str) -> None:
         tool_id = data.tool_call_id or ""
         import json as _json
@@ -647,16 +683,19 @@ class CopilotAdapter(AgentAdapterInterface):
                 file_rw_increment["file_read_count"] = 1
             else:
                 file_rw_increment["file_write_count"] = 1
+            # Counted in memory; the tracker's batched flush writes them
+            tracker = get_file_access_tracker()
+            flush_due = False
             for fpath in paths:
-                self._schedule_db_write(
-                    self._db_write(
-                        "record_file_access",
-                        job_id=job_id,
-                        file_path=fpath,
-                        access_type=access_type,
-                        turn_number=turn_num,
-                    )
+                flush_due = tracker.record(
+                    job_id,
+                    fpath,
+                    access_type,
+                    turn_number=turn_num,
+                    byte_count=result_size if len(paths) == 1 else None,
                 )
+            if flush_due and self._session_factory is not None:
+                self._schedule_db_write(tracker.flush(self._session_factory))
 
         # SQLite writes
         self._schedule_db_write(
@@ -1049,7 +1088,7 @@ class CopilotAdapter(AgentAdapterInterface):
         # Wire telemetry mapping before registering the callback so
         # no early SDK events are lost.
         if config.job_id:
-            self.set_job_id(session_id, config.job_id)
+            self.set_job_id(session_id, config.job_id, config.span_origin)
 
         # Sequence counter for log events emitted from this session.
         log_seq = [0]
@@ -1098,6 +1137,14 @@ class CopilotAdapter(AgentAdapterInterface):
                         self._schedule_db_write(
                             self._db_write("increment", job_id=job_id, premium_requests=float(total_pr))
                         )
+                        # The session's exact total replaces its share of the live estimate.
+                        if total_pr:
+                            queue.put_nowait(
+                                SessionEvent(
+                                    kind=SessionEventKind.usage,
+                                    payload={"premium_requests": float(total_pr)},
+                                )
+                            )
 
             # --- Emit log events for operational SDK events ---
             self._emit_log_event(kind_str, data, requested_model, queue, log_seq)
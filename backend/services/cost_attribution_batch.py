@@ -0,0 +1,333 @@
+"""Vectorized cost attribution across many jobs.
+
+Produces the same attribution rows and turn stats as
+:func:`backend.services.cost_attribution.compute_attribution`, but loads the
+spans for a whole batch of jobs in one query and aggregates them as NumPy
+arrays instead of per-span dicts:
+
+- execution phases are forward/backward filled within each job with
+  ``maximum``/``minimum`` accumulates,
+- ``classify_tool`` runs once per distinct tool name, not once per span,
+- per-turn activity weights, weighted splits and per-job sums are array ops
+  keyed by (job, turn).
+
+Used by ``cpl backfill-attribution`` to recompute historical jobs.  NumPy
+ships with the ``analytics`` extra; without it the batch entry point falls
+back to the per-job path.
+"""
+
+from __future__ import annotations
+
+from typing import TYPE_CHECKING, Any
+
+import structlog
+
+from backend.models.api_schemas import ExecutionPhase
+from backend.models.events import DomainEventKind
+from backend.persistence.cost_attribution_repo import CostAttributionRepo
+from backend.persistence.event_repo import EventRepository
+from backend.persistence.file_access_repo import FileAccessRepo
+from backend.persistence.telemetry_spans_repo import TelemetrySpansRepo
+from backend.persistence.telemetry_summary_repo import TelemetrySummaryRepo
+from backend.services.cost_attribution import _TOOL_CATEGORY_ACTIVITY, compute_attribution
+from backend.services.tool_classifier import classify_tool
+
+if TYPE_CHECKING:
+    from collections.abc import Sequence
+
+    from sqlalchemy.ext.asyncio import AsyncSession, async_sessionmaker
+
+log = structlog.get_logger()
+
+# Column order of the activity matrix.  Every bucket ``_derive_activity_weights``
+# can return must appear here.
+ACTIVITY_BUCKETS: tuple[str, ...] = tuple(
+    dict.fromkeys([*_TOOL_CATEGORY_ACTIVITY.values(), "other_tools", "verification", "setup", "wrap_up", "reasoning"])
+)
+_ACTIVITY_INDEX = {bucket: i for i, bucket in enumerate(ACTIVITY_BUCKETS)}
+
+_PHASES: tuple[str, ...] = tuple(phase.value for phase in ExecutionPhase)
+_PHASE_INDEX = {phase: i for i, phase in enumerate(_PHASES)}
+
+# Phases that pin the whole turn to a single bucket regardless of tool mix.
+_PHASE_OVERRIDES = {
+    ExecutionPhase.verification.value: "verification",
+    ExecutionPhase.environment_setup.value: "setup",
+    ExecutionPhase.finalization.value: "wrap_up",
+    ExecutionPhase.post_completion.value: "wrap_up",
+}
+
+DEFAULT_BATCH_SIZE = 500
+
+
+def numpy_available() -> bool:
+    """Return True if the optional NumPy dependency can be imported."""
+    try:
+        import numpy  # noqa: F401
+    except ImportError:
+        return False
+    return True
+
+
+async def compute_attribution_batch(session: AsyncSession, job_ids: Sequence[str]) -> int:
+    """Recompute attribution for *job_ids*, replacing any existing rows.
+
+    Returns the number of jobs attributed.
+    """
+    job_ids = list(job_ids)
+    if not job_ids:
+        return 0
+    attr_repo = CostAttributionRepo(session)
+
+    if not numpy_available():
+        await attr_repo.delete_for_jobs(job_ids)
+        for job_id in job_ids:
+            await compute_attribution(session, job_id)
+        return len(job_ids)
+
+    spans = await TelemetrySpansRepo(session).attribution_columns(job_ids)
+    if not spans:
+        return 0
+    results = attribute_spans(spans)
+    attributed = list(results)
+
+    file_stats = await FileAccessRepo(session).reread_stats_for_jobs(attributed)
+    diffs = await EventRepository(session).list_latest_payloads(attributed, DomainEventKind.diff_updated)
+
+    await attr_repo.delete_for_jobs(attributed)
+    await attr_repo.insert_many([row for result in results.values() for row in result["rows"]])
+
+    turn_stats: list[dict[str, Any]] = []
+    for job_id, result in results.items():
+        stats = file_stats.get(job_id, {})
+        changed_files = diffs.get(job_id, {}).get("changed_files", [])
+        turn_stats.append(
+            {
+                "job_id": job_id,
+                "unique_files_read": stats.get("unique_files", 0),
+                "file_reread_count": stats.get("reread_count", 0),
+                "peak_turn_cost_usd": result["peak_turn_cost_usd"],
+                "avg_turn_cost_usd": result["avg_turn_cost_usd"],
+                "cost_first_half_usd": result["cost_first_half_usd"],
+                "cost_second_half_usd": result["cost_second_half_usd"],
+                "diff_lines_added": sum(f.get("additions", 0) for f in changed_files),
+                "diff_lines_removed": sum(f.get("deletions", 0) for f in changed_files),
+            }
+        )
+    await TelemetrySummaryRepo(session).set_turn_stats_many(turn_stats)
+
+    log.info("cost_attribution_batch_written", jobs=len(results), spans=len(spans))
+    return len(results)
+
+
+async def backfill_attribution(
+    session_factory: async_sessionmaker[AsyncSession],
+    *,
+    batch_size: int = DEFAULT_BATCH_SIZE,
+) -> int:
+    """Recompute attribution for every job with spans, one commit per batch."""
+    async with session_factory() as session:
+        job_ids = await TelemetrySpansRepo(session).job_ids_with_spans()
+
+    written = 0
+    for start in range(0, len(job_ids), batch_size):
+        async with session_factory() as session:
+            written += await compute_attribution_batch(session, job_ids[start : start + batch_size])
+            await session.commit()
+        log.debug("cost_attribution_backfill_progress", done=min(start + batch_size, len(job_ids)), total=len(job_ids))
+    return written
+
+
+def attribute_spans(spans: Sequence[Sequence[Any]]) -> dict[str, dict[str, Any]]:
+    """Aggregate span rows (see ``TelemetrySpansRepo.attribution_columns``) per job.
+
+    Rows must be grouped by job and ordered by start time within each job.
+    Returns ``{job_id: {"rows": [...], "peak_turn_cost_usd": ..., ...}}``.
+    """
+    import numpy as np
+
+    n = len(spans)
+    if n == 0:
+        return {}
+    job_col, type_col, name_col, turn_col, phase_col, cost_col, in_col, out_col = zip(*spans, strict=True)
+
+    jobs = np.array(job_col, dtype=object)
+    span_type = np.array(type_col, dtype=object)
+    turn_raw = np.array(turn_col, dtype=np.float64)
+    cost = np.array(cost_col, dtype=np.float64)
+    in_tok = np.trunc(np.array(in_col, dtype=np.float64)).astype(np.int64)
+    out_tok = np.trunc(np.array(out_col, dtype=np.float64)).astype(np.int64)
+    pos = np.arange(n)
+
+    # --- Job segments (rows arrive grouped by job) ---
+    boundary = np.empty(n, dtype=bool)
+    boundary[0] = True
+    boundary[1:] = jobs[1:] != jobs[:-1]
+    seg_start = np.flatnonzero(boundary)
+    seg_end = np.append(seg_start[1:], n) - 1
+    seg = np.cumsum(boundary) - 1
+    job_names = [str(j) for j in jobs[seg_start]]
+    n_jobs = len(job_names)
+
+    has_turn = ~np.isnan(turn_raw)
+    turn = np.where(has_turn, turn_raw, 0).astype(np.int64)
+    is_tool = span_type == "tool"
+    is_llm = span_type == "llm"
+
+    # --- Execution phase: forward fill, then backward fill, within each job ---
+    phase = _encode(np.array(phase_col, dtype=object), _PHASE_INDEX)
+    valid = phase >= 0
+    prev_valid = np.maximum.accumulate(np.where(valid, pos, -1))
+    next_valid = np.minimum.accumulate(np.where(valid, pos, n)[::-1])[::-1]
+    filled = np.where(
+        prev_valid >= seg_start[seg],
+        phase[np.maximum(prev_valid, 0)],
+        np.where(next_valid <= seg_end[seg], phase[np.minimum(next_valid, n - 1)], -1),
+    )
+    has_phase = filled >= 0
+
+    # --- Turn contexts: one per (job, turn) touched by a phased, tool or LLM span ---
+    in_ctx = has_turn & (has_phase | is_tool | is_llm)
+    ctx_keys, ctx_of = np.unique(np.stack([seg[in_ctx], turn[in_ctx]], axis=1), axis=0, return_inverse=True)
+    ctx_of = ctx_of.reshape(-1)
+    n_ctx = len(ctx_keys)
+    ctx_pos = pos[in_ctx]
+
+    # Phase of a turn is the phase of its last phased span.
+    last_phased = np.full(n_ctx, -1, dtype=np.int64)
+    phased = has_phase[in_ctx]
+    np.maximum.at(last_phased, ctx_of[phased], ctx_pos[phased])
+    ctx_phase = np.where(last_phased >= 0, filled[np.maximum(last_phased, 0)], -1)
+
+    llm = is_llm[in_ctx]
+    ctx_cost = np.bincount(ctx_of[llm], weights=cost[in_ctx][llm], minlength=n_ctx)
+    ctx_in = np.bincount(ctx_of[llm], weights=in_tok[in_ctx][llm], minlength=n_ctx).astype(np.int64)
+    ctx_out = np.bincount(ctx_of[llm], weights=out_tok[in_ctx][llm], minlength=n_ctx).astype(np.int64)
+
+    # --- Activity weights: tool counts per bucket, remembering first-seen order ---
+    n_buckets = len(ACTIVITY_BUCKETS)
+    tool_names = np.array(name_col, dtype=object)
+    activity = _encode(tool_names, {}, lambda name: _ACTIVITY_INDEX[_tool_activity(name)])
+    tools = is_tool[in_ctx]
+    tool_ctx = ctx_of[tools]
+    tool_bucket = activity[in_ctx][tools]
+    weights = np.zeros((n_ctx, n_buckets), dtype=np.int64)
+    np.add.at(weights, (tool_ctx, tool_bucket), 1)
+    first_seen = np.full((n_ctx, n_buckets), n, dtype=np.int64)
+    np.minimum.at(first_seen, (tool_ctx, tool_bucket), ctx_pos[tools])
+
+    override_of_phase = np.array([_ACTIVITY_INDEX.get(_PHASE_OVERRIDES.get(p, ""), -1) for p in _PHASES])
+    override = np.where(ctx_phase >= 0, override_of_phase[np.maximum(ctx_phase, 0)], -1)
+    pinned = np.flatnonzero(override >= 0)
+    weights[pinned] = 0
+    weights[pinned, override[pinned]] = 1
+    idle = np.flatnonzero(weights.sum(axis=1) == 0)
+    weights[idle, _ACTIVITY_INDEX["reasoning"]] = 1
+
+    # --- Weighted split; the last-seen bucket of each turn takes the remainder ---
+    present = weights > 0
+    share = weights / weights.sum(axis=1, keepdims=True)
+    last_seen = np.where(present, first_seen, -1).max(axis=1, keepdims=True)
+    is_last = present & (first_seen == last_seen)
+    head = present & ~is_last
+
+    alloc_cost = np.where(head, ctx_cost[:, None] * share, 0.0)
+    alloc_in = np.where(head, np.trunc(ctx_in[:, None] * share), 0).astype(np.int64)
+    alloc_out = np.where(head, np.trunc(ctx_out[:, None] * share), 0).astype(np.int64)
+    alloc_cost = np.where(is_last, (ctx_cost - alloc_cost.sum(axis=1))[:, None], alloc_cost)
+    alloc_in = np.where(is_last, (ctx_in - alloc_in.sum(axis=1))[:, None], alloc_in)
+    alloc_out = np.where(is_last, (ctx_out - alloc_out.sum(axis=1))[:, None], alloc_out)
+
+    ctx_job = ctx_keys[:, 0]
+    act_cost = np.zeros((n_jobs, n_buckets))
+    act_in = np.zeros((n_jobs, n_buckets), dtype=np.int64)
+    act_out = np.zeros((n_jobs, n_buckets), dtype=np.int64)
+    act_calls = np.zeros((n_jobs, n_buckets), dtype=np.int64)
+    np.add.at(act_cost, ctx_job, alloc_cost)
+    np.add.at(act_in, ctx_job, alloc_in)
+    np.add.at(act_out, ctx_job, alloc_out)
+    np.add.at(act_calls, ctx_job, present.astype(np.int64))
+
+    # --- Turn dimension: LLM spans carry the cost ---
+    llm_turn = is_llm & has_turn
+    turn_keys, turn_of = np.unique(np.stack([seg[llm_turn], turn[llm_turn]], axis=1), axis=0, return_inverse=True)
+    turn_of = turn_of.reshape(-1)
+    n_turns = len(turn_keys)
+    turn_cost = np.bincount(turn_of, weights=cost[llm_turn], minlength=n_turns)
+    turn_in = np.bincount(turn_of, weights=in_tok[llm_turn], minlength=n_turns).astype(np.int64)
+    turn_out = np.bincount(turn_of, weights=out_tok[llm_turn], minlength=n_turns).astype(np.int64)
+    turn_calls = np.bincount(turn_of, minlength=n_turns)
+
+    # --- Turn economics (turn keys are sorted by job, then turn number) ---
+    turn_job = turn_keys[:, 0]
+    turns_per_job = np.bincount(turn_job, minlength=n_jobs)
+    rank = np.arange(n_turns) - np.searchsorted(turn_job, turn_job)
+    first_half = rank < (turns_per_job // 2)[turn_job]
+    job_turn_cost = np.bincount(turn_job, weights=turn_cost, minlength=n_jobs)
+    first_half_cost = np.bincount(turn_job, weights=np.where(first_half, turn_cost, 0.0), minlength=n_jobs)
+    second_half_cost = np.bincount(turn_job, weights=np.where(first_half, 0.0, turn_cost), minlength=n_jobs)
+    has_turns = turns_per_job > 0
+    turn_peak = np.full(n_jobs, -np.inf)
+    np.maximum.at(turn_peak, turn_job, turn_cost)
+    peak = np.where(has_turns, turn_peak, 0.0)
+    avg = np.divide(job_turn_cost, turns_per_job, out=np.zeros(n_jobs), where=has_turns)
+
+    # --- Materialize per-job rows ---
+    results: dict[str, dict[str, Any]] = {
+        job_id: {
+            "rows": [],
+            "total_turns": int(turns_per_job[j]),
+            "peak_turn_cost_usd": float(peak[j]),
+            "avg_turn_cost_usd": float(avg[j]),
+            "cost_first_half_usd": float(first_half_cost[j]),
+            "cost_second_half_usd": float(second_half_cost[j]),
+        }
+        for j, job_id in enumerate(job_names)
+    }
+    for j, b in zip(*np.nonzero(act_calls), strict=True):
+        job_id = job_names[j]
+        results[job_id]["rows"].append(
+            {
+                "job_id": job_id,
+                "dimension": "activity",
+                "bucket": ACTIVITY_BUCKETS[b],
+                "cost_usd": float(act_cost[j, b]),
+                "input_tokens": int(act_in[j, b]),
+                "output_tokens": int(act_out[j, b]),
+                "call_count": int(act_calls[j, b]),
+            }
+        )
+    for t in range(n_turns):
+        job_id = job_names[turn_job[t]]
+        results[job_id]["rows"].append(
+            {
+                "job_id": job_id,
+                "dimension": "turn",
+                "bucket": str(int(turn_keys[t, 1])),
+                "cost_usd": float(turn_cost[t]),
+                "input_tokens": int(turn_in[t]),
+                "output_tokens": int(turn_out[t]),
+                "call_count": int(turn_calls[t]),
+            }
+        )
+    return results
+
+
+def _tool_activity(name: str) -> str:
+    category = classify_tool(name) or "other"
+    return _TOOL_CATEGORY_ACTIVITY.get(category, "other_tools")
+
+
+def _encode(values: Any, vocab: dict[str, int], fallback: Any = None) -> Any:
+    """Map an object array to integer codes, resolving each distinct value once.
+
+    Values missing from *vocab* map to ``fallback(value)`` if given, else -1.
+    """
+    import numpy as np
+
+    uniq, inverse = np.unique(values, return_inverse=True)
+    codes = np.array(
+        [vocab[v] if v in vocab else (fallback(v) if fallback else -1) for v in uniq.tolist()],
+        dtype=np.int64,
+    )
+    return codes[inverse.reshape(-1)]
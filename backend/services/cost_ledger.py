@@ -0,0 +1,283 @@
+"""Live in-memory cost ledger for budget enforcement.
+
+Tracks spend per job, per repo and per SDK for the current calendar month
+(UTC) from adapter ``usage`` events as they arrive, so the runtime loop can
+enforce budgets and the dashboard can show them without a database round-trip.
+
+Month-to-date totals are seeded at startup from the telemetry summaries;
+after that every update is in memory.  When several server processes share one
+database, :meth:`CostLedger.refresh` folds the spend the other processes have
+written to the summaries back in.  The ledger rolls over on the
+first read or usage event of a new month and then calls ``on_rollover`` so the
+runtime can release jobs held for an exhausted budget.  Claude spend is capped in USD
+(``claude_monthly_budget_usd``); Copilot in premium requests
+(``copilot_premium_entitlement``).
+
+Copilot reports premium requests per session only when the session ends;
+until then the account-wide quota is all there is.  Its increases are booked
+as *unattributed* spend: they count towards the SDK's monthly cap but not
+towards any job or repo.  A session's exact total later moves that much out
+of the unattributed bucket onto its job.
+"""
+
+from __future__ import annotations
+
+from dataclasses import dataclass, field
+from datetime import UTC, datetime
+from enum import StrEnum
+from typing import TYPE_CHECKING, Any
+
+import structlog
+
+from backend.persistence.telemetry_summary_repo import TelemetrySummaryRepo
+
+if TYPE_CHECKING:
+    from collections.abc import Callable
+
+    from sqlalchemy.ext.asyncio import AsyncSession
+
+    from backend.config import TelemetryConfig
+
+log = structlog.get_logger()
+
+
+class BudgetStatus(StrEnum):
+    """Position of spend relative to a cap."""
+
+    ok = "ok"
+    soft = "soft"
+    exhausted = "exhausted"
+
+
+@dataclass(slots=True)
+class LedgerTotals:
+    """Additive spend counters."""
+
+    cost_usd: float = 0.0
+    input_tokens: int = 0
+    output_tokens: int = 0
+    premium_requests: float = 0.0
+
+    def add(self, cost_usd: float, input_tokens: int, output_tokens: int, premium_requests: float) -> None:
+        self.cost_usd += cost_usd
+        self.input_tokens += input_tokens
+        self.output_tokens += output_tokens
+        self.premium_requests += premium_requests
+
+
+@dataclass(slots=True)
+class _JobEntry:
+    repo: str
+    sdk: str
+    totals: LedgerTotals = field(default_factory=LedgerTotals)
+
+
+def current_month(now: datetime | None = None) -> str:
+    """Ledger month key (``YYYY-MM``, UTC)."""
+    return (now or datetime.now(UTC)).strftime("%Y-%m")
+
+
+def seconds_until_next_month(now: datetime | None = None) -> float:
+    """Seconds from *now* until the next ledger month starts (UTC)."""
+    now = now or datetime.now(UTC)
+    year, month = (now.year + 1, 1) if now.month == 12 else (now.year, now.month + 1)
+    return (datetime(year, month, 1, tzinfo=UTC) - now).total_seconds()
+
+
+class CostLedger:
+    """Month-to-date and per-job spend, updated from live usage events."""
+
+    def __init__(self, config: TelemetryConfig) -> None:
+        self._config = config
+        self._month = current_month()
+        self._by_sdk: dict[str, LedgerTotals] = {}
+        self._by_repo: dict[str, LedgerTotals] = {}
+        self._jobs: dict[str, _JobEntry] = {}
+        # Premium requests seen on the account quota, per SDK, not yet booked to a job
+        self._unattributed: dict[str, float] = {}
+        # Set by the runtime; called (synchronously) after a month rollover.
+        self.on_rollover: Callable[[], None] | None = None
+
+    @property
+    def month(self) -> str:
+        return self._month
+
+    async def load(self, session: AsyncSession) -> None:
+        """Seed month-to-date totals from the telemetry summaries."""
+        self._reset(current_month())
+        by_sdk, by_repo = await self._month_to_date(session)
+        self._by_sdk.update(by_sdk)
+        self._by_repo.update(by_repo)
+        log.info("cost_ledger_loaded", month=self._month, sdks=sorted(self._by_sdk))
+
+    async def refresh(self, session: AsyncSession) -> None:
+        """Take in month-to-date spend recorded by other server processes sharing the database.
+
+        Every process writes its usage to the telemetry summaries as it
+        arrives, so their sums cover the whole fleet.  A total is never
+        lowered: this process's own latest usage may not be written yet.
+        """
+        self._maybe_roll_over()
+        by_sdk, by_repo = await self._month_to_date(session)
+        for stored, current in ((by_sdk, self._by_sdk), (by_repo, self._by_repo)):
+            for key, db in stored.items():
+                mine = current.setdefault(key, LedgerTotals())
+                mine.cost_usd = max(mine.cost_usd, db.cost_usd)
+                mine.input_tokens = max(mine.input_tokens, db.input_tokens)
+                mine.output_tokens = max(mine.output_tokens, db.output_tokens)
+                mine.premium_requests = max(mine.premium_requests, db.premium_requests)
+
+    async def _month_to_date(self, session: AsyncSession) -> tuple[dict[str, LedgerTotals], dict[str, LedgerTotals]]:
+        by_sdk: dict[str, LedgerTotals] = {}
+        by_repo: dict[str, LedgerTotals] = {}
+        rows = await TelemetrySummaryRepo(session).month_to_date(f"{self._month}-01")
+        for row in rows:
+            for totals in (
+                by_sdk.setdefault(row["sdk"] or "", LedgerTotals()),
+                by_repo.setdefault(row["repo"] or "", LedgerTotals()),
+            ):
+                totals.add(
+                    float(row["cost_usd"] or 0),
+                    int(row["input_tokens"] or 0),
+                    int(row["output_tokens"] or 0),
+                    float(row["premium_requests"] or 0),
+                )
+        return by_sdk, by_repo
+
+    # --- Job lifecycle ---
+
+    def register_job(self, job_id: str, *, repo: str, sdk: str, cost_usd: float = 0.0) -> None:
+        """Start tracking a job; *cost_usd* carries spend from earlier sessions of a resumed job."""
+        entry = self._jobs.get(job_id)
+        if entry is None:
+            self._jobs[job_id] = _JobEntry(repo=repo, sdk=sdk, totals=LedgerTotals(cost_usd=cost_usd))
+        else:
+            entry.sdk = sdk
+
+    def forget_job(self, job_id: str) -> None:
+        self._jobs.pop(job_id, None)
+
+    def record(
+        self,
+        job_id: str,
+        *,
+        cost_usd: float = 0.0,
+        input_tokens: int = 0,
+        output_tokens: int = 0,
+        premium_requests: float = 0.0,
+    ) -> None:
+        """Add one usage increment to the job, its repo and its SDK."""
+        self._maybe_roll_over()
+        entry = self._jobs.get(job_id)
+        if entry is None:
+            log.debug("cost_ledger_unknown_job", job_id=job_id)
+            return
+        delta = (cost_usd, input_tokens, output_tokens, premium_requests)
+        entry.totals.add(*delta)
+        self._repo_totals(entry.repo).add(*delta)
+        # Spend already counted as unattributed is not added to the SDK twice
+        absorbed = min(premium_requests, self._unattributed.get(entry.sdk, 0.0)) if premium_requests > 0 else 0.0
+        if absorbed:
+            self._unattributed[entry.sdk] -= absorbed
+        self._sdk_totals(entry.sdk).add(cost_usd, input_tokens, output_tokens, premium_requests - absorbed)
+
+    def record_unattributed(self, sdk: str, premium_requests: float) -> None:
+        """Count premium requests towards *sdk*'s month without charging any job."""
+        self._maybe_roll_over()
+        if premium_requests <= 0:
+            return
+        self._unattributed[sdk] = self._unattributed.get(sdk, 0.0) + premium_requests
+        self._sdk_totals(sdk).premium_requests += premium_requests
+
+    # --- Budget checks ---
+
+    def month_spent(self, sdk: str) -> tuple[float, float, str]:
+        """Return ``(spent, limit, unit)`` for *sdk*'s monthly cap (limit 0 = unlimited)."""
+        self._maybe_roll_over()
+        totals = self._by_sdk.get(sdk) or LedgerTotals()
+        if sdk == "copilot":
+            return totals.premium_requests, float(self._config.copilot_premium_entitlement), "premium_requests"
+        limit = self._config.claude_monthly_budget_usd if sdk == "claude" else 0.0
+        return totals.cost_usd, float(limit), "usd"
+
+    def month_status(self, sdk: str) -> BudgetStatus:
+        spent, limit, _ = self.month_spent(sdk)
+        return self._status(spent, limit)
+
+    def job_status(self, job_id: str) -> BudgetStatus:
+        entry = self._jobs.get(job_id)
+        if entry is None:
+            return BudgetStatus.ok
+        return self._status(entry.totals.cost_usd, self._config.job_budget_usd)
+
+    def job_sdk(self, job_id: str) -> str | None:
+        entry = self._jobs.get(job_id)
+        return entry.sdk if entry else None
+
+    def jobs_for_sdk(self, sdk: str) -> list[str]:
+        return [job_id for job_id, entry in self._jobs.items() if entry.sdk == sdk]
+
+    def exhausted_sdks(self) -> set[str]:
+        return {sdk for sdk in ("claude", "copilot") if self.month_status(sdk) is BudgetStatus.exhausted}
+
+    def snapshot(self, job_id: str | None = None) -> dict[str, Any]:
+        """Budget state in the shape of ``BudgetSnapshot`` / ``BudgetUpdatedPayload``."""
+        self._maybe_roll_over()
+        sdks = []
+        for sdk in sorted({"claude", "copilot", *self._by_sdk} - {""}):
+            spent, limit, unit = self.month_spent(sdk)
+            sdks.append(
+                {
+                    "sdk": sdk,
+                    "unit": unit,
+                    "spent": round(spent, 6),
+                    "limit": limit,
+                    "status": self._status(spent, limit).value,
+                }
+            )
+        snap: dict[str, Any] = {
+            "month": self._month,
+            "total_cost_usd": round(sum(t.cost_usd for t in self._by_sdk.values()), 6),
+            "sdks": sdks,
+            "repos": {repo: round(t.cost_usd, 6) for repo, t in self._by_repo.items() if repo},
+        }
+        if job_id is not None:
+            entry = self._jobs.get(job_id)
+            snap.update(
+                job_id=job_id,
+                job_cost_usd=round(entry.totals.cost_usd, 6) if entry else 0.0,
+                job_limit_usd=self._config.job_budget_usd,
+                job_status=self.job_status(job_id).value,
+            )
+        return snap
+
+    # --- Internals ---
+
+    def _status(self, spent: float, limit: float) -> BudgetStatus:
+        if limit <= 0:
+            return BudgetStatus.ok
+        if spent >= limit:
+            return BudgetStatus.exhausted
+        if spent >= limit * self._config.budget_soft_pct / 100:
+            return BudgetStatus.soft
+        return BudgetStatus.ok
+
+    def _sdk_totals(self, sdk: str) -> LedgerTotals:
+        return self._by_sdk.setdefault(sdk, LedgerTotals())
+
+    def _repo_totals(self, repo: str) -> LedgerTotals:
+        return self._by_repo.setdefault(repo, LedgerTotals())
+
+    def _maybe_roll_over(self) -> None:
+        month = current_month()
+        if month != self._month:
+            log.info("cost_ledger_month_rollover", previous=self._month, month=month)
+            self._reset(month)
+            if self.on_rollover is not None:
+                self.on_rollover()
+
+    def _reset(self, month: str) -> None:
+        self._month = month
+        self._by_sdk.clear()
+        self._by_repo.clear()
+        self._unattributed.clear()
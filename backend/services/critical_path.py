@@ -0,0 +1,221 @@
+"""Per-job execution waterfall and critical-path breakdown.
+
+Builds a timeline from the persisted ``job_telemetry_spans`` rows — adapter
+LLM and tool spans plus the ``internal`` spans RuntimeService records for
+CodePlane's own stages (queue wait, environment setup, diff work, approval
+wait, post-completion bookkeeping) — and attributes every instant of the
+job's wall clock to exactly one category.
+
+Spans overlap (a tool call runs while an approval is pending, diffs are
+computed while the model is thinking), so a plain sum double-counts.  The
+timeline is swept instead: at each instant the active span of the highest
+precedence category owns the time, and gaps with no active span are
+``idle``.  The chain of owning spans is the critical path; the time owned by
+``overhead`` and ``queue`` spans is what the job spent waiting on CodePlane
+rather than on the model, its tools or the operator.
+"""
+
+from __future__ import annotations
+
+from dataclasses import dataclass, field
+from enum import StrEnum
+from typing import TYPE_CHECKING, Any
+
+if TYPE_CHECKING:
+    from collections.abc import Iterable, Mapping
+
+# span_type of spans recorded by RuntimeService for its own stages
+INTERNAL_SPAN_TYPE = "internal"
+
+
+class SpanCategory(StrEnum):
+    """Where a slice of wall-clock time went."""
+
+    approval = "approval"
+    llm = "llm"
+    tool = "tool"
+    overhead = "overhead"
+    queue = "queue"
+    idle = "idle"
+
+
+# Owner of an instant when spans overlap, highest first.  An approval blocks
+# the tool call it gates; agent work hides CodePlane work running beside it.
+_PRECEDENCE: tuple[SpanCategory, ...] = (
+    SpanCategory.approval,
+    SpanCategory.llm,
+    SpanCategory.tool,
+    SpanCategory.overhead,
+    SpanCategory.queue,
+)
+
+_INTERNAL_CATEGORIES: dict[str, SpanCategory] = {
+    "approval_wait": SpanCategory.approval,
+    "queue_wait": SpanCategory.queue,
+}
+
+
+@dataclass(slots=True)
+class WaterfallBar:
+    """One span on the timeline.  ``critical_ms`` is the time it owned."""
+
+    name: str
+    category: SpanCategory
+    start_ms: float
+    duration_ms: float
+    critical_ms: float = 0.0
+
+    @property
+    def end_ms(self) -> float:
+        return self.start_ms + self.duration_ms
+
+
+@dataclass(slots=True)
+class CriticalSegment:
+    """A maximal stretch of the critical path owned by one span (or idle)."""
+
+    category: SpanCategory
+    name: str
+    start_ms: float
+    end_ms: float
+
+
+@dataclass(slots=True)
+class Waterfall:
+    start_ms: float = 0.0
+    end_ms: float = 0.0
+    bars: list[WaterfallBar] = field(default_factory=list)
+    critical_path: list[CriticalSegment] = field(default_factory=list)
+    breakdown: dict[SpanCategory, float] = field(default_factory=dict)
+
+    @property
+    def wall_ms(self) -> float:
+        return self.end_ms - self.start_ms
+
+    @property
+    def codeplane_ms(self) -> float:
+        """Critical-path time spent in CodePlane's own stages."""
+        return self.breakdown.get(SpanCategory.overhead, 0.0) + self.breakdown.get(SpanCategory.queue, 0.0)
+
+    def overhead_stages(self) -> dict[str, float]:
+        """Critical-path ms per internal stage name, largest first."""
+        stages: dict[str, float] = {}
+        for bar in self.bars:
+            if bar.category in (SpanCategory.overhead, SpanCategory.queue) and bar.critical_ms > 0:
+                stages[bar.name] = stages.get(bar.name, 0.0) + bar.critical_ms
+        return dict(sorted(stages.items(), key=lambda kv: kv[1], reverse=True))
+
+    def to_dict(self) -> dict[str, Any]:
+        """Shape of ``JobWaterfallResponse`` (minus ``job_id``)."""
+        wall = self.wall_ms
+        return {
+            "start_ms": round(self.start_ms, 1),
+            "wall_ms": round(wall, 1),
+            "codeplane_ms": round(self.codeplane_ms, 1),
+            "codeplane_pct": round(self.codeplane_ms / wall * 100, 1) if wall > 0 else 0.0,
+            "breakdown": {c.value: round(self.breakdown.get(c, 0.0), 1) for c in SpanCategory},
+            "overhead_stages": {name: round(ms, 1) for name, ms in self.overhead_stages().items()},
+            "bars": [
+                {
+                    "name": b.name,
+                    "category": b.category.value,
+                    "start_ms": round(b.start_ms, 1),
+                    "duration_ms": round(b.duration_ms, 1),
+                    "critical_ms": round(b.critical_ms, 1),
+                }
+                for b in self.bars
+            ],
+            "critical_path": [
+                {
+                    "category": s.category.value,
+                    "name": s.name,
+                    "start_ms": round(s.start_ms, 1),
+                    "end_ms": round(s.end_ms, 1),
+                }
+                for s in self.critical_path
+            ],
+        }
+
+
+def classify(span: Mapping[str, Any]) -> SpanCategory:
+    """Map a persisted span row to its waterfall category."""
+    span_type = span.get("span_type")
+    if span_type == "llm":
+        return SpanCategory.llm
+    if span_type == "tool":
+        return SpanCategory.tool
+    if span_type == INTERNAL_SPAN_TYPE:
+        return _INTERNAL_CATEGORIES.get(str(span.get("name") or ""), SpanCategory.overhead)
+    return SpanCategory.overhead
+
+
+def build_waterfall(spans: Iterable[Mapping[str, Any]], *, wall_ms: float = 0.0) -> Waterfall:
+    """Sweep *spans* (rows from ``TelemetrySpansRepo.list_for_job``) into a waterfall.
+
+    Span ``started_at`` is seconds from the job's span origin.  *wall_ms* is
+    the job's measured duration from that origin; time after the last span
+    up to it is idle.  Queue wait is recorded before the origin, so the
+    timeline may start below zero.
+    """
+    bars = sorted(
+        (
+            WaterfallBar(
+                name=str(span.get("name") or ""),
+                category=classify(span),
+                start_ms=float(span.get("started_at") or 0.0) * 1000,
+                duration_ms=max(float(span.get("duration_ms") or 0.0), 0.0),
+            )
+            for span in spans
+        ),
+        key=lambda b: (b.start_ms, -b.duration_ms),
+    )
+    waterfall = Waterfall(bars=bars)
+    if not bars and wall_ms <= 0:
+        return waterfall
+
+    start = min([0.0, *(b.start_ms for b in bars)])
+    end = max([wall_ms, *(b.end_ms for b in bars)])
+    waterfall.start_ms, waterfall.end_ms = start, end
+
+    # (time, is_start, bar index); ends sort before starts at the same instant
+    events = sorted(
+        [(b.start_ms, 1, i) for i, b in enumerate(bars) if b.duration_ms > 0]
+        + [(b.end_ms, 0, i) for i, b in enumerate(bars) if b.duration_ms > 0]
+    )
+    active: dict[SpanCategory, set[int]] = {c: set() for c in _PRECEDENCE}
+    breakdown: dict[SpanCategory, float] = {}
+    path = waterfall.critical_path
+    cursor = start
+
+    def _attribute(until: float) -> None:
+        if until <= cursor:
+            return
+        owner: int | None = None
+        for category in _PRECEDENCE:
+            if active[category]:
+                # Latest-started span of the winning category (innermost on the timeline)
+                owner = max(active[category])
+                break
+        if owner is None:
+            category, name = SpanCategory.idle, "idle"
+        else:
+            bar = bars[owner]
+            bar.critical_ms += until - cursor
+            category, name = bar.category, bar.name
+        breakdown[category] = breakdown.get(category, 0.0) + until - cursor
+        if path and path[-1].category == category and path[-1].name == name and path[-1].end_ms == cursor:
+            path[-1].end_ms = until
+        else:
+            path.append(CriticalSegment(category=category, name=name, start_ms=cursor, end_ms=until))
+
+    for at, is_start, idx in events:
+        _attribute(at)
+        cursor = max(cursor, at)
+        if is_start:
+            active[bars[idx].category].add(idx)
+        else:
+            active[bars[idx].category].discard(idx)
+    _attribute(end)
+
+    waterfall.breakdown = breakdown
+    return waterfall
@@ -3,13 +3,12 @@
 from __future__ import annotations
 
 import asyncio
-import contextlib
-from collections.abc import Callable, Coroutine
-from typing import Any
+from collections.abc import Callable, Coroutine, Iterable
+from typing import Any, NamedTuple
 
 import structlog
 
-from backend.models.events import DomainEvent
+from backend.models.events import DomainEvent, DomainEventKind
 
 log = structlog.get_logger()
 
@@ -17,40 +16,79 @@ log = structlog.get_logger()
 Subscriber = Callable[[DomainEvent], Coroutine[Any, Any, None]]
 
 
+class _Subscription(NamedTuple):
+    handler: Subscriber
+    kinds: frozenset[DomainEventKind] | None  # None = every kind
+    job_id: str | None  # None = every job
+
+
 class EventBus:
     """In-process async pub/sub for domain events.
 
-    Subscribers are async callables. Publishing fans out to all subscribers
-    concurrently via ``asyncio.gather``. Subscriber exceptions are logged
-    but do not prevent other subscribers from receiving the event.
+    Subscribers are async callables, optionally limited to a set of event
+    kinds and/or one job.  Publishing looks the event's kind up in a table
+    precomputed on (un)subscribe and fans out to the interested subscribers
+    concurrently via ``asyncio.gather``; with none interested it returns
+    without scheduling anything.  Subscriber exceptions are logged but do not
+    prevent other subscribers from receiving the event.
     """
 
     def __init__(self) -> None:
-        self._subscribers: list[Subscriber] = []
+        self._subscriptions: list[_Subscription] = []
+        self._by_kind: dict[DomainEventKind, tuple[_Subscription, ...]] = {}
+        self._in_flight = 0
 
-    def subscribe(self, handler: Subscriber) -> None:
-        """Register *handler* to receive all published events."""
-        self._subscribers.append(handler)
+    @property
+    def in_flight(self) -> int:
+        """Publishes currently waiting on subscribers (backpressure indicator)."""
+        return self._in_flight
+
+    def subscribe(
+        self,
+        handler: Subscriber,
+        *,
+        kinds: Iterable[DomainEventKind] | None = None,
+        job_id: str | None = None,
+    ) -> None:
+        """Register *handler* for events of *kinds* (default all) about *job_id* (default any)."""
+        self._subscriptions.append(_Subscription(handler, frozenset(kinds) if kinds is not None else None, job_id))
+        self._reindex()
 
     def unsubscribe(self, handler: Subscriber) -> None:
         """Remove a previously registered handler (no-op if not found)."""
-        with contextlib.suppress(ValueError):
-            self._subscribers.remove(handler)
+        self._subscriptions = [s for s in self._subscriptions if s.handler != handler]
+        self._reindex()
+
+    def _reindex(self) -> None:
+        self._by_kind = {
+            kind: subs
+            for kind in DomainEventKind
+            if (subs := tuple(s for s in self._subscriptions if s.kinds is None or kind in s.kinds))
+        }
 
     async def publish(self, event: DomainEvent) -> None:
-        """Fan-out *event* to every subscriber concurrently."""
-        if not self._subscribers:
+        """Fan-out *event* to every interested subscriber concurrently."""
+        subs = self._by_kind.get(event.kind)
+        if subs is None:
             return
+        if any(s.job_id is not None for s in subs):
+            subs = tuple(s for s in subs if s.job_id is None or s.job_id == event.job_id)
+            if not subs:
+                return
 
-        results = await asyncio.gather(
-            *(sub(event) for sub in self._subscribers),
-            return_exceptions=True,
-        )
-        for idx, result in enumerate(results):
+        self._in_flight += 1
+        try:
+            results = await asyncio.gather(
+                *(s.handler(event) for s in subs),
+                return_exceptions=True,
+            )
+        finally:
+            self._in_flight -= 1
+        for sub, result in zip(subs, results, strict=True):
             if isinstance(result, BaseException):
                 log.error(
                     "event_bus_subscriber_error",
-                    subscriber=str(self._subscribers[idx]),
+                    subscriber=str(sub.handler),
                     event_kind=event.kind,
                     error=str(result),
                 )
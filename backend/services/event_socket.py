@@ -0,0 +1,179 @@
+"""Local IPC event bus between the runtime process and SSE front workers.
+
+In multi-worker mode (``cpl up --workers N``) one runtime process owns the
+event bus, the agents and the database writers, and N front processes serve
+HTTP.  The runtime publishes every event it would broadcast over SSE to each
+connected front as one JSON line on a Unix domain socket.  Each front feeds
+its own :class:`SSEManager`, so building SSE frames and fanning them out to
+browsers happens on as many cores as there are fronts.
+
+A front that falls more than ``_CLIENT_BUFFER`` events behind is disconnected
+rather than allowed to grow the runtime's memory.  On reconnect the front
+closes its SSE streams, and browsers resume through ``Last-Event-ID`` replay.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import contextlib
+import json
+from datetime import datetime
+from typing import TYPE_CHECKING
+
+import structlog
+
+from backend.models.events import DomainEvent, DomainEventKind
+
+if TYPE_CHECKING:
+    from pathlib import Path
+
+    from backend.services.sse_manager import SSEManager
+
+log = structlog.get_logger()
+
+_CLIENT_BUFFER = 10_000
+_LINE_LIMIT = 16 * 1024 * 1024  # transcript payloads can be large
+_RECONNECT_MAX_S = 5.0
+
+
+def encode_event(event: DomainEvent) -> bytes:
+    """One newline-terminated JSON line carrying *event* and its ``db_id``."""
+    record = {
+        "event_id": event.event_id,
+        "job_id": event.job_id,
+        "timestamp": event.timestamp.isoformat(),
+        "kind": event.kind.value,
+        "payload": event.payload,
+        "db_id": event.db_id,
+    }
+    return json.dumps(record, default=str).encode() + b"\n"
+
+
+def decode_event(line: bytes) -> DomainEvent:
+    """Inverse of :func:`encode_event`."""
+    record = json.loads(line)
+    return DomainEvent(
+        event_id=record["event_id"],
+        job_id=record["job_id"],
+        timestamp=datetime.fromisoformat(record["timestamp"]),
+        kind=DomainEventKind(record["kind"]),
+        payload=record["payload"],
+        db_id=record["db_id"],
+    )
+
+
+class EventSocketServer:
+    """Runtime side: publish broadcast events to every connected front."""
+
+    def __init__(self, path: Path) -> None:
+        self._path = path
+        self._clients: set[asyncio.Queue[bytes | None]] = set()
+        self._writers: set[asyncio.Task[None]] = set()
+        self._server: asyncio.Server | None = None
+
+    @property
+    def client_count(self) -> int:
+        return len(self._clients)
+
+    async def start(self) -> None:
+        self._path.unlink(missing_ok=True)
+        self._server = await asyncio.start_unix_server(self._serve, path=str(self._path))
+        self._path.chmod(0o600)
+        log.info("event_socket_listening", path=str(self._path))
+
+    async def close(self) -> None:
+        if self._server is None:
+            return
+        self._server.close()
+        for queue in list(self._clients):
+            self._disconnect(queue)
+        await asyncio.gather(*self._writers, return_exceptions=True)
+        await self._server.wait_closed()
+        self._path.unlink(missing_ok=True)
+
+    async def broadcast_domain_event(self, event: DomainEvent) -> None:
+        """Same signature as :meth:`SSEManager.broadcast_domain_event`."""
+        if not self._clients:
+            return
+        line = encode_event(event)
+        for queue in list(self._clients):
+            try:
+                queue.put_nowait(line)
+            except asyncio.QueueFull:
+                log.warning("event_socket_client_lagging", buffered=queue.qsize())
+                self._disconnect(queue)
+
+    def _disconnect(self, queue: asyncio.Queue[bytes | None]) -> None:
+        self._clients.discard(queue)
+        while not queue.empty():
+            queue.get_nowait()
+        queue.put_nowait(None)
+
+    async def _serve(self, reader: asyncio.StreamReader, writer: asyncio.StreamWriter) -> None:
+        queue: asyncio.Queue[bytes | None] = asyncio.Queue(maxsize=_CLIENT_BUFFER)
+        self._clients.add(queue)
+        task = asyncio.current_task()
+        if task is not None:
+            self._writers.add(task)
+            task.add_done_callback(self._writers.discard)
+        log.debug("event_socket_client_connected", clients=len(self._clients))
+        try:
+            while (line := await queue.get()) is not None:
+                writer.write(line)
+                await writer.drain()
+        except (ConnectionError, asyncio.CancelledError):
+            pass
+        finally:
+            self._clients.discard(queue)
+            writer.close()
+            with contextlib.suppress(Exception):
+                await writer.wait_closed()
+            log.debug("event_socket_client_closed", clients=len(self._clients))
+
+
+class EventSocketClient:
+    """Front side: feed events from the runtime into the local SSE manager."""
+
+    def __init__(self, path: Path, sse_manager: SSEManager) -> None:
+        self._path = path
+        self._sse_manager = sse_manager
+
+    async def handle(self, line: bytes) -> bool:
+        """Broadcast one received line; False when it cannot be decoded."""
+        try:
+            event = decode_event(line)
+        except (ValueError, KeyError, TypeError):
+            log.warning("event_socket_bad_line", line=line[:200])
+            return False
+        await self._sse_manager.broadcast_domain_event(event)
+        return True
+
+    async def run(self) -> None:
+        """Consume forever, reconnecting with backoff; launch as a background task."""
+        delay = 0.1
+        connected_before = False
+        while True:
+            try:
+                reader, writer = await asyncio.open_unix_connection(str(self._path), limit=_LINE_LIMIT)
+            except (OSError, ValueError):
+                await asyncio.sleep(delay)
+                delay = min(delay * 2, _RECONNECT_MAX_S)
+                continue
+            if connected_before:
+                # Events were missed while disconnected — make browsers
+                # reconnect so Last-Event-ID replay fills the gap.
+                await self._sse_manager.close_all()
+            connected_before = True
+            delay = 0.1
+            log.info("event_socket_connected", path=str(self._path))
+            try:
+                while line := await reader.readline():
+                    try:
+                        await self.handle(line)
+                    except Exception:
+                        log.warning("event_socket_broadcast_failed", exc_info=True)
+            except (ConnectionError, asyncio.LimitOverrunError, ValueError):
+                log.warning("event_socket_read_failed", exc_info=True)
+            finally:
+                writer.close()
+            log.warning("event_socket_disconnected", path=str(self._path))
@@ -0,0 +1,180 @@
+"""In-memory file-access counters, flushed to the database in batches.
+
+Agents read and write files on most tool calls.  Writing one row (and one
+session and commit) per access made file telemetry the busiest write path
+of a running job.  Adapters instead count each access here, per job and
+path, and the counters are upserted into ``job_file_access_stats`` every
+:data:`FLUSH_EVERY` distinct files or :data:`FLUSH_INTERVAL_S` seconds,
+whichever comes first, and when the job finalizes.  The interval flush runs
+from :meth:`FileAccessTracker.flush_loop`, so counters of a job that stops
+touching files still reach the database.
+
+Individual accesses are only written to ``job_file_access_log`` for a
+sample of them (``telemetry.file_access_raw_sample_rate``, off by default).
+"""
+
+from __future__ import annotations
+
+import asyncio
+import random
+import time
+from dataclasses import asdict, dataclass
+from datetime import UTC, datetime
+from typing import TYPE_CHECKING, Any
+
+import structlog
+
+if TYPE_CHECKING:
+    from sqlalchemy.ext.asyncio import AsyncSession, async_sessionmaker
+
+log = structlog.get_logger()
+
+# Distinct (job, file) counters pending before a flush is due
+FLUSH_EVERY = 64
+# Longest a counted access waits for a flush
+FLUSH_INTERVAL_S = 5.0
+
+
+@dataclass
+class FileAccessCounts:
+    """Accesses to one file by one job since the last flush."""
+
+    read_count: int = 0
+    write_count: int = 0
+    read_bytes: int = 0
+    first_turn: int | None = None
+    last_turn: int | None = None
+    first_access_at: str = ""
+    last_access_at: str = ""
+
+    def add(self, other: FileAccessCounts) -> None:
+        self.read_count += other.read_count
+        self.write_count += other.write_count
+        self.read_bytes += other.read_bytes
+        turns = [t for t in (self.first_turn, other.first_turn) if t is not None]
+        self.first_turn = min(turns) if turns else None
+        turns = [t for t in (self.last_turn, other.last_turn) if t is not None]
+        self.last_turn = max(turns) if turns else None
+        self.first_access_at = min(filter(None, (self.first_access_at, other.first_access_at)), default="")
+        self.last_access_at = max(self.last_access_at, other.last_access_at)
+
+
+class FileAccessTracker:
+    """Per-job, per-path access counters awaiting a batched flush."""
+
+    def __init__(self, *, raw_sample_rate: float = 0.0) -> None:
+        self.raw_sample_rate = raw_sample_rate
+        self._pending: dict[tuple[str, str], FileAccessCounts] = {}
+        self._raw: dict[str, list[dict[str, Any]]] = {}
+        self._last_flush = time.monotonic()
+        self._flushing = False
+
+    @property
+    def pending(self) -> int:
+        return len(self._pending)
+
+    def record(
+        self,
+        job_id: str,
+        file_path: str,
+        access_type: str,
+        *,
+        turn_number: int | None = None,
+        byte_count: int | None = None,
+    ) -> bool:
+        """Count one access.  Returns whether a flush is now due."""
+        now = datetime.now(UTC).isoformat()
+        is_read = access_type == "read"
+        delta = FileAccessCounts(
+            read_count=1 if is_read else 0,
+            write_count=0 if is_read else 1,
+            read_bytes=(byte_count or 0) if is_read else 0,
+            first_turn=turn_number,
+            last_turn=turn_number,
+            first_access_at=now,
+            last_access_at=now,
+        )
+        counts = self._pending.get((job_id, file_path))
+        if counts is None:
+            self._pending[(job_id, file_path)] = delta
+        else:
+            counts.add(delta)
+        if self.raw_sample_rate > 0 and random.random() < self.raw_sample_rate:  # noqa: S311
+            self._raw.setdefault(job_id, []).append(
+                {
+                    "file_path": file_path,
+                    "access_type": access_type,
+                    "turn_number": turn_number,
+                    "byte_count": byte_count,
+                    "created_at": now,
+                }
+            )
+        return not self._flushing and (
+            len(self._pending) >= FLUSH_EVERY or time.monotonic() - self._last_flush >= FLUSH_INTERVAL_S
+        )
+
+    async def flush(self, session_factory: async_sessionmaker[AsyncSession], job_id: str | None = None) -> int:
+        """Write pending counters (only *job_id*'s when given); returns the rows upserted.
+
+        Counters that fail to write are kept and retried on the next flush.
+        """
+        from backend.persistence.file_access_repo import FileAccessRepo
+
+        counts, raw = self._drain(job_id)
+        if not counts and not raw:
+            return 0
+        self._flushing = True
+        try:
+            async with session_factory() as session:
+                repo = FileAccessRepo(session)
+                await repo.merge_counts(
+                    [{"job_id": jid, "file_path": path, **asdict(c)} for (jid, path), c in counts.items()]
+                )
+                for jid, entries in raw.items():
+                    await repo.record_batch(job_id=jid, entries=entries)
+                await session.commit()
+        except Exception:
+            self._restore(counts, raw)
+            log.debug("file_access_flush_failed", rows=len(counts), exc_info=True)
+            return 0
+        finally:
+            self._flushing = False
+        return len(counts)
+
+    async def flush_loop(self, session_factory: async_sessionmaker[AsyncSession]) -> None:
+        """Flush on a timer. Designed to be launched as a background task."""
+        while True:
+            await asyncio.sleep(FLUSH_INTERVAL_S)
+            if self._pending or self._raw:
+                await self.flush(session_factory)
+
+    def _drain(
+        self, job_id: str | None
+    ) -> tuple[dict[tuple[str, str], FileAccessCounts], dict[str, list[dict[str, Any]]]]:
+        if job_id is None:
+            counts, self._pending = self._pending, {}
+            raw, self._raw = self._raw, {}
+            self._last_flush = time.monotonic()
+            return counts, raw
+        counts = {key: self._pending.pop(key) for key in [k for k in self._pending if k[0] == job_id]}
+        entries = self._raw.pop(job_id, None)
+        return counts, {job_id: entries} if entries else {}
+
+    def _restore(self, counts: dict[tuple[str, str], FileAccessCounts], raw: dict[str, list[dict[str, Any]]]) -> None:
+        for key, c in counts.items():
+            pending = self._pending.get(key)
+            if pending is None:
+                self._pending[key] = c
+            else:
+                c.add(pending)
+                self._pending[key] = c
+        for jid, entries in raw.items():
+            self._raw[jid] = entries + self._raw.get(jid, [])
+
+
+_tracker = FileAccessTracker()
+
+
+def get_file_access_tracker() -> FileAccessTracker:
+    """The process-wide tracker shared by the agent adapters and the runtime."""
+    return _tracker
@@ -0,0 +1,146 @@
+"""Resolve a worktree's HEAD commit by reading git's files, without spawning git.
+
+StepTracker records HEAD at every step boundary.  ``git rev-parse HEAD``
+costs a fork and exec per call.  Reading ``HEAD`` and the ref it names costs
+a few ``stat`` calls once warm: each file's content is cached against its
+``(mtime_ns, size, inode)``.  git rewrites refs by renaming a lock file over
+them, so every update shows up as a new inode.
+
+Handles plain repositories and linked worktrees (a ``.git`` file with
+``gitdir:`` plus ``commondir``), symbolic and detached HEAD, loose refs and
+``packed-refs``.  Anything else returns None, so the caller can fall back to
+``git rev-parse``.  That includes reftable repositories, unborn branches and
+unreadable files.
+"""
+
+from __future__ import annotations
+
+import os
+import re
+from pathlib import Path
+
+_SHA_RE = re.compile(r"[0-9a-f]{40}(?:[0-9a-f]{24})?")
+# Refs stored per worktree rather than in the shared common dir
+_PER_WORKTREE_PREFIXES = ("refs/worktree/", "refs/bisect/", "refs/rewritten/")
+_MAX_SYMREF_DEPTH = 5
+
+_StatKey = tuple[int, int, int]
+
+
+def _stat_key(path: Path) -> _StatKey | None:
+    try:
+        st = os.stat(path)
+    except OSError:
+        return None
+    return st.st_mtime_ns, st.st_size, st.st_ino
+
+
+class GitHeadCache:
+    """Stat-validated cache of HEAD, loose-ref and packed-refs file contents."""
+
+    def __init__(self) -> None:
+        self._dirs: dict[str, tuple[Path, Path]] = {}  # worktree → (gitdir, commondir)
+        self._files: dict[Path, tuple[_StatKey, str]] = {}
+        self._packed: dict[Path, tuple[_StatKey, dict[str, str]]] = {}
+        self._keys: dict[str, set[Path]] = {}  # worktree → file paths cached on its behalf
+
+    def head(self, worktree: str) -> str | None:
+        """Commit SHA that HEAD of *worktree* points at, or None when unresolvable."""
+        dirs = self._git_dirs(worktree)
+        if dirs is None:
+            return None
+        gitdir, common = dirs
+        keys = self._keys.setdefault(worktree, set())
+        value = self._read(gitdir / "HEAD", keys)
+        for _ in range(_MAX_SYMREF_DEPTH):
+            if value is None:
+                return None
+            if not value.startswith("ref:"):
+                return value if _SHA_RE.fullmatch(value) else None
+            value = self._resolve_ref(value[4:].strip(), gitdir, common, keys)
+        return None
+
+    def forget(self, worktree: str) -> None:
+        """Drop cached state for a worktree that is going away.
+
+        Evicts every file read for it, including loose refs and packed-refs
+        in the common dir of a linked worktree.  Worktrees sharing that
+        common dir just re-read those files on their next lookup.
+        """
+        dirs = self._dirs.pop(worktree, None)
+        for path in self._keys.pop(worktree, ()):
+            self._files.pop(path, None)
+        if dirs is not None and all(d[1] != dirs[1] for d in self._dirs.values()):
+            self._packed.pop(dirs[1], None)
+
+    def _git_dirs(self, worktree: str) -> tuple[Path, Path] | None:
+        cached = self._dirs.get(worktree)
+        if cached is not None:
+            return cached
+        dotgit = Path(worktree) / ".git"
+        if dotgit.is_dir():
+            gitdir = dotgit
+        else:
+            try:
+                pointer = dotgit.read_text(encoding="utf-8").strip()
+            except (OSError, UnicodeDecodeError):
+                return None  # Not created yet — retry next time
+            if not pointer.startswith("gitdir:"):
+                return None
+            gitdir = (Path(worktree) / pointer[7:].strip()).resolve()
+        try:
+            common_rel = (gitdir / "commondir").read_text(encoding="utf-8").strip()
+            common = (gitdir / common_rel).resolve()
+        except (OSError, UnicodeDecodeError):
+            common = gitdir
+        if (common / "reftable").is_dir():
+            return None
+        self._dirs[worktree] = (gitdir, common)
+        return gitdir, common
+
+    def _read(self, path: Path, keys: set[Path]) -> str | None:
+        key = _stat_key(path)
+        if key is None:
+            self._files.pop(path, None)
+            return None
+        cached = self._files.get(path)
+        if cached is not None and cached[0] == key:
+            return cached[1]
+        try:
+            text = path.read_text(encoding="utf-8").strip()
+        except (OSError, UnicodeDecodeError):
+            return None
+        self._files[path] = (key, text)
+        keys.add(path)
+        return text
+
+    def _resolve_ref(self, ref: str, gitdir: Path, common: Path, keys: set[Path]) -> str | None:
+        if not ref.startswith("refs/") or ".." in ref:
+            return None
+        base = gitdir if ref.startswith(_PER_WORKTREE_PREFIXES) else common
+        loose = self._read(base / ref, keys)
+        if loose is not None:
+            return loose
+        return self._packed_refs(common).get(ref)
+
+    def _packed_refs(self, common: Path) -> dict[str, str]:
+        path = common / "packed-refs"
+        key = _stat_key(path)
+        if key is None:
+            return {}
+        cached = self._packed.get(common)
+        if cached is not None and cached[0] == key:
+            return cached[1]
+        refs: dict[str, str] = {}
+        try:
+            with path.open(encoding="utf-8") as fh:
+                for line in fh:
+                    if line.startswith(("#", "^")):
+                        continue
+                    sha, _, name = line.strip().partition(" ")
+                    if name:
+                        refs[name] = sha
+        except (OSError, UnicodeDecodeError):
+            return {}
+        self._packed[common] = (key, refs)
+        return refs
@@ -7,12 +7,15 @@ import contextlib
 import os
 import re
 import shutil
+import time
 from pathlib import Path
 from typing import TYPE_CHECKING
 
 import structlog
 
 if TYPE_CHECKING:
+    from collections.abc import Sequence
+
     from backend.config import CPLConfig
 
 log = structlog.get_logger()
@@ -48,8 +51,12 @@ class GitService:
 
     async def _run_git(self, *args: str, cwd: str | Path) -> str:
         """Run a git command and return stdout. Raises GitError on failure."""
+        from backend.services import telemetry as tel
+
         env = {**os.environ, "GIT_TERMINAL_PROMPT": "0"}
         cwd_path = Path(cwd)
+        command = args[0] if args else "git"
+        started = time.monotonic()
         try:
             proc = await asyncio.create_subprocess_exec(
                 "git",
@@ -72,6 +79,9 @@ class GitService:
         stdout = stdout_bytes.decode().strip()
         stderr = stderr_bytes.decode().strip()
 
+        outcome = "ok" if proc.returncode == 0 else "error"
+        tel.git_commands.add(1, {"command": command, "outcome": outcome})
+        tel.git_duration.record((time.monotonic() - started) * 1000, {"command": command})
         if proc.returncode != 0:
             raise GitError(
                 f"git {' '.join(args)} failed (exit {proc.returncode}): {stderr}",
@@ -83,8 +93,10 @@ class GitService:
         """Run `git diff <diff_spec>` and return raw output."""
         return await self._run_git("diff", diff_spec, cwd=cwd)
 
-    async def diff_range(self, ref1: str, ref2: str, *, cwd: str | Path) -> str:
-        """Run `git diff <ref1> <ref2>` comparing two commits (no working tree)."""
+    async def diff_range(self, ref1: str, ref2: str, *, cwd: str | Path, paths: Sequence[str] = ()) -> str:
+        """Run `git diff <ref1> <ref2> [-- <paths>]` comparing two commits (no working tree)."""
+        if paths:
+            return await self._run_git("diff", ref1, ref2, "--", *paths, cwd=cwd)
         return await self._run_git("diff", ref1, ref2, cwd=cwd)
 
     async def merge_base(self, ref1: str, ref2: str, *, cwd: str | Path) -> str:
@@ -2,11 +2,10 @@
 
 from __future__ import annotations
 
-import glob
 from dataclasses import dataclass
 from datetime import UTC, datetime
 from pathlib import Path
-from typing import TYPE_CHECKING, Any
+from typing import TYPE_CHECKING, Any, TypeVar
 
 import structlog
 
@@ -17,13 +16,18 @@ from backend.models.domain import (
     InvalidStateTransitionError,
     Job,
     JobState,
+    JobSummary,
     PermissionMode,
     Resolution,
     validate_state_transition,
 )
+from backend.persistence.job_repo import encode_job_cursor
 from backend.services.agent_adapter import validate_sdk_model
+from backend.services.repo_registry import get_repo_registry, resolve_repos
 
 if TYPE_CHECKING:
+    from collections.abc import Set as AbstractSet
+
     from sqlalchemy.ext.asyncio import AsyncSession
 
     from backend.config import CPLConfig
@@ -35,7 +39,7 @@ if TYPE_CHECKING:
 
 log = structlog.get_logger()
 
-_MAX_COUNT_LIMIT = 10_000  # upper bound for count queries that scan all jobs
+_T = TypeVar("_T", Job, JobSummary)
 
 
 class RepoNotAllowedError(Exception):
@@ -59,6 +63,15 @@ class ProgressPreview:
     summary: str
 
 
+def _page(jobs: list[_T], limit: int) -> tuple[list[_T], str | None, bool]:
+    """Trim a ``limit + 1`` fetch to *limit* and build the cursor for the next page."""
+    has_more = len(jobs) > limit
+    if has_more:
+        jobs = jobs[:limit]
+    next_cursor = encode_job_cursor(jobs[-1].created_at, jobs[-1].id) if has_more and jobs else None
+    return jobs, next_cursor, has_more
+
+
 class JobService:
     """Orchestrates job creation, state transitions, and control actions."""
 
@@ -107,24 +120,18 @@ class JobService:
             event_repo=event_repo,
         )
 
-    def _resolve_repos(self) -> set[str]:
-        """Expand glob patterns and return the full set of allowed repo paths.
+    def _resolve_repos(self) -> AbstractSet[str]:
+        """Return the full set of allowed repo paths.
 
-        Reads fresh from disk on every call so that repos registered after
-        app startup (via the settings API) are immediately visible.
+        Served from memory by the server's :class:`RepoRegistry`, which still
+        sees repos registered after startup (via the settings API) on the next
+        call.  Without one (CLI, tests) the config is read and glob patterns
+        expanded on every call.
         """
-        fresh_repos = load_config().repos
-        allowed: set[str] = set()
-        for pattern in fresh_repos:
-            expanded = Path(pattern).expanduser()
-            if "*" in pattern or "?" in pattern:
-                for match in glob.glob(str(expanded), recursive=True):
-                    p = Path(match).resolve()
-                    if p.is_dir() and (p / ".git").exists():
-                        allowed.add(str(p))
-            else:
-                allowed.add(str(expanded.resolve()))
-        return allowed
+        registry = get_repo_registry()
+        if registry is not None:
+            return registry.allowed()
+        return resolve_repos(load_config().repos)
 
     async def list_events_by_job(
         self,
@@ -195,6 +202,13 @@ class JobService:
         Returns the created Job domain object.
         Raises RepoNotAllowedError if the repo is not in the allowlist.
         """
+        registry = get_repo_registry()
+        if registry is not None:
+            if not registry.ready:
+                # A repo matched by a glob still being expanded must not be rejected
+                await registry.wait_ready()
+            # Nor one cloned under a glob before the watcher's rescan
+            await registry.discover(repo)
         resolved_repo = self.validate_repo(repo)
 
         assert self._git is not None, "GitService required for job creation"
@@ -429,11 +443,23 @@ class JobService:
             cursor=cursor,
             include_archived=include_archived,
         )
-        has_more = len(jobs) > limit
-        if has_more:
-            jobs = jobs[:limit]
-        next_cursor = jobs[-1].id if has_more and jobs else None
-        return jobs, next_cursor, has_more
+        return _page(jobs, limit)
+
+    async def list_job_summaries(
+        self,
+        state: str | None = None,
+        limit: int = 50,
+        cursor: str | None = None,
+        archived: bool | None = None,
+    ) -> tuple[list[JobSummary], str | None, bool]:
+        """Like :meth:`list_jobs`, without prompt texts — for listings that show many jobs."""
+        jobs = await self._job_repo.list_summaries(
+            state=state,
+            limit=limit + 1,
+            cursor=cursor,
+            include_archived=archived,
+        )
+        return _page(jobs, limit)
 
     async def transition_state(self, job_id: str, new_state: JobState, *, failure_reason: str | None = None) -> Job:
         """Transition a job's state. Validates the transition."""
@@ -484,16 +510,11 @@ class JobService:
 
     async def count_active_jobs(self) -> int:
         """Count currently active (non-terminal) jobs."""
-        jobs = await self._job_repo.list(
-            state=",".join(ACTIVE_STATES),
-            limit=_MAX_COUNT_LIMIT,
-        )
-        return len(jobs)
+        return await self._job_repo.count(",".join(ACTIVE_STATES))
 
     async def count_queued_jobs(self) -> int:
         """Count queued jobs."""
-        jobs = await self._job_repo.list(state=JobState.queued, limit=_MAX_COUNT_LIMIT)
-        return len(jobs)
+        return await self._job_repo.count(JobState.queued)
 
     async def resolve_job(self, job_id: str, action: str) -> Job:
         """Validate that a job is eligible for resolution.
@@ -0,0 +1,145 @@
+"""OpenMetrics text rendering of the in-process OTEL metrics.
+
+Serves the ``/metrics`` scrape endpoint without an extra exporter dependency:
+the ``InMemoryMetricReader`` that :mod:`backend.services.telemetry` always
+installs is collected on demand and rendered in the OpenMetrics 1.0 text
+format.
+
+Agent instruments are labelled per job (``job_id``, ``branch``), which would
+give Prometheus one series per job forever.  Those labels are dropped here and
+the points re-aggregated: counters and histograms are summed, gauges keep the
+maximum.
+"""
+
+from __future__ import annotations
+
+import math
+import re
+from dataclasses import dataclass, field
+from typing import TYPE_CHECKING, Any
+
+from opentelemetry.sdk.metrics.export import Gauge, Histogram, HistogramDataPoint, Sum
+
+if TYPE_CHECKING:
+    from collections.abc import Mapping
+
+    from opentelemetry.sdk.metrics.export import MetricsData
+
+CONTENT_TYPE = "application/openmetrics-text; version=1.0.0; charset=utf-8"
+
+# Per-job / unbounded attributes never exported as labels.
+HIGH_CARDINALITY_LABELS: frozenset[str] = frozenset({"job_id", "branch", "session_id", "turn_id"})
+
+_INVALID_NAME_CHARS = re.compile(r"[^a-zA-Z0-9_:]")
+
+LabelKey = tuple[tuple[str, str], ...]
+
+
+@dataclass(slots=True)
+class _Family:
+    name: str
+    kind: str  # counter | gauge | histogram
+    description: str
+    values: dict[LabelKey, float] = field(default_factory=dict)
+    # histogram: label key -> (explicit bounds, bucket counts, sum, count)
+    histograms: dict[LabelKey, tuple[tuple[float, ...], list[int], float, int]] = field(default_factory=dict)
+
+
+def metric_name(otel_name: str) -> str:
+    """``cp.tokens.input`` -> ``cp_tokens_input``."""
+    name = _INVALID_NAME_CHARS.sub("_", otel_name)
+    return f"_{name}" if name[:1].isdigit() else name
+
+
+def _label_key(attributes: Mapping[str, Any] | None) -> LabelKey:
+    items = []
+    for key, value in (attributes or {}).items():
+        if key in HIGH_CARDINALITY_LABELS:
+            continue
+        if isinstance(value, bool):
+            value = "true" if value else "false"
+        items.append((metric_name(key), str(value)))
+    return tuple(sorted(items))
+
+
+def _escape(value: str) -> str:
+    return value.replace("\\", "\\\\").replace("\n", "\\n").replace('"', '\\"')
+
+
+def _format_labels(key: LabelKey, extra: tuple[str, str] | None = None) -> str:
+    pairs = [*key, extra] if extra else list(key)
+    if not pairs:
+        return ""
+    return "{" + ",".join(f'{k}="{_escape(v)}"' for k, v in pairs) + "}"
+
+
+def _format_value(value: float) -> str:
+    if math.isinf(value):
+        return "+Inf" if value > 0 else "-Inf"
+    if math.isnan(value):
+        return "NaN"
+    if float(value).is_integer():
+        return str(int(value))
+    return repr(float(value))
+
+
+def _merge_histogram(family: _Family, key: LabelKey, point: HistogramDataPoint) -> None:
+    bounds = tuple(point.explicit_bounds)
+    prev = family.histograms.get(key)
+    if prev is None or prev[0] != bounds:
+        family.histograms[key] = (bounds, list(point.bucket_counts), point.sum, point.count)
+    else:
+        counts = [a + b for a, b in zip(prev[1], point.bucket_counts, strict=True)]
+        family.histograms[key] = (bounds, counts, prev[2] + point.sum, prev[3] + point.count)
+
+
+def _collect(data: MetricsData) -> dict[str, _Family]:
+    families: dict[str, _Family] = {}
+    for resource_metrics in data.resource_metrics:
+        for scope_metrics in resource_metrics.scope_metrics:
+            for metric in scope_metrics.metrics:
+                name = metric_name(metric.name)
+                payload = metric.data
+                if isinstance(payload, Sum):
+                    kind = "counter" if payload.is_monotonic else "gauge"
+                elif isinstance(payload, Gauge):
+                    kind = "gauge"
+                elif isinstance(payload, Histogram):
+                    kind = "histogram"
+                else:
+                    continue  # exponential histograms are not produced by our views
+                family = families.setdefault(name, _Family(name, kind, metric.description or ""))
+                for point in payload.data_points:
+                    key = _label_key(point.attributes)
+                    if isinstance(point, HistogramDataPoint):
+                        _merge_histogram(family, key, point)
+                    elif kind == "counter":
+                        family.values[key] = family.values.get(key, 0.0) + point.value
+                    else:
+                        family.values[key] = max(family.values.get(key, -math.inf), point.value)
+    return families
+
+
+def render(data: MetricsData | None) -> str:
+    """Render collected OTEL metrics as an OpenMetrics text exposition."""
+    lines: list[str] = []
+    families = _collect(data) if data is not None else {}
+    for name in sorted(families):
+        family = families[name]
+        lines.append(f"# TYPE {name} {family.kind}")
+        if family.description:
+            lines.append(f"# HELP {name} {family.description}")
+        if family.kind == "histogram":
+            for key, (bounds, counts, total, count) in sorted(family.histograms.items()):
+                cumulative = 0
+                for bound, bucket in zip((*bounds, math.inf), counts, strict=True):
+                    cumulative += bucket
+                    lines.append(f"{name}_bucket{_format_labels(key, ('le', _format_value(bound)))} {cumulative}")
+                lines.append(f"{name}_count{_format_labels(key)} {count}")
+                lines.append(f"{name}_sum{_format_labels(key)} {_format_value(total)}")
+        else:
+            suffix = "_total" if family.kind == "counter" else ""
+            for key, value in sorted(family.values.items()):
+                lines.append(f"{name}{suffix}{_format_labels(key)} {_format_value(value)}")
+    lines.append("# EOF")
+    return "\n".join(lines) + "\n"
@@ -17,10 +17,20 @@ routed to the operator for explicit approval and can never be bypassed:
 * ``git reset --hard`` — destructive history rewrite that discards all
   uncommitted changes and moves HEAD.  An agent must never run this
   without a human story and explicit sign-off.
+
+Fast path
+---------
+This module runs on every tool call.  The rule table is compiled once into
+per-mode lookups, and decisions that need no input are folded to constants.
+The hard-gate and read-only patterns are combined into a single anchored
+regex, so one match classifies a shell command.  Classifications are kept
+in an LRU keyed by the command text.  Path checks are never cached, because
+``realpath`` answers change when symlinks do.
 """
 
 from __future__ import annotations
 
+import functools
 import os
 import re
 from enum import StrEnum
@@ -46,14 +56,14 @@ class PolicyDecision(StrEnum):
 # permission mode.  These are irreversible or bypass CodePlane controls
 # (e.g. merging outside the managed merge flow).
 # ---------------------------------------------------------------------------
-_HARD_GATED_SHELL_RE = re.compile(
-    r"(?i)"
+_HARD_GATED_SHELL = (
     # git merge / pull / rebase / cherry-pick — bypass CodePlane merge controls
     r"(?:^\s*git\s+(?:merge|pull|rebase|cherry-pick)\b)"
     # git reset --hard — destructive history rewrite
     r"|(?:^\s*git\s+reset\s+.*--hard\b)"
-    r"|(?:^\s*git\s+reset\s+--hard\b)",
+    r"|(?:^\s*git\s+reset\s+--hard\b)"
 )
+_HARD_GATED_SHELL_RE = re.compile(_HARD_GATED_SHELL, re.IGNORECASE)
 
 
 # ---------------------------------------------------------------------------
@@ -96,6 +106,8 @@ def is_git_reset_hard(command: str) -> bool:
     stripped before matching so that literal text inside arguments does not
     cause false positives.
     """
+    if "--hard" not in command.lower():
+        return False  # cheap reject before stripping quotes
     return bool(_GIT_RESET_HARD_RE.search(_strip_quoted_strings(command)))
 
 
@@ -104,7 +116,7 @@ def is_git_reset_hard(command: str) -> bool:
 # Covers Unix (grep, ls, cat …), Windows cmd (dir, findstr, where …),
 # and PowerShell cmdlets (Get-ChildItem, Select-String …).
 # ---------------------------------------------------------------------------
-_READONLY_SHELL_RE = re.compile(
+_READONLY_SHELL = (
     r"^\s*("
     # Unix
     r"grep|egrep|fgrep|rg|find|ls|cat|head|tail|wc|sort|diff|file|stat|du|tree"
@@ -116,9 +128,50 @@ _READONLY_SHELL_RE = re.compile(
     r"|Select-String|Measure-Object|Compare-Object|Test-Path|Resolve-Path"
     r"|Write-Output|Out-Host|Format-List|Format-Table"
     r"|gci|gc|gi|sls|measure|compare"
-    r")\b",
-    re.IGNORECASE,
+    r")\b"
 )
+_READONLY_SHELL_RE = re.compile(_READONLY_SHELL, re.IGNORECASE)
+
+# Both alternatives are anchored at the start, so a single ``match`` tells a
+# hard-gated command from a read-only one from anything else.
+_SHELL_CLASS_RE = re.compile(f"(?P<gated>{_HARD_GATED_SHELL})|(?P<readonly>{_READONLY_SHELL})", re.IGNORECASE)
+
+_GATED = "gated"
+_READONLY = "readonly"
+_OTHER = "other"
+
+_SHELL_CACHE_SIZE = 4096
+_SHELL_CACHE_MAX_LEN = 4096  # longer commands (heredocs, scripts) are classified uncached
+
+
+def _classify_shell_uncached(command: str) -> str:
+    m = _SHELL_CLASS_RE.match(command)
+    if m is not None and m.group("gated") is not None:
+        return _GATED
+    if is_git_reset_hard(command):
+        return _GATED
+    return _READONLY if m is not None else _OTHER
+
+
+_classify_shell_cached = functools.lru_cache(maxsize=_SHELL_CACHE_SIZE)(_classify_shell_uncached)
+
+
+def _classify_shell(command: str) -> str:
+    """Classify *command* as hard-gated, read-only or other."""
+    if len(command) > _SHELL_CACHE_MAX_LEN:
+        return _classify_shell_uncached(command)
+    # Surrounding whitespace never changes a classification
+    return _classify_shell_cached(command.strip())
+
+
+def is_hard_gated(command: str) -> bool:
+    """Return True if *command* must always be routed to the operator.
+
+    Covers ``git merge``/``pull``/``rebase``/``cherry-pick`` and every form of
+    ``git reset --hard`` — the commands :func:`evaluate` always answers with
+    ``ask``.
+    """
+    return bool(command) and _classify_shell(command) == _GATED
 
 
 def _is_path_within_workspace(path: str, workspace: str) -> bool:
@@ -187,6 +240,19 @@ _MODE_DEFAULTS: dict[str, PolicyDecision] = {
 }
 
 
+def _compile_rules(rules: dict[tuple[str, str], _Rule]) -> dict[str, dict[str, _Rule]]:
+    """Split the rule table per mode, folding rules whose outcome is fixed."""
+    compiled: dict[str, dict[str, _Rule]] = {}
+    for (mode, kind), rule in rules.items():
+        if rule.decision == _PATH_WS and rule.fallback == _APPROVE:
+            rule = _Rule(_APPROVE)  # approve whether or not the path is inside
+        compiled.setdefault(mode, {})[kind] = rule
+    return compiled
+
+
+_MODE_RULES = _compile_rules(_RULES)
+
+
 def _resolve(
     rule: _Rule,
     *,
@@ -194,7 +260,7 @@ def _resolve(
     file_name: str | None,
     path: str | None,
     possible_paths: list[str] | None,
-    full_command_text: str | None,
+    shell_class: str,
     read_only: bool | None,
 ) -> PolicyDecision:
     """Resolve a rule entry into a concrete PolicyDecision."""
@@ -212,8 +278,7 @@ def _resolve(
         return rule.fallback
 
     if decision == _SHELL_RO:
-        cmd = full_command_text or ""
-        return _APPROVE if _READONLY_SHELL_RE.match(cmd) else rule.fallback
+        return _APPROVE if shell_class == _READONLY else rule.fallback
 
     if decision == _MCP_RO:
         return _APPROVE if read_only else rule.fallback
@@ -283,15 +348,14 @@ def _evaluate(
     # Hard-gated commands always require approval, regardless of mode or trust level.
     # _HARD_GATED_SHELL_RE covers merge/pull/rebase/cherry-pick and simple git reset --hard.
     # is_git_reset_hard() additionally catches compound commands (e.g. cd /x && git reset --hard).
-    if (
-        kind == "shell"
-        and full_command_text
-        and (_HARD_GATED_SHELL_RE.search(full_command_text) or is_git_reset_hard(full_command_text))
-    ):
-        log.info("hard_gated_command", command=full_command_text, mode=mode)
-        return _ASK
-
-    rule = _RULES.get((mode, kind))
+    shell_class = _OTHER
+    if kind == "shell" and full_command_text:
+        shell_class = _classify_shell(full_command_text)
+        if shell_class == _GATED:
+            log.info("hard_gated_command", command=full_command_text, mode=mode)
+            return _ASK
+
+    rule = _MODE_RULES.get(mode, {}).get(kind)
     if rule is None:
         default = _MODE_DEFAULTS.get(mode, _ASK)
         if default == _ASK:
@@ -304,6 +368,6 @@ def _evaluate(
         file_name=file_name,
         path=path,
         possible_paths=possible_paths,
-        full_command_text=full_command_text,
+        shell_class=shell_class,
         read_only=read_only,
     )
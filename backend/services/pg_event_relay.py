@@ -0,0 +1,149 @@
+"""Cross-process event fan-out over PostgreSQL LISTEN/NOTIFY.
+
+With a shared PostgreSQL database several CodePlane server processes can
+serve the same team.  Each process persists its own events and broadcasts
+them to its own SSE clients; :meth:`EventRepository.append` also issues a
+``pg_notify`` carrying the new row id.  The relay LISTENs on that channel,
+loads events appended by *other* processes and broadcasts them locally, so
+every browser sees every job regardless of which process runs it.
+
+Only the SSE stream is fed — remote events are not republished on the local
+event bus, whose subscribers (persistence, step tracking) already ran in the
+process that produced them.  In multi-worker mode the relay feeds the
+event socket instead, since the front workers hold the SSE clients.
+
+Each running job is driven by exactly one process, the holder of its lease
+(see :meth:`JobRepository.claim_lease`).  Requests that need the live agent
+session — cancel, operator messages, approval decisions — may reach any
+process, so they are forwarded on a second channel through
+:class:`ControlChannel` and acted on by whichever process holds the session.
+The same channel tells every process to reload the learned approval rules
+when one of them disables a rule.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import json
+from typing import TYPE_CHECKING, Any
+
+import structlog
+from sqlalchemy import make_url, text
+
+from backend.persistence.event_repo import EVENT_CHANNEL, PROCESS_ORIGIN, EventRepository
+
+if TYPE_CHECKING:
+    from collections.abc import Awaitable, Callable
+
+    from sqlalchemy.ext.asyncio import AsyncSession, async_sessionmaker
+
+    from backend.services.event_socket import EventSocketServer
+    from backend.services.sse_manager import SSEManager
+
+log = structlog.get_logger()
+
+_RECONNECT_MAX_S = 30.0
+
+# NOTIFY channel carrying ``{"op", "origin", ...}`` requests for the process driving a job.
+CONTROL_CHANNEL = "codeplane_control"
+# PostgreSQL rejects NOTIFY payloads of 8000 bytes or more
+_NOTIFY_MAX_BYTES = 7999
+
+
+class ControlPayloadTooLargeError(ValueError):
+    """A control request does not fit in one NOTIFY payload."""
+
+
+class ControlChannel:
+    """Sends control requests to the other server processes sharing the database."""
+
+    def __init__(self, session_factory: async_sessionmaker[AsyncSession]) -> None:
+        self._session_factory = session_factory
+
+    async def send(self, op: str, **fields: Any) -> None:
+        payload = json.dumps({"op": op, "origin": PROCESS_ORIGIN, **fields})
+        if len(payload.encode()) > _NOTIFY_MAX_BYTES:
+            raise ControlPayloadTooLargeError(f"{op} request is too large to forward to another server process")
+        async with self._session_factory() as session:
+            await session.execute(
+                text("SELECT pg_notify(:channel, :payload)"), {"channel": CONTROL_CHANNEL, "payload": payload}
+            )
+            await session.commit()
+        log.debug("pg_control_sent", op=op)
+
+
+class PgEventRelay:
+    """LISTEN loop rebroadcasting events persisted by other server processes."""
+
+    def __init__(
+        self,
+        url: str,
+        session_factory: async_sessionmaker[AsyncSession],
+        sse_manager: SSEManager | EventSocketServer,
+    ) -> None:
+        # libpq wants a plain ``postgresql://`` DSN, not the SQLAlchemy driver URL
+        self._dsn = make_url(url).set(drivername="postgresql").render_as_string(hide_password=False)
+        self._session_factory = session_factory
+        self._sse_manager = sse_manager
+        self._control_handlers: dict[str, Callable[[dict[str, Any]], Awaitable[object]]] = {}
+
+    def on_control(self, op: str, handler: Callable[[dict[str, Any]], Awaitable[object]]) -> None:
+        """Run *handler* for ``op`` requests sent by other processes."""
+        self._control_handlers[op] = handler
+
+    async def handle_control(self, payload: str) -> bool:
+        """Dispatch a control request; False when skipped."""
+        try:
+            request = json.loads(payload)
+            handler = self._control_handlers.get(request["op"])
+        except (ValueError, KeyError, TypeError):
+            log.warning("pg_control_bad_payload", payload=payload[:200])
+            return False
+        if handler is None or request.get("origin") == PROCESS_ORIGIN:
+            return False
+        await handler(request)
+        return True
+
+    async def handle(self, payload: str) -> bool:
+        """Broadcast the event named by a notification; False when skipped."""
+        try:
+            note = json.loads(payload)
+            db_id = int(note["id"])
+        except (ValueError, KeyError, TypeError):
+            log.warning("pg_event_relay_bad_payload", payload=payload[:200])
+            return False
+        if note.get("origin") == PROCESS_ORIGIN:
+            return False
+        async with self._session_factory() as session:
+            event = await EventRepository(session).get(db_id)
+        if event is None:
+            return False
+        await self._sse_manager.broadcast_domain_event(event)
+        return True
+
+    async def run(self) -> None:
+        """Listen forever, reconnecting with backoff; launch as a background task."""
+        import psycopg
+
+        delay = 1.0
+        while True:
+            try:
+                async with await psycopg.AsyncConnection.connect(self._dsn, autocommit=True) as conn:
+                    await conn.execute(f"LISTEN {EVENT_CHANNEL}")
+                    await conn.execute(f"LISTEN {CONTROL_CHANNEL}")
+                    log.info("pg_event_relay_listening", channels=[EVENT_CHANNEL, CONTROL_CHANNEL])
+                    delay = 1.0
+                    async for notify in conn.notifies():
+                        try:
+                            if notify.channel == CONTROL_CHANNEL:
+                                await self.handle_control(notify.payload)
+                            else:
+                                await self.handle(notify.payload)
+                        except Exception:
+                            log.warning("pg_event_relay_broadcast_failed", channel=notify.channel, exc_info=True)
+            except asyncio.CancelledError:
+                raise
+            except Exception:
+                log.warning("pg_event_relay_disconnected", retry_in_s=delay, exc_info=True)
+            await asyncio.sleep(delay)
+            delay = min(delay * 2, _RECONNECT_MAX_S)
@@ -631,6 +631,8 @@ class ProgressTrackingService:
 class _ProgressSubscriber:
     """EventBus subscriber that dispatches events to ProgressTrackingService."""
 
+    EVENT_KINDS = frozenset({DomainEventKind.step_completed})
+
     def __init__(self, service: ProgressTrackingService) -> None:
         self._svc = service
 
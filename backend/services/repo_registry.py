@@ -0,0 +1,362 @@
+"""In-memory allowlist of repositories, kept fresh without disk work per lookup.
+
+``config.repos`` holds explicit paths and glob patterns such as ``~/src/**``.
+Expanding a recursive pattern walks the whole tree and stats ``.git`` in every
+directory, which takes seconds under a large home directory.  The server's
+registry expands each pattern once, in a worker thread, and then:
+
+* re-reads ``config.yaml`` when its mtime or size changes.  That costs one
+  ``stat`` per lookup, so a repo registered through the API is allowed on the
+  very next request;
+* re-expands only the patterns whose root saw a repository appear or
+  disappear, reported by ``watchfiles`` (inotify / FSEvents, or polling
+  every ``poll_interval_s`` when native watching is unavailable).  Ordinary
+  edits and builds inside a working tree do not trigger a rescan.
+
+Until the first expansion has finished, lookups answer with the explicit
+paths plus whatever patterns are already expanded; callers that must not miss
+a glob match await :meth:`RepoRegistry.wait_ready` first, then
+:meth:`RepoRegistry.discover` for a repo cloned since.  Only without a running
+event loop (CLI) does a lookup expand synchronously, as :func:`resolve_repos`
+always did.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import contextlib
+import fnmatch
+import glob
+import os
+from pathlib import Path
+from typing import TYPE_CHECKING
+
+import structlog
+
+from backend.config import get_codeplane_dir, load_config
+
+if TYPE_CHECKING:
+    from collections.abc import Iterable
+
+    from watchfiles import Change
+
+log = structlog.get_logger()
+
+# Batch window for filesystem events; a clone creates ``.git`` once
+_WATCH_DEBOUNCE_MS = 200
+
+# Upper bound on how long a lookup waits for the first expansion
+_READY_TIMEOUT_S = 30.0
+
+
+def is_pattern(entry: str) -> bool:
+    return "*" in entry or "?" in entry
+
+
+def expand_pattern(pattern: str) -> frozenset[str]:
+    """Git repositories matching one glob *pattern*."""
+    found: set[str] = set()
+    for match in glob.glob(str(Path(pattern).expanduser()), recursive=True):
+        p = Path(match).resolve()
+        if p.is_dir() and (p / ".git").exists():
+            found.add(str(p))
+    return frozenset(found)
+
+
+def resolve_repos(entries: Iterable[str]) -> set[str]:
+    """Expand glob patterns and return the full set of allowed repo paths."""
+    allowed: set[str] = set()
+    for entry in entries:
+        if is_pattern(entry):
+            allowed |= expand_pattern(entry)
+        else:
+            allowed.add(str(Path(entry).expanduser().resolve()))
+    return allowed
+
+
+def _split_pattern(pattern: str) -> tuple[tuple[str, ...], tuple[str, ...]]:
+    """Split *pattern* into its fixed leading directories and the wildcard rest."""
+    parts = Path(pattern).expanduser().parts
+    for i, part in enumerate(parts):
+        if is_pattern(part) or "[" in part:
+            return parts[:i], parts[i:]
+    return parts, ()
+
+
+def pattern_root(pattern: str) -> Path:
+    """The deepest directory of *pattern* before the first wildcard — what to watch."""
+    fixed, _ = _split_pattern(pattern)
+    return Path(*fixed).resolve() if fixed else Path.cwd()
+
+
+def _match_parts(pattern: tuple[str, ...], parts: tuple[str, ...]) -> bool:
+    if not pattern:
+        return not parts
+    head, rest = pattern[0], pattern[1:]
+    if head == "**":
+        return any(
+            _match_parts(rest, parts[i:])
+            for i in range(len(parts) + 1)
+            if not any(p.startswith(".") for p in parts[:i])
+        )
+    if not parts or (parts[0].startswith(".") and not head.startswith(".")):
+        return False
+    return fnmatch.fnmatchcase(parts[0], head) and _match_parts(rest, parts[1:])
+
+
+def pattern_matches(pattern: str, path: str) -> bool:
+    """Whether the resolved directory *path* is one that *pattern* would expand to.
+
+    Follows :func:`glob.glob` with ``recursive=True``: ``**`` spans any number
+    of directories and wildcards do not match names starting with a dot.
+    """
+    try:
+        rel = Path(path).relative_to(pattern_root(pattern)).parts
+    except ValueError:
+        return False
+    return _match_parts(_split_pattern(pattern)[1], rel)
+
+
+class RepoRegistry:
+    """Allowed repository paths, resolved in O(1) from memory."""
+
+    def __init__(self, config_path: Path | None = None, *, poll_interval_s: float = 30.0) -> None:
+        self._config_path = config_path or get_codeplane_dir() / "config.yaml"
+        self._poll_interval_s = poll_interval_s
+        self._signature: tuple[int, int] | None = None  # (mtime_ns, size) of config.yaml when last read
+        self._explicit: frozenset[str] = frozenset()
+        self._patterns: tuple[str, ...] = ()
+        self._worktrees_dirname = ""
+        self._matches: dict[str, frozenset[str]] = {}  # pattern → repos found, once expanded
+        self._allowed: frozenset[str] = frozenset()
+        self._expansions: set[asyncio.Task[None]] = set()
+        self._watch_task: asyncio.Task[None] | None = None
+        self._ready = asyncio.Event()
+
+    @property
+    def ready(self) -> bool:
+        """Whether every glob pattern has been expanded at least once."""
+        return all(p in self._matches for p in self._patterns)
+
+    async def wait_ready(self, timeout: float = _READY_TIMEOUT_S) -> bool:
+        """Wait until every glob pattern has been expanded; ``False`` on timeout."""
+        with contextlib.suppress(TimeoutError):
+            await asyncio.wait_for(self._ready.wait(), timeout)
+        return self._ready.is_set()
+
+    async def start(self) -> None:
+        """Read the config and begin expanding and watching in the background."""
+        self._load_config()
+
+    async def close(self) -> None:
+        tasks = [*self._expansions, *([self._watch_task] if self._watch_task else [])]
+        for task in tasks:
+            task.cancel()
+        for task in tasks:
+            with contextlib.suppress(asyncio.CancelledError):
+                await task
+        self._expansions.clear()
+        self._watch_task = None
+
+    def allowed(self) -> frozenset[str]:
+        """All allowed repo paths.  Costs one ``stat`` of ``config.yaml``, never a tree walk on the loop.
+
+        While patterns are still being expanded this is the explicit paths plus
+        the matches known so far; see :meth:`wait_ready`.
+        """
+        if self._config_signature() != self._signature:
+            self._load_config()
+        pending = [p for p in self._patterns if p not in self._matches]
+        if pending:
+            try:
+                asyncio.get_running_loop()
+            except RuntimeError:
+                # No loop to block (CLI): answer correctly rather than quickly
+                return self._allowed.union(*map(expand_pattern, pending))
+            if not self._expansions:
+                self._expand_later(pending)
+        return self._allowed
+
+    async def discover(self, repo: str) -> None:
+        """Allow *repo* at once if it matches a glob but appeared since the last expansion.
+
+        A repository cloned under a watched root is otherwise only picked up
+        by the watcher's rescan, which lags the clone by the debounce window
+        (or a whole poll interval).  Only *repo* itself is checked, in a
+        worker thread; the rest of the pattern is left to the watcher.
+        """
+        allowed = self.allowed()
+        patterns = [p for p in self._patterns if p in self._matches]
+        if not patterns:
+            return
+
+        def _check() -> tuple[str, list[str]]:
+            path = Path(repo).expanduser().resolve()
+            if str(path) in allowed or not (path.is_dir() and (path / ".git").exists()):
+                return str(path), []
+            return str(path), [p for p in patterns if pattern_matches(p, str(path))]
+
+        path, matched = await asyncio.to_thread(_check)
+        for pattern in matched:
+            if pattern in self._matches:  # not removed from the config meanwhile
+                self._matches[pattern] = self._matches[pattern] | {path}
+        if matched:
+            self._rebuild()
+            log.debug("repo_registry_discovered", repo=path, patterns=len(matched))
+
+    # ------------------------------------------------------------------
+
+    def _config_signature(self) -> tuple[int, int] | None:
+        try:
+            st = self._config_path.stat()
+        except OSError:
+            return None
+        return st.st_mtime_ns, st.st_size
+
+    def _load_config(self) -> None:
+        self._signature = self._config_signature()
+        config = load_config(self._config_path)
+        self._worktrees_dirname = config.runtime.worktrees_dirname
+        entries = config.repos
+        patterns = tuple(dict.fromkeys(e for e in entries if is_pattern(e)))
+        self._explicit = frozenset(str(Path(e).expanduser().resolve()) for e in entries if not is_pattern(e))
+        self._matches = {p: m for p, m in self._matches.items() if p in patterns}
+        patterns_changed = patterns != self._patterns
+        self._patterns = patterns
+        self._rebuild()
+        if patterns_changed:
+            with contextlib.suppress(RuntimeError):  # no running loop (sync callers)
+                asyncio.get_running_loop()
+                self._expand_later([p for p in patterns if p not in self._matches])
+                self._restart_watch()
+        log.debug("repo_registry_config_loaded", explicit=len(self._explicit), patterns=len(patterns))
+
+    def _rebuild(self) -> None:
+        self._allowed = self._explicit.union(*self._matches.values())
+        if self.ready:
+            self._ready.set()
+        else:
+            self._ready.clear()
+
+    def _expand_later(self, patterns: list[str]) -> None:
+        if not patterns:
+            return
+        task = asyncio.get_running_loop().create_task(self._expand(patterns), name="repo-registry-expand")
+        self._expansions.add(task)
+        task.add_done_callback(self._expansions.discard)
+
+    async def _expand(self, patterns: list[str]) -> None:
+        results = await asyncio.to_thread(lambda: {p: expand_pattern(p) for p in patterns})
+        for pattern, found in results.items():
+            if pattern in self._patterns:  # not removed from the config meanwhile
+                self._matches[pattern] = found
+        self._rebuild()
+        log.debug("repo_registry_expanded", patterns=len(results), repos=len(self._allowed))
+
+    def _restart_watch(self) -> None:
+        if self._watch_task is not None:
+            self._watch_task.cancel()
+        self._watch_task = None
+        roots = {root for root in map(pattern_root, self._patterns) if root.is_dir()}
+        if roots:
+            self._watch_task = asyncio.get_running_loop().create_task(self._watch(roots), name="repo-registry-watch")
+
+    @staticmethod
+    def _is_structural(change: Change, path: str) -> bool:
+        from watchfiles import Change
+
+        # Edits inside a working tree never add or remove a repository
+        return change != Change.modified
+
+    def _on_changes(self, changes: set[tuple[Change, str]]) -> None:
+        task = asyncio.get_running_loop().create_task(self._rescan(changes), name="repo-registry-rescan")
+        self._expansions.add(task)
+        task.add_done_callback(self._expansions.discard)
+
+    async def _rescan(self, changes: set[tuple[Change, str]]) -> None:
+        paths = await asyncio.to_thread(self._repo_changes, changes, self._allowed, self._worktrees_dirname)
+        affected = self._affected(paths)
+        if affected:
+            await self._expand(affected)
+
+    @staticmethod
+    def _repo_changes(
+        changes: set[tuple[Change, str]], allowed: frozenset[str], worktrees_dirname: str = ""
+    ) -> list[str]:
+        """The changed paths that may add or remove a repository.  Runs in a worker thread.
+
+        Job worktrees (under *worktrees_dirname*) carry a ``.git`` file of their
+        own but are never repositories to allow, so their churn is ignored.
+        """
+        from watchfiles import Change
+
+        relevant: list[str] = []
+        added: list[str] = []
+        for change, path in changes:
+            if worktrees_dirname and worktrees_dirname in Path(path).parts:
+                continue
+            if Path(path).name == ".git":
+                relevant.append(path)
+            elif change == Change.deleted:
+                # A known repo, or a directory holding some, was removed or moved away
+                if any(repo == path or repo.startswith(path + "/") for repo in allowed):
+                    relevant.append(path)
+            else:
+                added.append(path)
+        # A directory created with its contents (clone, move in) may have been
+        # populated before the watcher saw it, so look inside rather than wait
+        # for a ``.git`` event.  Subtrees of another added path are covered by it.
+        tops = set(added)
+        for path in added:
+            if any(parent in tops for parent in map(str, Path(path).parents)):
+                continue
+            if any(".git" in dirs or ".git" in files for _, dirs, files in os.walk(path)):
+                relevant.append(path)
+        return relevant
+
+    def _affected(self, paths: Iterable[str]) -> list[str]:
+        changed = [Path(p) for p in paths]
+        return [p for p in self._patterns if any(c.is_relative_to(pattern_root(p)) for c in changed)]
+
+    async def _watch(self, roots: set[Path]) -> None:
+        try:
+            from watchfiles import awatch
+        except ImportError:
+            await self._poll()
+            return
+        force_polling = False
+        while True:
+            try:
+                async for changes in awatch(
+                    *roots,
+                    watch_filter=self._is_structural,
+                    debounce=_WATCH_DEBOUNCE_MS,
+                    force_polling=force_polling,
+                    poll_delay_ms=int(self._poll_interval_s * 1000),
+                ):
+                    self._on_changes(changes)
+                return
+            except OSError as exc:
+                # Typically the inotify watch limit under a very large tree
+                if force_polling:
+                    raise
+                log.warning("repo_registry_watch_failed", error=str(exc), fallback="polling")
+                force_polling = True
+
+    async def _poll(self) -> None:
+        while True:
+            await asyncio.sleep(self._poll_interval_s)
+            self._expand_later(list(self._patterns))
+
+
+_registry: RepoRegistry | None = None
+
+
+def set_repo_registry(registry: RepoRegistry | None) -> None:
+    """Install the server's registry (``None`` to go back to reading the config per call)."""
+    global _registry  # noqa: PLW0603
+    _registry = registry
+
+
+def get_repo_registry() -> RepoRegistry | None:
+    return _registry
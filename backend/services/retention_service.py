@@ -1,4 +1,4 @@
-"""Retention policy — artifact cleanup, worktree cleanup, daily background task."""
+"""Retention policy — artifact cleanup, worktree cleanup, analysis counter pruning, daily background task."""
 
 from __future__ import annotations
 
@@ -11,6 +11,7 @@ from typing import TYPE_CHECKING
 import structlog
 
 from backend.config import CODEPLANE_DIR
+from backend.persistence.analysis_counters_repo import AnalysisCountersRepo
 from backend.persistence.artifact_repo import ArtifactRepository
 from backend.persistence.job_repo import JobRepository
 
@@ -52,12 +53,14 @@ class RetentionService:
 
         archive_cutoff = datetime.now(tz=UTC) - timedelta(days=self._auto_archive_days)
         auto_archived = await self._auto_archive_resolved_jobs(archive_cutoff)
+        counters_pruned = await self._prune_analysis_counters()
 
         summary = {
             "artifacts_deleted": artifacts_deleted,
             "snapshots_deleted": snapshots_deleted,
             "worktrees_deleted": worktrees_deleted,
             "auto_archived": auto_archived,
+            "analysis_counters_pruned": counters_pruned,
         }
         log.info("retention_cleanup_done", **summary)
         return summary
@@ -166,3 +169,13 @@ class RetentionService:
             if count > 0:
                 log.info("auto_archived_resolved_jobs", count=count)
             return count
+
+    async def _prune_analysis_counters(self) -> int:
+        """Drop statistical-analysis counters for days outside the detectors' window."""
+        async with self._session_factory() as session:
+            count = await AnalysisCountersRepo(session).prune_expired()
+            await session.commit()
+
+            if count > 0:
+                log.info("retention_analysis_counters_pruned", count=count)
+            return count
@@ -15,8 +15,9 @@ import contextlib
 import dataclasses
 import enum
 import re
+import time
 from datetime import UTC, datetime
-from typing import TYPE_CHECKING, cast
+from typing import TYPE_CHECKING, Any, cast
 
 import structlog
 
@@ -35,7 +36,7 @@ from backend.services.progress_tracking_service import ProgressTrackingService
 from backend.services.step_tracker import StepTracker
 
 if TYPE_CHECKING:
-    from collections.abc import AsyncIterator
+    from collections.abc import AsyncIterator, Awaitable, Callable
 
     from backend.persistence.job_repo import JobRepository
 
@@ -100,6 +101,21 @@ class _SessionAttemptResult:
     downgrade: tuple[str, str] | None = None  # (requested, actual) model names
 
 
+@dataclasses.dataclass
+class RecoveryProgress:
+    """Progress of the startup crash recovery run by ``start_recovery``."""
+
+    total: int = 0
+    recovered: int = 0
+    failed: int = 0
+    started_at: datetime | None = None
+    finished_at: datetime | None = None
+
+    @property
+    def in_progress(self) -> bool:
+        return self.started_at is not None and self.finished_at is None
+
+
 if TYPE_CHECKING:
     from sqlalchemy.ext.asyncio import AsyncSession, async_sessionmaker
 
@@ -108,6 +124,8 @@ if TYPE_CHECKING:
     from backend.services.adapter_registry import AdapterRegistry
     from backend.services.agent_adapter import AgentAdapterInterface
     from backend.services.approval_service import ApprovalService
+    from backend.services.columnar_store import ColumnarStore
+    from backend.services.cost_ledger import CostLedger
     from backend.services.diff_service import DiffService
     from backend.services.event_bus import EventBus
     from backend.services.job_service import JobService
@@ -129,6 +147,12 @@ _DEFAULT_RESUME_INSTRUCTION = "Continue the current task from where you left off
 # Heartbeat configuration
 _HEARTBEAT_INTERVAL_S = 30
 
+# Job leases are renewed this often (well inside JobRepository's LEASE_TTL_S)
+_LEASE_RENEW_INTERVAL_S = 20
+
+# Buffered internal stage spans are written at job end or after this long
+_STAGE_FLUSH_INTERVAL_S = 5.0
+
 # Default prompts for post-completion verification and self-review turns
 DEFAULT_VERIFY_PROMPT = (
     "You are now running a post-task verification pass. "
@@ -204,6 +228,9 @@ class RuntimeService:
         sister_sessions: SisterSessionManager | None = None,
         step_tracker: StepTracker | None = None,
         progress_tracking: ProgressTrackingService | None = None,
+        columnar_store: ColumnarStore | None = None,
+        cost_ledger: CostLedger | None = None,
+        shared_database: bool = False,
     ) -> None:
         self._session_factory = session_factory
         self._event_bus = event_bus
@@ -218,7 +245,8 @@ class RuntimeService:
         self._step_tracker = step_tracker
         self._tasks: dict[str, asyncio.Task[None]] = {}
         self._agent_sessions: dict[str, _AgentSession] = {}
-        self._heartbeat_tasks: dict[str, asyncio.Task[None]] = {}
+        # One ticker for all running jobs; alive only while any job is
+        self._heartbeat_task: asyncio.Task[None] | None = None
         self._last_activity: dict[str, float] = {}
         self._waiting_for_approval: set[str] = set()
         self._session_ids: dict[str, str] = {}
@@ -233,6 +261,30 @@ class RuntimeService:
         self._echo_suppress: dict[str, set[str]] = {}
         # Progress tracking (headline milestones + plan extraction)
         self._progress_tracking = progress_tracking
+        # Optional DuckDB/Parquet engine for cross-job analysis
+        self._columnar_store = columnar_store
+        # Live spend ledger for budget enforcement (None = budgets not enforced)
+        self._cost_ledger = cost_ledger
+        self._budget_paused: set[str] = set()
+        self._budget_tasks: set[asyncio.Task[Any]] = set()
+        # Fires a dequeue pass at the next month boundary while jobs are held for budget
+        self._budget_wakeup: asyncio.TimerHandle | None = None
+        if cost_ledger is not None:
+            cost_ledger.on_rollover = self.release_budget_holds
+        # Waterfall timeline: span origin per running job, and when held jobs entered the queue
+        self._span_origins: dict[str, float] = {}
+        self._enqueued_at: dict[str, float] = {}
+        # Stage spans (name, started_at, duration_ms) waiting for the batched write
+        self._stage_spans: dict[str, list[tuple[str, float, float]]] = {}
+        self._stage_flush_task: asyncio.Task[None] | None = None
+        # Startup crash recovery, run in the background by start_recovery()
+        self._recovery = RecoveryProgress()
+        self._recovery_task: asyncio.Task[None] | None = None
+        # Other server processes may run jobs from the same database: job
+        # leases are honoured, and requests for jobs this process does not
+        # drive go out through forward_control (set by the lifespan).
+        self._shared_database = shared_database
+        self.forward_control: Callable[..., Awaitable[None]] | None = None
 
     def _resolve_adapter(self, sdk: str) -> AgentAdapterInterface:
         """Resolve the adapter for a given SDK via the registry."""
@@ -249,24 +301,165 @@ class RuntimeService:
             config=self._config,
         )
 
+    def _record_stage(self, job_id: str, name: str, started: float, ended: float | None = None) -> None:
+        """Buffer an ``internal`` span for one of CodePlane's own job stages.
+
+        *started* / *ended* are ``time.monotonic()`` readings (*ended* defaults
+        to now).  Spans are written in one transaction per flush — at job end
+        or ``_STAGE_FLUSH_INTERVAL_S`` after the first unflushed span — so
+        stage timing never adds a write to the stage it measures.  Jobs
+        without a span origin are skipped.
+        """
+        origin = self._span_origins.get(job_id)
+        if origin is None:
+            return
+        ended = time.monotonic() if ended is None else ended
+        duration_ms = round((ended - started) * 1000, 1)
+
+        from backend.services import telemetry as tel
+
+        tel.stage_duration.record(duration_ms, {"stage": name})
+        self._stage_spans.setdefault(job_id, []).append((name, round(started - origin, 3), duration_ms))
+        if self._stage_flush_task is None or self._stage_flush_task.done():
+            self._stage_flush_task = asyncio.create_task(self._flush_stage_spans_later(), name="stage-span-flush")
+
+    async def _flush_stage_spans_later(self) -> None:
+        await asyncio.sleep(_STAGE_FLUSH_INTERVAL_S)
+        await self._flush_stage_spans()
+
+    async def _flush_stage_spans(self, job_id: str | None = None) -> None:
+        """Write buffered stage spans for *job_id* (or every job) in one transaction."""
+        if job_id is None:
+            batches, self._stage_spans = self._stage_spans, {}
+        else:
+            spans = self._stage_spans.pop(job_id, None)
+            batches = {job_id: spans} if spans else {}
+        if not batches:
+            return
+
+        from backend.persistence.telemetry_spans_repo import TelemetrySpansRepo
+        from backend.services.critical_path import INTERNAL_SPAN_TYPE
+
+        try:
+            async with self._session_factory() as session:
+                repo = TelemetrySpansRepo(session)
+                for span_job_id, spans in batches.items():
+                    for name, started_at, duration_ms in spans:
+                        await repo.insert(
+                            job_id=span_job_id,
+                            span_type=INTERNAL_SPAN_TYPE,
+                            name=name,
+                            started_at=started_at,
+                            duration_ms=duration_ms,
+                        )
+                await session.commit()
+        except asyncio.CancelledError:
+            # Put the batch back so the shutdown flush still writes it.
+            for span_job_id, spans in batches.items():
+                self._stage_spans[span_job_id] = spans + self._stage_spans.get(span_job_id, [])
+            raise
+        except Exception:
+            log.debug("stage_span_write_failed", job_ids=sorted(batches), exc_info=True)
+
     async def _finalize_diff_safe(self, job_id: str, worktree_path: str | None, base_ref: str | None) -> None:
         """Finalize the diff snapshot, swallowing exceptions."""
         if self._diff_service is None or not worktree_path or not base_ref:
             return
+        started = time.monotonic()
         try:
             await self._diff_service.finalize(job_id, worktree_path, base_ref)
         except (Exception, asyncio.CancelledError):
             log.warning("diff_finalize_failed", job_id=job_id, exc_info=True)
+        self._record_stage(job_id, "diff_finalize", started)
 
     @property
     def running_count(self) -> int:
         """Number of currently running job tasks."""
         return len(self._tasks)
 
+    @property
+    def pending_count(self) -> int:
+        """Jobs accepted for start but waiting for a free slot."""
+        return len(self._pending_starts)
+
     @property
     def max_concurrent(self) -> int:
         return self._config.runtime.max_concurrent_jobs
 
+    @property
+    def columnar_store(self) -> ColumnarStore | None:
+        return self._columnar_store
+
+    @property
+    def cost_ledger(self) -> CostLedger | None:
+        return self._cost_ledger
+
+    def _budget_blocked(self, job: Job) -> bool:
+        """True when the job's SDK has exhausted its monthly budget."""
+        from backend.services.cost_ledger import BudgetStatus
+
+        if self._cost_ledger is None:
+            return False
+        if self._cost_ledger.month_status(job.sdk) is not BudgetStatus.exhausted:
+            return False
+        self._arm_budget_wakeup()
+        return True
+
+    def _arm_budget_wakeup(self) -> None:
+        """Make sure held jobs are reconsidered when the ledger month rolls over.
+
+        Without this a queue held for budget only moves when another job
+        finishes, which never happens if every queued job is held.
+        """
+        from backend.services.cost_ledger import seconds_until_next_month
+
+        if self._budget_wakeup is not None or self._shutting_down:
+            return
+
+        def _wake() -> None:
+            self._budget_wakeup = None
+            self.release_budget_holds()
+
+        # One second of slack so the ledger's own clock has crossed the boundary.
+        delay = seconds_until_next_month() + 1.0
+        self._budget_wakeup = asyncio.get_running_loop().call_later(delay, _wake)
+
+    def release_budget_holds(self) -> None:
+        """Schedule dequeue passes to start jobs that budget holds may have blocked.
+
+        Called on ledger month rollover and after budget or capacity settings
+        change.  Each pass starts at most one job, so keep going while slots
+        fill up.
+        """
+        if self._shutting_down:
+            return
+
+        async def _fill() -> None:
+            while self.running_count < self.max_concurrent:
+                before = self.running_count
+                await self._dequeue_next()
+                if self.running_count == before:
+                    return
+
+        task = asyncio.create_task(_fill(), name="budget-release")
+        self._budget_tasks.add(task)
+        task.add_done_callback(self._budget_tasks.discard)
+
+    def apply_config(self, config: CPLConfig) -> None:
+        """Adopt capacity and budget settings from a freshly saved config.
+
+        The ledger reads caps from the same ``TelemetryConfig`` object, so the
+        fields are copied in place rather than swapping the object.
+        """
+        self._config.runtime.max_concurrent_jobs = config.runtime.max_concurrent_jobs
+        live, new = self._config.telemetry, config.telemetry
+        live.claude_monthly_budget_usd = new.claude_monthly_budget_usd
+        live.copilot_premium_entitlement = new.copilot_premium_entitlement
+        live.budget_soft_pct = new.budget_soft_pct
+        live.budget_downgrade_models = dict(new.budget_downgrade_models)
+        live.job_budget_usd = new.job_budget_usd
+        self.release_budget_holds()
+
     async def start_or_enqueue(
         self,
         job: Job,
@@ -290,7 +483,11 @@ class RuntimeService:
             log.warning("job_rejected_shutting_down", job_id=job.id)
             return
         async with self._dequeue_lock:
-            if self.running_count >= self.max_concurrent:
+            budget_blocked = self._budget_blocked(job)
+            if self.running_count >= self.max_concurrent or budget_blocked:
+                self._enqueued_at.setdefault(job.id, time.monotonic())
+                if budget_blocked:
+                    log.info("job_held_budget_exhausted", job_id=job.id, sdk=job.sdk)
                 if job.state == JobState.queued:
                     if override_prompt is not None:
                         self._queued_override_prompts[job.id] = override_prompt
@@ -361,6 +558,9 @@ class RuntimeService:
                 raise JobNotFoundError(f"Job {job_id} does not exist.")
             if job.state not in (JobState.running, JobState.waiting_for_approval):
                 raise StateConflictError(f"Job {job_id} is not active and cannot be recovered (current: {job.state}).")
+            # Committed together with the reset below; fails while another live process drives the job
+            if not await job_repo.claim_lease(job_id, honor_leases=self._shared_database):
+                raise StateConflictError(f"Job {job_id} is being run by another server process.")
 
             previous_state = job.state
             previous_session_count = job.session_count
@@ -455,13 +655,21 @@ class RuntimeService:
         # an HTTP request race on the same job.  Only the winner proceeds.
         from backend.persistence.job_repo import JobRepository
 
+        prior_cost = 0.0
         async with self._session_factory() as session:
             repo = JobRepository(session)
-            claimed = await repo.claim_for_start(job.id)
+            claimed = await repo.claim_for_start(job.id, honor_leases=self._shared_database)
             await session.commit()
+            if claimed and self._cost_ledger is not None:
+                from backend.persistence.telemetry_summary_repo import TelemetrySummaryRepo
+
+                summary = await TelemetrySummaryRepo(session).get(job.id)
+                prior_cost = float(summary["total_cost_usd"] or 0) if summary else 0.0
         if not claimed:
             log.warning("job_start_claim_lost", job_id=job.id)
             return
+        if self._cost_ledger is not None:
+            self._cost_ledger.register_job(job.id, repo=job.repo, sdk=job.sdk, cost_usd=prior_cost)
 
         agent_session = _AgentSession()
         self._agent_sessions[job.id] = agent_session
@@ -478,13 +686,18 @@ class RuntimeService:
                 self._permission_overrides.pop(job.id, None),
             )
             if override_prompt is not None:
-                import dataclasses
-
                 session_config = dataclasses.replace(session_config, prompt=override_prompt)
             if resume_sdk_session_id is not None:
-                import dataclasses
-
                 session_config = dataclasses.replace(session_config, resume_sdk_session_id=resume_sdk_session_id)
+            downgrade_model = self._budget_downgrade_model(job)
+            if downgrade_model is not None:
+                log.warning(
+                    "job_model_downgraded_for_budget",
+                    job_id=job.id,
+                    requested=session_config.model,
+                    model=downgrade_model,
+                )
+                session_config = dataclasses.replace(session_config, model=downgrade_model)
 
             task = asyncio.create_task(
                 self._run_job_guarded(job.id, agent_session, session_config, session_number=job.session_count),
@@ -549,10 +762,19 @@ class RuntimeService:
             # This catches the case where CancelledError hit during setup,
             # before the inner try was entered.
             if job_id in self._tasks:
-                heartbeat = self._heartbeat_tasks.pop(job_id, None)
-                if heartbeat:
-                    heartbeat.cancel()
                 await self._cleanup_job_state(job_id)
+            await self._release_lease(job_id)
+
+    async def _release_lease(self, job_id: str) -> None:
+        """Let any server process pick the job up again once this process stops driving it."""
+        from backend.persistence.job_repo import JobRepository
+
+        try:
+            async with self._session_factory() as session:
+                await JobRepository(session).release_leases([job_id])
+                await session.commit()
+        except Exception:
+            log.debug("job_lease_release_failed", job_id=job_id, exc_info=True)
 
     async def _run_job(
         self,
@@ -566,11 +788,13 @@ class RuntimeService:
 
         self._last_activity[job_id] = time.monotonic()
         _job_wall_start = time.monotonic()  # captured here so adapter cleanup can't erase it
-        heartbeat_task = asyncio.create_task(
-            self._heartbeat_loop(job_id),
-            name=f"heartbeat-{job_id}",
-        )
-        self._heartbeat_tasks[job_id] = heartbeat_task
+        # Adapter spans and internal stage spans share this origin
+        self._span_origins[job_id] = _job_wall_start
+        config = dataclasses.replace(config, span_origin=_job_wall_start)
+        enqueued_at = self._enqueued_at.pop(job_id, None)
+        if enqueued_at is not None:
+            self._record_stage(job_id, "queue_wait", enqueued_at, _job_wall_start)
+        self._ensure_heartbeat()
 
         # Start progress tracking (plan-step orchestration)
         if self._progress_tracking is not None:
@@ -646,6 +870,8 @@ class RuntimeService:
         if worktree_path and self._step_tracker is not None:
             self._step_tracker.register_worktree(job_id, worktree_path)
 
+        self._record_stage(job_id, "environment_setup", _job_wall_start)
+
         session_id: str | None = None
         error_reason: str | None = None
         try:
@@ -844,6 +1070,7 @@ class RuntimeService:
             await self._fail_job(job_id, f"Execution error: {exc}")
         finally:
             tel.end_job_span(job_id)
+            finalize_started = time.monotonic()
 
             # Emit finalization phase
             try:
@@ -891,6 +1118,11 @@ class RuntimeService:
                     )
                     await session.commit()
 
+                # Attribution and the detectors read the job's file-access counters
+                from backend.services.file_access_tracker import get_file_access_tracker
+
+                await get_file_access_tracker().flush(self._session_factory, job_id)
+
                 # Run post-job cost attribution pipeline
                 try:
                     async with self._session_factory() as session:
@@ -901,12 +1133,12 @@ class RuntimeService:
                 except Exception:
                     log.warning("cost_attribution_failed", job_id=job_id, exc_info=True)
 
-                # Run statistical analysis (fire-and-forget, non-blocking)
+                # Fold this job into the streaming statistical detectors
                 try:
                     async with self._session_factory() as session:
-                        from backend.services.statistical_analysis import run_analysis
+                        from backend.services.statistical_analysis import update_for_job
 
-                        await run_analysis(session)
+                        await update_for_job(session, job_id)
                         await session.commit()
                 except Exception:
                     log.debug("statistical_analysis_failed", job_id=job_id, exc_info=True)
@@ -926,9 +1158,8 @@ class RuntimeService:
 
             # --- Store post-completion artifacts (telemetry, plan, approvals) ---
             await self._store_post_completion_artifacts(job_id)
+            self._record_stage(job_id, "finalization", finalize_started)
 
-            heartbeat_task.cancel()
-            self._heartbeat_tasks.pop(job_id, None)
             if self._progress_tracking is not None:
                 self._progress_tracking.stop_tracking(job_id)
                 succeeded = final_state == JobState.completed
@@ -1064,6 +1295,7 @@ class RuntimeService:
         # Last-resort guard: if the job is still non-terminal after all error
         # handlers have run, force it to failed so it doesn't stay stuck.
         await self._ensure_terminal_state(job_id)
+        await self._flush_stage_spans(job_id)
 
         if self._progress_tracking is not None:
             self._progress_tracking.cleanup(job_id)
@@ -1078,6 +1310,11 @@ class RuntimeService:
         self._pending_starts.pop(job_id, None)
         self._queued_override_prompts.pop(job_id, None)
         self._queued_resume_session_ids.pop(job_id, None)
+        self._budget_paused.discard(job_id)
+        self._span_origins.pop(job_id, None)
+        self._enqueued_at.pop(job_id, None)
+        if self._cost_ledger is not None:
+            self._cost_ledger.forget_job(job_id)
         if self._sister_sessions is not None:
             await self._sister_sessions.close_job(job_id)
         if self._approval_service is not None:
@@ -1152,6 +1389,33 @@ class RuntimeService:
 
         assert self._approval_service is not None
 
+        approval_id = domain_event.payload.get("approval_id", "")
+        rule = self._approval_service.pop_auto_resolution(approval_id)
+        if rule is not None:
+            # Answered by a learned approval rule — the job keeps running, but
+            # the decision is still published so it shows up in the timeline.
+            await self._event_bus.publish(
+                DomainEvent(
+                    event_id=DomainEvent.make_event_id(),
+                    job_id=job_id,
+                    timestamp=datetime.now(UTC),
+                    kind=DomainEventKind.approval_resolved,
+                    payload={
+                        "approval_id": approval_id,
+                        "resolution": "approved",
+                        "timestamp": datetime.now(UTC).isoformat(),
+                        "auto_approved": True,
+                        "resolved_by": "rule",
+                        "description": domain_event.payload.get("description", ""),
+                        "proposed_action": domain_event.payload.get("proposed_action"),
+                        "rule": {"repo": rule.repo, "action": rule.action, "approvals": rule.approvals},
+                    },
+                )
+            )
+            log.info("approval_auto_approved_by_rule", job_id=job_id, approval_id=approval_id, repo=rule.repo)
+            self._last_activity[job_id] = time.monotonic()
+            return "approved"
+
         async with self._session_factory() as sess:
             svc = self._make_job_service(sess)
             await svc.transition_state(job_id, JobState.waiting_for_approval)
@@ -1161,8 +1425,9 @@ class RuntimeService:
 
         await self._event_bus.publish(domain_event)
 
-        approval_id = domain_event.payload.get("approval_id", "")
+        wait_started = time.monotonic()
         resolution = await self._approval_service.wait_for_resolution(approval_id)
+        self._record_stage(job_id, "approval_wait", wait_started)
 
         await self._event_bus.publish(
             DomainEvent(
@@ -1301,7 +1566,9 @@ class RuntimeService:
             and worktree_path
             and base_ref
         ):
+            diff_started = time.monotonic()
             await self._diff_service.on_worktree_file_modified(job_id, worktree_path, base_ref)
+            self._record_stage(job_id, "diff_update", diff_started)
             return _EventAction.skip, None, None
 
         # Diff recalculation on tool completions (skip internal markers like report_intent)
@@ -1313,7 +1580,14 @@ class RuntimeService:
             and worktree_path
             and base_ref
         ):
+            diff_started = time.monotonic()
             await self._diff_service.on_worktree_file_modified(job_id, worktree_path, base_ref)
+            self._record_stage(job_id, "diff_update", diff_started)
+
+        # Live spend: update the ledger and enforce budgets
+        if session_event.kind == SessionEventKind.usage:
+            await self._record_usage(job_id, session_event.payload)
+            return _EventAction.skip, None, None
 
         domain_event = self._translate_event(job_id, session_event)
         if domain_event is None:
@@ -1647,47 +1921,80 @@ class RuntimeService:
         # Final diff snapshot after verify/review turns
         await self._finalize_diff_safe(job_id, worktree_path, base_ref)
 
-    async def _heartbeat_loop(self, job_id: str) -> None:
-        """Emit periodic heartbeats for session health display."""
-        try:
-            while True:
-                await asyncio.sleep(_HEARTBEAT_INTERVAL_S)
+    def _ensure_heartbeat(self) -> None:
+        """Start the shared heartbeat ticker unless it is already running."""
+        if self._heartbeat_task is None or self._heartbeat_task.done():
+            self._heartbeat_task = asyncio.create_task(self._heartbeat_loop(), name="heartbeat")
 
-                last = self._last_activity.get(job_id)
-                if last is None:
-                    return
+    async def _heartbeat_loop(self) -> None:
+        """Emit one liveness event per tick covering every running job.
 
-                session_id = self._session_ids.get(job_id, "")
-                await self._event_bus.publish(
-                    DomainEvent(
-                        event_id=DomainEvent.make_event_id(),
-                        job_id=job_id,
-                        timestamp=datetime.now(UTC),
-                        kind=DomainEventKind.session_heartbeat,
-                        payload={
-                            "job_id": job_id,
-                            "session_id": session_id,
-                            "timestamp": datetime.now(UTC).isoformat(),
-                        },
-                    )
+        The event carries no ``job_id`` and is broadcast only, never
+        persisted.  The loop exits once no job is running; the next job
+        start restarts it.
+        """
+        while True:
+            await asyncio.sleep(_HEARTBEAT_INTERVAL_S)
+            if not self._last_activity:
+                return
+            now = time.monotonic()
+            jobs = [
+                {"job_id": job_id, "session_id": self._session_ids.get(job_id, ""), "idle_s": round(now - last, 1)}
+                for job_id, last in self._last_activity.items()
+            ]
+            timestamp = datetime.now(UTC)
+            await self._event_bus.publish(
+                DomainEvent(
+                    event_id=DomainEvent.make_event_id(),
+                    job_id="",
+                    timestamp=timestamp,
+                    kind=DomainEventKind.session_heartbeat,
+                    payload={"jobs": jobs, "timestamp": timestamp.isoformat()},
                 )
-        except asyncio.CancelledError:
-            pass
+            )
 
     async def cancel(self, job_id: str) -> None:
         """Cancel a running job by cancelling its asyncio task.
 
         State transitions for non-running jobs (e.g. queued) are handled
         by the service layer (JobService.cancel_job). This method only
-        interacts with in-memory runtime tasks.
+        interacts with in-memory runtime tasks — its own, or, with a
+        shared database, those of the process driving the job.
         """
         task = self._tasks.get(job_id)
         if task is not None:
             task.cancel()
             log.info("job_cancel_requested", job_id=job_id)
+        elif self.forward_control is not None:
+            try:
+                await self.forward_control("cancel", job_id=job_id)
+            except Exception:
+                # The owner's lease tick still sees the canceled state
+                log.warning("job_cancel_forward_failed", job_id=job_id, exc_info=True)
         else:
             log.info("job_cancel_no_running_task", job_id=job_id)
 
+    async def handle_control(self, request: dict[str, Any]) -> None:
+        """Act on a request forwarded by another server process, if this process drives the job."""
+        op, job_id = request.get("op"), str(request.get("job_id", ""))
+        if op == "approval_resolved":
+            if self._approval_service is not None:
+                self._approval_service.settle(str(request["approval_id"]), str(request["resolution"]))
+            return
+        if op == "rules_changed":
+            if self._approval_service is not None:
+                await self._approval_service.reload_rules()
+            return
+        if job_id not in self._tasks:
+            return
+        log.info("job_control_received", op=op, job_id=job_id)
+        if op == "cancel":
+            self._tasks[job_id].cancel()
+        elif op == "message" and job_id in self._agent_sessions:
+            await self.send_message(job_id, str(request["message"]))
+        elif op == "trust" and self._approval_service is not None:
+            await self._approval_service.trust_job(job_id, forward=False)
+
     async def send_message(self, job_id: str, message: str) -> bool:
         """Send an operator message to a running job.
 
@@ -1700,6 +2007,8 @@ class RuntimeService:
         """
         agent_session = self._agent_sessions.get(job_id)
         if agent_session is None:
+            if await self._forward_to_owner(job_id, message):
+                return True
             return await self._resume_orphaned(job_id, message)
         # Lift any tool block from a previous pause before sending.
         agent_session.resume_tools()
@@ -1731,6 +2040,28 @@ class RuntimeService:
         self._echo_suppress.setdefault(job_id, set()).add(message)
         return True
 
+    async def _forward_to_owner(self, job_id: str, message: str) -> bool:
+        """Hand an operator message to the server process holding the job's lease.
+
+        Returns False when no other live process drives the job.
+        """
+        if self.forward_control is None:
+            return False
+        from backend.persistence.event_repo import PROCESS_ORIGIN
+        from backend.persistence.job_repo import JobRepository
+        from backend.services.job_service import StateConflictError
+        from backend.services.pg_event_relay import ControlPayloadTooLargeError
+
+        async with self._session_factory() as session:
+            holder = await JobRepository(session).lease_holder(job_id)
+        if holder is None or holder == PROCESS_ORIGIN:
+            return False
+        try:
+            await self.forward_control("message", job_id=job_id, message=message)
+        except ControlPayloadTooLargeError as exc:
+            raise StateConflictError(str(exc)) from exc
+        return True
+
     async def _resume_orphaned(self, job_id: str, message: str) -> bool:
         """Auto-resume a job that has no live agent session.
 
@@ -1783,6 +2114,66 @@ class RuntimeService:
             return False
         return True
 
+    def _budget_downgrade_model(self, job: Job) -> str | None:
+        """Fallback model for a job whose SDK is past its soft monthly budget."""
+        from backend.services.cost_ledger import BudgetStatus
+
+        model = self._config.telemetry.budget_downgrade_models.get(job.sdk)
+        if self._cost_ledger is None or not model or job.model == model:
+            return None
+        if self._cost_ledger.month_status(job.sdk) is BudgetStatus.ok:
+            return None
+        return model
+
+    async def _record_usage(self, job_id: str, payload: dict[str, Any]) -> None:
+        """Apply a usage increment to the cost ledger, stream it, and enforce hard caps."""
+        from backend.services.cost_ledger import BudgetStatus
+
+        ledger = self._cost_ledger
+        if ledger is None:
+            return
+        # Copilot's account-wide quota moved: not necessarily this job's spend
+        unattributed = float(payload.get("unattributed_premium_requests") or 0)
+        if unattributed and (quota_sdk := ledger.job_sdk(job_id)) is not None:
+            ledger.record_unattributed(quota_sdk, unattributed)
+        ledger.record(
+            job_id,
+            cost_usd=float(payload.get("cost_usd") or 0),
+            input_tokens=int(payload.get("input_tokens") or 0),
+            output_tokens=int(payload.get("output_tokens") or 0),
+            premium_requests=float(payload.get("premium_requests") or 0),
+        )
+        now = datetime.now(UTC)
+        await self._event_bus.publish(
+            DomainEvent(
+                event_id=DomainEvent.make_event_id(),
+                job_id=job_id,
+                timestamp=now,
+                kind=DomainEventKind.budget_updated,
+                payload=ledger.snapshot(job_id),
+            )
+        )
+
+        to_pause: list[str] = []
+        if ledger.job_status(job_id) is BudgetStatus.exhausted:
+            log.warning("job_budget_exhausted", job_id=job_id, limit_usd=self._config.telemetry.job_budget_usd)
+            to_pause.append(job_id)
+        sdk = ledger.job_sdk(job_id)
+        if sdk is not None and ledger.month_status(sdk) is BudgetStatus.exhausted:
+            log.warning("monthly_budget_exhausted", sdk=sdk, month=ledger.month)
+            to_pause.extend(ledger.jobs_for_sdk(sdk))
+        self._pause_for_budget(to_pause)
+
+    def _pause_for_budget(self, to_pause: list[str]) -> None:
+        for target in to_pause:
+            if target in self._budget_paused or target not in self._agent_sessions:
+                continue
+            self._budget_paused.add(target)
+            # Pause out-of-band: this runs inside the job's own event loop.
+            task = asyncio.create_task(self.pause_job(target), name=f"budget-pause-{target}")
+            self._budget_tasks.add(task)
+            task.add_done_callback(self._budget_tasks.discard)
+
     async def pause_job(self, job_id: str) -> bool:
         """Forcefully pause a running agent. Returns True if sent.
 
@@ -1821,13 +2212,14 @@ class RuntimeService:
             if self.running_count >= self.max_concurrent:
                 return
             try:
-                if self._pending_starts:
-                    job_id, (override_prompt, resume_sdk_session_id) = next(iter(self._pending_starts.items()))
-                    self._pending_starts.pop(job_id, None)
+                for job_id, (override_prompt, resume_sdk_session_id) in list(self._pending_starts.items()):
                     async with self._session_factory() as session:
                         from backend.persistence.job_repo import JobRepository
 
                         job = await JobRepository(session).get(job_id)
+                    if job is not None and self._budget_blocked(job):
+                        continue
+                    self._pending_starts.pop(job_id, None)
                     if job is not None:
                         await self._start_job(
                             job,
@@ -1836,12 +2228,20 @@ class RuntimeService:
                         )
                     return
 
+                # With an exhausted SDK budget the head of the queue may be
+                # held, so look further down for a job on another SDK.
+                exhausted = self._cost_ledger.exhausted_sdks() if self._cost_ledger is not None else set()
+                # Scan the lightweight projection; only the chosen job is loaded in full.
                 async with self._session_factory() as session:
+                    from backend.persistence.job_repo import JobRepository
+
                     svc = self._make_job_service(session)
-                    queued_jobs = await svc.list_jobs(state=JobState.queued, limit=1)
-                    jobs, _, _ = queued_jobs
-                if jobs:
-                    job = jobs[0]
+                    queued, _, _ = await svc.list_job_summaries(state=JobState.queued, limit=100 if exhausted else 1)
+                    head = next((j for j in queued if j.sdk not in exhausted), None)
+                    if any(j.sdk in exhausted for j in queued):
+                        self._arm_budget_wakeup()
+                    job = await JobRepository(session).get(head.id) if head is not None else None
+                if job is not None:
                     override_prompt = self._queued_override_prompts.pop(job.id, None)
                     resume_sdk_session_id = self._queued_resume_session_ids.pop(job.id, None)
                     await self._start_job(
@@ -2313,29 +2713,182 @@ class RuntimeService:
         )
 
     async def recover_on_startup(self) -> None:
-        """Recover from a previous crash by restarting active jobs and re-enqueueing queued ones."""
-        # Restore in-memory futures for approvals that survived the restart
-        # so that recovered jobs in waiting_for_approval can be unblocked.
-        if self._approval_service is not None:
-            await self._approval_service.recover_pending_approvals()
+        """Recover from a previous crash by restarting active jobs and re-enqueueing queued ones.
+
+        Returns once every job has been recovered or re-enqueued.
+        """
+        task = await self.start_recovery()
+        if task is not None:
+            await task
+
+    async def start_recovery(self) -> asyncio.Task[None] | None:
+        """Start crash recovery in the background and return its task.
+
+        Pending approval futures are restored and the jobs to recover are
+        listed before this returns, so the API can be served right away.
+        Resuming the jobs (worktree checks, DB writes, SDK session
+        resumption) then runs with at most ``runtime.recovery_concurrency``
+        jobs at a time, jobs that were waiting for approval first.  Progress
+        is available from :meth:`recovery_progress`.
+
+        Returns None when there is nothing to recover.
+        """
+        from backend.persistence.job_repo import JobRepository
 
         orphaned_jobs: list[tuple[Job, JobState]] = []
         async with self._session_factory() as session:
             svc = self._make_job_service(session)
             # Recover jobs that were already in progress before the backend restart.
-            for state in (JobState.running, JobState.waiting_for_approval):
-                jobs, _, _ = await svc.list_jobs(state=state, limit=10000)
-                orphaned_jobs.extend((job, state) for job in jobs)
+            # Jobs waiting for approval go first — an operator is likely blocked on them.
+            if self._shared_database:
+                # Jobs another live server process drives are not orphaned
+                active = await JobRepository(session).list_unleased_active()
+                for state in (JobState.waiting_for_approval, JobState.running):
+                    orphaned_jobs.extend((job, state) for job in active if job.state == state)
+            else:
+                for state in (JobState.waiting_for_approval, JobState.running):
+                    jobs, _, _ = await svc.list_jobs(state=state, limit=10000)
+                    orphaned_jobs.extend((job, state) for job in jobs)
 
             # Re-enqueue queued jobs
             queued_jobs, _, _ = await svc.list_jobs(state=JobState.queued, limit=10000)
 
-        for job, state in orphaned_jobs:
-            log.warning("recovering_orphaned_job", job_id=job.id, state=state)
-            await self._recover_active_job(job.id)
+        # Restore in-memory futures for approvals that survived the restart
+        # so that recovered jobs in waiting_for_approval can be unblocked.
+        if self._approval_service is not None:
+            await self._approval_service.recover_pending_approvals(
+                {job.id for job, _ in orphaned_jobs} if self._shared_database else None
+            )
+
+        if not orphaned_jobs and not queued_jobs:
+            return None
+        self._recovery = RecoveryProgress(total=len(orphaned_jobs) + len(queued_jobs), started_at=datetime.now(UTC))
+        log.info("recovery_started", active=len(orphaned_jobs), queued=len(queued_jobs))
+        self._recovery_task = asyncio.create_task(
+            self._run_recovery(orphaned_jobs, queued_jobs), name="startup-recovery"
+        )
+        return self._recovery_task
+
+    async def _run_recovery(self, orphaned_jobs: list[tuple[Job, JobState]], queued_jobs: list[Job]) -> None:
+        progress = self._recovery
+        limit = asyncio.Semaphore(max(1, self._config.runtime.recovery_concurrency))
+
+        def _done(job_id: str, ok: bool) -> None:
+            if ok:
+                progress.recovered += 1
+            else:
+                progress.failed += 1
+                log.error("recovery_job_failed", job_id=job_id, exc_info=True)
+            log.info(
+                "recovery_progress",
+                recovered=progress.recovered,
+                failed=progress.failed,
+                total=progress.total,
+            )
+
+        async def _recover(job: Job, state: JobState) -> None:
+            # Semaphore waiters are woken in FIFO order, so jobs start in list order
+            async with limit:
+                if self._shutting_down:
+                    return
+                log.warning("recovering_orphaned_job", job_id=job.id, state=state)
+                try:
+                    await self._recover_active_job(job.id)
+                except Exception:
+                    _done(job.id, ok=False)
+                else:
+                    _done(job.id, ok=True)
 
-        for job in queued_jobs:
-            await self.start_or_enqueue(job)
+        started = time.monotonic()
+        try:
+            await asyncio.gather(*(_recover(job, state) for job, state in orphaned_jobs))
+
+            # Queued jobs only go through the capacity check — keep their order
+            for job in queued_jobs:
+                if self._shutting_down:
+                    return
+                try:
+                    await self.start_or_enqueue(job)
+                except Exception:
+                    _done(job.id, ok=False)
+                else:
+                    _done(job.id, ok=True)
+        finally:
+            progress.finished_at = datetime.now(UTC)
+            self._recovery_task = None
+            log.info(
+                "recovery_finished",
+                recovered=progress.recovered,
+                failed=progress.failed,
+                total=progress.total,
+                duration_s=round(time.monotonic() - started, 2),
+            )
+
+    async def lease_loop(self) -> None:
+        """Keep this process's job leases alive; designed to be launched as a background task.
+
+        Only needed with a shared database.  Each tick also applies
+        cancellations and approval decisions made through other processes
+        (in case their forwarded request was missed), reloads the learned
+        approval rules and the fleet's month-to-date spend, and takes over
+        active jobs whose process stopped renewing its lease.
+        """
+        while True:
+            await asyncio.sleep(_LEASE_RENEW_INTERVAL_S)
+            try:
+                await self._tend_leases()
+            except Exception:
+                log.warning("job_lease_tick_failed", exc_info=True)
+
+    async def _tend_leases(self) -> None:
+        from backend.persistence.job_repo import JobRepository
+
+        job_ids = list(self._tasks)
+        adopt = not self._shutting_down and self._recovery_task is None
+        async with self._session_factory() as session:
+            repo = JobRepository(session)
+            await repo.renew_leases(job_ids)
+            states = await repo.states_of(job_ids)
+            orphans = await repo.list_unleased_active() if adopt else []
+            await session.commit()
+
+        for job_id, state in states.items():
+            task = self._tasks.get(job_id)
+            if state == JobState.canceled and task is not None and not task.cancelling():
+                log.info("job_cancel_observed", job_id=job_id)
+                task.cancel()
+        if self._approval_service is not None:
+            await self._approval_service.settle_resolved()
+            await self._approval_service.reload_rules()
+        await self._refresh_budgets()
+
+        for job in orphans:
+            if self._shutting_down or job.id in self._tasks:
+                continue
+            log.warning("adopting_orphaned_job", job_id=job.id, state=job.state)
+            try:
+                if self._approval_service is not None:
+                    await self._approval_service.recover_pending_approvals({job.id})
+                await self._recover_active_job(job.id)
+            except Exception:
+                log.warning("adopt_orphaned_job_failed", job_id=job.id, exc_info=True)
+
+    async def _refresh_budgets(self) -> None:
+        """Count other processes' spend towards the monthly caps and pause local jobs past them."""
+        ledger = self._cost_ledger
+        if ledger is None:
+            return
+        async with self._session_factory() as session:
+            await ledger.refresh(session)
+        for sdk in ledger.exhausted_sdks():
+            jobs = [j for j in ledger.jobs_for_sdk(sdk) if j not in self._budget_paused]
+            if jobs:
+                log.warning("monthly_budget_exhausted", sdk=sdk, month=ledger.month, source="fleet")
+                self._pause_for_budget(jobs)
+
+    def recovery_progress(self) -> RecoveryProgress:
+        """Progress of the startup crash recovery (all zero when nothing needed recovering)."""
+        return self._recovery
 
     async def shutdown(self) -> None:
         """Gracefully shut down all running jobs.
@@ -2345,6 +2898,14 @@ class RuntimeService:
         instead of marking them as canceled (which confused users).
         """
         self._shutting_down = True
+        if self._heartbeat_task is not None:
+            self._heartbeat_task.cancel()
+        if self._budget_wakeup is not None:
+            self._budget_wakeup.cancel()
+            self._budget_wakeup = None
+        if self._recovery_task is not None:
+            self._recovery_task.cancel()
+            await asyncio.gather(self._recovery_task, return_exceptions=True)
         for job_id in list(self._tasks):
             task = self._tasks.get(job_id)
             if task is not None:
@@ -2359,6 +2920,11 @@ class RuntimeService:
         if snapshot_tasks:
             await asyncio.gather(*snapshot_tasks, return_exceptions=True)
 
+        if self._stage_flush_task is not None:
+            self._stage_flush_task.cancel()
+            await asyncio.gather(self._stage_flush_task, return_exceptions=True)
+        await self._flush_stage_spans()
+
     @property
     def is_shutting_down(self) -> bool:
         return self._shutting_down
@@ -106,13 +106,20 @@ class SisterSession:
         system prompt).  The underlying adapter.complete() is responsible
         for its own thread/connection safety.
         """
+        from backend.services import telemetry as tel
+
         effective = await self._ensure_primed(prompt)
         t0 = time.monotonic()
-        result = await asyncio.wait_for(
-            self._adapter.complete(effective),
-            timeout=timeout,
-        )
+        try:
+            result = await asyncio.wait_for(
+                self._adapter.complete(effective),
+                timeout=timeout,
+            )
+        except BaseException:
+            tel.sister_duration.record((time.monotonic() - t0) * 1000, {"outcome": "error"})
+            raise
         elapsed_ms = (time.monotonic() - t0) * 1000
+        tel.sister_duration.record(elapsed_ms, {"outcome": "ok"})
         self.call_count += 1
         self.total_latency_ms += elapsed_ms
         self.total_input_tokens += result.input_tokens
@@ -5,6 +5,7 @@ from __future__ import annotations
 import asyncio
 import contextlib
 import json
+import time
 from collections.abc import Callable
 from datetime import UTC, datetime, timedelta
 from typing import TYPE_CHECKING
@@ -15,6 +16,7 @@ from backend.models.api_schemas import (
     ApprovalRequestedPayload,
     ApprovalResolvedPayload,
     ApprovalResponse,
+    BudgetUpdatedPayload,
     DiffUpdatePayload,
     JobArchivedPayload,
     JobCompletedPayload,
@@ -22,6 +24,7 @@ from backend.models.api_schemas import (
     JobResolvedPayload,
     JobReviewPayload,
     JobStateChangedPayload,
+    JobSummaryResponse,
     JobTitleUpdatedPayload,
     LogLinePayload,
     MergeCompletedPayload,
@@ -35,10 +38,12 @@ from backend.models.api_schemas import (
     ToolGroupSummaryPayload,
     TranscriptPayload,
 )
-from backend.models.domain import JobState, Resolution
+from backend.models.domain import JobState, JobSummary, Resolution
 from backend.models.events import DomainEvent, DomainEventKind
 
 if TYPE_CHECKING:
+    from collections.abc import Sequence
+
     from backend.persistence.approval_repo import ApprovalRepository
     from backend.persistence.event_repo import EventRepository
     from backend.persistence.job_repo import JobRepository
@@ -79,6 +84,8 @@ _SSE_EVENT_TYPE: dict[DomainEventKind, str | None] = {
     DomainEventKind.step_group_updated: None,
     # Plan steps — the only step-level event the frontend sees
     DomainEventKind.plan_step_updated: "plan_step_updated",
+    # Live cost ledger — broadcast only, never persisted
+    DomainEventKind.budget_updated: "budget_updated",
 }
 
 # State implied by each domain event kind (for job_state_changed payloads)
@@ -113,6 +120,15 @@ _JOB_SCOPED_ONLY: frozenset[str] = frozenset(
 MAX_REPLAY_EVENTS = 500
 MAX_REPLAY_AGE = timedelta(minutes=5)
 
+# Jobs per snapshot frame when the replay gap is too large
+SNAPSHOT_CHUNK_JOBS = 50
+
+# Keepalive: a connection idle this long gets an empty session_heartbeat.
+# A real event rather than an SSE comment — comments are invisible to
+# HTTP/2 proxies and don't prevent idle stream timeouts.
+KEEPALIVE_IDLE_S = 5.0
+KEEPALIVE_FRAME = "event: session_heartbeat\ndata: {}\n\n"
+
 
 class SSEConnection:
     """Represents a single SSE client connection."""
@@ -123,12 +139,14 @@ class SSEConnection:
         self.job_id = job_id  # None = all jobs
         self.queue: asyncio.Queue[str] = asyncio.Queue(maxsize=1024)
         self.closed = False
+        self.last_sent = time.monotonic()
 
     async def send(self, data: str) -> None:
         if self.closed:
             return
         try:
             self.queue.put_nowait(data)
+            self.last_sent = time.monotonic()
         except asyncio.QueueFull:
             # Close the overloaded connection so the client reconnects and
             # gets missed events via replay instead of silently losing them.
@@ -138,6 +156,11 @@ class SSEConnection:
     def close(self) -> None:
         self.closed = True
 
+    def wake(self) -> None:
+        """Unblock a reader waiting on an empty queue so it notices :attr:`closed`."""
+        if self.queue.empty():
+            self.queue.put_nowait(KEEPALIVE_FRAME)
+
 
 def _format_sse(event_id: str | None, event_type: str, data: str) -> str:
     """Format a single SSE frame. Omits ``id:`` when *event_id* is ``None``."""
@@ -149,6 +172,22 @@ def _format_sse(event_id: str | None, event_type: str, data: str) -> str:
     return "\n".join(parts) + "\n\n"
 
 
+def parse_sse_frame(frame: str) -> tuple[str | None, str, str] | None:
+    """Split a frame built by :func:`_format_sse` into (id, event type, data); None for comments."""
+    event_id: str | None = None
+    event_type: str | None = None
+    data = ""
+    for line in frame.splitlines():
+        field_name, _, value = line.partition(": ")
+        if field_name == "id":
+            event_id = value
+        elif field_name == "event":
+            event_type = value
+        elif field_name == "data":
+            data = value
+    return None if event_type is None else (event_id, event_type, data)
+
+
 # ---------------------------------------------------------------------------
 # Generic field-map builder
 # ---------------------------------------------------------------------------
@@ -229,6 +268,11 @@ def _build_plan_step_updated(event: DomainEvent) -> str:
     ).model_dump_json(by_alias=True)
 
 
+def _build_budget_updated(event: DomainEvent) -> str:
+    p = {k: v for k, v in event.payload.items() if k not in ("job_id", "timestamp")}
+    return BudgetUpdatedPayload(job_id=event.job_id, timestamp=event.timestamp, **p).model_dump_json(by_alias=True)
+
+
 # ---------------------------------------------------------------------------
 # Unified SSE payload registry
 # ---------------------------------------------------------------------------
@@ -241,6 +285,7 @@ _SSE_PAYLOAD_REGISTRY: dict[str, tuple[type, FieldMap] | _BuilderFn] = {
     "job_state_changed": _build_job_state_changed,
     "job_review": _build_job_review,
     "plan_step_updated": _build_plan_step_updated,
+    "budget_updated": _build_budget_updated,
     # --- Field-map builders (declarative) ---
     "log_line": (
         LogLinePayload,
@@ -297,6 +342,9 @@ _SSE_PAYLOAD_REGISTRY: dict[str, tuple[type, FieldMap] | _BuilderFn] = {
             "approval_id": ("approval_id", ""),
             "resolution": ("resolution", ""),
             "timestamp": ("timestamp", _TS_FALLBACK),
+            "auto_approved": ("auto_approved", False),
+            "description": ("description", None),
+            "proposed_action": ("proposed_action", None),
         },
     ),
     "session_heartbeat": (
@@ -304,6 +352,7 @@ _SSE_PAYLOAD_REGISTRY: dict[str, tuple[type, FieldMap] | _BuilderFn] = {
         {
             "session_id": ("session_id", ""),
             "timestamp": ("timestamp", _TS_FALLBACK),
+            "jobs": ("jobs", []),
         },
     ),
     "merge_completed": (
@@ -425,6 +474,8 @@ def _build_derived_state_frame(event: DomainEvent, sse_id: str | None) -> str |
             timestamp=event.timestamp,
         )
     elif event.kind == DomainEventKind.approval_resolved:
+        if event.payload.get("auto_approved"):
+            return None  # the job never left running
         new_state = JobState.running if event.payload.get("resolution") == "approved" else JobState.failed
         payload = JobStateChangedPayload(
             job_id=event.job_id,
@@ -452,12 +503,14 @@ class SSEManager:
     - Translate domain events to SSE wire format
     - Broadcast/route events to appropriate connections
     - Support selective streaming when >20 jobs active
+    - Keep idle connections alive from a single ticker
     - Handle disconnection cleanup
     """
 
     def __init__(self) -> None:
         self._connections: list[SSEConnection] = []
         self._active_job_count: int = 0
+        self._keepalive_task: asyncio.Task[None] | None = None
 
     @property
     def connection_count(self) -> int:
@@ -467,6 +520,27 @@ class SSEManager:
         """Register a new SSE connection."""
         self._connections.append(conn)
         log.debug("sse_connection_opened", job_id=conn.job_id, total=len(self._connections))
+        if self._keepalive_task is None or self._keepalive_task.done():
+            with contextlib.suppress(RuntimeError):  # no running loop (sync callers)
+                self._keepalive_task = asyncio.get_running_loop().create_task(
+                    self._keepalive_loop(), name="sse-keepalive"
+                )
+
+    async def _keepalive_loop(self) -> None:
+        """Send a keepalive to every connection that has been idle for ``KEEPALIVE_IDLE_S``.
+
+        One timer for all connections instead of a read timeout per stream.
+        Connections closed while their reader is blocked are woken so the
+        stream ends.  Exits when the last connection goes away.
+        """
+        while self._connections:
+            await asyncio.sleep(KEEPALIVE_IDLE_S / 2)
+            cutoff = time.monotonic() - KEEPALIVE_IDLE_S
+            for conn in list(self._connections):
+                if conn.closed:
+                    conn.wake()
+                elif conn.last_sent <= cutoff:
+                    await conn.send(KEEPALIVE_FRAME)
 
     def unregister(self, conn: SSEConnection) -> None:
         """Remove a connection."""
@@ -475,6 +549,13 @@ class SSEManager:
             self._connections.remove(conn)
         log.debug("sse_connection_closed", job_id=conn.job_id, total=len(self._connections))
 
+    def queue_stats(self) -> tuple[int, int, int, float]:
+        """Return ``(job_scoped, global, buffered_frames, max_fill)`` over open connections."""
+        scoped = sum(1 for c in self._connections if c.job_id is not None)
+        depths = [(c.queue.qsize(), c.queue.maxsize) for c in self._connections]
+        max_fill = max((size / cap for size, cap in depths if cap), default=0.0)
+        return scoped, len(self._connections) - scoped, sum(size for size, _ in depths), max_fill
+
     def set_active_job_count(self, count: int) -> None:
         """Update the active job count for selective streaming decisions."""
         self._active_job_count = count
@@ -484,6 +565,9 @@ class SSEManager:
         sse_type = _SSE_EVENT_TYPE.get(event.kind)
         if sse_type is None:
             return  # internal-only event
+        if event.kind == DomainEventKind.session_heartbeat and not event.job_id:
+            await self._broadcast_fleet_heartbeat(event)
+            return
 
         sse_id = str(event.db_id) if event.db_id is not None else event.event_id
         frame = _format_sse(sse_id, sse_type, _build_sse_data(event, sse_type))
@@ -516,6 +600,20 @@ class SSEManager:
         if derived is not None:
             await self._broadcast_frame(derived, event.job_id)
 
+    async def _broadcast_fleet_heartbeat(self, event: DomainEvent) -> None:
+        """Deliver the runtime-wide liveness frame.
+
+        Global connections get it even in selective mode — it is one frame
+        per tick however many jobs run.  A job-scoped connection gets it
+        while its job is listed.  No ``id:``, since it is never persisted.
+        """
+        frame = _format_sse(None, "session_heartbeat", _build_sse_data(event, "session_heartbeat"))
+        running = {job.get("job_id") for job in event.payload.get("jobs", [])}
+        for conn in list(self._connections):
+            if conn.closed or (conn.job_id is not None and conn.job_id not in running):
+                continue
+            await conn.send(frame)
+
     async def _broadcast_frame(self, frame: str, job_id: str) -> None:
         """Send a pre-formatted frame to all relevant connections."""
         for conn in list(self._connections):
@@ -563,6 +661,57 @@ class SSEManager:
             for a in pending
         ]
 
+    async def _send_fleet_snapshot(
+        self,
+        conn: SSEConnection,
+        event_repo: EventRepository,
+        job_repo: JobRepository,
+        approval_repo: ApprovalRepository | None,
+    ) -> None:
+        """Send the snapshot (scoped to ``conn.job_id`` if set) in chunks of SNAPSHOT_CHUNK_JOBS.
+
+        Each chunk is queried and sent before the next is read, so the
+        newest jobs reach the client without waiting for the whole fleet.
+        """
+        from backend.persistence.job_repo import encode_job_cursor
+
+        if conn.job_id is not None:
+            single = await job_repo.get(conn.job_id)
+            jobs = [JobSummary.from_job(single)] if single else []
+            await self._send_snapshot_chunk(conn, jobs, event_repo, approval_repo)
+            return
+        chunk = 0
+        cursor: str | None = None
+        while True:
+            page = await job_repo.list_summaries(limit=SNAPSHOT_CHUNK_JOBS + 1, cursor=cursor, include_archived=False)
+            more = len(page) > SNAPSHOT_CHUNK_JOBS
+            page = page[:SNAPSHOT_CHUNK_JOBS]
+            await self._send_snapshot_chunk(conn, page, event_repo, approval_repo, chunk=chunk, final=not more)
+            if not more:
+                return
+            cursor = encode_job_cursor(page[-1].created_at, page[-1].id)
+            chunk += 1
+
+    async def _send_snapshot_chunk(
+        self,
+        conn: SSEConnection,
+        jobs: Sequence[JobSummary],
+        event_repo: EventRepository,
+        approval_repo: ApprovalRepository | None,
+        *,
+        chunk: int = 0,
+        final: bool = True,
+    ) -> None:
+        previews = await event_repo.list_latest_progress_previews([j.id for j in jobs]) if jobs else {}
+        snapshot = SnapshotPayload(
+            jobs=[JobSummaryResponse.from_summary(j, *previews.get(j.id, (None, None))) for j in jobs],
+            pending_approvals=await self._fetch_pending_approvals(approval_repo, conn.job_id) if final else [],
+            chunk=chunk,
+            final=final,
+            job_id=conn.job_id,
+        )
+        await self.send_snapshot(conn, snapshot)
+
     async def replay_events(
         self,
         conn: SSEConnection,
@@ -594,47 +743,7 @@ class SSEManager:
             needs_snapshot = True
 
         if needs_snapshot:
-            # Build and send snapshot (scoped to conn.job_id if set)
-            from backend.models.api_schemas import JobResponse
-
-            if conn.job_id is not None:
-                single = await job_repo.get(conn.job_id)
-                fetched_jobs = [single] if single else []
-            else:
-                fetched_jobs = [j for j in await job_repo.list(limit=10000) if j.archived_at is None]
-
-            progress_by_job = await event_repo.list_latest_progress_previews([j.id for j in fetched_jobs])
-
-            job_responses = [
-                JobResponse(
-                    id=j.id,
-                    repo=j.repo,
-                    prompt=j.prompt,
-                    title=j.title,
-                    state=j.state,
-                    base_ref=j.base_ref,
-                    worktree_path=j.worktree_path,
-                    branch=j.branch,
-                    created_at=j.created_at,
-                    updated_at=j.updated_at,
-                    completed_at=j.completed_at,
-                    pr_url=j.pr_url,
-                    merge_status=j.merge_status,
-                    resolution=j.resolution,
-                    archived_at=j.archived_at,
-                    failure_reason=j.failure_reason,
-                    progress_headline=progress_by_job.get(j.id, (None, None))[0],
-                    progress_summary=progress_by_job.get(j.id, (None, None))[1],
-                    model=j.model,
-                    sdk=j.sdk,
-                )
-                for j in fetched_jobs
-            ]
-            snapshot = SnapshotPayload(
-                jobs=job_responses,
-                pending_approvals=await self._fetch_pending_approvals(approval_repo, conn.job_id),
-            )
-            await self.send_snapshot(conn, snapshot)
+            await self._send_fleet_snapshot(conn, event_repo, job_repo, approval_repo)
 
             # Filter events to only those within the replay window
             events = [e for e in events if e.timestamp.replace(tzinfo=UTC) >= cutoff]
@@ -684,8 +793,46 @@ class SSEManager:
                 approval_repo=approval_repo,
             )
 
+    async def collect_since(
+        self,
+        session_factory: object,
+        last_event_id: int,
+        *,
+        job_id: str | None = None,
+        wait_s: float = 0.0,
+    ) -> list[str]:
+        """Frames a client at *last_event_id* has missed, waiting up to *wait_s* for some.
+
+        Long-poll counterpart of the SSE stream for clients that cannot hold
+        one open (the MCP tools).  Frames come from :meth:`replay_events`, so
+        ids, snapshots and derived state frames match what an SSE client
+        reconnecting with ``Last-Event-ID`` would see.
+        """
+        sink = SSEConnection(job_id=job_id)
+        waker = SSEConnection(job_id=job_id)
+        self.register(waker)
+        deadline = time.monotonic() + wait_s
+        try:
+            while True:
+                await self.replay_from_factory(sink, session_factory, last_event_id)
+                frames = [sink.queue.get_nowait() for _ in range(sink.queue.qsize())]
+                remaining = deadline - time.monotonic()
+                if frames or remaining <= 0:
+                    return frames
+                # A live broadcast means something may have been persisted; the
+                # one-second re-check covers events written by other processes.
+                with contextlib.suppress(TimeoutError):
+                    await asyncio.wait_for(waker.queue.get(), timeout=min(remaining, 1.0))
+                while not waker.queue.empty():
+                    waker.queue.get_nowait()
+        finally:
+            self.unregister(waker)
+
     async def close_all(self) -> None:
         """Close all connections (used during shutdown)."""
         for conn in list(self._connections):
             conn.close()
+            conn.wake()
         self._connections.clear()
+        if self._keepalive_task is not None:
+            self._keepalive_task.cancel()
@@ -7,127 +7,238 @@ Analyses accumulated telemetry to surface actionable cost observations:
 - Retry waste (retries that cost more than the original attempt)
 - Phase imbalance (verification consuming more than reasoning)
 
-Run periodically or after each job completion.
+``update_for_job`` is the streaming path run as each job finalizes: it folds
+the job's own rows into delta-maintained counters and re-evaluates only the
+files/tools it touched, so cost is O(job) rather than O(history).
+``run_analysis`` is the full 30-day rescan behind ``POST /analytics/analyse``.
+
+Span-level passes run through the optional :class:`ColumnarStore` (DuckDB
+over exported Parquet) when one is configured, falling back to SQLite.
 """
 
 from __future__ import annotations
 
-from typing import TYPE_CHECKING
+from typing import TYPE_CHECKING, Any
 
 import structlog
-from sqlalchemy import text
+from sqlalchemy import bindparam, text
 
 if TYPE_CHECKING:
     from sqlalchemy.ext.asyncio import AsyncSession
 
+    from backend.services.columnar_store import ColumnarStore
+
+from backend.persistence.analysis_counters_repo import (
+    DETECTOR_FILE_REREAD,
+    DETECTOR_RETRY_WASTE,
+    DETECTOR_TOOL_FAILURE,
+    DETECTOR_TURN_ESCALATION,
+    AnalysisCountersRepo,
+)
+from backend.persistence.dialect import dialect_of, json_is_false, now_minus_days
 from backend.persistence.observations_repo import ObservationsRepo
 
 log = structlog.get_logger()
 
 
-async def run_analysis(session: AsyncSession) -> int:
+async def run_analysis(session: AsyncSession, columnar: ColumnarStore | None = None) -> int:
     """Run all analysis passes. Returns the number of observations written."""
     repo = ObservationsRepo(session)
+    if columnar is not None:
+        try:
+            await columnar.export(session)
+        except Exception:
+            log.warning("columnar_export_failed", exc_info=True)
+            columnar = None
     count = 0
     count += await _analyse_file_rereads(session, repo)
-    count += await _analyse_tool_failures(session, repo)
+    count += await _analyse_tool_failures(session, repo, columnar)
     count += await _analyse_turn_escalation(session, repo)
-    count += await _analyse_retry_waste(session, repo)
+    count += await _analyse_retry_waste(session, repo, columnar)
     log.info("statistical_analysis_complete", observations=count)
     return count
 
 
+async def update_for_job(session: AsyncSession, job_id: str) -> int:
+    """Fold one finished job into the detectors. Returns observations written."""
+    counters = AnalysisCountersRepo(session)
+    touched = await counters.replace_job(job_id, await counters.job_contributions(job_id))
+    repo = ObservationsRepo(session)
+    count = 0
+    escalation_touched = False
+    for detector, key in sorted(touched):
+        if detector == DETECTOR_TURN_ESCALATION:
+            escalation_touched = True
+            continue
+        t = await counters.window_totals(detector, key)
+        events, hits, jobs = int(t["events"]), int(t["hits"]), int(t["jobs"])
+        if detector == DETECTOR_FILE_REREAD and events >= 10 and jobs >= 3:
+            await _report_file_reread(
+                repo, file_path=key, total_reads=events, job_count=jobs, total_bytes=int(t["amount"])
+            )
+            count += 1
+        elif detector == DETECTOR_TOOL_FAILURE and events >= 10 and hits / events >= 0.2:
+            await _report_tool_failure(repo, name=key, total_calls=events, failures=hits, job_count=jobs)
+            count += 1
+        elif detector == DETECTOR_RETRY_WASTE and hits >= 5:
+            count += await _report_retry_waste(
+                repo, tool_name=key, retry_count=hits, total_calls=events, job_count=jobs
+            )
+
+    if escalation_touched:
+        top = await counters.top_keys(DETECTOR_TURN_ESCALATION, limit=20)
+        if len(top) >= 3:
+            result = await session.execute(
+                text("""
+                    SELECT job_id, total_turns, cost_first_half_usd, cost_second_half_usd, total_cost_usd
+                    FROM job_telemetry_summary
+                    WHERE job_id IN :job_ids
+                    ORDER BY (cost_second_half_usd - cost_first_half_usd) DESC
+                """).bindparams(bindparam("job_ids", expanding=True)),
+                {"job_ids": [r["key"] for r in top]},
+            )
+            count += await _report_turn_escalation(repo, [dict(r) for r in result.mappings().all()])
+
+    log.debug("statistical_analysis_job_folded", job_id=job_id, keys=len(touched), observations=count)
+    return count
+
+
+async def _span_rows(
+    session: AsyncSession,
+    columnar: ColumnarStore | None,
+    *,
+    columnar_sql: str,
+    db_sql: str,
+) -> list[dict[str, Any]]:
+    """Run a span aggregation through DuckDB when available, else the database."""
+    if columnar is not None:
+        try:
+            return await columnar.query(columnar_sql)
+        except Exception:
+            log.debug("columnar_query_failed_falling_back", exc_info=True)
+    result = await session.execute(text(db_sql))
+    return [dict(r) for r in result.mappings().all()]
+
+
 async def _analyse_file_rereads(session: AsyncSession, repo: ObservationsRepo) -> int:
     """Find files read excessively across jobs."""
     result = await session.execute(
-        text("""
+        text(f"""
             SELECT
                 file_path,
-                COUNT(*) as total_reads,
+                SUM(read_count) as total_reads,
                 COUNT(DISTINCT job_id) as job_count,
-                SUM(CASE WHEN access_type = 'read' THEN byte_count ELSE 0 END) as total_bytes
-            FROM job_file_access_log
-            WHERE access_type = 'read'
-                AND created_at >= datetime('now', '-30 days')
+                SUM(read_bytes) as total_bytes
+            FROM job_file_access_stats
+            WHERE read_count > 0
+                AND last_access_at >= {now_minus_days(30, dialect_of(session))}
             GROUP BY file_path
-            HAVING COUNT(*) >= 10 AND COUNT(DISTINCT job_id) >= 3
+            HAVING SUM(read_count) >= 10 AND COUNT(DISTINCT job_id) >= 3
             ORDER BY total_reads DESC
             LIMIT 20
-        """)
+        """)  # noqa: S608
     )
     rows = result.mappings().all()
-    count = 0
     for r in rows:
-        await repo.upsert(
-            category="file_reread",
-            severity="warning" if r["total_reads"] >= 50 else "info",
-            title=f"Excessive rereads: {r['file_path']}",
-            detail=(
-                f"File '{r['file_path']}' was read {r['total_reads']} times "
-                f"across {r['job_count']} jobs in the last 30 days."
-            ),
-            evidence={
-                "file_path": r["file_path"],
-                "total_reads": r["total_reads"],
-                "job_count": r["job_count"],
-                "total_bytes": r["total_bytes"],
-            },
+        await _report_file_reread(
+            repo,
+            file_path=r["file_path"],
+            total_reads=r["total_reads"],
             job_count=r["job_count"],
+            total_bytes=r["total_bytes"],
         )
-        count += 1
-    return count
+    return len(rows)
+
+
+async def _report_file_reread(
+    repo: ObservationsRepo, *, file_path: str, total_reads: int, job_count: int, total_bytes: int
+) -> None:
+    await repo.upsert(
+        category="file_reread",
+        severity="warning" if total_reads >= 50 else "info",
+        title=f"Excessive rereads: {file_path}",
+        detail=f"File '{file_path}' was read {total_reads} times across {job_count} jobs in the last 30 days.",
+        evidence={
+            "file_path": file_path,
+            "total_reads": total_reads,
+            "job_count": job_count,
+            "total_bytes": total_bytes,
+        },
+        job_count=job_count,
+    )
 
 
-async def _analyse_tool_failures(session: AsyncSession, repo: ObservationsRepo) -> int:
+async def _analyse_tool_failures(
+    session: AsyncSession, repo: ObservationsRepo, columnar: ColumnarStore | None = None
+) -> int:
     """Find tools with high failure rates."""
-    result = await session.execute(
-        text("""
+    dialect = dialect_of(session)
+    failed = json_is_false("attrs_json", "success", dialect)
+    rows = await _span_rows(
+        session,
+        columnar,
+        columnar_sql="""
+            SELECT
+                name,
+                COUNT(*) as total_calls,
+                SUM(CASE WHEN success = false THEN 1 ELSE 0 END) as failures,
+                COUNT(DISTINCT job_id) as job_count
+            FROM spans
+            WHERE span_type = 'tool'
+                AND CAST(day AS DATE) >= current_date - 30
+            GROUP BY name
+            HAVING COUNT(*) >= 10
+                AND CAST(failures AS DOUBLE) / total_calls >= 0.2
+            ORDER BY failures DESC
+            LIMIT 20
+        """,
+        db_sql=f"""
             SELECT
                 name,
                 COUNT(*) as total_calls,
-                SUM(CASE WHEN json_extract(attrs_json, '$.success') = 0
-                         OR json_extract(attrs_json, '$.success') = 'false'
-                    THEN 1 ELSE 0 END) as failures,
+                SUM(CASE WHEN {failed} THEN 1 ELSE 0 END) as failures,
                 COUNT(DISTINCT job_id) as job_count
             FROM job_telemetry_spans
             WHERE span_type = 'tool'
-                AND created_at >= datetime('now', '-30 days')
+                AND created_at >= {now_minus_days(30, dialect)}
             GROUP BY name
-            HAVING total_calls >= 10
-                AND CAST(failures AS FLOAT) / total_calls >= 0.2
+            HAVING COUNT(*) >= 10
+                AND SUM(CASE WHEN {failed} THEN 1.0 ELSE 0.0 END) / COUNT(*) >= 0.2
             ORDER BY failures DESC
             LIMIT 20
-        """)
+        """,  # noqa: S608
     )
-    rows = result.mappings().all()
-    count = 0
     for r in rows:
-        failure_rate = r["failures"] / r["total_calls"] * 100
-        await repo.upsert(
-            category="tool_failure",
-            severity="critical" if failure_rate >= 50 else "warning",
-            title=f"High failure rate: {r['name']} ({failure_rate:.0f}%)",
-            detail=(
-                f"Tool '{r['name']}' failed {r['failures']}/{r['total_calls']} times "
-                f"({failure_rate:.1f}%) across {r['job_count']} jobs."
-            ),
-            evidence={
-                "tool_name": r["name"],
-                "total_calls": r["total_calls"],
-                "failures": r["failures"],
-                "failure_rate_pct": round(failure_rate, 1),
-                "job_count": r["job_count"],
-            },
-            job_count=r["job_count"],
+        await _report_tool_failure(
+            repo, name=r["name"], total_calls=r["total_calls"], failures=r["failures"], job_count=r["job_count"]
         )
-        count += 1
-    return count
+    return len(rows)
+
+
+async def _report_tool_failure(
+    repo: ObservationsRepo, *, name: str, total_calls: int, failures: int, job_count: int
+) -> None:
+    failure_rate = failures / total_calls * 100
+    await repo.upsert(
+        category="tool_failure",
+        severity="critical" if failure_rate >= 50 else "warning",
+        title=f"High failure rate: {name} ({failure_rate:.0f}%)",
+        detail=(f"Tool '{name}' failed {failures}/{total_calls} times ({failure_rate:.1f}%) across {job_count} jobs."),
+        evidence={
+            "tool_name": name,
+            "total_calls": total_calls,
+            "failures": failures,
+            "failure_rate_pct": round(failure_rate, 1),
+            "job_count": job_count,
+        },
+        job_count=job_count,
+    )
 
 
 async def _analyse_turn_escalation(session: AsyncSession, repo: ObservationsRepo) -> int:
     """Find jobs where cost/turn escalates significantly in the second half."""
     result = await session.execute(
-        text("""
+        text(f"""
             SELECT
                 job_id,
                 total_turns,
@@ -139,12 +250,16 @@ async def _analyse_turn_escalation(session: AsyncSession, repo: ObservationsRepo
                 AND cost_second_half_usd > 0
                 AND cost_first_half_usd > 0
                 AND (cost_second_half_usd / cost_first_half_usd) >= 2.0
-                AND created_at >= datetime('now', '-30 days')
+                AND created_at >= {now_minus_days(30, dialect_of(session))}
             ORDER BY (cost_second_half_usd - cost_first_half_usd) DESC
             LIMIT 20
-        """)
+        """)  # noqa: S608
     )
-    rows = result.mappings().all()
+    return await _report_turn_escalation(repo, [dict(r) for r in result.mappings().all()])
+
+
+async def _report_turn_escalation(repo: ObservationsRepo, rows: list[dict[str, Any]]) -> int:
+    """Upsert the fleet-wide escalation observation; *rows* are sorted by waste."""
     if len(rows) < 3:
         return 0
 
@@ -155,7 +270,7 @@ async def _analyse_turn_escalation(session: AsyncSession, repo: ObservationsRepo
         title=f"Cost escalation in {len(rows)} jobs",
         detail=(f"{len(rows)} jobs had 2nd-half costs ≥2x 1st-half costs. Estimated waste: ${total_waste:.2f}."),
         evidence={
-            "affected_jobs": [dict(r) for r in rows[:5]],
+            "affected_jobs": rows[:5],
             "total_jobs": len(rows),
         },
         job_count=len(rows),
@@ -164,46 +279,75 @@ async def _analyse_turn_escalation(session: AsyncSession, repo: ObservationsRepo
     return 1
 
 
-async def _analyse_retry_waste(session: AsyncSession, repo: ObservationsRepo) -> int:
+async def _analyse_retry_waste(
+    session: AsyncSession, repo: ObservationsRepo, columnar: ColumnarStore | None = None
+) -> int:
     """Find tools where retries are common and costly."""
-    result = await session.execute(
-        text("""
+    rows = await _span_rows(
+        session,
+        columnar,
+        columnar_sql="""
             SELECT
                 name as tool_name,
-                SUM(CASE WHEN is_retry = 1 THEN 1 ELSE 0 END) as retry_count,
+                SUM(CASE WHEN is_retry THEN 1 ELSE 0 END) as retry_count,
                 COUNT(*) as total_calls,
                 COUNT(DISTINCT job_id) as job_count
-            FROM job_telemetry_spans
+            FROM spans
             WHERE span_type = 'tool'
-                AND created_at >= datetime('now', '-30 days')
+                AND CAST(day AS DATE) >= current_date - 30
             GROUP BY name
             HAVING retry_count >= 5
             ORDER BY retry_count DESC
             LIMIT 20
-        """)
+        """,
+        db_sql=f"""
+            SELECT
+                name as tool_name,
+                SUM(CASE WHEN is_retry = TRUE THEN 1 ELSE 0 END) as retry_count,
+                COUNT(*) as total_calls,
+                COUNT(DISTINCT job_id) as job_count
+            FROM job_telemetry_spans
+            WHERE span_type = 'tool'
+                AND created_at >= {now_minus_days(30, dialect_of(session))}
+            GROUP BY name
+            HAVING SUM(CASE WHEN is_retry = TRUE THEN 1 ELSE 0 END) >= 5
+            ORDER BY retry_count DESC
+            LIMIT 20
+        """,  # noqa: S608
     )
-    rows = result.mappings().all()
     count = 0
     for r in rows:
-        retry_pct = r["retry_count"] / r["total_calls"] * 100
-        if retry_pct < 10:
-            continue
-        await repo.upsert(
-            category="retry_waste",
-            severity="warning" if retry_pct >= 30 else "info",
-            title=f"Frequent retries: {r['tool_name']} ({retry_pct:.0f}%)",
-            detail=(
-                f"Tool '{r['tool_name']}' was retried {r['retry_count']}/{r['total_calls']} "
-                f"times ({retry_pct:.1f}%) across {r['job_count']} jobs."
-            ),
-            evidence={
-                "tool_name": r["tool_name"],
-                "retry_count": r["retry_count"],
-                "total_calls": r["total_calls"],
-                "retry_pct": round(retry_pct, 1),
-                "job_count": r["job_count"],
-            },
+        count += await _report_retry_waste(
+            repo,
+            tool_name=r["tool_name"],
+            retry_count=r["retry_count"],
+            total_calls=r["total_calls"],
             job_count=r["job_count"],
         )
-        count += 1
     return count
+
+
+async def _report_retry_waste(
+    repo: ObservationsRepo, *, tool_name: str, retry_count: int, total_calls: int, job_count: int
+) -> int:
+    retry_pct = retry_count / total_calls * 100
+    if retry_pct < 10:
+        return 0
+    await repo.upsert(
+        category="retry_waste",
+        severity="warning" if retry_pct >= 30 else "info",
+        title=f"Frequent retries: {tool_name} ({retry_pct:.0f}%)",
+        detail=(
+            f"Tool '{tool_name}' was retried {retry_count}/{total_calls} "
+            f"times ({retry_pct:.1f}%) across {job_count} jobs."
+        ),
+        evidence={
+            "tool_name": tool_name,
+            "retry_count": retry_count,
+            "total_calls": total_calls,
+            "retry_pct": round(retry_pct, 1),
+            "job_count": job_count,
+        },
+        job_count=job_count,
+    )
+    return 1
@@ -0,0 +1,234 @@
+"""Persistent, content-addressed cache of per-step diffs.
+
+A step's diff runs between two commits, ``start_sha`` and ``end_sha``.  Commits
+never change, so the diff never does either.  Each result is stored once as a
+gzip-compressed JSON file holding the raw diff text and the parsed
+``DiffFileModel`` list::
+
+    <codeplane dir>/cache/step-diffs/<key[:2]>/<key>.json.gz
+
+The key is a SHA-256 over (repo, from_sha, to_sha, path filter).  Files are
+written atomically and survive restarts.  Once the cache holds more than
+``_MAX_ENTRIES`` files, the least recently read ones are removed.
+
+The cache also subscribes to the EventBus.  When a ``step_completed`` or a
+finished ``plan_step_updated`` event carries both SHAs, it computes the diff
+in the background, so the first click on that step's diff is already a hit.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import contextlib
+import gzip
+import hashlib
+import json
+import os
+import re
+from dataclasses import dataclass, field
+from typing import TYPE_CHECKING
+
+import structlog
+
+from backend.config import get_codeplane_dir
+from backend.models.api_schemas import DiffFileModel
+from backend.models.events import DomainEvent, DomainEventKind
+from backend.persistence.job_repo import JobRepository
+from backend.services.diff_service import DiffService
+
+if TYPE_CHECKING:
+    from collections.abc import Sequence
+    from pathlib import Path
+
+    from sqlalchemy.ext.asyncio import AsyncSession, async_sessionmaker
+
+    from backend.services.git_service import GitService
+
+log = structlog.get_logger()
+
+_FORMAT_VERSION = 1
+_MAX_ENTRIES = 5_000
+_PRUNE_EVERY = 100  # writes between size checks
+_PREFETCH_CONCURRENCY = 2
+_SHA_RE = re.compile(r"[0-9a-f]{40}(?:[0-9a-f]{24})?")
+
+
+@dataclass(frozen=True)
+class StepDiff:
+    """A diff between two commits, raw and parsed."""
+
+    diff: str
+    changed_files: list[DiffFileModel] = field(default_factory=list)
+
+    @property
+    def files_changed(self) -> int:
+        return self.diff.count("\ndiff --git ") + (1 if self.diff.startswith("diff --git ") else 0)
+
+
+EMPTY_DIFF = StepDiff(diff="")
+
+
+def cache_key(repo: str, from_sha: str, to_sha: str, paths: Sequence[str] = ()) -> str:
+    """Content address of a diff between two commits of *repo*, limited to *paths*."""
+    material = json.dumps([repo, from_sha, to_sha, sorted(paths)], separators=(",", ":"))
+    return hashlib.sha256(material.encode()).hexdigest()
+
+
+class StepDiffCache:
+    """Serve step diffs from disk, computing each (repo, from, to, paths) once."""
+
+    # Finished steps whose diff is prefetched
+    EVENT_KINDS = frozenset({DomainEventKind.step_completed, DomainEventKind.plan_step_updated})
+
+    def __init__(
+        self,
+        git_service: GitService,
+        session_factory: async_sessionmaker[AsyncSession],
+        cache_dir: Path | None = None,
+    ) -> None:
+        self._git = git_service
+        self._session_factory = session_factory
+        self._dir = cache_dir or get_codeplane_dir() / "cache" / "step-diffs"
+        self._inflight: dict[str, asyncio.Future[StepDiff]] = {}
+        self._prefetches: set[asyncio.Task[None]] = set()
+        self._prefetch_slots = asyncio.Semaphore(_PREFETCH_CONCURRENCY)
+        self._writes = 0
+
+    async def get(
+        self,
+        repo: str,
+        worktree: str,
+        from_sha: str,
+        to_sha: str,
+        paths: Sequence[str] = (),
+    ) -> StepDiff:
+        """Diff *from_sha*..*to_sha*, read from the cache or computed in *worktree*.
+
+        Raises ``GitError`` when git cannot produce the diff; failures are not
+        cached.
+        """
+        if from_sha == to_sha:
+            return EMPTY_DIFF
+        if not (_SHA_RE.fullmatch(from_sha) and _SHA_RE.fullmatch(to_sha)):
+            # Only full commit SHAs are immutable; refs and short SHAs bypass the cache
+            return await self._compute(worktree, from_sha, to_sha, paths)
+
+        key = cache_key(repo, from_sha, to_sha, paths)
+        cached = await asyncio.to_thread(self._load, key)
+        if cached is not None:
+            return cached
+
+        pending = self._inflight.get(key)
+        if pending is not None:
+            return await asyncio.shield(pending)
+        future: asyncio.Future[StepDiff] = asyncio.get_running_loop().create_future()
+        self._inflight[key] = future
+        try:
+            result = await self._compute(worktree, from_sha, to_sha, paths)
+            await asyncio.to_thread(self._store, key, result)
+            future.set_result(result)
+            return result
+        except asyncio.CancelledError:
+            future.cancel()
+            raise
+        except Exception as exc:
+            future.set_exception(exc)
+            future.exception()  # mark retrieved when nobody else is waiting
+            raise
+        finally:
+            del self._inflight[key]
+
+    async def __call__(self, event: DomainEvent) -> None:
+        """EventBus entry point — schedule a prefetch when a step finishes."""
+        if event.kind == DomainEventKind.plan_step_updated:
+            if event.payload.get("status") != "done":
+                return
+        elif event.kind != DomainEventKind.step_completed:
+            return
+        start_sha = event.payload.get("start_sha")
+        end_sha = event.payload.get("end_sha")
+        if not start_sha or not end_sha or start_sha == end_sha:
+            return
+        task = asyncio.create_task(self._prefetch(event.job_id, str(start_sha), str(end_sha)))
+        self._prefetches.add(task)
+        task.add_done_callback(self._prefetches.discard)
+
+    async def close(self) -> None:
+        """Cancel outstanding prefetches."""
+        for task in list(self._prefetches):
+            task.cancel()
+        await asyncio.gather(*self._prefetches, return_exceptions=True)
+
+    async def _prefetch(self, job_id: str, start_sha: str, end_sha: str) -> None:
+        async with self._prefetch_slots:
+            try:
+                async with self._session_factory() as session:
+                    job = await JobRepository(session).get(job_id)
+                if job is None or not job.worktree_path:
+                    return
+                await self.get(job.repo, job.worktree_path, start_sha, end_sha)
+            except asyncio.CancelledError:
+                raise
+            except Exception:
+                log.debug("step_diff_prefetch_failed", job_id=job_id, exc_info=True)
+
+    async def _compute(self, worktree: str, from_sha: str, to_sha: str, paths: Sequence[str]) -> StepDiff:
+        diff_text = await self._git.diff_range(from_sha, to_sha, cwd=worktree, paths=paths)
+        return StepDiff(diff=diff_text, changed_files=DiffService._parse_unified_diff(diff_text))
+
+    def _path(self, key: str) -> Path:
+        return self._dir / key[:2] / f"{key}.json.gz"
+
+    def _load(self, key: str) -> StepDiff | None:
+        path = self._path(key)
+        try:
+            with gzip.open(path, "rt", encoding="utf-8") as fh:
+                record = json.load(fh)
+            if record.get("v") != _FORMAT_VERSION:
+                return None
+            result = StepDiff(
+                diff=record["diff"],
+                changed_files=[DiffFileModel.model_validate(f) for f in record["files"]],
+            )
+        except FileNotFoundError:
+            return None
+        except (OSError, ValueError, KeyError, TypeError):
+            log.warning("step_diff_cache_corrupt", path=str(path), exc_info=True)
+            path.unlink(missing_ok=True)
+            return None
+        with contextlib.suppress(OSError):
+            os.utime(path)  # recency for pruning
+        return result
+
+    def _store(self, key: str, result: StepDiff) -> None:
+        path = self._path(key)
+        record = {
+            "v": _FORMAT_VERSION,
+            "diff": result.diff,
+            "files": [f.model_dump(mode="json") for f in result.changed_files],
+        }
+        try:
+            path.parent.mkdir(parents=True, exist_ok=True)
+            tmp = path.with_suffix(f".{os.getpid()}.tmp")
+            with gzip.open(tmp, "wt", encoding="utf-8", compresslevel=6) as fh:
+                json.dump(record, fh, separators=(",", ":"))
+            os.replace(tmp, path)
+        except OSError:
+            log.warning("step_diff_cache_write_failed", path=str(path), exc_info=True)
+            return
+        self._writes += 1
+        if self._writes % _PRUNE_EVERY == 0:
+            self._prune()
+
+    def _prune(self) -> None:
+        entries: list[tuple[float, Path]] = []
+        for path in self._dir.glob("*/*.json.gz"):
+            with contextlib.suppress(OSError):
+                entries.append((path.stat().st_mtime, path))
+        excess = len(entries) - _MAX_ENTRIES
+        if excess <= 0:
+            return
+        entries.sort()
+        for _, path in entries[:excess]:
+            path.unlink(missing_ok=True)
+        log.debug("step_diff_cache_pruned", removed=excess)
@@ -16,11 +16,11 @@ if TYPE_CHECKING:
 class StepPersistenceSubscriber:
     """Listens for step events and persists them via StepRepository.
 
-    Registered as an EventBus subscriber — receives ALL events.
-    Filters to step_started / step_completed internally and early-returns
-    on all other event kinds to minimize async overhead.
+    Registered on the EventBus for :attr:`EVENT_KINDS` only.
     """
 
+    EVENT_KINDS = frozenset({DomainEventKind.step_started, DomainEventKind.step_completed})
+
     def __init__(self, step_repo: StepRepository) -> None:
         self._step_repo = step_repo
 
@@ -30,7 +30,6 @@ class StepPersistenceSubscriber:
             await self._on_step_started(event)
         elif event.kind == DomainEventKind.step_completed:
             await self._on_step_completed(event)
-        # All other event kinds: early return (no-op)
 
     async def _on_step_started(self, event: DomainEvent) -> None:
         p = event.payload
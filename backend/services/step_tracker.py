@@ -8,7 +8,9 @@ The adapters guarantee non-empty turn_id on every transcript event. If an
 adapter violates this, the tracker logs a warning and assigns the event to
 the current step (no phantom split).
 
-Tracks: file paths touched per step, Git SHA at step boundaries.
+Tracks: file paths touched per step, Git SHA at step boundaries.  SHAs are
+read from the worktree's ref files (``GitHeadCache``); ``git rev-parse`` is
+only spawned when those cannot be resolved.
 """
 
 from __future__ import annotations
@@ -26,6 +28,7 @@ if TYPE_CHECKING:
     from backend.services.git_service import GitService
 
 from backend.models.events import DomainEvent, DomainEventKind
+from backend.services.git_head import GitHeadCache
 
 log = structlog.get_logger()
 
@@ -79,6 +82,7 @@ class StepTracker:
         self._current: dict[str, _StepState] = {}
         self._counters: dict[str, int] = {}
         self._worktree_paths: dict[str, str] = {}  # job_id → worktree cwd
+        self._heads = GitHeadCache()
 
     def register_worktree(self, job_id: str, worktree_path: str) -> None:
         """Set the worktree path for a job. Called from _execute_session_attempt."""
@@ -184,14 +188,7 @@ class StepTracker:
         self._counters[job_id] = n
         step_id = f"step-{uuid.uuid4().hex[:12]}"
 
-        start_sha: str | None = None
-        if self._git_service:
-            cwd = self._worktree_paths.get(job_id)
-            if cwd:
-                try:
-                    start_sha = await self._git_service.rev_parse("HEAD", cwd=cwd)
-                except Exception:
-                    pass  # No worktree yet, or git error — not fatal
+        start_sha = await self._head_sha(job_id)
 
         state = _StepState(
             step_id=step_id,
@@ -226,14 +223,7 @@ class StepTracker:
         now = datetime.now(UTC)
         duration_ms = int((now - state.started_at).total_seconds() * 1000)
 
-        end_sha: str | None = None
-        if self._git_service:
-            cwd = self._worktree_paths.get(job_id)
-            if cwd:
-                try:
-                    end_sha = await self._git_service.rev_parse("HEAD", cwd=cwd)
-                except Exception:
-                    pass
+        end_sha = await self._head_sha(job_id)
 
         await self._event_bus.publish(DomainEvent(
             event_id=DomainEvent.make_event_id(),
@@ -255,8 +245,25 @@ class StepTracker:
         ))
         self._current.pop(job_id, None)
 
+    async def _head_sha(self, job_id: str) -> str | None:
+        """HEAD of the job's worktree, from the ref files when possible."""
+        if not self._git_service:
+            return None
+        cwd = self._worktree_paths.get(job_id)
+        if not cwd:
+            return None
+        sha = self._heads.head(cwd)
+        if sha is not None:
+            return sha
+        try:
+            return await self._git_service.rev_parse("HEAD", cwd=cwd)
+        except Exception:
+            return None  # No worktree yet, or git error — not fatal
+
     def cleanup(self, job_id: str) -> None:
         """Remove all in-memory state for a job."""
         self._current.pop(job_id, None)
         self._counters.pop(job_id, None)
-        self._worktree_paths.pop(job_id, None)
+        cwd = self._worktree_paths.pop(job_id, None)
+        if cwd is not None and cwd not in self._worktree_paths.values():
+            self._heads.forget(cwd)
@@ -4,7 +4,8 @@ Provides OpenTelemetry instruments (counters, histograms, gauges) that agent
 adapters call directly.  An in-process ``InMemoryMetricReader`` is always
 active so the API can serve live telemetry with zero config.  An optional
 OTLP exporter can be activated by setting ``OTEL_EXPORTER_ENDPOINT`` to push
-to Grafana / Jaeger / Prometheus.
+to Grafana / Jaeger / Prometheus; Prometheus can also pull the in-memory
+reader through ``GET /metrics`` (see :mod:`backend.services.openmetrics`).
 
 Adapters import the instruments and call them with standard OTEL attributes::
 
@@ -18,8 +19,10 @@ Adapters import the instruments and call them with standard OTEL attributes::
 from __future__ import annotations
 
 import os
+from collections.abc import Callable, Iterable
 
 from opentelemetry import metrics, trace
+from opentelemetry.metrics import CallbackOptions, Observation
 from opentelemetry.sdk.metrics import MeterProvider
 from opentelemetry.sdk.metrics.export import InMemoryMetricReader, MetricReader
 from opentelemetry.sdk.trace import TracerProvider
@@ -100,6 +103,55 @@ quota_used_gauge = meter.create_gauge("cp.quota.used", description="Copilot quot
 quota_entitlement_gauge = meter.create_gauge("cp.quota.entitlement", description="Copilot quota entitlement")
 quota_remaining_gauge = meter.create_gauge("cp.quota.remaining_pct", unit="%", description="Copilot quota remaining %")
 
+# ---------------------------------------------------------------------------
+# Runtime internals — process health rather than agent usage.  Labels must
+# stay low-cardinality (no job ids); these feed the ``/metrics`` scrape.
+# ---------------------------------------------------------------------------
+
+git_commands = meter.create_counter("cp.git.commands", description="git subprocesses run, by subcommand and outcome")
+git_duration = meter.create_histogram("cp.git.duration", unit="ms", description="git subprocess wall time")
+sister_duration = meter.create_histogram(
+    "cp.sister.duration", unit="ms", description="Sister-session completion latency"
+)
+event_persist_duration = meter.create_histogram(
+    "cp.events.persist.duration", unit="ms", description="Domain event persist latency, including lock wait"
+)
+stage_duration = meter.create_histogram(
+    "cp.stage.duration", unit="ms", description="CodePlane-internal job stage time (queue, diff, setup, ...)"
+)
+jobs_queued_gauge = meter.create_gauge("cp.jobs.queued", description="Jobs waiting in the queue")
+
+# Observable gauges read live service state at collection time.  Services
+# are wired after import, so each gauge pulls from a source registered via
+# :func:`observe`; an unregistered source reports nothing.
+GaugeSource = Callable[[], Iterable[tuple[float, dict[str, str]]]]
+_gauge_sources: dict[str, GaugeSource] = {}
+
+
+def observe(name: str, source: GaugeSource) -> None:
+    """Attach (or replace) the source of ``(value, labels)`` pairs behind an observable gauge."""
+    _gauge_sources[name] = source
+
+
+def _observable_gauge(name: str, description: str) -> None:
+    def _callback(_options: CallbackOptions) -> Iterable[Observation]:
+        source = _gauge_sources.get(name)
+        return [Observation(value, labels) for value, labels in source()] if source is not None else []
+
+    meter.create_observable_gauge(name, callbacks=[_callback], description=description)
+
+
+_observable_gauge("cp.jobs.active", "Jobs held by the runtime, by state (running | pending)")
+_observable_gauge("cp.events.in_flight", "Event bus publishes awaiting subscribers")
+_observable_gauge("cp.events.dead_letter", "Events waiting for a persist retry")
+_observable_gauge("cp.sse.connections", "Open SSE connections, by scope (job | global)")
+_observable_gauge("cp.sse.queue.depth", "Frames buffered across SSE connection queues")
+_observable_gauge("cp.sse.queue.max_fill", "Fullest SSE connection queue, as a fraction of capacity")
+_observable_gauge("cp.db.pool", "Database connection pools, by pool (main | write | read) and state")
+_observable_gauge("cp.db.wal.bytes", "SQLite write-ahead log size in bytes")
+_observable_gauge("cp.log.queue.depth", "Log records waiting for the file-writer thread")
+_observable_gauge("cp.log.discarded", "Log records never written since startup, by reason (dropped | sampled)")
+
 # ---------------------------------------------------------------------------
 # Per-job span tracking — root span per job for waterfall views
 # ---------------------------------------------------------------------------
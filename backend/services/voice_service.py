@@ -1,15 +1,27 @@
 """Local voice transcription via faster-whisper.
 
 Requires the ``voice`` extra: ``pip install codeplane[voice]``.
+
+The model lives in a resident worker process (``backend.services.voice_worker``)
+started once per server, so loading and decoding never compete with the
+event loop and the first request does not pay for the model load.
 """
 
 from __future__ import annotations
 
+import asyncio
+import contextlib
 import io
+import itertools
+import json
+import sys
+import threading
 from typing import TYPE_CHECKING, Any
 
 import structlog
 
+from backend.config import VoiceConfig
+
 if TYPE_CHECKING:
     from faster_whisper import WhisperModel
 
@@ -29,26 +41,179 @@ def _import_whisper() -> Any:
     return _Cls
 
 
+class VoiceBusyError(Exception):
+    """Too many transcriptions are already waiting for the worker."""
+
+
 class VoiceService:
     """Transcribes audio using faster-whisper locally.
 
-    The model is loaded once and reused across requests.
+    In the server, :meth:`submit` and :meth:`submit_partial` hand audio to the
+    resident worker process.  Inside the worker, :meth:`transcribe` runs the
+    model, which is loaded once and reused across requests.
     """
 
-    def __init__(self) -> None:
-        self._model_name = _MODEL_NAME
+    def __init__(self, config: VoiceConfig | None = None) -> None:
+        self._config = config or VoiceConfig(model=_MODEL_NAME)
+        self._model_name = self._config.model
         self._model: WhisperModel | None = None
+        # Transcriptions run concurrently on worker threads and may race the load
+        self._load_lock = threading.Lock()
+        # Server side: the worker process and the requests waiting on it
+        self._proc: asyncio.subprocess.Process | None = None
+        self._reader: asyncio.Task[None] | None = None
+        self._spawn_lock = asyncio.Lock()
+        self._pending: dict[int, asyncio.Future[str | None]] = {}
+        self._ids = itertools.count(1)
+
+    @property
+    def partial_interval_s(self) -> float:
+        return self._config.partial_interval_s
+
+    # ------------------------------------------------------------------
+    # In-process model (runs inside the worker)
+    # ------------------------------------------------------------------
 
     def _ensure_model(self) -> Any:
-        if self._model is None:
-            whisper_cls = _import_whisper()
-            logger.debug("voice_model_loading", model=self._model_name)
-            self._model = whisper_cls(self._model_name, device="cpu", compute_type="int8")
-            logger.debug("voice_model_loaded", model=self._model_name)
+        with self._load_lock:
+            if self._model is None:
+                whisper_cls = _import_whisper()
+                logger.debug("voice_model_loading", model=self._model_name)
+                # One replica per concurrent request, so they do not queue on a single one
+                self._model = whisper_cls(
+                    self._model_name, device="cpu", compute_type="int8", num_workers=max(1, self._config.workers)
+                )
+                logger.debug("voice_model_loaded", model=self._model_name)
         return self._model
 
+    def warm_up(self) -> None:
+        """Load the model and decode a second of silence so the first request is fast."""
+        model = self._ensure_model()
+        import numpy as np  # installed with faster-whisper
+
+        segments, _ = model.transcribe(np.zeros(16000, dtype=np.float32))
+        for _ in segments:
+            pass
+
     def transcribe(self, audio_bytes: bytes) -> str:
         """Transcribe raw audio bytes and return the text."""
         model = self._ensure_model()
         segments, _ = model.transcribe(io.BytesIO(audio_bytes))
         return " ".join(seg.text.strip() for seg in segments)
+
+    # ------------------------------------------------------------------
+    # Resident worker client (runs in the server)
+    # ------------------------------------------------------------------
+
+    async def start(self) -> None:
+        """Start the worker now if ``voice.preload`` is set; otherwise on first use."""
+        if self._config.preload:
+            await self._ensure_worker()
+
+    async def submit(self, audio: bytes) -> str:
+        """Transcribe a complete recording.
+
+        Raises :class:`VoiceBusyError` when ``voice.queue_limit`` requests are
+        already waiting.
+        """
+        if len(self._pending) >= self._config.queue_limit:
+            raise VoiceBusyError
+        return await self._request(audio, stream=None, partial=False) or ""
+
+    async def submit_partial(self, stream: str, audio: bytes) -> str | None:
+        """Transcribe the audio received so far on *stream*.
+
+        Returns None when the hypothesis was skipped: the queue is full, or a
+        newer partial for the same stream replaced it before it ran.
+        """
+        if len(self._pending) >= self._config.queue_limit:
+            return None
+        return await self._request(audio, stream=stream, partial=True)
+
+    async def close(self) -> None:
+        """Stop the worker process, failing anything still waiting on it."""
+        proc, self._proc = self._proc, None
+        if self._reader is not None:
+            self._reader.cancel()
+            with contextlib.suppress(asyncio.CancelledError):
+                await self._reader
+            self._reader = None
+        self._fail_pending("Voice worker stopped")
+        if proc is None or proc.returncode is not None:
+            return
+        if proc.stdin is not None:
+            proc.stdin.close()
+        try:
+            await asyncio.wait_for(proc.wait(), timeout=5)
+        except TimeoutError:
+            proc.kill()
+            await proc.wait()
+
+    async def _ensure_worker(self) -> asyncio.subprocess.Process:
+        async with self._spawn_lock:
+            if self._proc is not None and self._proc.returncode is None:
+                return self._proc
+            logger.debug("voice_worker_starting", model=self._model_name, workers=self._config.workers)
+            proc = await asyncio.create_subprocess_exec(
+                sys.executable,
+                "-m",
+                "backend.services.voice_worker",
+                "--model",
+                self._model_name,
+                "--workers",
+                str(self._config.workers),
+                stdin=asyncio.subprocess.PIPE,
+                stdout=asyncio.subprocess.PIPE,
+            )
+            assert proc.stdout is not None
+            line = await proc.stdout.readline()
+            try:
+                ready = json.loads(line) if line else {}
+            except ValueError:
+                ready = {"error": line.decode(errors="replace").strip()}
+            if not ready.get("ready"):
+                await proc.wait()
+                raise RuntimeError(f"Voice worker failed to start: {ready.get('error', proc.returncode)}")
+            self._proc = proc
+            self._reader = asyncio.create_task(self._read_responses(proc), name="voice-worker-reader")
+            logger.debug("voice_worker_ready", model=self._model_name, pid=proc.pid)
+            return proc
+
+    async def _request(self, audio: bytes, *, stream: str | None, partial: bool) -> str | None:
+        proc = await self._ensure_worker()
+        assert proc.stdin is not None
+        request_id = next(self._ids)
+        future: asyncio.Future[str | None] = asyncio.get_running_loop().create_future()
+        self._pending[request_id] = future
+        try:
+            header = {"id": request_id, "size": len(audio), "stream": stream, "partial": partial}
+            proc.stdin.write(json.dumps(header).encode() + b"\n" + audio)
+            await proc.stdin.drain()
+            return await future
+        finally:
+            self._pending.pop(request_id, None)
+
+    async def _read_responses(self, proc: asyncio.subprocess.Process) -> None:
+        assert proc.stdout is not None
+        while line := await proc.stdout.readline():
+            try:
+                message = json.loads(line)
+            except ValueError:
+                continue
+            future = self._pending.pop(message.get("id"), None)
+            if future is None or future.done():
+                continue  # caller went away
+            if "error" in message:
+                future.set_exception(RuntimeError(message["error"]))
+            else:
+                future.set_result(message.get("text"))
+        if self._proc is proc:
+            self._proc = None
+        logger.warning("voice_worker_exited", returncode=await proc.wait())
+        self._fail_pending("Voice worker exited")
+
+    def _fail_pending(self, reason: str) -> None:
+        pending, self._pending = self._pending, {}
+        for future in pending.values():
+            if not future.done():
+                future.set_exception(RuntimeError(reason))
@@ -0,0 +1,161 @@
+"""Resident transcription worker — ``python -m backend.services.voice_worker``.
+
+Spawned once by :class:`~backend.services.voice_service.VoiceService`, so
+the whisper model is loaded (and warmed up) a single time rather than in
+the server process on the first request.
+
+Protocol over stdin/stdout:
+
+    request:  {"id": N, "size": B, "stream": "...", "partial": bool}\\n  then B raw audio bytes
+    response: {"id": N, "text": "..."} | {"id": N, "error": "..."} | {"id": N, "skipped": true}
+
+The first line written is ``{"ready": true}`` once the model is loaded, or
+``{"error": "..."}`` if it cannot be.  Waiting requests are coalesced: a
+partial hypothesis is dropped (``skipped``) when a newer one for the same
+stream is queued behind it, and final transcriptions are served first.
+Up to ``--workers`` requests run concurrently on separate model replicas.
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import queue
+import sys
+import threading
+from concurrent.futures import ThreadPoolExecutor
+from dataclasses import dataclass
+from typing import IO, Any
+
+import structlog
+
+from backend.config import VoiceConfig
+from backend.services.voice_service import VoiceService
+
+log = structlog.get_logger()
+
+
+@dataclass
+class _Request:
+    id: int
+    audio: bytes
+    stream: str | None = None
+    partial: bool = False
+
+
+def read_request(stream: IO[bytes]) -> _Request | None:
+    """Read one framed request, or None at end of input."""
+    header = stream.readline()
+    if not header:
+        return None
+    meta = json.loads(header)
+    size = int(meta["size"])
+    audio = stream.read(size)
+    if len(audio) < size:
+        return None
+    return _Request(id=int(meta["id"]), audio=audio, stream=meta.get("stream"), partial=bool(meta.get("partial")))
+
+
+def coalesce(pending: list[_Request]) -> tuple[list[_Request], list[_Request]]:
+    """Split waiting requests into (to run, finals first) and superseded partials."""
+    latest: dict[str, int] = {}
+    for index, req in enumerate(pending):
+        if req.partial and req.stream is not None:
+            latest[req.stream] = index
+    keep: list[_Request] = []
+    dropped: list[_Request] = []
+    for index, req in enumerate(pending):
+        if req.partial and req.stream is not None and latest[req.stream] != index:
+            dropped.append(req)
+        else:
+            keep.append(req)
+    keep.sort(key=lambda r: r.partial)
+    return keep, dropped
+
+
+class _Worker:
+    def __init__(self, service: VoiceService, workers: int, out: IO[bytes]) -> None:
+        self._service = service
+        self._out = out
+        self._out_lock = threading.Lock()
+        self._inbox: queue.Queue[_Request | None] = queue.Queue()
+        self._slots = threading.Semaphore(workers)
+        self._pool = ThreadPoolExecutor(max_workers=workers, thread_name_prefix="voice")
+
+    def send(self, message: dict[str, Any]) -> None:
+        line = json.dumps(message).encode() + b"\n"
+        with self._out_lock:
+            self._out.write(line)
+            self._out.flush()
+
+    def _run(self, req: _Request) -> None:
+        try:
+            self.send({"id": req.id, "text": self._service.transcribe(req.audio)})
+        except Exception as exc:
+            log.warning("voice_worker_transcribe_failed", error=str(exc))
+            self.send({"id": req.id, "error": str(exc)})
+        finally:
+            self._slots.release()
+
+    def _read_loop(self, stream: IO[bytes]) -> None:
+        while (req := read_request(stream)) is not None:
+            self._inbox.put(req)
+        self._inbox.put(None)
+
+    def _drain(self, pending: list[_Request]) -> bool:
+        """Move everything queued into *pending*; False once input has ended."""
+        while True:
+            try:
+                req = self._inbox.get_nowait()
+            except queue.Empty:
+                return True
+            if req is None:
+                return False
+            pending.append(req)
+
+    def serve(self, stream: IO[bytes]) -> None:
+        threading.Thread(target=self._read_loop, args=(stream,), name="voice-reader", daemon=True).start()
+        pending: list[_Request] = []
+        open_ = True
+        while open_ or pending:
+            if not pending:
+                req = self._inbox.get()
+                if req is None:
+                    break
+                pending.append(req)
+            # Wait for a free replica, then look at everything that arrived meanwhile
+            self._slots.acquire()
+            open_ = self._drain(pending) and open_
+            pending, dropped = coalesce(pending)
+            for req in dropped:
+                self.send({"id": req.id, "skipped": True})
+            self._pool.submit(self._run, pending.pop(0))
+        self._pool.shutdown(wait=True)
+
+
+def main(argv: list[str] | None = None) -> int:
+    parser = argparse.ArgumentParser(description="Resident voice transcription worker")
+    parser.add_argument("--model", default="base.en")
+    parser.add_argument("--workers", type=int, default=2)
+    args = parser.parse_args(argv)
+
+    # stdout carries the protocol; everything else goes to stderr
+    out = sys.stdout.buffer
+    sys.stdout = sys.stderr
+    structlog.configure(logger_factory=structlog.PrintLoggerFactory(sys.stderr))
+
+    workers = max(1, args.workers)
+    service = VoiceService(VoiceConfig(model=args.model, workers=workers))
+    worker = _Worker(service, workers, out)
+    try:
+        service.warm_up()
+    except Exception as exc:
+        worker.send({"error": str(exc)})
+        return 1
+    worker.send({"ready": True})
+    worker.serve(sys.stdin.buffer)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
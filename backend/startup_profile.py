@@ -0,0 +1,108 @@
+"""Startup phase timing for ``cpl up --profile-startup``.
+
+Phases are always recorded (one ``perf_counter`` read at each end) and
+logged as ``startup_profile`` once the first HTTP request has been served.
+With ``--profile-startup`` a table is also printed to stderr.  The clock
+starts when this module is imported, which ``backend.cli`` does before
+anything heavy, so the ``imports`` phase covers loading the application.
+
+For a per-module import breakdown run ``python -X importtime -m backend.cli up``.
+"""
+
+from __future__ import annotations
+
+import contextlib
+import sys
+import time
+from typing import TYPE_CHECKING, Any
+
+import structlog
+
+if TYPE_CHECKING:
+    from collections.abc import Awaitable, Callable, Iterator, MutableMapping
+
+    _Scope = MutableMapping[str, Any]
+    _ASGIApp = Callable[[_Scope, Callable[[], Awaitable[Any]], Callable[[Any], Awaitable[None]]], Awaitable[None]]
+
+log = structlog.get_logger()
+
+
+class StartupProfile:
+    """Named, ordered startup phases relative to process start."""
+
+    def __init__(self) -> None:
+        self.origin = time.perf_counter()
+        self.enabled = False
+        self._phases: list[tuple[str, float, float]] = []  # (name, offset s, duration s)
+        self._ready_at: float | None = None
+        self._first_request_at: float | None = None
+
+    def now(self) -> float:
+        """Seconds since process start."""
+        return time.perf_counter() - self.origin
+
+    @contextlib.contextmanager
+    def phase(self, name: str) -> Iterator[None]:
+        """Time the enclosed block as *name*."""
+        started = self.now()
+        try:
+            yield
+        finally:
+            self._phases.append((name, started, self.now() - started))
+
+    def phase_since(self, name: str, started: float) -> None:
+        """Record *name* as running from offset *started* until now."""
+        self._phases.append((name, started, self.now() - started))
+
+    def ready(self) -> None:
+        """Mark application startup complete — the listener binds right after."""
+        self._ready_at = self.now()
+
+    @property
+    def ready_at(self) -> float | None:
+        return self._ready_at
+
+    @property
+    def first_request_at(self) -> float | None:
+        return self._first_request_at
+
+    def wrap(self, app: _ASGIApp) -> _ASGIApp:
+        """Wrap an ASGI app so the first completed HTTP request ends the profile."""
+
+        async def _timed(
+            scope: _Scope, receive: Callable[[], Awaitable[Any]], send: Callable[[Any], Awaitable[None]]
+        ) -> None:
+            await app(scope, receive, send)
+            if scope["type"] == "http" and self._first_request_at is None:
+                self._first_request_at = self.now()
+                self._report()
+
+        return _timed
+
+    def summary(self) -> dict[str, Any]:
+        return {
+            "phases": {name: round(duration, 3) for name, _, duration in self._phases},
+            "ready_s": None if self._ready_at is None else round(self._ready_at, 3),
+            "first_request_s": None if self._first_request_at is None else round(self._first_request_at, 3),
+        }
+
+    def format_table(self) -> str:
+        lines = ["", "Startup profile (seconds since process start)", f"  {'phase':<32} {'start':>7} {'took':>7}"]
+        lines += [f"  {name:<32} {start:7.3f} {duration:7.3f}" for name, start, duration in self._phases]
+        if self._ready_at is not None:
+            lines.append(f"  {'ready to listen':<32} {self._ready_at:7.3f}")
+        if self._first_request_at is not None:
+            lines.append(f"  {'first request served':<32} {self._first_request_at:7.3f}")
+        return "\n".join(lines) + "\n"
+
+    def _report(self) -> None:
+        log.info("startup_profile", **self.summary())
+        if self.enabled:
+            sys.stderr.write(self.format_table())
+
+    def report_deferred(self) -> None:
+        """Log (and with profiling on, print) the table again once deferred services are up."""
+        self._report()
+
+
+profile = StartupProfile()
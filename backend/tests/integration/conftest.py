@@ -28,7 +28,7 @@ from sqlalchemy.ext.asyncio import (
 )
 
 from backend.config import CPLConfig
-from backend.di import AppProvider, CachedModelsBySdk, RequestProvider, VoiceMaxBytes
+from backend.di import AppProvider, CachedModelsBySdk, ReadSessionFactory, RequestProvider, VoiceMaxBytes
 from backend.models.db import Base, JobRow
 from backend.persistence.database import _set_sqlite_pragmas
 from backend.services.approval_service import ApprovalService
@@ -125,7 +125,7 @@ def mock_merge_service() -> AsyncMock:
 @pytest.fixture
 def mock_voice_service() -> Mock:
     svc = Mock()
-    svc.transcribe.return_value = "hello world"
+    svc.submit = AsyncMock(return_value="hello world")
     return svc
 
 
@@ -211,6 +211,7 @@ async def app(
         context={
             CPLConfig: _test_config(),
             async_sessionmaker: session_factory,
+            ReadSessionFactory: ReadSessionFactory(session_factory),
             EventBus: event_bus,
             SSEManager: sse_manager,
             ApprovalService: approval_service,
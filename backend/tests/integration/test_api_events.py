@@ -146,3 +146,35 @@ class TestSSEFiltering:
         """Last-Event-ID as request header is accepted without error."""
         r = await _raw_asgi_sse(app, headers={"Last-Event-ID": "0"})
         assert r["status"] == 200
+
+
+class TestReplayStreaming:
+    """Reconnection replay is streamed while it runs, not after it finishes."""
+
+    @pytest.mark.asyncio
+    async def test_replay_frames_flow_before_replay_finishes(self) -> None:
+        from backend.api.events import _event_stream
+        from backend.services.sse_manager import KEEPALIVE_FRAME, SSEConnection, SSEManager
+
+        manager = SSEManager()
+        conn = SSEConnection()
+        manager.register(conn)
+        second_chunk_read = asyncio.Event()
+
+        async def _replay(target: SSEConnection, _factory: object, _last_id: int) -> None:
+            await target.send("chunk-0")
+            await second_chunk_read.wait()
+            await target.send("chunk-1")
+
+        manager.replay_from_factory = _replay  # type: ignore[method-assign]
+        stream = _event_stream(conn, manager, None, "7")  # type: ignore[arg-type]
+        try:
+            assert await asyncio.wait_for(anext(stream), 1) == KEEPALIVE_FRAME
+            assert await asyncio.wait_for(anext(stream), 1) == "chunk-0"
+            second_chunk_read.set()
+            assert await asyncio.wait_for(anext(stream), 1) == "chunk-1"
+            await stream.aclose()
+            assert manager.connection_count == 0
+        finally:
+            await stream.aclose()
+            await manager.close_all()
@@ -105,6 +105,18 @@ class TestUpdateSettings:
         assert resp.status_code == 200
         assert resp.json()["maxConcurrentJobs"] == 5
 
+    @pytest.mark.asyncio
+    async def test_update_is_applied_to_running_runtime(
+        self, client: AsyncClient, mock_runtime_service: AsyncMock, monkeypatch: pytest.MonkeyPatch
+    ) -> None:
+        monkeypatch.setattr("backend.api.settings.load_config", lambda path=None: _test_config())
+        monkeypatch.setattr("backend.api.settings.save_config", lambda config, path=None: None)
+
+        resp = await client.put("/api/settings", json={"maxConcurrentJobs": 4})
+        assert resp.status_code == 200
+        mock_runtime_service.apply_config.assert_called_once()
+        assert mock_runtime_service.apply_config.call_args.args[0].runtime.max_concurrent_jobs == 4
+
     @pytest.mark.asyncio
     async def test_partial_update_preserves_other_fields(
         self, client: AsyncClient, monkeypatch: pytest.MonkeyPatch
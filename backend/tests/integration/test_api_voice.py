@@ -7,10 +7,17 @@ content-type validation, size limits, and error handling.
 from __future__ import annotations
 
 from typing import TYPE_CHECKING
+from unittest.mock import AsyncMock
 
 import pytest
+from fastapi import FastAPI
+from fastapi.testclient import TestClient
+
+from backend.api import voice
+from backend.services.voice_service import VoiceBusyError
 
 if TYPE_CHECKING:
+    from collections.abc import Generator
     from unittest.mock import Mock
 
     from httpx import AsyncClient
@@ -59,8 +66,8 @@ class TestTranscribe:
         assert resp.status_code == 400
 
     async def test_transcribe_exception(self, mock_voice_service: Mock, client: AsyncClient) -> None:
-        original_side = mock_voice_service.transcribe.side_effect
-        mock_voice_service.transcribe.side_effect = RuntimeError("model crashed")
+        original_side = mock_voice_service.submit.side_effect
+        mock_voice_service.submit.side_effect = RuntimeError("model crashed")
         try:
             # ASGITransport re-raises app exceptions by default
             with pytest.raises(RuntimeError, match="model crashed"):
@@ -69,7 +76,15 @@ class TestTranscribe:
                     files=_audio_file(),
                 )
         finally:
-            mock_voice_service.transcribe.side_effect = original_side
+            mock_voice_service.submit.side_effect = original_side
+
+    async def test_queue_full(self, mock_voice_service: Mock, client: AsyncClient) -> None:
+        mock_voice_service.submit.side_effect = VoiceBusyError
+        try:
+            resp = await client.post("/api/voice/transcribe", files=_audio_file())
+            assert resp.status_code == 429
+        finally:
+            mock_voice_service.submit.side_effect = None
 
 
 class TestVoiceSizeLimit:
@@ -86,3 +101,38 @@ class TestVoiceSizeLimit:
             files=_audio_file(data=_WEBM_MAGIC + b"\x00" * 256),
         )
         assert resp.status_code == 413
+
+
+class TestStream:
+    """The /api/voice/stream WebSocket — partial hypotheses, then a final transcript."""
+
+    @pytest.fixture
+    def stream_client(self, mock_voice_service: Mock) -> Generator[TestClient, None, None]:
+        mock_voice_service.partial_interval_s = 0.0
+        mock_voice_service.submit_partial = AsyncMock(side_effect=lambda _stream, audio: f"{len(audio)} bytes")
+        voice.set_voice_service(mock_voice_service, 256)
+        application = FastAPI()
+        application.include_router(voice.router, prefix="/api")
+        with TestClient(application) as test_client:
+            yield test_client
+        voice.set_voice_service(None, 0)  # type: ignore[arg-type]
+
+    def test_partials_then_final(self, stream_client: TestClient, mock_voice_service: Mock) -> None:
+        with stream_client.websocket_connect("/api/voice/stream") as ws:
+            ws.send_bytes(_WEBM_MAGIC + b"\x00" * 12)
+            assert ws.receive_json() == {"type": "partial", "text": "16 bytes"}
+            ws.send_bytes(b"\x00" * 16)
+            assert ws.receive_json() == {"type": "partial", "text": "32 bytes"}
+            ws.send_json({"type": "stop"})
+            assert ws.receive_json() == {"type": "final", "text": "hello world"}
+        mock_voice_service.submit.assert_awaited_with(_WEBM_MAGIC + b"\x00" * 28)
+
+    def test_rejects_non_audio(self, stream_client: TestClient) -> None:
+        with stream_client.websocket_connect("/api/voice/stream") as ws:
+            ws.send_bytes(b"not audio")
+            assert ws.receive_json() == {"type": "error", "message": "Unsupported audio format"}
+
+    def test_size_limit(self, stream_client: TestClient) -> None:
+        with stream_client.websocket_connect("/api/voice/stream") as ws:
+            ws.send_bytes(_WEBM_MAGIC + b"\x00" * 512)
+            assert ws.receive_json()["type"] == "error"
@@ -0,0 +1,298 @@
+"""Tests for learned approval rules — counting operator decisions and auto-approving."""
+
+from __future__ import annotations
+
+import json
+import sqlite3
+from datetime import UTC, datetime
+from typing import TYPE_CHECKING
+
+import pytest
+from sqlalchemy import event as sa_event
+from sqlalchemy.ext.asyncio import AsyncSession, async_sessionmaker, create_async_engine
+
+from backend.config import ApprovalRulesConfig
+from backend.models.db import Base, JobRow
+from backend.persistence.database import _set_sqlite_pragmas
+from backend.services.approval_rules import ApprovalRules, action_key
+from backend.services.approval_service import ApprovalService
+
+if TYPE_CHECKING:
+    from collections.abc import AsyncGenerator
+    from pathlib import Path
+
+_PYTEST = "uv run pytest -q backend/tests"
+
+
+@pytest.fixture
+async def session_factory() -> AsyncGenerator[async_sessionmaker[AsyncSession], None]:
+    engine = create_async_engine("sqlite+aiosqlite:///:memory:")
+    sa_event.listen(engine.sync_engine, "connect", _set_sqlite_pragmas)
+    async with engine.begin() as conn:
+        await conn.run_sync(Base.metadata.create_all)
+    factory = async_sessionmaker(engine, expire_on_commit=False)
+    async with factory() as session:
+        for jid, repo in [("job-1", "/repo-a"), ("job-2", "/repo-a"), ("job-3", "/repo-b")]:
+            session.add(
+                JobRow(
+                    id=jid,
+                    repo=repo,
+                    prompt="test",
+                    state="running",
+                    base_ref="main",
+                    created_at=datetime.now(UTC),
+                    updated_at=datetime.now(UTC),
+                )
+            )
+        await session.commit()
+    yield factory
+    await engine.dispose()
+
+
+async def _service(
+    session_factory: async_sessionmaker[AsyncSession], min_approvals: int = 3
+) -> tuple[ApprovalService, ApprovalRules]:
+    rules = ApprovalRules(session_factory, ApprovalRulesConfig(enabled=True, min_approvals=min_approvals))
+    await rules.load()
+    return ApprovalService(session_factory, rules=rules), rules
+
+
+async def _decide(svc: ApprovalService, job_id: str, command: str, resolution: str, times: int = 1) -> None:
+    for _ in range(times):
+        approval = await svc.create_request(job_id, f"Run shell: {command}", proposed_action=command, tool="shell")
+        await svc.resolve(approval.id, resolution)
+
+
+def test_action_key() -> None:
+    assert action_key("shell", f"  {_PYTEST}\n") == _PYTEST
+    assert action_key("Bash", json.dumps({"command": _PYTEST, "description": "tests"})) == _PYTEST
+    assert action_key("Bash", json.dumps({"file_path": "/x.py", "content": "x"})) is None
+    assert action_key("Bash", _PYTEST) is None
+    assert action_key("shell", "") is None
+    assert action_key("shell", None) is None
+    # Claude input cut at the stored length is not a command key
+    assert action_key("Bash", json.dumps({"command": "x" * 3000})[:2000]) is None
+    assert action_key("Bash", '{"command": "rm -rf ') is None
+    # Only shell tools are learned, whatever their input looks like
+    assert action_key("mcp__db__query", json.dumps({"command": "DROP TABLE jobs"})) is None
+    assert action_key("write", "/repo/src/app.py") is None
+    assert action_key("url", "https://example.com") is None
+    assert action_key(None, _PYTEST) is None
+
+
+@pytest.mark.asyncio
+async def test_learned_after_threshold_and_scoped_to_repo(session_factory: async_sessionmaker[AsyncSession]) -> None:
+    svc, _ = await _service(session_factory)
+    await _decide(svc, "job-1", _PYTEST, "approved", times=2)
+    assert (await svc.create_request("job-2", "x", proposed_action=_PYTEST, tool="shell")).resolution is None
+
+    await _decide(svc, "job-2", _PYTEST, "approved")
+    auto = await svc.create_request("job-2", "x", proposed_action=_PYTEST, tool="shell")
+    assert auto.resolution == "approved"
+    assert auto.resolved_by == "rule"
+    assert await svc.wait_for_resolution(auto.id) == "approved"
+    assert svc.pop_auto_resolution(auto.id) is not None
+    assert svc.pop_auto_resolution(auto.id) is None
+
+    # Same command, different repo — not learned there
+    assert (await svc.create_request("job-3", "x", proposed_action=_PYTEST, tool="shell")).resolution is None
+    # Different command in the same repo
+    assert (await svc.create_request("job-1", "x", proposed_action=_PYTEST + " -x", tool="shell")).resolution is None
+
+
+@pytest.mark.asyncio
+async def test_rules_survive_restart(session_factory: async_sessionmaker[AsyncSession]) -> None:
+    svc, _ = await _service(session_factory)
+    await _decide(svc, "job-1", _PYTEST, "approved", times=3)
+    auto = await svc.create_request("job-1", "x", proposed_action=_PYTEST, tool="shell")
+
+    restarted, rules = await _service(session_factory)
+    [rule] = restarted.list_rules()
+    assert (rule.repo, rule.tool, rule.action, rule.approvals, rule.auto_approved) == (
+        "/repo-a",
+        "shell",
+        _PYTEST,
+        3,
+        1,
+    )
+    assert rules.is_active(rule)
+    assert (await restarted.create_request("job-1", "x", proposed_action=_PYTEST, tool="shell")).resolved_by == "rule"
+    assert auto.resolved_by == "rule"
+
+
+@pytest.mark.asyncio
+async def test_rejection_disables_rule(session_factory: async_sessionmaker[AsyncSession]) -> None:
+    svc, _ = await _service(session_factory)
+    await _decide(svc, "job-1", _PYTEST, "approved", times=3)
+    await _decide(svc, "job-1", "rm -rf build", "approved", times=2)
+    await _decide(svc, "job-1", "rm -rf build", "rejected")
+    await _decide(svc, "job-1", "rm -rf build", "approved", times=5)
+    assert (await svc.create_request("job-1", "x", proposed_action="rm -rf build", tool="shell")).resolution is None
+    assert (await svc.create_request("job-1", "x", proposed_action=_PYTEST, tool="shell")).resolution == "approved"
+
+
+@pytest.mark.asyncio
+async def test_only_operator_decisions_are_learned(session_factory: async_sessionmaker[AsyncSession]) -> None:
+    svc, _ = await _service(session_factory, min_approvals=1)
+    mcp = await svc.create_request("job-1", "x", proposed_action=_PYTEST, tool="shell")
+    await svc.resolve(mcp.id, "approved", resolved_by="mcp")
+    await svc.create_request("job-1", "x", proposed_action=_PYTEST, tool="shell")
+    assert await svc.trust_job("job-1") == 1
+    assert svc.list_rules() == []
+
+    explicit = await svc.create_request(
+        "job-2", "x", proposed_action=_PYTEST, tool="shell", requires_explicit_approval=True
+    )
+    await svc.resolve(explicit.id, "approved")
+    assert svc.list_rules() == []
+
+
+@pytest.mark.asyncio
+async def test_hard_gated_commands_always_ask(session_factory: async_sessionmaker[AsyncSession]) -> None:
+    svc, _ = await _service(session_factory, min_approvals=1)
+    for command in ("git pull origin main", "git merge feature", "git reset --hard HEAD~1"):
+        await _decide(svc, "job-1", command, "approved", times=2)
+        assert (await svc.create_request("job-1", "x", proposed_action=command, tool="shell")).resolution is None
+    assert svc.list_rules() == []
+
+
+@pytest.mark.asyncio
+async def test_claude_tool_input_is_matched_on_command(session_factory: async_sessionmaker[AsyncSession]) -> None:
+    svc, _ = await _service(session_factory, min_approvals=2)
+    for description in ("run tests", "run the tests again"):
+        approval = await svc.create_request(
+            "job-1",
+            "Bash",
+            proposed_action=json.dumps({"command": _PYTEST, "description": description}),
+            tool="Bash",
+        )
+        await svc.resolve(approval.id, "approved")
+    bash = json.dumps({"command": _PYTEST, "description": "once more"})
+    assert (await svc.create_request("job-2", "x", proposed_action=bash, tool="Bash")).resolved_by == "rule"
+    # The rule is keyed on the tool: the same text from another tool is not approved
+    assert (await svc.create_request("job-2", "x", proposed_action=_PYTEST, tool="shell")).resolution is None
+    assert (await svc.create_request("job-2", "x", proposed_action=bash, tool="Task")).resolution is None
+
+
+@pytest.mark.asyncio
+async def test_non_shell_tools_are_never_learned(session_factory: async_sessionmaker[AsyncSession]) -> None:
+    svc, _ = await _service(session_factory, min_approvals=1)
+    # A non-Bash Claude tool whose input happens to carry a command field
+    mcp_input = json.dumps({"command": _PYTEST})
+    for tool, action in (("mcp__runner__exec", mcp_input), ("write", "/repo-a/app.py"), ("url", "https://x.io")):
+        for _ in range(2):
+            approval = await svc.create_request("job-1", tool, proposed_action=action, tool=tool)
+            await svc.resolve(approval.id, "approved")
+        assert (await svc.create_request("job-1", tool, proposed_action=action, tool=tool)).resolution is None
+    assert svc.list_rules() == []
+
+
+@pytest.mark.asyncio
+async def test_truncated_claude_command_is_never_learned(session_factory: async_sessionmaker[AsyncSession]) -> None:
+    from backend.services.claude_adapter import _TOOL_ACTION_MAX
+
+    svc, _ = await _service(session_factory, min_approvals=2)
+    prefix = "echo " + "a" * _TOOL_ACTION_MAX
+
+    def _stored(command: str) -> str:
+        # How the Claude adapter records the tool input on the approval
+        return json.dumps({"command": command})[:_TOOL_ACTION_MAX]
+
+    assert _stored(prefix + " && true") == _stored(prefix + " && rm -rf ~")
+    for _ in range(2):
+        approval = await svc.create_request("job-1", "Bash", proposed_action=_stored(prefix + " && true"), tool="Bash")
+        await svc.resolve(approval.id, "approved")
+
+    request = await svc.create_request("job-1", "Bash", proposed_action=_stored(prefix + " && rm -rf ~"), tool="Bash")
+    assert request.resolution is None
+    assert svc.list_rules() == []
+
+
+@pytest.mark.asyncio
+async def test_revoke_requires_relearning(session_factory: async_sessionmaker[AsyncSession]) -> None:
+    svc, _ = await _service(session_factory, min_approvals=2)
+    await _decide(svc, "job-1", _PYTEST, "approved", times=2)
+    assert await svc.revoke_rule("/repo-a", "shell", _PYTEST)
+    assert not await svc.revoke_rule("/repo-a", "shell", "unknown")
+    assert not await svc.revoke_rule("/repo-a", "Bash", _PYTEST)
+    assert (await svc.create_request("job-1", "x", proposed_action=_PYTEST, tool="shell")).resolution is None
+
+    restarted, _ = await _service(session_factory, min_approvals=2)
+    [rule] = restarted.list_rules()
+    assert (rule.approvals, rule.revoked_at is not None) == (0, True)
+    await _decide(restarted, "job-1", _PYTEST, "approved", times=2)
+    assert (await restarted.create_request("job-1", "x", proposed_action=_PYTEST, tool="shell")).resolved_by == "rule"
+
+
+@pytest.mark.asyncio
+async def test_disabling_a_rule_reaches_other_processes(session_factory: async_sessionmaker[AsyncSession]) -> None:
+    # Two server processes sharing one database
+    svc, _ = await _service(session_factory, min_approvals=2)
+    other, _ = await _service(session_factory, min_approvals=2)
+    announced: list[str] = []
+
+    async def forward(op: str, **fields: object) -> None:
+        announced.append(op)
+
+    svc.forward_control = forward
+    await _decide(svc, "job-1", _PYTEST, "approved", times=2)
+    assert announced == []
+    await other.reload_rules()
+    assert (await other.create_request("job-1", "x", proposed_action=_PYTEST, tool="shell")).resolved_by == "rule"
+
+    assert await svc.revoke_rule("/repo-a", "shell", _PYTEST)
+    assert announced == ["rules_changed"]
+    await other.reload_rules()
+    assert (await other.create_request("job-1", "x", proposed_action=_PYTEST, tool="shell")).resolution is None
+
+    await _decide(svc, "job-1", "make lint", "rejected")
+    assert announced == ["rules_changed", "rules_changed"]
+
+
+@pytest.mark.asyncio
+async def test_disabled_never_auto_approves(session_factory: async_sessionmaker[AsyncSession]) -> None:
+    rules = ApprovalRules(session_factory, ApprovalRulesConfig(enabled=False, min_approvals=1))
+    svc = ApprovalService(session_factory, rules=rules)
+    await _decide(svc, "job-1", _PYTEST, "approved", times=3)
+    assert (await svc.create_request("job-1", "x", proposed_action=_PYTEST, tool="shell")).resolution is None
+    assert [r.approvals for r in svc.list_rules()] == [3]
+
+
+def test_backfill_learns_only_intact_shell_commands(tmp_path: Path) -> None:
+    from alembic.config import Config
+
+    from alembic import command
+    from backend.persistence.database import _ALEMBIC_DIR
+
+    db_path = tmp_path / "cp.db"
+    cfg = Config()
+    cfg.set_main_option("script_location", str(_ALEMBIC_DIR))
+    cfg.set_main_option("sqlalchemy.url", f"sqlite:///{db_path}")
+    command.upgrade(cfg, "0017")
+
+    truncated = json.dumps({"command": "echo " + "a" * 3000})[:2000]
+    with sqlite3.connect(db_path) as conn:
+        conn.execute(
+            "INSERT INTO jobs (id, repo, prompt, state, base_ref, created_at, updated_at)"
+            " VALUES ('job-1', '/repo-a', 'p', 'succeeded', 'main', '2026-01-01', '2026-01-01')"
+        )
+        history = [
+            (f"Bash: {truncated[:80]}", truncated),
+            (f"Bash: {truncated[:80]}", truncated),
+            (f"Bash: {_PYTEST}", json.dumps({"command": _PYTEST})),
+            (f"Bash: {_PYTEST}", json.dumps({"command": _PYTEST, "description": "tests"})),
+            (f"Run shell: {_PYTEST}", _PYTEST),
+            ("mcp__runner__exec: run", json.dumps({"command": _PYTEST})),
+            ("Write file: app.py", _PYTEST),
+        ]
+        for i, (description, action) in enumerate(history):
+            conn.execute(
+                "INSERT INTO approvals (id, job_id, description, proposed_action, requested_at, resolved_at,"
+                " resolution) VALUES (?, 'job-1', ?, ?, '2026-01-01', '2026-01-01', 'approved')",
+                (f"a-{i}", description, action),
+            )
+    command.upgrade(cfg, "0018")
+
+    with sqlite3.connect(db_path) as conn:
+        rows = conn.execute("SELECT repo, tool, action, approvals FROM approval_rules ORDER BY tool").fetchall()
+    assert rows == [("/repo-a", "Bash", _PYTEST, 2), ("/repo-a", "shell", _PYTEST, 1)]
@@ -174,6 +174,51 @@ class TestIsLocalhost:
         assert auth.is_localhost(req) is False
 
 
+class TestHasBearerToken:
+    def test_matching_token(self) -> None:
+        req = _make_request(headers={"authorization": "Bearer s3cret"})
+        assert auth.has_bearer_token(req, "s3cret") is True
+
+    @pytest.mark.parametrize("header", ["Bearer wrong", "Basic s3cret", "s3cret", ""])
+    def test_rejects_other_credentials(self, header: str) -> None:
+        req = _make_request(headers={"authorization": header})
+        assert auth.has_bearer_token(req, "s3cret") is False
+
+    def test_empty_expected_token_never_matches(self) -> None:
+        req = _make_request(headers={"authorization": "Bearer "})
+        assert auth.has_bearer_token(req, "") is False
+
+
+class TestMetricsScrapeAuth:
+    """A remote scraper reaches /metrics through the password gate only with metrics.token."""
+
+    @pytest.mark.asyncio
+    async def test_bearer_token_opens_metrics_only(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        from fastapi import FastAPI
+        from fastapi.responses import PlainTextResponse
+        from httpx import ASGITransport, AsyncClient
+
+        from backend.app_factory import _configure_middleware
+        from backend.config import CPLConfig
+
+        _reset_auth_state(monkeypatch)
+        config = CPLConfig()
+        config.metrics.token = "scrape-token"
+        monkeypatch.setattr("backend.config.load_config", lambda path=None: config)
+
+        app = FastAPI()
+        _configure_middleware(app, dev=False, tunnel_origin=None, password="pw")
+        app.add_api_route("/metrics", lambda: PlainTextResponse("cp_up 1"))
+        app.add_api_route("/api/jobs", lambda: {"items": []})
+
+        transport = ASGITransport(app=app, client=("203.0.113.5", 4242))
+        async with AsyncClient(transport=transport, base_url="http://test") as c:
+            bearer = {"Authorization": "Bearer scrape-token"}
+            assert (await c.get("/metrics", headers=bearer)).text == "cp_up 1"
+            assert "cp_up" not in (await c.get("/metrics")).text
+            assert (await c.get("/api/jobs", headers=bearer)).status_code == 401
+
+
 # ---------------------------------------------------------------------------
 # handle_login
 # ---------------------------------------------------------------------------
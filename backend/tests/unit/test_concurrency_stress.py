@@ -8,16 +8,18 @@ and lost updates.
 from __future__ import annotations
 
 import asyncio
-from datetime import UTC, datetime
+from datetime import UTC, datetime, timedelta
 from typing import TYPE_CHECKING
 
 import pytest
 from sqlalchemy import event as sa_event
+from sqlalchemy import update
 from sqlalchemy.ext.asyncio import AsyncSession, async_sessionmaker, create_async_engine
 
-from backend.models.db import Base
+from backend.models.db import Base, JobRow
 from backend.models.domain import Job, JobState
 from backend.persistence.database import _set_sqlite_pragmas
+from backend.persistence.event_repo import PROCESS_ORIGIN
 from backend.persistence.job_repo import JobRepository
 
 if TYPE_CHECKING:
@@ -105,6 +107,69 @@ class TestClaimForStart:
         assert claimed is False
 
 
+class TestJobLeases:
+    """A job leased by another live server process is left alone."""
+
+    async def _lease_to(
+        self,
+        session_factory: async_sessionmaker[AsyncSession],
+        job_id: str,
+        state: str,
+        expires_in: timedelta,
+    ) -> None:
+        async with session_factory() as session:
+            await JobRepository(session).create(_make_job(job_id, state))
+            await session.execute(
+                update(JobRow)
+                .where(JobRow.id == job_id)
+                .values(owner="other-process", lease_expires_at=datetime.now(UTC) + expires_in)
+            )
+            await session.commit()
+
+    @pytest.mark.asyncio
+    async def test_live_lease_blocks_claim_and_recovery(
+        self, session_factory: async_sessionmaker[AsyncSession]
+    ) -> None:
+        await self._lease_to(session_factory, "held", "running", timedelta(seconds=30))
+
+        async with session_factory() as session:
+            repo = JobRepository(session)
+            assert await repo.claim_for_start("held") is False
+            assert await repo.claim_lease("held") is False
+            assert await repo.list_unleased_active() == []
+            assert await repo.lease_holder("held") == "other-process"
+
+    @pytest.mark.asyncio
+    async def test_lapsed_lease_is_taken_over(self, session_factory: async_sessionmaker[AsyncSession]) -> None:
+        await self._lease_to(session_factory, "orphan", "waiting_for_approval", timedelta(seconds=-1))
+
+        async with session_factory() as session:
+            repo = JobRepository(session)
+            assert [j.id for j in await repo.list_unleased_active()] == ["orphan"]
+            assert await repo.lease_holder("orphan") is None
+            assert await repo.claim_lease("orphan") is True
+            await session.commit()
+
+        async with session_factory() as session:
+            repo = JobRepository(session)
+            assert await repo.lease_holder("orphan") == PROCESS_ORIGIN
+            await repo.release_leases(["orphan"])
+            await session.commit()
+            assert await repo.lease_holder("orphan") is None
+
+    @pytest.mark.asyncio
+    async def test_queued_job_is_claimed_once(self, session_factory: async_sessionmaker[AsyncSession]) -> None:
+        async with session_factory() as session:
+            await JobRepository(session).create(_make_job("fresh", "queued"))
+            await session.commit()
+
+        async with session_factory() as session:
+            repo = JobRepository(session)
+            assert await repo.claim_for_start("fresh") is True
+            await session.commit()
+            assert await repo.lease_holder("fresh") == PROCESS_ORIGIN
+
+
 class TestOptimisticLocking:
     """Version column increments on every update."""
 
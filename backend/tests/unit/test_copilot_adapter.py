@@ -889,6 +889,32 @@ class TestEventTelemetry:
 
             mock_msg.add.assert_called_once_with(1, {"job_id": "job-tel", "sdk": "copilot", "role": "operator"})
 
+    @pytest.mark.asyncio
+    async def test_quota_moves_are_unattributed_until_shutdown(self, adapter: CopilotAdapter) -> None:
+        sid, queue, session = await self._setup_session_with_job(adapter)
+
+        def _usage(used: float) -> _FakeEventData:
+            snap = SimpleNamespace(used_requests=used, entitlement_requests=300, remaining_percentage=50)
+            return _FakeEventData(
+                model="gpt-4o",
+                input_tokens=1,
+                output_tokens=1,
+                cache_read_tokens=0,
+                cache_write_tokens=0,
+                cost=0.0,
+                duration=10,
+                quota_snapshots={"premium_interactions": snap},
+            )
+
+        for used in (10.0, 11.0, 13.0):  # first snapshot only sets the baseline
+            session.fire_event(_FakeSdkSessionEvent("assistant.usage", _usage(used)))
+        session.fire_event(_FakeSdkSessionEvent("session.shutdown", _FakeEventData(total_premium_requests=4.0)))
+
+        usage = [e.payload for e in self._drain_queue(queue) if e.kind == SessionEventKind.usage]
+        # The account-wide quota may move for other sessions: never charged to this job
+        assert [p["unattributed_premium_requests"] for p in usage if "unattributed_premium_requests" in p] == [1.0, 2.0]
+        assert [p["premium_requests"] for p in usage if "premium_requests" in p] == [4.0]
+
 
 # ---------------------------------------------------------------------------
 # Tests: Log event emission from SDK events
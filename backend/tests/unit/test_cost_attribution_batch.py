@@ -0,0 +1,153 @@
+"""Tests for vectorized (batch) cost attribution."""
+
+from __future__ import annotations
+
+import random
+from datetime import UTC, datetime
+from typing import TYPE_CHECKING, Any
+
+import pytest
+from sqlalchemy import event as sa_event
+from sqlalchemy import text
+from sqlalchemy.ext.asyncio import AsyncSession, async_sessionmaker, create_async_engine
+
+if TYPE_CHECKING:
+    from collections.abc import AsyncGenerator
+
+from backend.models.db import Base, JobRow
+from backend.models.domain import JobState, PermissionMode
+from backend.persistence.cost_attribution_repo import CostAttributionRepo
+from backend.persistence.database import _set_sqlite_pragmas
+from backend.persistence.file_access_repo import FileAccessRepo
+from backend.persistence.telemetry_spans_repo import TelemetrySpansRepo
+from backend.persistence.telemetry_summary_repo import TelemetrySummaryRepo
+from backend.services.cost_attribution import compute_attribution
+from backend.services.cost_attribution_batch import compute_attribution_batch
+
+pytest.importorskip("numpy")
+
+_JOBS = tuple(f"job-{i}" for i in range(6))
+_TOOLS = ("read_file", "edit", "bash", "grep", "task", "mystery_tool", "git_commit")
+_PHASES = (None, None, "unknown", "agent_reasoning", "verification", "environment_setup", "finalization")
+_TURN_STAT_COLUMNS = (
+    "unique_files_read",
+    "file_reread_count",
+    "peak_turn_cost_usd",
+    "avg_turn_cost_usd",
+    "cost_first_half_usd",
+    "cost_second_half_usd",
+)
+
+
+@pytest.fixture
+async def session() -> AsyncGenerator[AsyncSession, None]:
+    engine = create_async_engine("sqlite+aiosqlite:///:memory:")
+    sa_event.listen(engine.sync_engine, "connect", _set_sqlite_pragmas)
+    async with engine.begin() as conn:
+        await conn.run_sync(Base.metadata.create_all)
+
+    factory = async_sessionmaker(engine, expire_on_commit=False)
+    async with factory() as sess:
+        now = datetime.now(UTC)
+        for job_id in _JOBS:
+            sess.add(
+                JobRow(
+                    id=job_id,
+                    repo="/repos/test",
+                    prompt="Fix the bug",
+                    state=JobState.running,
+                    base_ref="main",
+                    permission_mode=PermissionMode.full_auto,
+                    sdk="copilot",
+                    created_at=now,
+                    updated_at=now,
+                )
+            )
+        await sess.commit()
+        for job_id in _JOBS:
+            await TelemetrySummaryRepo(sess).init_job(job_id, sdk="copilot", model="gpt-4o")
+        await sess.commit()
+        yield sess
+
+    await engine.dispose()
+
+
+async def _random_history(session: AsyncSession, seed: int) -> None:
+    rng = random.Random(seed)
+    spans = TelemetrySpansRepo(session)
+    files = FileAccessRepo(session)
+    clock = 0.0
+    for job_id in _JOBS[:-1]:  # last job has no spans at all
+        for _ in range(rng.randint(1, 60)):
+            clock += 1.0
+            span_type = rng.choice(("llm", "llm", "tool", "tool", "tool", "operator"))
+            cost = round(rng.uniform(0, 0.05), 6)
+            legacy = rng.random() < 0.2  # older spans kept cost/tokens only in attrs
+            await spans.insert(
+                job_id=job_id,
+                span_type=span_type,
+                name=rng.choice(_TOOLS) if span_type == "tool" else "gpt-4o",
+                started_at=clock,
+                duration_ms=1.0,
+                attrs={"cost": cost, "input_tokens": 333, "output_tokens": 77} if legacy else {},
+                turn_number=None if rng.random() < 0.1 else rng.randint(0, 9),
+                execution_phase=rng.choice(_PHASES),
+                input_tokens=None if legacy else rng.randint(0, 5000),
+                output_tokens=None if legacy else rng.randint(0, 900),
+                cost_usd=None if legacy else cost,
+            )
+        for _ in range(rng.randint(0, 8)):
+            await files.record(
+                job_id=job_id,
+                file_path=rng.choice(("a.py", "b.py", "c.py")),
+                access_type=rng.choice(("read", "read", "write")),
+            )
+    await session.commit()
+
+
+async def _snapshot(session: AsyncSession) -> tuple[dict[tuple[str, str, str], dict[str, Any]], list[dict[str, Any]]]:
+    repo = CostAttributionRepo(session)
+    rows: dict[tuple[str, str, str], dict[str, Any]] = {}
+    for job_id in _JOBS:
+        for r in await repo.for_job(job_id):
+            rows[(job_id, r["dimension"], r["bucket"])] = {
+                k: r[k] for k in ("cost_usd", "input_tokens", "output_tokens", "call_count")
+            }
+    result = await session.execute(
+        text(f"SELECT job_id, {', '.join(_TURN_STAT_COLUMNS)} FROM job_telemetry_summary ORDER BY job_id")  # noqa: S608
+    )
+    return rows, [dict(r) for r in result.mappings().all()]
+
+
+@pytest.mark.asyncio
+@pytest.mark.parametrize("seed", [1, 2, 3])
+async def test_batch_matches_per_job_attribution(session: AsyncSession, seed: int) -> None:
+    await _random_history(session, seed)
+    for job_id in _JOBS:
+        await compute_attribution(session, job_id)
+    per_job_rows, per_job_stats = await _snapshot(session)
+
+    await session.execute(text("DELETE FROM job_cost_attribution"))
+    await session.execute(text("UPDATE job_telemetry_summary SET peak_turn_cost_usd = 0, unique_files_read = 0"))
+    assert await compute_attribution_batch(session, list(_JOBS)) == len(_JOBS) - 1
+    batch_rows, batch_stats = await _snapshot(session)
+
+    assert batch_rows.keys() == per_job_rows.keys()
+    for key, expected in per_job_rows.items():
+        assert batch_rows[key] == pytest.approx(expected), key
+    for got, expected in zip(batch_stats, per_job_stats, strict=True):
+        assert got.pop("job_id") == expected.pop("job_id")
+        assert got == pytest.approx(expected)
+
+
+@pytest.mark.asyncio
+async def test_batch_replaces_previous_rows(session: AsyncSession) -> None:
+    await _random_history(session, 7)
+    await compute_attribution_batch(session, list(_JOBS))
+    first, _ = await _snapshot(session)
+    await compute_attribution_batch(session, list(_JOBS))
+    second, _ = await _snapshot(session)
+
+    assert second.keys() == first.keys()
+    result = await session.execute(text("SELECT COUNT(*) FROM job_cost_attribution"))
+    assert result.scalar_one() == len(first)
@@ -0,0 +1,199 @@
+"""Tests for the live in-memory cost ledger and budget checks."""
+
+from __future__ import annotations
+
+from datetime import UTC, datetime
+from typing import TYPE_CHECKING
+
+import pytest
+from sqlalchemy import event as sa_event
+from sqlalchemy.ext.asyncio import AsyncSession, async_sessionmaker, create_async_engine
+
+if TYPE_CHECKING:
+    from collections.abc import AsyncGenerator
+
+from backend.config import TelemetryConfig
+from backend.models.api_schemas import BudgetUpdatedPayload
+from backend.models.db import Base, JobRow
+from backend.models.domain import JobState, PermissionMode
+from backend.models.events import DomainEvent, DomainEventKind
+from backend.persistence.database import _set_sqlite_pragmas
+from backend.persistence.telemetry_summary_repo import TelemetrySummaryRepo
+from backend.services.cost_ledger import BudgetStatus, CostLedger
+from backend.services.sse_manager import _SSE_EVENT_TYPE, _build_sse_data
+
+
+@pytest.fixture
+async def session() -> AsyncGenerator[AsyncSession, None]:
+    engine = create_async_engine("sqlite+aiosqlite:///:memory:")
+    sa_event.listen(engine.sync_engine, "connect", _set_sqlite_pragmas)
+    async with engine.begin() as conn:
+        await conn.run_sync(Base.metadata.create_all)
+
+    factory = async_sessionmaker(engine, expire_on_commit=False)
+    async with factory() as sess:
+        yield sess
+
+    await engine.dispose()
+
+
+def _config(**overrides: object) -> TelemetryConfig:
+    base: dict[str, object] = {"claude_monthly_budget_usd": 10.0, "copilot_premium_entitlement": 100}
+    base.update(overrides)
+    return TelemetryConfig(**base)
+
+
+@pytest.mark.asyncio
+async def test_load_seeds_month_to_date_from_rollups(session: AsyncSession) -> None:
+    now = datetime.now(UTC)
+    for job_id, sdk, repo in (("j1", "claude", "/a"), ("j2", "claude", "/b"), ("j3", "copilot", "/a")):
+        session.add(
+            JobRow(
+                id=job_id,
+                repo=repo,
+                prompt="p",
+                state=JobState.completed,
+                base_ref="main",
+                permission_mode=PermissionMode.full_auto,
+                sdk=sdk,
+                created_at=now,
+                updated_at=now,
+            )
+        )
+    await session.flush()
+    summaries = TelemetrySummaryRepo(session)
+    for job_id, sdk, repo in (("j1", "claude", "/a"), ("j2", "claude", "/b"), ("j3", "copilot", "/a")):
+        await summaries.init_job(job_id, sdk=sdk, model="m", repo=repo)
+    await summaries.increment("j1", total_cost_usd=3.0, input_tokens=100)
+    await summaries.increment("j2", total_cost_usd=2.0)
+    await summaries.increment("j3", total_cost_usd=1.0, premium_requests=40)
+    await session.commit()
+
+    ledger = CostLedger(_config())
+    await ledger.load(session)
+
+    spent, limit, unit = ledger.month_spent("claude")
+    assert spent == pytest.approx(5.0)
+    assert (limit, unit) == (10.0, "usd")
+    spent, limit, unit = ledger.month_spent("copilot")
+    assert spent == pytest.approx(40.0)
+    assert (limit, unit) == (100.0, "premium_requests")
+    snap = ledger.snapshot()
+    assert snap["total_cost_usd"] == pytest.approx(6.0)
+    assert snap["repos"] == {"/a": pytest.approx(4.0), "/b": pytest.approx(2.0)}
+
+
+@pytest.mark.asyncio
+async def test_refresh_counts_spend_from_other_processes(session: AsyncSession) -> None:
+    now = datetime.now(UTC)
+    for job_id in ("mine", "theirs"):
+        session.add(
+            JobRow(
+                id=job_id,
+                repo="/a",
+                prompt="p",
+                state=JobState.running,
+                base_ref="main",
+                permission_mode=PermissionMode.full_auto,
+                sdk="claude",
+                created_at=now,
+                updated_at=now,
+            )
+        )
+        await TelemetrySummaryRepo(session).init_job(job_id, sdk="claude", model="m", repo="/a")
+    await session.commit()
+
+    ledger = CostLedger(_config())
+    await ledger.load(session)
+    ledger.register_job("mine", repo="/a", sdk="claude")
+    # Local usage not written to the summaries yet
+    ledger.record("mine", cost_usd=2.0)
+    await ledger.refresh(session)
+    assert ledger.month_spent("claude")[0] == pytest.approx(2.0)
+
+    # Another process sharing the database writes its job's usage
+    await TelemetrySummaryRepo(session).increment("mine", total_cost_usd=2.0)
+    await TelemetrySummaryRepo(session).increment("theirs", total_cost_usd=8.5)
+    await session.commit()
+    await ledger.refresh(session)
+    assert ledger.month_spent("claude")[0] == pytest.approx(10.5)
+    assert ledger.month_status("claude") is BudgetStatus.exhausted
+    assert ledger.snapshot()["repos"] == {"/a": pytest.approx(10.5)}
+    assert ledger.job_status("mine") is BudgetStatus.ok
+
+
+def test_monthly_status_thresholds() -> None:
+    ledger = CostLedger(_config(budget_soft_pct=50.0))
+    ledger.register_job("j1", repo="/a", sdk="claude")
+
+    assert ledger.month_status("claude") is BudgetStatus.ok
+    ledger.record("j1", cost_usd=5.0)
+    assert ledger.month_status("claude") is BudgetStatus.soft
+    ledger.record("j1", cost_usd=5.0)
+    assert ledger.month_status("claude") is BudgetStatus.exhausted
+    assert ledger.exhausted_sdks() == {"claude"}
+    # Copilot is capped in premium requests, not USD
+    assert ledger.month_status("copilot") is BudgetStatus.ok
+
+
+def test_zero_limit_is_unlimited() -> None:
+    ledger = CostLedger(_config(claude_monthly_budget_usd=0.0))
+    ledger.register_job("j1", repo="/a", sdk="claude")
+    ledger.record("j1", cost_usd=1e6)
+    assert ledger.month_status("claude") is BudgetStatus.ok
+    assert ledger.job_status("j1") is BudgetStatus.ok
+
+
+def test_job_cap_includes_prior_sessions() -> None:
+    ledger = CostLedger(_config(job_budget_usd=2.0))
+    ledger.register_job("j1", repo="/a", sdk="copilot", cost_usd=1.5)
+    assert ledger.job_status("j1") is BudgetStatus.ok
+    ledger.record("j1", cost_usd=0.6, premium_requests=1)
+    assert ledger.job_status("j1") is BudgetStatus.exhausted
+    assert ledger.jobs_for_sdk("copilot") == ["j1"]
+
+    ledger.forget_job("j1")
+    assert ledger.job_status("j1") is BudgetStatus.ok
+    # Forgotten jobs no longer accrue, but month totals keep their spend
+    ledger.record("j1", cost_usd=5.0)
+    assert ledger.month_spent("copilot")[0] == pytest.approx(1.0)
+
+
+def test_unattributed_premium_counts_towards_month_only() -> None:
+    ledger = CostLedger(_config(copilot_premium_entitlement=10))
+    ledger.register_job("j1", repo="/a", sdk="copilot")
+    ledger.register_job("j2", repo="/b", sdk="copilot")
+
+    # Quota moves seen by j1 while both jobs run
+    ledger.record_unattributed("copilot", 6.0)
+    assert ledger.month_spent("copilot")[0] == pytest.approx(6.0)
+    assert ledger.snapshot("j1")["job_cost_usd"] == 0.0
+    assert ledger.snapshot()["repos"] == {}
+
+    # Sessions end with their exact totals: j2 made 4 of those requests, j1 made 3
+    ledger.record("j2", premium_requests=4.0)
+    ledger.record("j1", premium_requests=3.0)
+    assert ledger.month_spent("copilot")[0] == pytest.approx(7.0)
+    ledger.record_unattributed("copilot", 3.0)
+    assert ledger.month_status("copilot") is BudgetStatus.exhausted
+
+
+def test_budget_updated_sse_payload() -> None:
+    ledger = CostLedger(_config())
+    ledger.register_job("j1", repo="/a", sdk="claude")
+    ledger.record("j1", cost_usd=9.0)
+    event = DomainEvent(
+        event_id=DomainEvent.make_event_id(),
+        job_id="j1",
+        timestamp=datetime.now(UTC),
+        kind=DomainEventKind.budget_updated,
+        payload=ledger.snapshot("j1"),
+    )
+
+    sse_type = _SSE_EVENT_TYPE[DomainEventKind.budget_updated]
+    assert sse_type == "budget_updated"
+    payload = BudgetUpdatedPayload.model_validate_json(_build_sse_data(event, sse_type))
+    assert payload.job_id == "j1"
+    assert payload.job_cost_usd == pytest.approx(9.0)
+    claude = next(s for s in payload.sdks if s.sdk == "claude")
+    assert claude.status == "soft"
@@ -0,0 +1,99 @@
+"""Tests for the per-job execution waterfall / critical-path analyzer."""
+
+from __future__ import annotations
+
+from typing import Any
+
+import pytest
+
+from backend.models.api_schemas import JobWaterfallResponse
+from backend.services.critical_path import INTERNAL_SPAN_TYPE, SpanCategory, build_waterfall, classify
+
+
+def _span(span_type: str, name: str, start_s: float, duration_ms: float) -> dict[str, Any]:
+    return {"span_type": span_type, "name": name, "started_at": start_s, "duration_ms": duration_ms}
+
+
+def test_classify_internal_stages() -> None:
+    assert classify(_span("llm", "gpt", 0, 1)) is SpanCategory.llm
+    assert classify(_span("tool", "bash", 0, 1)) is SpanCategory.tool
+    assert classify(_span(INTERNAL_SPAN_TYPE, "approval_wait", 0, 1)) is SpanCategory.approval
+    assert classify(_span(INTERNAL_SPAN_TYPE, "queue_wait", 0, 1)) is SpanCategory.queue
+    assert classify(_span(INTERNAL_SPAN_TYPE, "diff_finalize", 0, 1)) is SpanCategory.overhead
+
+
+def test_sequential_spans_and_idle_gaps() -> None:
+    waterfall = build_waterfall(
+        [
+            _span(INTERNAL_SPAN_TYPE, "queue_wait", -2.0, 2000),
+            _span("llm", "m", 0.5, 1000),
+            _span("tool", "bash", 2.0, 500),
+            _span(INTERNAL_SPAN_TYPE, "diff_finalize", 3.0, 1000),
+        ],
+        wall_ms=5000,
+    )
+
+    assert waterfall.start_ms == -2000
+    assert waterfall.wall_ms == 7000
+    assert waterfall.breakdown[SpanCategory.queue] == pytest.approx(2000)
+    assert waterfall.breakdown[SpanCategory.llm] == pytest.approx(1000)
+    assert waterfall.breakdown[SpanCategory.tool] == pytest.approx(500)
+    assert waterfall.breakdown[SpanCategory.overhead] == pytest.approx(1000)
+    # 0-0.5s, 1.5-2s, 2.5-3s and 4-5s have no span
+    assert waterfall.breakdown[SpanCategory.idle] == pytest.approx(2500)
+    assert waterfall.codeplane_ms == pytest.approx(3000)
+    assert sum(waterfall.breakdown.values()) == pytest.approx(waterfall.wall_ms)
+
+
+def test_overlap_is_counted_once_by_precedence() -> None:
+    waterfall = build_waterfall(
+        [
+            # Tool call gated by an approval for most of its duration
+            _span("tool", "bash", 0.0, 4000),
+            _span(INTERNAL_SPAN_TYPE, "approval_wait", 1.0, 2000),
+            # Diff work hidden behind the model
+            _span("llm", "m", 4.0, 2000),
+            _span(INTERNAL_SPAN_TYPE, "diff_update", 4.5, 500),
+        ]
+    )
+
+    assert waterfall.wall_ms == 6000
+    assert waterfall.breakdown[SpanCategory.approval] == pytest.approx(2000)
+    assert waterfall.breakdown[SpanCategory.tool] == pytest.approx(2000)
+    assert waterfall.breakdown[SpanCategory.llm] == pytest.approx(2000)
+    assert SpanCategory.overhead not in waterfall.breakdown
+    diff = next(b for b in waterfall.bars if b.name == "diff_update")
+    assert diff.critical_ms == 0
+    assert [(s.category, s.start_ms, s.end_ms) for s in waterfall.critical_path] == [
+        (SpanCategory.tool, 0, 1000),
+        (SpanCategory.approval, 1000, 3000),
+        (SpanCategory.tool, 3000, 4000),
+        (SpanCategory.llm, 4000, 6000),
+    ]
+
+
+def test_overhead_stages_and_response_shape() -> None:
+    waterfall = build_waterfall(
+        [
+            _span(INTERNAL_SPAN_TYPE, "environment_setup", 0.0, 300),
+            _span("llm", "m", 0.3, 700),
+            _span(INTERNAL_SPAN_TYPE, "diff_finalize", 1.0, 900),
+            _span(INTERNAL_SPAN_TYPE, "finalization", 1.9, 100),
+        ],
+        wall_ms=1900,
+    )
+
+    assert list(waterfall.overhead_stages()) == ["diff_finalize", "environment_setup", "finalization"]
+    resp = JobWaterfallResponse.model_validate({"job_id": "j1", **waterfall.to_dict()})
+    assert resp.codeplane_pct == pytest.approx(65.0)
+    assert resp.breakdown["idle"] == 0
+    assert len(resp.bars) == 4
+    dumped = resp.model_dump(by_alias=True)
+    assert dumped["overheadStages"]["diff_finalize"] == 900
+    assert dumped["criticalPath"][0]["category"] == "overhead"
+
+
+def test_empty_job() -> None:
+    assert build_waterfall([]).to_dict()["wall_ms"] == 0
+    waterfall = build_waterfall([], wall_ms=1000)
+    assert waterfall.breakdown == {SpanCategory.idle: 1000}
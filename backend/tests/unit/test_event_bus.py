@@ -3,13 +3,18 @@
 from __future__ import annotations
 
 import asyncio
+import dataclasses
 from datetime import UTC, datetime
+from typing import TYPE_CHECKING, Any
 
 import pytest
 
 from backend.models.events import DomainEvent, DomainEventKind
 from backend.services.event_bus import EventBus
 
+if TYPE_CHECKING:
+    from collections.abc import Coroutine
+
 
 def _make_event(kind: DomainEventKind = DomainEventKind.job_created) -> DomainEvent:
     return DomainEvent(
@@ -138,3 +143,59 @@ class TestEventBus:
             await bus.publish(_make_event())
 
         assert count == 10
+
+    @pytest.mark.asyncio
+    async def test_kind_filtered_subscription(self) -> None:
+        bus = EventBus()
+        steps: list[DomainEventKind] = []
+        everything: list[DomainEventKind] = []
+
+        async def step_handler(event: DomainEvent) -> None:
+            steps.append(event.kind)
+
+        async def catch_all(event: DomainEvent) -> None:
+            everything.append(event.kind)
+
+        bus.subscribe(step_handler, kinds={DomainEventKind.step_started, DomainEventKind.step_completed})
+        bus.subscribe(catch_all)
+        for kind in (DomainEventKind.step_started, DomainEventKind.log_line_emitted, DomainEventKind.step_completed):
+            await bus.publish(_make_event(kind))
+
+        assert steps == [DomainEventKind.step_started, DomainEventKind.step_completed]
+        assert len(everything) == 3
+
+    @pytest.mark.asyncio
+    async def test_job_filtered_subscription(self) -> None:
+        bus = EventBus()
+        received: list[str] = []
+
+        async def handler(event: DomainEvent) -> None:
+            received.append(event.job_id)
+
+        bus.subscribe(handler, job_id="job-2")
+        await bus.publish(_make_event())  # job-1
+        await bus.publish(dataclasses.replace(_make_event(), job_id="job-2"))
+
+        assert received == ["job-2"]
+
+    @pytest.mark.asyncio
+    async def test_uninterested_kind_schedules_nothing(self) -> None:
+        bus = EventBus()
+        calls = 0
+
+        def handler(event: DomainEvent) -> Coroutine[Any, Any, None]:
+            nonlocal calls
+            calls += 1
+
+            async def noop() -> None:
+                pass
+
+            return noop()
+
+        bus.subscribe(handler, kinds={DomainEventKind.job_created})
+        await bus.publish(_make_event(DomainEventKind.transcript_updated))
+        assert calls == 0
+
+        bus.unsubscribe(handler)
+        await bus.publish(_make_event())
+        assert calls == 0
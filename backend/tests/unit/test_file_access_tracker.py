@@ -0,0 +1,152 @@
+"""Tests for batched file-access counters and their aggregate table."""
+
+from __future__ import annotations
+
+import asyncio
+from datetime import UTC, datetime
+from typing import TYPE_CHECKING
+
+import pytest
+from sqlalchemy import event as sa_event
+from sqlalchemy import text
+from sqlalchemy.ext.asyncio import AsyncSession, async_sessionmaker, create_async_engine
+
+if TYPE_CHECKING:
+    from collections.abc import AsyncGenerator
+
+from backend.models.db import Base, JobRow
+from backend.models.domain import JobState, PermissionMode
+from backend.persistence.database import _set_sqlite_pragmas
+from backend.persistence.file_access_repo import FileAccessRepo
+from backend.services import file_access_tracker
+from backend.services.file_access_tracker import FileAccessTracker
+
+_JOBS = ("job-1", "job-2")
+
+
+@pytest.fixture
+async def factory() -> AsyncGenerator[async_sessionmaker[AsyncSession], None]:
+    engine = create_async_engine("sqlite+aiosqlite:///:memory:")
+    sa_event.listen(engine.sync_engine, "connect", _set_sqlite_pragmas)
+    async with engine.begin() as conn:
+        await conn.run_sync(Base.metadata.create_all)
+
+    sessions = async_sessionmaker(engine, expire_on_commit=False)
+    async with sessions() as sess:
+        now = datetime.now(UTC)
+        for job_id in _JOBS:
+            sess.add(
+                JobRow(
+                    id=job_id,
+                    repo="/repos/test",
+                    prompt="Fix the bug",
+                    state=JobState.running,
+                    base_ref="main",
+                    permission_mode=PermissionMode.full_auto,
+                    sdk="copilot",
+                    created_at=now,
+                    updated_at=now,
+                )
+            )
+        await sess.commit()
+    yield sessions
+    await engine.dispose()
+
+
+async def _stats(factory: async_sessionmaker[AsyncSession], job_id: str) -> dict[str, dict[str, object]]:
+    async with factory() as session:
+        result = await session.execute(
+            text("SELECT * FROM job_file_access_stats WHERE job_id = :job_id"), {"job_id": job_id}
+        )
+        return {r["file_path"]: dict(r) for r in result.mappings().all()}
+
+
+@pytest.mark.asyncio
+async def test_counters_merge_across_flushes(factory: async_sessionmaker[AsyncSession]) -> None:
+    tracker = FileAccessTracker()
+    tracker.record("job-1", "a.py", "read", turn_number=2, byte_count=100)
+    tracker.record("job-1", "a.py", "read", turn_number=1, byte_count=50)
+    tracker.record("job-1", "a.py", "write", turn_number=3)
+    assert tracker.pending == 1
+    assert await tracker.flush(factory) == 1
+    assert tracker.pending == 0
+
+    tracker.record("job-1", "a.py", "read", turn_number=7, byte_count=10)
+    tracker.record("job-1", "b.py", "write")
+    assert await tracker.flush(factory) == 2
+
+    stats = await _stats(factory, "job-1")
+    assert stats["a.py"]["read_count"] == 3
+    assert stats["a.py"]["write_count"] == 1
+    assert stats["a.py"]["read_bytes"] == 160
+    assert (stats["a.py"]["first_turn"], stats["a.py"]["last_turn"]) == (1, 7)
+    assert stats["b.py"]["first_turn"] is None
+
+    async with factory() as session:
+        rereads = await FileAccessRepo(session).reread_stats("job-1")
+        empty = await FileAccessRepo(session).reread_stats("job-2")
+        raw = await session.execute(text("SELECT COUNT(*) FROM job_file_access_log"))
+    assert rereads == {"total_accesses": 5, "unique_files": 2, "total_reads": 3, "total_writes": 2, "reread_count": 2}
+    assert empty["reread_count"] == 0
+    assert raw.scalar() == 0  # raw logging is off by default
+
+
+def test_flush_is_due_by_size_or_age(monkeypatch: pytest.MonkeyPatch) -> None:
+    monkeypatch.setattr(file_access_tracker, "FLUSH_EVERY", 3)
+    tracker = FileAccessTracker()
+    assert not tracker.record("job-1", "a.py", "read")
+    assert not tracker.record("job-1", "a.py", "read")  # same counter
+    assert not tracker.record("job-1", "b.py", "read")
+    assert tracker.record("job-1", "c.py", "read")
+
+    tracker = FileAccessTracker()
+    monkeypatch.setattr(file_access_tracker, "FLUSH_INTERVAL_S", 0.0)
+    assert tracker.record("job-1", "a.py", "read")
+
+
+@pytest.mark.asyncio
+async def test_flush_loop_writes_idle_counters(
+    factory: async_sessionmaker[AsyncSession], monkeypatch: pytest.MonkeyPatch
+) -> None:
+    monkeypatch.setattr(file_access_tracker, "FLUSH_INTERVAL_S", 0.01)
+    tracker = FileAccessTracker()
+    tracker.record("job-1", "a.py", "read")  # no further access ever makes a flush due
+    loop = asyncio.create_task(tracker.flush_loop(factory))
+    try:
+        for _ in range(100):
+            if await _stats(factory, "job-1"):
+                break
+            await asyncio.sleep(0.01)
+    finally:
+        loop.cancel()
+    assert tracker.pending == 0
+    assert (await _stats(factory, "job-1"))["a.py"]["read_count"] == 1
+
+
+@pytest.mark.asyncio
+async def test_job_flush_leaves_other_jobs_pending(factory: async_sessionmaker[AsyncSession]) -> None:
+    tracker = FileAccessTracker(raw_sample_rate=1.0)
+    tracker.record("job-1", "a.py", "read", turn_number=1)
+    tracker.record("job-2", "a.py", "read", turn_number=1)
+
+    assert await tracker.flush(factory, "job-1") == 1
+    assert tracker.pending == 1
+    assert set(await _stats(factory, "job-1")) == {"a.py"}
+    assert await _stats(factory, "job-2") == {}
+    async with factory() as session:
+        raw = await session.execute(text("SELECT job_id FROM job_file_access_log"))
+    assert [r[0] for r in raw] == ["job-1"]
+
+
+@pytest.mark.asyncio
+async def test_failed_flush_keeps_counters(factory: async_sessionmaker[AsyncSession]) -> None:
+    tracker = FileAccessTracker()
+    tracker.record("job-1", "a.py", "read")
+
+    def broken() -> AsyncSession:
+        raise RuntimeError("database unavailable")
+
+    assert await tracker.flush(broken) == 0  # type: ignore[arg-type]
+    tracker.record("job-1", "a.py", "read")
+    assert await tracker.flush(factory) == 1
+    assert (await _stats(factory, "job-1"))["a.py"]["read_count"] == 2
@@ -0,0 +1,112 @@
+"""Tests for GitHeadCache — resolving HEAD from git's files without spawning git."""
+
+from __future__ import annotations
+
+import subprocess
+from typing import TYPE_CHECKING
+from unittest.mock import AsyncMock, MagicMock
+
+import pytest
+
+from backend.services.git_head import GitHeadCache
+from backend.services.step_tracker import StepTracker
+
+if TYPE_CHECKING:
+    from pathlib import Path
+
+
+def _git(cwd: Path, *args: str) -> str:
+    return subprocess.run(
+        ["git", "-c", "user.name=t", "-c", "user.email=t@t", "-c", "commit.gpgsign=false", *args],
+        cwd=cwd,
+        check=True,
+        capture_output=True,
+        text=True,
+    ).stdout.strip()
+
+
+def _commit(repo: Path, message: str) -> str:
+    _git(repo, "commit", "--allow-empty", "-q", "-m", message)
+    return _git(repo, "rev-parse", "HEAD")
+
+
+@pytest.fixture
+def repo(tmp_path: Path) -> Path:
+    path = tmp_path / "repo"
+    path.mkdir()
+    _git(path, "init", "-q", "-b", "main")
+    _commit(path, "initial")
+    return path
+
+
+def test_branch_head_tracks_new_commits(repo: Path) -> None:
+    cache = GitHeadCache()
+    assert cache.head(str(repo)) == _git(repo, "rev-parse", "HEAD")
+    second = _commit(repo, "second")
+    assert cache.head(str(repo)) == second
+
+
+def test_detached_head(repo: Path) -> None:
+    first = _git(repo, "rev-parse", "HEAD")
+    _commit(repo, "second")
+    _git(repo, "checkout", "-q", "--detach", first)
+    assert GitHeadCache().head(str(repo)) == first
+
+
+def test_packed_refs(repo: Path) -> None:
+    sha = _git(repo, "rev-parse", "HEAD")
+    _git(repo, "pack-refs", "--all")
+    assert not (repo / ".git" / "refs" / "heads" / "main").exists()
+    assert GitHeadCache().head(str(repo)) == sha
+
+
+def test_linked_worktree(repo: Path, tmp_path: Path) -> None:
+    worktree = tmp_path / "wt"
+    _git(repo, "worktree", "add", "-q", "-b", "feature", str(worktree))
+    cache = GitHeadCache()
+    assert cache.head(str(worktree)) == _git(repo, "rev-parse", "HEAD")
+    sha = _commit(worktree, "on feature")
+    assert cache.head(str(worktree)) == sha
+    assert cache.head(str(repo)) != sha  # main's HEAD is separate
+
+
+def test_forget_evicts_common_dir_refs(repo: Path, tmp_path: Path) -> None:
+    worktree = tmp_path / "wt"
+    _git(repo, "worktree", "add", "-q", "-b", "feature", str(worktree))
+    _git(repo, "pack-refs", "--all")
+    cache = GitHeadCache()
+    assert cache.head(str(worktree)) is not None  # via packed-refs
+    _commit(worktree, "loose ref in the common dir")
+    assert cache.head(str(worktree)) is not None
+    assert any(p.is_relative_to(repo / ".git" / "refs") for p in cache._files)
+    assert cache._packed
+
+    cache.forget(str(worktree))
+    assert not cache._files
+    assert not cache._packed
+
+
+def test_unresolvable_returns_none(tmp_path: Path) -> None:
+    unborn = tmp_path / "unborn"
+    unborn.mkdir()
+    _git(unborn, "init", "-q")
+    cache = GitHeadCache()
+    assert cache.head(str(unborn)) is None
+    assert cache.head(str(tmp_path / "missing")) is None
+
+
+@pytest.mark.asyncio
+async def test_step_tracker_falls_back_to_rev_parse(repo: Path, tmp_path: Path) -> None:
+    git_service = MagicMock()
+    git_service.rev_parse = AsyncMock(return_value="f" * 40)
+    tracker = StepTracker(MagicMock(), git_service=git_service)
+
+    tracker.register_worktree("job-1", str(repo))
+    assert await tracker._head_sha("job-1") == _git(repo, "rev-parse", "HEAD")
+    git_service.rev_parse.assert_not_awaited()
+
+    unborn = tmp_path / "unborn"
+    unborn.mkdir()
+    _git(unborn, "init", "-q")
+    tracker.register_worktree("job-2", str(unborn))
+    assert await tracker._head_sha("job-2") == "f" * 40
@@ -16,6 +16,7 @@ from backend.config import CPLConfig
 from backend.di import (
     AppProvider,
     CachedModelsBySdk,
+    ReadSessionFactory,
     RequestProvider,
     VoiceMaxBytes,
 )
@@ -67,6 +68,7 @@ async def app() -> AsyncGenerator[FastAPI, None]:
         context={
             CPLConfig: CPLConfig(repos=[]),
             async_sessionmaker: session_factory,
+            ReadSessionFactory: ReadSessionFactory(session_factory),
             **_make_mock_services(),
         },
     )
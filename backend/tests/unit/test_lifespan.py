@@ -8,7 +8,7 @@ from unittest.mock import AsyncMock
 import pytest
 from sqlalchemy.exc import OperationalError
 
-from backend.lifespan import _persist_event_with_retry
+from backend.lifespan import _DeferredASGIApp, _persist_event_with_retry
 from backend.models.events import DomainEvent, DomainEventKind
 
 
@@ -101,3 +101,21 @@ async def test_persist_event_does_not_retry_non_lock_errors(monkeypatch: pytest.
 
     session.rollback.assert_awaited_once()
     session.commit.assert_not_called()
+
+
+@pytest.mark.asyncio
+async def test_deferred_mount_answers_503_until_ready() -> None:
+    mount = _DeferredASGIApp("MCP server")
+    sent: list[dict[str, Any]] = []
+
+    async def _send(message: dict[str, Any]) -> None:
+        sent.append(message)
+
+    await mount({"type": "http"}, AsyncMock(), _send)
+    assert sent[0]["status"] == 503
+    assert (b"retry-after", b"1") in sent[0]["headers"]
+
+    mount.app = AsyncMock()
+    await mount({"type": "http"}, AsyncMock(), _send)
+    mount.app.assert_awaited_once()
+    assert len(sent) == 2
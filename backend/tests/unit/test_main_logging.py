@@ -1,10 +1,13 @@
 from __future__ import annotations
 
+import json
 import logging
 from io import StringIO
 
 import structlog
 
+from backend import logging_config
+from backend.logging_config import _BoundedQueueHandler, _DebugSampler, discard_counts
 from backend.main import _ConsoleNoiseFilter, setup_logging
 
 
@@ -61,3 +64,48 @@ def test_setup_logging_renders_structlog_human_readable(tmp_path) -> None:
     assert "job_id=job-1" in output
     assert "state=running" in output
     assert "{'job_id': 'job-1'" not in output
+
+
+def test_file_log_written_by_listener_with_tracebacks(tmp_path) -> None:
+    log_file = tmp_path / "codeplane.log"
+    setup_logging(str(log_file), log_format="json")
+    try:
+        raise ValueError("bad")
+    except ValueError:
+        structlog.get_logger("backend.test").warning("step_failed", payload=b"\x00\xff\n", exc_info=True)
+    logging.getLogger("third.party").info("plain %s", "message")
+    logging_config._stop_listener()
+
+    lines = log_file.read_text().splitlines()
+    first, second = (json.loads(line) for line in lines)
+    assert first["event"] == "step_failed"
+    assert first["payload"] == "b'\\x00\\xff\\n'"
+    assert "ValueError: bad" in first["exception"]
+    assert (second["logger"], second["event"]) == ("third.party", "plain message")
+    assert second["timestamp"] >= first["timestamp"]
+
+
+def test_debug_sampler_keeps_one_in_n_by_longest_prefix() -> None:
+    sampler = _DebugSampler({"backend.services": 0.5, "backend.services.sse_manager": 0.1, "noisy": 0})
+    _, sampled_before = discard_counts()
+
+    def kept(name: str, level: int = logging.DEBUG) -> int:
+        return sum(sampler.filter(_record(name, level)) for _ in range(20))
+
+    assert kept("backend.services.sse_manager") == 2
+    assert kept("backend.services.job_service") == 10
+    assert kept("noisy.child") == 0
+    assert kept("noisy.child", logging.INFO) == 20
+    assert kept("backend.servicesx") == 20  # prefix matches whole dotted segments only
+    assert discard_counts()[1] - sampled_before == 18 + 10 + 20
+
+
+def test_full_queue_drops_without_blocking() -> None:
+    import queue
+
+    handler = _BoundedQueueHandler(queue.Queue(maxsize=2))
+    dropped_before, _ = discard_counts()
+    for _ in range(5):
+        handler.handle(_record("backend.test", logging.INFO))
+    assert handler.queue.qsize() == 2
+    assert discard_counts()[0] - dropped_before == 3
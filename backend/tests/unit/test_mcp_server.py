@@ -8,6 +8,7 @@ from unittest.mock import AsyncMock, MagicMock, patch
 import pytest
 
 from backend.mcp.server import create_mcp_server
+from backend.models.domain import JobSummary
 from backend.services.git_service import GitService
 from backend.tests.unit.conftest import make_job
 
@@ -152,17 +153,24 @@ class TestJobTool:
 
     @pytest.mark.asyncio
     async def test_list(self, mcp_server) -> None:
-        jobs = [make_job(id="job-123", repo="/test/repo"), make_job(id="job-456", repo="/test/repo")]
+        jobs = [
+            make_job(id="job-123", repo="/test/repo", merge_status="merged", worktree_name="fix-it"),
+            make_job(id="job-456", repo="/test/repo"),
+        ]
         with (
             patch("backend.mcp.server.JobService") as mock_svc_cls,
             patch("backend.mcp.server.GitService"),
         ):
             svc = AsyncMock()
-            svc.list_jobs = AsyncMock(return_value=(jobs, None, False))
+            svc.list_job_summaries = AsyncMock(return_value=([JobSummary.from_job(j) for j in jobs], None, False))
             mock_svc_cls.return_value = svc
 
             result = await _tool(mcp_server, "codeplane_job")(action="list")
             assert len(result["items"]) == 2
+            assert result["items"][0]["prompt_preview"] == jobs[0].prompt
+            # Same mapping as GET /jobs and the SSE snapshot, so no field is dropped
+            assert result["items"][0]["merge_status"] == "merged"
+            assert result["items"][0]["worktree_name"] == "fix-it"
             assert result["has_more"] is False
 
     @pytest.mark.asyncio
@@ -256,6 +264,149 @@ class TestJobTool:
         assert "Unknown action" in result["error"]
 
 
+class TestJobBatches:
+    @pytest.mark.asyncio
+    async def test_get_many_keeps_order_and_per_item_errors(self, mcp_server) -> None:
+        from backend.services.job_service import JobNotFoundError
+
+        async def _get(job_id: str):
+            if job_id == "missing":
+                raise JobNotFoundError(job_id)
+            return make_job(id=job_id, repo="/test/repo")
+
+        with patch("backend.mcp.server.JobService") as mock_svc_cls, patch("backend.mcp.server.GitService"):
+            svc = AsyncMock()
+            svc.get_job = AsyncMock(side_effect=_get)
+            mock_svc_cls.return_value = svc
+            result = await _tool(mcp_server, "codeplane_job")(action="get", job_ids=["job-1", "missing", "job-3"])
+
+        ids = [r.get("id") or r.get("job_id") for r in result["results"]]
+        assert ids == ["job-1", "missing", "job-3"]
+        assert "error" in result["results"][1]
+
+    @pytest.mark.asyncio
+    async def test_cancel_many(self, mcp_server, mock_runtime) -> None:
+        with patch("backend.mcp.server.JobService") as mock_svc_cls, patch("backend.mcp.server.GitService"):
+            svc = AsyncMock()
+            svc.cancel_job = AsyncMock(side_effect=lambda jid: make_job(id=jid, repo="/r", state="canceled"))
+            mock_svc_cls.return_value = svc
+            result = await _tool(mcp_server, "codeplane_job")(action="cancel", job_ids=["a", "b"])
+        assert [r["state"] for r in result["results"]] == ["canceled", "canceled"]
+        assert mock_runtime.cancel.await_count == 2
+
+    @pytest.mark.asyncio
+    async def test_create_many(self, mcp_server, mock_runtime) -> None:
+        with patch("backend.mcp.server.JobService") as mock_svc_cls, patch("backend.mcp.server.GitService"):
+            svc = AsyncMock()
+            svc.create_job = AsyncMock(side_effect=lambda **kw: make_job(id=kw["prompt"], repo=kw["repo"]))
+            svc.get_job = AsyncMock(side_effect=lambda jid: make_job(id=jid, repo="/r", state="queued"))
+            mock_svc_cls.return_value = svc
+            result = await _tool(mcp_server, "codeplane_job")(
+                action="create",
+                jobs=[{"repo": "/r", "prompt": "one"}, {"repo": "/r", "prompt": "two", "branch": "b"}, {"repo": "/r"}],
+            )
+        assert [r.get("id") for r in result["results"]] == ["one", "two", None]
+        assert "error" in result["results"][2]
+        assert svc.create_job.await_args_list[1].kwargs["branch"] == "b"
+        assert mock_runtime.start_or_enqueue.await_count == 2
+
+    @pytest.mark.asyncio
+    async def test_create_many_rejects_bad_specs_per_item(self, mcp_server, mock_runtime) -> None:
+        with patch("backend.mcp.server.JobService") as mock_svc_cls, patch("backend.mcp.server.GitService"):
+            svc = AsyncMock()
+            svc.create_job = AsyncMock(side_effect=lambda **kw: make_job(id=kw["prompt"], repo=kw["repo"]))
+            svc.get_job = AsyncMock(side_effect=lambda jid: make_job(id=jid, repo="/r", state="queued"))
+            mock_svc_cls.return_value = svc
+            result = await _tool(mcp_server, "codeplane_job")(
+                action="create",
+                jobs=[{"repo": "/r", "prompt": "ok"}, {"repo": "/r", "prompt": "x", "evil": "1"}, "not-a-dict"],
+            )
+        results = result["results"]
+        assert results[0]["id"] == "ok"
+        assert "evil" in results[1]["error"]
+        assert "error" in results[2]
+        assert svc.create_job.await_count == 1
+
+    @pytest.mark.asyncio
+    async def test_batch_item_exception_stays_per_item(self, mcp_server, mock_runtime) -> None:
+        async def _cancel(job_id: str):
+            if job_id == "boom":
+                raise RuntimeError("db exploded")
+            return make_job(id=job_id, repo="/r", state="canceled")
+
+        with patch("backend.mcp.server.JobService") as mock_svc_cls, patch("backend.mcp.server.GitService"):
+            svc = AsyncMock()
+            svc.cancel_job = AsyncMock(side_effect=_cancel)
+            mock_svc_cls.return_value = svc
+            result = await _tool(mcp_server, "codeplane_job")(action="cancel", job_ids=["a", "boom", "c"])
+        results = result["results"]
+        assert results[0]["state"] == "canceled"
+        assert results[1] == {"error": "db exploded"}
+        assert results[2]["state"] == "canceled"
+
+    @pytest.mark.asyncio
+    async def test_batch_limits(self, mcp_server) -> None:
+        tool = _tool(mcp_server, "codeplane_job")
+        assert "error" in await tool(action="get", job_ids=[])
+        assert "error" in await tool(action="get", job_ids=[f"j{i}" for i in range(51)])
+
+
+class TestJobEvents:
+    @pytest.fixture
+    def sse_server(self, mock_session_factory, mock_runtime, mock_approval):
+        sse = MagicMock()
+        sse.collect_since = AsyncMock(return_value=[])
+        server = create_mcp_server(
+            session_factory=mock_session_factory,
+            runtime_service=mock_runtime,
+            approval_service=mock_approval,
+            sse_manager=sse,
+        )
+        return server, sse
+
+    @pytest.mark.asyncio
+    async def test_events_after_cursor(self, sse_server) -> None:
+        from backend.services.sse_manager import _format_sse
+
+        server, sse = sse_server
+        sse.collect_since.return_value = [
+            _format_sse("11", "approval_resolved", '{"jobId": "job-1"}'),
+            _format_sse("11", "job_state_changed", '{"jobId": "job-1", "newState": "running"}'),
+            _format_sse("12", "log_line", '{"message": "hi"}'),
+        ]
+        result = await _tool(server, "codeplane_job")(action="events", cursor="10", job_id="job-1", wait_s=500)
+        assert [e["event"] for e in result["events"]] == ["approval_resolved", "job_state_changed", "log_line"]
+        assert result["cursor"] == "12"
+        assert result["has_more"] is False
+        _, after = sse.collect_since.await_args.args
+        assert after == 10
+        assert sse.collect_since.await_args.kwargs == {"job_id": "job-1", "wait_s": 60.0}
+
+        # limit counts events, not frames — a derived frame stays with its source
+        result = await _tool(server, "codeplane_job")(action="events", cursor="10", limit=1)
+        assert [e["id"] for e in result["events"]] == ["11", "11"]
+        assert (result["cursor"], result["has_more"]) == ("11", True)
+
+    @pytest.mark.asyncio
+    async def test_events_without_cursor_start_at_head(self, sse_server) -> None:
+        server, sse = sse_server
+        with patch("backend.mcp.server.EventRepository") as repo_cls:
+            repo_cls.return_value.latest_id = AsyncMock(return_value=42)
+            result = await _tool(server, "codeplane_job")(action="events")
+        assert result == {"events": [], "cursor": "42", "has_more": False}
+
+    @pytest.mark.asyncio
+    async def test_events_invalid_cursor(self, sse_server) -> None:
+        server, _ = sse_server
+        result = await _tool(server, "codeplane_job")(action="events", cursor="abc")
+        assert "error" in result
+
+    @pytest.mark.asyncio
+    async def test_events_unavailable_without_sse_manager(self, mcp_server) -> None:
+        result = await _tool(mcp_server, "codeplane_job")(action="events", cursor="1")
+        assert "error" in result
+
+
 # ── Approval tool ────────────────────────────────────────────────────
 
 
@@ -352,6 +503,40 @@ class TestWorkspaceTool:
         result = await _tool(mcp_server, "codeplane_workspace")(action="list", job_id=None)
         assert "error" in result
 
+    @pytest.mark.asyncio
+    async def test_read_many(self, mcp_server, tmp_path) -> None:
+        (tmp_path / "a.py").write_text("a = 1")
+        (tmp_path / "b.py").write_text("b = 2")
+        job = make_job(id="job-123", repo="/test/repo", worktree_path=str(tmp_path))
+        with patch("backend.mcp.server.JobService") as mock_svc_cls, patch("backend.mcp.server.GitService"):
+            svc = AsyncMock()
+            svc.get_job = AsyncMock(return_value=job)
+            mock_svc_cls.return_value = svc
+            result = await _tool(mcp_server, "codeplane_workspace")(
+                action="read", job_id="job-123", paths=["a.py", "missing.py", "../escape", "b.py"]
+            )
+        files = result["files"]
+        assert [f["path"] for f in files] == ["a.py", "missing.py", "../escape", "b.py"]
+        assert (files[0]["content"], files[3]["content"]) == ("a = 1", "b = 2")
+        assert files[1]["error"] == "File not found"
+        assert files[2]["error"] == "Invalid path"
+
+    @pytest.mark.asyncio
+    async def test_read_many_within_total_budget(self, mcp_server, tmp_path, monkeypatch) -> None:
+        monkeypatch.setattr("backend.mcp.server._MAX_READ_BYTES", 10)
+        for name in ("a", "b", "c"):
+            (tmp_path / name).write_text("x" * 4)
+        job = make_job(id="job-123", repo="/test/repo", worktree_path=str(tmp_path))
+        with patch("backend.mcp.server.JobService") as mock_svc_cls, patch("backend.mcp.server.GitService"):
+            svc = AsyncMock()
+            svc.get_job = AsyncMock(return_value=job)
+            mock_svc_cls.return_value = svc
+            result = await _tool(mcp_server, "codeplane_workspace")(
+                action="read", job_id="job-123", paths=["a", "b", "c"]
+            )
+        assert sum("content" in f for f in result["files"]) == 2
+        assert sum("error" in f for f in result["files"]) == 1
+
 
 # ── Artifact tool ────────────────────────────────────────────────────
 
@@ -140,6 +140,73 @@ async def test_summary_aggregate(session: AsyncSession) -> None:
     assert agg["completed"] == 1
 
 
+@pytest.mark.asyncio
+async def test_rollups_apply_deltas_on_refinalize(session: AsyncSession) -> None:
+    repo = TelemetrySummaryRepo(session)
+    await repo.init_job("job-1", sdk="copilot", model="gpt-4o", repo="/repos/test")
+    await repo.increment("job-1", total_cost_usd=0.5)
+    await repo.finalize("job-1", status="failed", duration_ms=1000)
+    # Resumed and finished again — the job must still be counted once.
+    await repo.increment("job-1", total_cost_usd=0.25)
+    await repo.finalize("job-1", status="completed", duration_ms=3000)
+    await session.commit()
+
+    for period in (1, 30):
+        agg = await repo.aggregate(period_days=period)
+        assert agg["total_jobs"] == 1
+        assert agg["completed"] == 1
+        assert agg["failed"] == 0
+        assert agg["total_cost_usd"] == pytest.approx(0.75)
+        assert agg["avg_duration_ms"] == pytest.approx(3000)
+
+    by_repo = await repo.cost_by_repo(period_days=7)
+    assert [r["repo"] for r in by_repo] == ["/repos/test"]
+    assert by_repo[0]["succeeded"] == 1
+
+    trend = await repo.cost_by_day(period_days=7)
+    assert len(trend) == 1
+    assert trend[0]["jobs"] == 1
+
+
+@pytest.mark.asyncio
+async def test_rollups_track_resolution(session: AsyncSession) -> None:
+    from backend.persistence.job_repo import JobRepository
+
+    repo = TelemetrySummaryRepo(session)
+    await repo.init_job("job-1", sdk="copilot", model="gpt-4o")
+    await repo.finalize("job-1", status="review", duration_ms=1000)
+    await JobRepository(session).update_resolution("job-1", "merged")
+    await session.commit()
+
+    rows = await repo.model_comparison(period_days=30)
+    assert len(rows) == 1
+    assert rows[0]["merged"] == 1
+    assert rows[0]["job_count"] == 1
+
+
+@pytest.mark.asyncio
+async def test_model_comparison_counts_failed_by_job_state(session: AsyncSession) -> None:
+    from backend.persistence.job_repo import JobRepository
+
+    repo = TelemetrySummaryRepo(session)
+    jobs = JobRepository(session)
+    await repo.init_job("job-1", sdk="copilot", model="gpt-4o")
+    # The summary never saw a failure, but the job itself ended failed.
+    await repo.finalize("job-1", status="completed", duration_ms=1000)
+    await jobs.update_state("job-1", JobState.failed, datetime.now(UTC))
+    await session.commit()
+
+    rows = await repo.model_comparison(period_days=30)
+    assert rows[0]["failed"] == 1
+    assert (await repo.aggregate(period_days=30))["failed"] == 0
+
+    await jobs.reset_for_resume("job-1", 2)
+    await session.commit()
+
+    rows = await repo.model_comparison(period_days=30)
+    assert rows[0]["failed"] == 0
+
+
 # ---------------------------------------------------------------------------
 # TelemetrySpansRepo
 # ---------------------------------------------------------------------------
@@ -218,3 +285,37 @@ async def test_spans_tool_stats(session: AsyncSession) -> None:
     assert stats[0]["name"] == "write_file"
     assert stats[0]["count"] == 5
     assert stats[0]["failure_count"] == 1
+
+
+@pytest.mark.asyncio
+async def test_spans_tool_stats_ignores_llm_spans(session: AsyncSession) -> None:
+    repo = TelemetrySpansRepo(session)
+    await repo.insert(job_id="job-1", span_type="llm", name="gpt-4o", started_at=0.0, duration_ms=900.0)
+    await repo.insert(
+        job_id="job-1", span_type="tool", name="bash", started_at=1.0, duration_ms=40.0, attrs={"success": "false"}
+    )
+    await session.commit()
+
+    stats = await repo.tool_stats(period_days=1)
+    assert [s["name"] for s in stats] == ["bash"]
+    assert stats[0]["failure_count"] == 1
+    assert stats[0]["avg_duration_ms"] == pytest.approx(40.0)
+
+
+@pytest.mark.asyncio
+async def test_tool_rollups_count_zero_success_as_failure(session: AsyncSession) -> None:
+    repo = TelemetrySpansRepo(session)
+    for i, success in enumerate((0, False, "false", True, 1)):
+        await repo.insert(
+            job_id="job-1",
+            span_type="tool",
+            name="bash",
+            started_at=float(i),
+            duration_ms=10.0,
+            attrs={"success": success},
+        )
+    await session.commit()
+
+    stats = await repo.tool_stats(period_days=1)
+    assert stats[0]["count"] == 5
+    assert stats[0]["failure_count"] == 3
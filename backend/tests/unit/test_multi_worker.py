@@ -0,0 +1,261 @@
+"""Tests for multi-worker mode: the runtime event socket and the front proxy."""
+
+from __future__ import annotations
+
+import asyncio
+import contextlib
+from datetime import UTC, datetime
+from typing import TYPE_CHECKING
+from unittest.mock import AsyncMock, MagicMock
+
+import httpx
+import pytest
+import uvicorn
+from dishka import make_async_container
+from starlette.applications import Starlette
+from starlette.responses import JSONResponse, Response, StreamingResponse
+from starlette.routing import Route
+
+from backend.front_app import (
+    FrontProvider,
+    FrontSettings,
+    _proxy_http,
+    _SessionCache,
+    _sse_authorized,
+    create_front_app,
+)
+from backend.models.events import DomainEvent, DomainEventKind
+from backend.services.event_socket import EventSocketClient, EventSocketServer, decode_event, encode_event
+
+if TYPE_CHECKING:
+    from collections.abc import AsyncGenerator
+    from pathlib import Path
+
+    from starlette.requests import Request
+
+
+def _event(seq: int, db_id: int | None = None) -> DomainEvent:
+    return DomainEvent(
+        event_id=f"evt-{seq}",
+        job_id="job-1",
+        timestamp=datetime(2026, 1, 1, tzinfo=UTC),
+        kind=DomainEventKind.log_line_emitted,
+        payload={"seq": seq, "content": "line\nwith newline"},
+        db_id=db_id,
+    )
+
+
+# ---------------------------------------------------------------------------
+# Event socket
+# ---------------------------------------------------------------------------
+
+
+def test_encode_decode_round_trip() -> None:
+    event = _event(1, db_id=42)
+    line = encode_event(event)
+    assert line.endswith(b"\n") and line.count(b"\n") == 1
+    assert decode_event(line) == event
+
+
+@pytest.mark.asyncio
+async def test_events_reach_every_front(tmp_path: Path) -> None:
+    server = EventSocketServer(tmp_path / "events.sock")
+    await server.start()
+    managers = [AsyncMock(), AsyncMock()]
+    clients = [asyncio.create_task(EventSocketClient(tmp_path / "events.sock", m).run()) for m in managers]
+    try:
+        while server.client_count < 2:
+            await asyncio.sleep(0.01)
+        assert oct((tmp_path / "events.sock").stat().st_mode & 0o777) == "0o600"
+        for i in range(3):
+            await server.broadcast_domain_event(_event(i, db_id=i + 1))
+        for manager in managers:
+            while manager.broadcast_domain_event.await_count < 3:
+                await asyncio.sleep(0.01)
+            received = [c.args[0] for c in manager.broadcast_domain_event.await_args_list]
+            assert [e.db_id for e in received] == [1, 2, 3]
+    finally:
+        for task in clients:
+            task.cancel()
+        await server.close()
+    assert not (tmp_path / "events.sock").exists()
+
+
+@pytest.mark.asyncio
+async def test_lagging_front_is_dropped(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    monkeypatch.setattr("backend.services.event_socket._CLIENT_BUFFER", 2)
+    server = EventSocketServer(tmp_path / "events.sock")
+    await server.start()
+    # A connected peer that never reads
+    _reader, writer = await asyncio.open_unix_connection(str(tmp_path / "events.sock"))
+    try:
+        while server.client_count < 1:
+            await asyncio.sleep(0.01)
+        big = _event(0)
+        big.payload["content"] = "x" * 1_000_000
+        for _ in range(20):
+            await server.broadcast_domain_event(big)
+            await asyncio.sleep(0)
+            if server.client_count == 0:
+                break
+        assert server.client_count == 0
+    finally:
+        writer.close()
+        await server.close()
+
+
+@pytest.mark.asyncio
+async def test_client_reconnect_closes_sse_streams(tmp_path: Path) -> None:
+    path = tmp_path / "events.sock"
+    manager = AsyncMock()
+    client = asyncio.create_task(EventSocketClient(path, manager).run())
+    try:
+        for _ in range(2):
+            server = EventSocketServer(path)
+            await server.start()
+            while server.client_count < 1:
+                await asyncio.sleep(0.01)
+            await server.close()
+        # Only the second connection followed a gap
+        while manager.close_all.await_count < 1:
+            await asyncio.sleep(0.01)
+        assert manager.close_all.await_count == 1
+    finally:
+        client.cancel()
+    assert not await EventSocketClient(path, manager).handle(b"not json")
+
+
+# ---------------------------------------------------------------------------
+# Front proxy
+# ---------------------------------------------------------------------------
+
+
+async def _echo(request: Request) -> Response:
+    body = await request.body()
+    response = JSONResponse(
+        {
+            "client": request.client.host if request.client else None,
+            "path": request.url.path,
+            "query": request.url.query,
+            "body": body.decode(),
+        },
+        status_code=201,
+    )
+    response.set_cookie("a", "1")
+    response.set_cookie("b", "2")
+    return response
+
+
+async def _stream(request: Request) -> StreamingResponse:
+    async def chunks() -> AsyncGenerator[bytes, None]:
+        for i in range(3):
+            yield f"chunk-{i}\n".encode()
+
+    return StreamingResponse(chunks(), media_type="text/plain")
+
+
+async def _session(request: Request) -> Response:
+    ok = request.cookies.get("cpl_session") == "good"
+    return Response(status_code=204 if ok else 401)
+
+
+@pytest.fixture
+async def runtime_socket(tmp_path: Path) -> AsyncGenerator[Path, None]:
+    """A stand-in runtime served the way ``cpl up --workers`` serves the real one."""
+    path = tmp_path / "runtime.sock"
+    app = Starlette(
+        routes=[
+            Route("/api/echo/{rest:path}", _echo, methods=["GET", "POST"]),
+            Route("/api/stream", _stream),
+            Route("/api/auth/session", _session),
+        ]
+    )
+    server = uvicorn.Server(uvicorn.Config(app, uds=str(path), forwarded_allow_ips="*", log_level="error"))
+    task = asyncio.create_task(server.serve())
+    while not server.started:
+        await asyncio.sleep(0.01)
+    yield path
+    server.should_exit = True
+    with contextlib.suppress(asyncio.CancelledError):
+        await task
+
+
+@pytest.fixture
+async def front(runtime_socket: Path) -> AsyncGenerator[httpx.AsyncClient, None]:
+    app = create_front_app(
+        FrontSettings(runtime_socket=runtime_socket, event_socket=runtime_socket.parent / "e", auth_enabled=True)
+    )
+    app.state.runtime = httpx.AsyncClient(
+        transport=httpx.AsyncHTTPTransport(uds=str(runtime_socket)), base_url="http://codeplane"
+    )
+    app.state.session_cache = _SessionCache()
+    app.state.dishka_container = make_async_container(FrontProvider(), context={})
+    transport = httpx.ASGITransport(app=app, client=("203.0.113.7", 5000))
+    async with httpx.AsyncClient(transport=transport, base_url="http://front") as client:
+        yield client
+    await app.state.runtime.aclose()
+
+
+@pytest.mark.asyncio
+async def test_proxy_forwards_peer_address_not_client_header(front: httpx.AsyncClient) -> None:
+    resp = await front.post(
+        "/api/echo/a%20b?x=1&y=%2F",
+        content=b"payload",
+        headers={"x-forwarded-for": "127.0.0.1"},
+    )
+    assert resp.status_code == 201
+    assert resp.json() == {"client": "203.0.113.7", "path": "/api/echo/a b", "query": "x=1&y=%2F", "body": "payload"}
+    assert resp.headers.get_list("set-cookie") == ["a=1; Path=/; SameSite=lax", "b=2; Path=/; SameSite=lax"]
+    assert resp.headers["x-content-type-options"] == "nosniff"
+
+
+@pytest.mark.asyncio
+async def test_proxy_streams_response(front: httpx.AsyncClient) -> None:
+    resp = await front.get("/api/stream")
+    assert resp.text == "chunk-0\nchunk-1\nchunk-2\n"
+
+
+@pytest.mark.asyncio
+async def test_proxy_reports_unreachable_runtime(tmp_path: Path) -> None:
+    app = create_front_app(
+        FrontSettings(runtime_socket=tmp_path / "absent.sock", event_socket=tmp_path / "e", auth_enabled=False)
+    )
+    app.state.runtime = httpx.AsyncClient(
+        transport=httpx.AsyncHTTPTransport(uds=str(tmp_path / "absent.sock")), base_url="http://codeplane"
+    )
+    request = MagicMock(app=app, headers=httpx.Headers(), scope={"raw_path": b"/api/jobs", "query_string": b""})
+    request.headers = MagicMock(raw=[], __contains__=lambda _self, _key: False)
+    request.url.path = "/api/jobs"
+    request.url.scheme = "http"
+    request.method = "GET"
+    request.client = None
+    resp = await _proxy_http(request)
+    assert resp.status_code == 503
+    await app.state.runtime.aclose()
+
+
+@pytest.mark.asyncio
+async def test_sse_auth_asks_runtime_and_caches(runtime_socket: Path) -> None:
+    state = MagicMock()
+    state.session_cache = _SessionCache()
+    state.runtime = httpx.AsyncClient(
+        transport=httpx.AsyncHTTPTransport(uds=str(runtime_socket)), base_url="http://codeplane"
+    )
+
+    def _request(cookie: str | None, host: str = "203.0.113.7") -> MagicMock:
+        request = MagicMock()
+        request.app.state = state
+        request.client.host = host
+        request.cookies = {"cpl_session": cookie} if cookie else {}
+        request.headers = {"cookie": f"cpl_session={cookie}"} if cookie else {}
+        return request
+
+    try:
+        assert await _sse_authorized(_request(None, host="127.0.0.1"))
+        assert not await _sse_authorized(_request(None))
+        assert not await _sse_authorized(_request("bad"))
+        assert await _sse_authorized(_request("good"))
+        assert state.session_cache.hit("good")
+        assert not state.session_cache.hit("bad")
+    finally:
+        await state.runtime.aclose()
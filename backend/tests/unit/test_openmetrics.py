@@ -0,0 +1,83 @@
+"""Tests for the OpenMetrics rendering behind ``/metrics``."""
+
+from __future__ import annotations
+
+from opentelemetry.metrics import CallbackOptions, Observation
+from opentelemetry.sdk.metrics import MeterProvider
+from opentelemetry.sdk.metrics.export import InMemoryMetricReader
+
+from backend.services.openmetrics import metric_name, render
+
+
+def _provider() -> tuple[MeterProvider, InMemoryMetricReader]:
+    reader = InMemoryMetricReader()
+    return MeterProvider(metric_readers=[reader]), reader
+
+
+def _samples(text: str) -> dict[str, float]:
+    out: dict[str, float] = {}
+    for line in text.splitlines():
+        if line and not line.startswith("#"):
+            name, value = line.rsplit(" ", 1)
+            out[name] = float(value)
+    return out
+
+
+def test_metric_name_sanitised() -> None:
+    assert metric_name("cp.tokens.input") == "cp_tokens_input"
+    assert metric_name("cp.quota.remaining-pct") == "cp_quota_remaining_pct"
+
+
+def test_counter_drops_job_id_and_sums() -> None:
+    provider, reader = _provider()
+    counter = provider.get_meter("t").create_counter("cp.tokens.input", description="Input tokens")
+    counter.add(5, {"job_id": "a", "sdk": "copilot", "model": "m"})
+    counter.add(7, {"job_id": "b", "sdk": "copilot", "model": "m"})
+    counter.add(1, {"job_id": "c", "sdk": "claude", "model": "m"})
+
+    text = render(reader.get_metrics_data())
+
+    assert "# TYPE cp_tokens_input counter" in text
+    assert "job_id" not in text
+    samples = _samples(text)
+    assert samples['cp_tokens_input_total{model="m",sdk="copilot"}'] == 12
+    assert samples['cp_tokens_input_total{model="m",sdk="claude"}'] == 1
+    assert text.endswith("# EOF\n")
+
+
+def test_histogram_buckets_are_cumulative() -> None:
+    provider, reader = _provider()
+    hist = provider.get_meter("t").create_histogram("cp.git.duration", unit="ms")
+    for ms in (3.0, 30.0, 30.0, 20_000.0):
+        hist.record(ms, {"command": "diff", "job_id": "x"})
+
+    samples = _samples(render(reader.get_metrics_data()))
+
+    assert samples['cp_git_duration_bucket{command="diff",le="5"}'] == 1
+    assert samples['cp_git_duration_bucket{command="diff",le="50"}'] == 3
+    assert samples['cp_git_duration_bucket{command="diff",le="+Inf"}'] == 4
+    assert samples['cp_git_duration_count{command="diff"}'] == 4
+    assert samples['cp_git_duration_sum{command="diff"}'] == 20_063
+
+
+def test_gauges_keep_max_and_escape_labels() -> None:
+    provider, reader = _provider()
+    meter = provider.get_meter("t")
+    gauge = meter.create_gauge("cp.context.tokens")
+    gauge.set(100, {"job_id": "a"})
+    gauge.set(300, {"job_id": "b"})
+
+    def _observe(_options: CallbackOptions) -> list[Observation]:
+        return [Observation(2, {"scope": 'we"ird\\'}), Observation(0.25, {"scope": "global"})]
+
+    meter.create_observable_gauge("cp.sse.connections", callbacks=[_observe])
+
+    samples = _samples(render(reader.get_metrics_data()))
+
+    assert samples["cp_context_tokens"] == 300
+    assert samples['cp_sse_connections{scope="we\\"ird\\\\"}'] == 2
+    assert samples['cp_sse_connections{scope="global"}'] == 0.25
+
+
+def test_empty_exposition() -> None:
+    assert render(None) == "# EOF\n"
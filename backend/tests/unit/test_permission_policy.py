@@ -545,3 +545,166 @@ class TestEvaluateApprovalRequired:
     def test_unknown_kind_asks(self, tmp_path: Path) -> None:
         result = evaluate_approval_required(kind="something-new", workspace_path=str(tmp_path))
         assert result == PolicyDecision.ask
+
+
+# ---------------------------------------------------------------------------
+# Compiled fast path — decisions must match the plain rule-table evaluation
+# ---------------------------------------------------------------------------
+
+# Hand-picked edge cases: quoting, compound commands, case, whitespace, and
+# near-misses for every hard-gated and read-only pattern.
+_CORPUS_SEEDS = [
+    "",
+    " ",
+    "git reset --hard",
+    "  git reset --hard HEAD~2  ",
+    "GIT RESET --HARD",
+    "git reset HEAD --hard",
+    "git reset --hard-ish",
+    "git reset '--hard'",
+    'git commit -m "git reset --hard"',
+    "echo 'git reset --hard' && ls",
+    "cd /repo && git reset --hard origin/main",
+    "cd /repo; git reset --soft HEAD && git reset --hard",
+    "ls | git reset --hard",
+    'echo "unterminated && git reset --hard',
+    "git\treset\t--hard",
+    "git reset --mixed\n--hard",
+    "git merge main",
+    "git  merge",
+    "git merged",
+    "git pull --rebase",
+    "git rebase -i HEAD~3",
+    "git cherry-pick abc",
+    "git cherry-picker",
+    "grep -r foo .",
+    "grepx foo",
+    "ls -la && rm -rf /",
+    "cat file | sh",
+    "Get-ChildItem .",
+    "get-childitem",
+    "findstr /s x *.txt",
+    "python script.py",
+    "rm -rf build",
+    " ls",
+    "ls ",
+    "echo --HARD git reset",
+]
+_CORPUS_FRAGMENTS = [
+    "git",
+    "reset",
+    "--hard",
+    "--soft",
+    "merge",
+    "pull",
+    "HEAD",
+    "ls",
+    "grep",
+    "cat",
+    "echo",
+    "&&",
+    "||",
+    ";",
+    "|",
+    "'",
+    '"',
+    "\\",
+    "\n",
+    "\t",
+    " ",
+    "rm",
+    "-rf",
+    "x",
+    "Get-Content",
+    "rg",
+]
+
+
+def _fuzz_corpus(n: int = 3000, seed: int = 0) -> list[str]:
+    import random
+
+    rng = random.Random(seed)
+    corpus = list(_CORPUS_SEEDS)
+    for _ in range(n):
+        k = rng.randint(1, 8)
+        sep = rng.choice([" ", "  ", "", "\t"])
+        corpus.append(sep.join(rng.choice(_CORPUS_FRAGMENTS) for _ in range(k)))
+    return corpus
+
+
+def _reference_evaluate(
+    mode: str,
+    kind: str,
+    workspace: str,
+    *,
+    full_command_text: str | None = None,
+    file_name: str | None = None,
+    read_only: bool | None = None,
+) -> PolicyDecision:
+    """The rule table evaluated directly, without compilation or caching."""
+    from backend.services.permission_policy import (
+        _GIT_RESET_HARD_RE,
+        _MODE_DEFAULTS,
+        _RULES,
+        _strip_quoted_strings,
+    )
+
+    cmd = full_command_text or ""
+    if kind == "shell" and (_HARD_GATED_SHELL_RE.search(cmd) or _GIT_RESET_HARD_RE.search(_strip_quoted_strings(cmd))):
+        return PolicyDecision.ask
+    rule = _RULES.get((mode, kind))
+    if rule is None:
+        return _MODE_DEFAULTS.get(mode, PolicyDecision.ask)
+    if isinstance(rule.decision, PolicyDecision):
+        return rule.decision
+    inside = file_name is not None and _is_path_within_workspace(file_name, workspace)
+    if rule.decision == "path_in_ws":
+        return PolicyDecision.approve if inside else rule.fallback
+    if rule.decision == "shell_readonly":
+        return PolicyDecision.approve if _READONLY_SHELL_RE.match(cmd) else rule.fallback
+    if rule.decision == "mcp_readonly":
+        return PolicyDecision.approve if read_only else rule.fallback
+    return PolicyDecision.approve if file_name is None or inside else PolicyDecision.deny
+
+
+class TestCompiledPolicyMatchesReference:
+    _MODES = ("full_auto", "observe_only", "review_and_approve")
+
+    def test_shell_decisions_identical_over_fuzz_corpus(self, tmp_path: Path) -> None:
+        from backend.services.permission_policy import evaluate
+
+        for cmd in _fuzz_corpus():
+            for mode in self._MODES:
+                for _ in range(2):  # second pass is served from the cache
+                    got = evaluate(mode, kind="shell", workspace_path=str(tmp_path), full_command_text=cmd)
+                    want = _reference_evaluate(mode, "shell", str(tmp_path), full_command_text=cmd)
+                    assert got == want, f"{mode}: {cmd!r}"
+
+    def test_is_git_reset_hard_prefilter_agrees(self) -> None:
+        from backend.services.permission_policy import _GIT_RESET_HARD_RE, _strip_quoted_strings
+
+        for cmd in _fuzz_corpus(seed=1):
+            assert is_git_reset_hard(cmd) == bool(_GIT_RESET_HARD_RE.search(_strip_quoted_strings(cmd))), cmd
+
+    def test_non_shell_decisions_identical(self, tmp_path: Path) -> None:
+        from backend.services.permission_policy import evaluate
+
+        inside = str(tmp_path / "a.py")
+        outside = str(tmp_path.parent / "elsewhere.py")
+        for mode in self._MODES:
+            for kind in ("read", "write", "memory", "mcp", "url", "custom-tool", "new-kind"):
+                for target in (None, inside, outside):
+                    for read_only in (None, True, False):
+                        got = evaluate(
+                            mode, kind=kind, workspace_path=str(tmp_path), file_name=target, read_only=read_only
+                        )
+                        want = _reference_evaluate(mode, kind, str(tmp_path), file_name=target, read_only=read_only)
+                        assert got == want, (mode, kind, target, read_only)
+
+    def test_long_commands_bypass_cache(self, tmp_path: Path) -> None:
+        from backend.services.permission_policy import _SHELL_CACHE_MAX_LEN, _classify_shell_cached, evaluate
+
+        _classify_shell_cached.cache_clear()
+        long_cmd = "cat <<EOF\n" + "x" * _SHELL_CACHE_MAX_LEN + "\nEOF && git reset --hard"
+        assert evaluate("full_auto", kind="shell", workspace_path=str(tmp_path), full_command_text=long_cmd) == "ask"
+        assert _classify_shell_cached.cache_info().currsize == 0
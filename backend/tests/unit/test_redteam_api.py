@@ -25,6 +25,7 @@ from backend.config import CPLConfig
 from backend.di import (
     AppProvider,
     CachedModelsBySdk,
+    ReadSessionFactory,
     RequestProvider,
     VoiceMaxBytes,
 )
@@ -79,6 +80,7 @@ async def _client() -> AsyncGenerator[Any, None]:
         context={
             CPLConfig: CPLConfig(repos=[]),
             async_sessionmaker: session_factory,
+            ReadSessionFactory: ReadSessionFactory(session_factory),
             EventBus: EventBus(),
             SSEManager: SSEManager(),
             ApprovalService: AsyncMock(spec=ApprovalService),
@@ -0,0 +1,212 @@
+"""Tests for the in-memory repo registry — cached globs, config reloads and watching."""
+
+from __future__ import annotations
+
+import asyncio
+from typing import TYPE_CHECKING
+
+import pytest
+
+from backend.config import CPLConfig, register_repo, unregister_repo
+from backend.services.repo_registry import RepoRegistry, pattern_matches, pattern_root, resolve_repos
+
+if TYPE_CHECKING:
+    from pathlib import Path
+
+
+def _make_repo(path: Path) -> Path:
+    (path / ".git").mkdir(parents=True)
+    return path
+
+
+def _write_config(path: Path, repos: list[str]) -> None:
+    path.write_text("repos:\n" + "".join(f"  - {r}\n" for r in repos))
+
+
+async def _until(predicate: object, timeout: float = 10.0) -> None:
+    deadline = asyncio.get_running_loop().time() + timeout
+    while not predicate():  # type: ignore[operator]
+        assert asyncio.get_running_loop().time() < deadline, "condition not reached in time"
+        await asyncio.sleep(0.05)
+
+
+def test_pattern_root(tmp_path: Path) -> None:
+    assert pattern_root(f"{tmp_path}/src/**") == tmp_path / "src"
+    assert pattern_root(f"{tmp_path}/a/*/b") == tmp_path / "a"
+
+
+def test_pattern_matches_like_glob(tmp_path: Path) -> None:
+    assert pattern_matches(f"{tmp_path}/src/*", f"{tmp_path}/src/one")
+    assert not pattern_matches(f"{tmp_path}/src/*", f"{tmp_path}/src/a/b")
+    assert pattern_matches(f"{tmp_path}/src/**", f"{tmp_path}/src/a/b")
+    assert pattern_matches(f"{tmp_path}/src/**/repo-?", f"{tmp_path}/src/repo-1")
+    assert not pattern_matches(f"{tmp_path}/src/**", f"{tmp_path}/src/.hidden/b")
+    assert not pattern_matches(f"{tmp_path}/src/*", f"{tmp_path}/other/one")
+
+
+def test_resolve_repos_only_matches_git_directories(tmp_path: Path) -> None:
+    repo = _make_repo(tmp_path / "src" / "one")
+    (tmp_path / "src" / "plain").mkdir()
+    assert resolve_repos([f"{tmp_path}/src/*", "/explicit/path"]) == {str(repo), "/explicit/path"}
+
+
+@pytest.mark.asyncio
+async def test_globs_are_expanded_once(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    repo = _make_repo(tmp_path / "src" / "one")
+    config_path = tmp_path / "config.yaml"
+    _write_config(config_path, [f"{tmp_path}/src/*"])
+
+    registry = RepoRegistry(config_path)
+    await registry.start()
+    try:
+        await _until(lambda: registry.ready)
+        assert registry.allowed() == {str(repo)}
+
+        calls: list[str] = []
+
+        def _counting_glob(pattern: str, **kwargs: object) -> list[str]:
+            calls.append(pattern)
+            return []
+
+        monkeypatch.setattr("backend.services.repo_registry.glob.glob", _counting_glob)
+        for _ in range(5):
+            assert str(repo) in registry.allowed()
+        assert calls == []
+    finally:
+        await registry.close()
+
+
+@pytest.mark.asyncio
+async def test_registered_repo_visible_on_next_lookup(tmp_path: Path) -> None:
+    config_path = tmp_path / "config.yaml"
+    _write_config(config_path, [])
+    repo = _make_repo(tmp_path / "new")
+
+    registry = RepoRegistry(config_path)
+    await registry.start()
+    try:
+        assert str(repo) not in registry.allowed()
+        register_repo(CPLConfig(), str(repo), config_path)
+        assert str(repo) in registry.allowed()
+        unregister_repo(CPLConfig(), str(repo), config_path)
+        assert str(repo) not in registry.allowed()
+    finally:
+        await registry.close()
+
+
+@pytest.mark.asyncio
+async def test_cloned_repo_picked_up_by_watcher(tmp_path: Path) -> None:
+    (tmp_path / "src").mkdir()
+    config_path = tmp_path / "config.yaml"
+    _write_config(config_path, [f"{tmp_path}/src/**"])
+
+    registry = RepoRegistry(config_path)
+    await registry.start()
+    try:
+        await _until(lambda: registry.ready)
+        # Let the watcher attach before the tree changes
+        await asyncio.sleep(0.5)
+        repo = _make_repo(tmp_path / "src" / "group" / "cloned")
+        await _until(lambda: str(repo) in registry.allowed())
+
+        (repo / ".git").rmdir()
+        await _until(lambda: str(repo) not in registry.allowed())
+    finally:
+        await registry.close()
+
+
+def test_lookup_before_expansion_finishes(tmp_path: Path) -> None:
+    repo = _make_repo(tmp_path / "src" / "one")
+    config_path = tmp_path / "config.yaml"
+    _write_config(config_path, [f"{tmp_path}/src/*"])
+
+    registry = RepoRegistry(config_path)
+    # No event loop to expand in the background: the lookup expands synchronously
+    assert registry.allowed() == {str(repo)}
+    assert not registry.ready
+
+
+@pytest.mark.asyncio
+async def test_lookup_during_expansion_does_not_walk_on_the_loop(
+    tmp_path: Path, monkeypatch: pytest.MonkeyPatch
+) -> None:
+    import glob
+    import threading
+
+    repo = _make_repo(tmp_path / "src" / "one")
+    config_path = tmp_path / "config.yaml"
+    _write_config(config_path, [f"{tmp_path}/src/*", "/explicit/path"])
+
+    release = threading.Event()
+    real_glob = glob.glob
+
+    def _slow_glob(pattern: str, **kwargs: bool) -> list[str]:
+        release.wait(10)
+        return real_glob(pattern, **kwargs)
+
+    monkeypatch.setattr("backend.services.repo_registry.glob.glob", _slow_glob)
+    registry = RepoRegistry(config_path)
+    await registry.start()
+    try:
+        # Answers at once with what is known, while the pattern expands in a thread
+        assert registry.allowed() == {"/explicit/path"}
+        assert not await registry.wait_ready(timeout=0.05)
+        release.set()
+        assert await registry.wait_ready()
+        assert registry.allowed() == {str(repo), "/explicit/path"}
+    finally:
+        release.set()
+        await registry.close()
+
+
+def test_only_repository_changes_trigger_a_rescan(tmp_path: Path) -> None:
+    from watchfiles import Change
+
+    repo = _make_repo(tmp_path / "src" / "one")
+    (tmp_path / "src" / "one" / "build" / "out").mkdir(parents=True)
+    cloned = _make_repo(tmp_path / "src" / "two")
+    changes = {
+        (Change.added, str(tmp_path / "src" / "one" / "build")),
+        (Change.added, str(tmp_path / "src" / "one" / "build" / "out")),
+        (Change.deleted, str(tmp_path / "src" / "one" / "stale.o")),
+        (Change.added, str(cloned)),
+        (Change.added, str(cloned / ".git")),
+    }
+    relevant = RepoRegistry._repo_changes(changes, frozenset({str(repo)}))
+    assert sorted(relevant) == sorted([str(cloned), str(cloned / ".git")])
+
+    moved = {(Change.deleted, str(tmp_path / "src"))}
+    assert RepoRegistry._repo_changes(moved, frozenset({str(repo)})) == [str(tmp_path / "src")]
+
+
+def test_worktree_churn_is_ignored(tmp_path: Path) -> None:
+    from watchfiles import Change
+
+    repo = _make_repo(tmp_path / "src" / "one")
+    worktree = tmp_path / "src" / "one" / ".codeplane-worktrees" / "job-1"
+    worktree.mkdir(parents=True)
+    (worktree / ".git").write_text("gitdir: ../../.git/worktrees/job-1\n")
+    changes = {(Change.added, str(worktree)), (Change.added, str(worktree / ".git"))}
+    assert RepoRegistry._repo_changes(changes, frozenset({str(repo)}), ".codeplane-worktrees") == []
+
+
+@pytest.mark.asyncio
+async def test_discover_allows_a_fresh_clone_before_the_rescan(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    (tmp_path / "src").mkdir()
+    config_path = tmp_path / "config.yaml"
+    _write_config(config_path, [f"{tmp_path}/src/*"])
+    monkeypatch.setattr(RepoRegistry, "_restart_watch", lambda self: None)
+
+    registry = RepoRegistry(config_path)
+    await registry.start()
+    try:
+        await _until(lambda: registry.ready)
+        repo = _make_repo(tmp_path / "src" / "cloned")
+        outside = _make_repo(tmp_path / "elsewhere")
+        assert str(repo) not in registry.allowed()
+
+        await registry.discover(str(repo))
+        await registry.discover(str(outside))
+        assert registry.allowed() == {str(repo)}
+    finally:
+        await registry.close()
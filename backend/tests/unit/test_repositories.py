@@ -13,12 +13,12 @@ if TYPE_CHECKING:
     from collections.abc import AsyncGenerator
 
 from backend.models.db import Base
-from backend.models.domain import Artifact
+from backend.models.domain import PROMPT_PREVIEW_CHARS, Artifact
 from backend.models.events import DomainEvent, DomainEventKind
 from backend.persistence.artifact_repo import ArtifactRepository
 from backend.persistence.database import _set_sqlite_pragmas
 from backend.persistence.event_repo import EventRepository
-from backend.persistence.job_repo import JobRepository
+from backend.persistence.job_repo import JobRepository, decode_job_cursor, encode_job_cursor
 from backend.tests.unit.conftest import make_job
 
 
@@ -123,6 +123,42 @@ async def test_job_list_cursor_pagination(session: AsyncSession) -> None:
     assert len(all_ids) == len(set(all_ids))
 
 
+@pytest.mark.asyncio
+async def test_job_list_summaries_pages_by_keyset(session: AsyncSession) -> None:
+    repo = JobRepository(session)
+    created = datetime(2026, 1, 1, tzinfo=UTC)
+    # job-1 and job-2 share a timestamp, so the id breaks the tie across pages
+    for i, hour in enumerate([0, 1, 1, 3, 4]):
+        at = created.replace(hour=hour)
+        await repo.create(make_job(id=f"job-{i}", prompt="x" * 500, created_at=at, updated_at=at))
+    await repo.create(make_job(id="job-archived", created_at=created, updated_at=created, archived_at=created))
+    await session.commit()
+
+    page1 = await repo.list_summaries(limit=3, include_archived=False)
+    cursor = encode_job_cursor(page1[-1].created_at, page1[-1].id)
+    assert decode_job_cursor(cursor) == (page1[-1].created_at, "job-2")
+    page2 = await repo.list_summaries(limit=3, cursor=cursor, include_archived=False)
+    assert [j.id for j in page1] == ["job-4", "job-3", "job-2"]
+    assert [j.id for j in page2] == ["job-1", "job-0"]
+    assert page1[0].prompt_preview == "x" * PROMPT_PREVIEW_CHARS
+    assert not hasattr(page1[0], "prompt")
+
+    # Cursors issued as a bare job id keep working
+    assert [j.id for j in await repo.list(limit=3, cursor="job-2")] == ["job-1", "job-archived", "job-0"]
+
+
+@pytest.mark.asyncio
+async def test_job_count(session: AsyncSession) -> None:
+    repo = JobRepository(session)
+    for i, state in enumerate(["running", "queued", "queued", "failed"]):
+        await repo.create(make_job(id=f"job-{i}", state=state))
+    await session.commit()
+
+    assert await repo.count() == 4
+    assert await repo.count("queued") == 2
+    assert await repo.count("running,queued") == 3
+
+
 @pytest.mark.asyncio
 async def test_job_update_state(session: AsyncSession) -> None:
     repo = JobRepository(session)
@@ -5,6 +5,7 @@ from __future__ import annotations
 import asyncio
 import contextlib
 import json
+import time
 from datetime import UTC, datetime
 from types import SimpleNamespace
 from typing import TYPE_CHECKING
@@ -43,12 +44,9 @@ from backend.models.events import DomainEvent, DomainEventKind
 from backend.persistence.database import _set_sqlite_pragmas
 from backend.services.adapter_registry import AdapterRegistry
 from backend.services.agent_adapter import AgentAdapterInterface
+from backend.services.cost_ledger import BudgetStatus, CostLedger
 from backend.services.event_bus import EventBus
 from backend.services.job_service import StateConflictError
-from backend.services.progress_tracking_service import (
-    _count_similar_trailing_headlines,
-    _headlines_are_similar,
-)
 from backend.services.runtime_service import (
     RuntimeService,
     _AgentSession,
@@ -159,7 +157,12 @@ def session_factory(engine: AsyncEngine) -> async_sessionmaker[AsyncSession]:
 
 @pytest.fixture
 def config(tmp_path: Path) -> CPLConfig:
-    return CPLConfig(repos=[str(tmp_path)])
+    config = CPLConfig(repos=[str(tmp_path)])
+    # The in-memory engine hands every session the same connection, so real
+    # recoveries must not run in parallel here; tests that exercise the
+    # concurrency bound stub out the DB work and raise this themselves.
+    config.runtime.recovery_concurrency = 1
+    return config
 
 
 @pytest.fixture
@@ -409,22 +412,6 @@ class TestCapacityAndQueueing:
         assert runtime.max_concurrent == 2  # default
 
 
-class TestHeadlineSimilarity:
-    def test_headlines_are_similar_when_subject_is_same(self) -> None:
-        assert _headlines_are_similar("Investigating tool error display", "Debugging tool error display")
-
-    def test_headlines_are_not_similar_for_different_work(self) -> None:
-        assert not _headlines_are_similar("Implementing auth API", "Writing Playwright tests")
-
-    def test_count_similar_trailing_headlines_counts_contiguous_tail(self) -> None:
-        history = [
-            "Preparing worktree",
-            "Investigating tool error display",
-            "Debugging tool error display",
-        ]
-        assert _count_similar_trailing_headlines(history, "Fixing tool error display") == 2
-
-
 # ---------------------------------------------------------------------------
 # RuntimeService — event translation
 # ---------------------------------------------------------------------------
@@ -1148,6 +1135,143 @@ class TestRecovery:
             assert row.state == JobState.review
 
 
+# ---------------------------------------------------------------------------
+# RuntimeService — budget enforcement
+# ---------------------------------------------------------------------------
+
+
+class RecordingAgentAdapter(FakeAgentAdapter):
+    """Fake adapter that remembers the session configs it was started with."""
+
+    def __init__(self, delay: float = 0.0) -> None:
+        super().__init__(delay=delay)
+        self.configs: list[SessionConfig] = []
+
+    async def create_session(self, config: SessionConfig) -> str:
+        self.configs.append(config)
+        return await super().create_session(config)
+
+
+def _spend_premium(ledger: CostLedger, premium_requests: float) -> None:
+    """Book month-to-date Copilot spend from an earlier, finished job."""
+    ledger.register_job("earlier", repo="/repos/other", sdk="copilot")
+    ledger.record("earlier", premium_requests=premium_requests)
+    ledger.forget_job("earlier")
+
+
+class TestBudgetEnforcement:
+    @pytest.fixture
+    def ledger(self, config: CPLConfig) -> CostLedger:
+        config.telemetry.copilot_premium_entitlement = 10
+        config.telemetry.budget_downgrade_models = {"copilot": "gpt-4o-mini"}
+        return CostLedger(config.telemetry)
+
+    @pytest.fixture
+    def recording_adapter(self) -> RecordingAgentAdapter:
+        return RecordingAgentAdapter(delay=0.5)
+
+    @pytest.fixture
+    async def budget_runtime(
+        self,
+        session_factory: async_sessionmaker[AsyncSession],
+        event_bus: EventBus,
+        recording_adapter: RecordingAgentAdapter,
+        config: CPLConfig,
+        ledger: CostLedger,
+    ) -> AsyncGenerator[RuntimeService, None]:
+        service = RuntimeService(
+            session_factory=session_factory,
+            event_bus=event_bus,
+            adapter_registry=FakeAdapterRegistry(recording_adapter),
+            config=config,
+            cost_ledger=ledger,
+        )
+        yield service
+        await service.shutdown()
+        await asyncio.sleep(0.05)
+
+    async def test_soft_budget_starts_job_on_downgrade_model(
+        self,
+        budget_runtime: RuntimeService,
+        ledger: CostLedger,
+        recording_adapter: RecordingAgentAdapter,
+        session_factory: async_sessionmaker[AsyncSession],
+        config: CPLConfig,
+    ) -> None:
+        _spend_premium(ledger, 9)
+        job = _make_job(repo=config.repos[0])
+        await _create_db_job(session_factory, job)
+
+        await budget_runtime.start_or_enqueue(job)
+
+        await _wait_until(lambda: bool(recording_adapter.configs), msg="session not created")
+        assert recording_adapter.configs[0].model == "gpt-4o-mini"
+
+    async def test_exhausted_month_pauses_running_jobs(
+        self,
+        budget_runtime: RuntimeService,
+        session_factory: async_sessionmaker[AsyncSession],
+        config: CPLConfig,
+        monkeypatch: pytest.MonkeyPatch,
+    ) -> None:
+        pause = AsyncMock(return_value=True)
+        monkeypatch.setattr(budget_runtime, "pause_job", pause)
+        job = _make_job(repo=config.repos[0])
+        await _create_db_job(session_factory, job)
+        await budget_runtime.start_or_enqueue(job)
+        assert budget_runtime.running_count == 1
+
+        await budget_runtime._record_usage(job.id, {"premium_requests": 10})
+        await budget_runtime._record_usage(job.id, {"premium_requests": 1})
+
+        await _wait_until(lambda: pause.await_count > 0, msg="job not paused")
+        pause.assert_awaited_once_with(job.id)
+
+    async def test_exhausted_budget_holds_job_until_month_rolls_over(
+        self,
+        budget_runtime: RuntimeService,
+        ledger: CostLedger,
+        recording_adapter: RecordingAgentAdapter,
+        session_factory: async_sessionmaker[AsyncSession],
+        config: CPLConfig,
+        monkeypatch: pytest.MonkeyPatch,
+    ) -> None:
+        _spend_premium(ledger, 10)
+        job = _make_job(repo=config.repos[0])
+        await _create_db_job(session_factory, job)
+
+        await budget_runtime.start_or_enqueue(job)
+        assert budget_runtime.running_count == 0
+        assert budget_runtime._budget_wakeup is not None  # armed for the month boundary
+
+        # Nothing else finishes; the rollover alone must start the held job.
+        monkeypatch.setattr("backend.services.cost_ledger.current_month", lambda now=None: "2999-01")
+        assert ledger.exhausted_sdks() == set()  # first read of the new month rolls the ledger over
+        await _wait_until(lambda: bool(recording_adapter.configs), msg="held job not released on rollover")
+        assert recording_adapter.configs[0].model != "gpt-4o-mini"
+
+    async def test_raising_budget_releases_held_job(
+        self,
+        budget_runtime: RuntimeService,
+        ledger: CostLedger,
+        recording_adapter: RecordingAgentAdapter,
+        session_factory: async_sessionmaker[AsyncSession],
+        config: CPLConfig,
+    ) -> None:
+        _spend_premium(ledger, 10)
+        job = _make_job(repo=config.repos[0])
+        await _create_db_job(session_factory, job)
+        await budget_runtime.start_or_enqueue(job)
+        assert budget_runtime.running_count == 0
+
+        updated = CPLConfig(repos=config.repos)
+        updated.telemetry.copilot_premium_entitlement = 100
+        budget_runtime.apply_config(updated)
+
+        await _wait_until(lambda: bool(recording_adapter.configs), msg="held job not released after cap change")
+        assert ledger.month_status("copilot") is BudgetStatus.ok
+
+
 # ---------------------------------------------------------------------------
 # RuntimeService — shutdown
 # ---------------------------------------------------------------------------
@@ -1172,6 +1296,74 @@ class TestShutdown:
         assert runtime.running_count == 0
 
 
+class TestStageSpans:
+    async def _internal_spans(self, session_factory: async_sessionmaker[AsyncSession], job_id: str) -> list[str]:
+        from backend.persistence.telemetry_spans_repo import TelemetrySpansRepo
+
+        async with session_factory() as session:
+            spans = await TelemetrySpansRepo(session).list_for_job(job_id)
+        return [s["name"] for s in spans if s["span_type"] == "internal"]
+
+    async def test_stage_spans_are_written_together_at_job_end(
+        self, runtime: RuntimeService, session_factory: async_sessionmaker[AsyncSession], config: CPLConfig
+    ) -> None:
+        job = _make_job(repo=config.repos[0])
+        await _create_db_job(session_factory, job)
+
+        await runtime.start_or_enqueue(job)
+        await _wait_until(lambda: runtime.running_count == 0, msg="job did not complete")
+
+        names = await self._internal_spans(session_factory, job.id)
+        assert {"environment_setup", "finalization"} <= set(names)
+        assert job.id not in runtime._stage_spans
+
+    async def test_shutdown_flushes_buffered_stage_spans(
+        self, runtime: RuntimeService, session_factory: async_sessionmaker[AsyncSession], config: CPLConfig
+    ) -> None:
+        await _create_db_job(session_factory, _make_job(repo=config.repos[0]))
+        runtime._span_origins["job-1"] = time.monotonic()
+        runtime._record_stage("job-1", "approval_wait", time.monotonic())
+        runtime._record_stage("job-1", "diff_update", time.monotonic())
+        assert await self._internal_spans(session_factory, "job-1") == []  # buffered, not yet written
+
+        await runtime.shutdown()
+
+        assert sorted(await self._internal_spans(session_factory, "job-1")) == ["approval_wait", "diff_update"]
+        assert runtime._stage_flush_task is not None and runtime._stage_flush_task.done()
+
+
+class TestHeartbeat:
+    async def test_one_heartbeat_per_tick_for_all_running_jobs(
+        self, runtime: RuntimeService, event_bus: EventBus, monkeypatch: pytest.MonkeyPatch
+    ) -> None:
+        monkeypatch.setattr("backend.services.runtime_service._HEARTBEAT_INTERVAL_S", 0.02)
+        beats: list[DomainEvent] = []
+
+        async def _collect(event: DomainEvent) -> None:
+            if event.kind == DomainEventKind.session_heartbeat:
+                beats.append(event)
+
+        event_bus.subscribe(_collect)
+        runtime._last_activity.update({"job-a": time.monotonic(), "job-b": time.monotonic()})
+        runtime._session_ids["job-a"] = "sess-a"
+        runtime._ensure_heartbeat()
+        runtime._ensure_heartbeat()  # already running — no second ticker
+        await _wait_until(lambda: len(beats) >= 2, msg="no heartbeat")
+
+        for beat in beats:
+            assert beat.job_id == ""
+            assert [(j["job_id"], j["session_id"]) for j in beat.payload["jobs"]] == [
+                ("job-a", "sess-a"),
+                ("job-b", ""),
+            ]
+
+        # The ticker stops once no job is running
+        runtime._last_activity.clear()
+        task = runtime._heartbeat_task
+        assert task is not None
+        await asyncio.wait_for(task, timeout=1)
+
+
 # ---------------------------------------------------------------------------
 # FakeAgentAdapter
 # ---------------------------------------------------------------------------
@@ -1512,6 +1704,87 @@ class TestRecoveryCapacity:
         assert pending_entry[1] == f"sdk-{pending_job_id}"
 
 
+class TestBackgroundRecovery:
+    async def test_start_recovery_returns_before_jobs_are_resumed(
+        self, runtime: RuntimeService, session_factory: async_sessionmaker[AsyncSession], config: CPLConfig
+    ) -> None:
+        gate = asyncio.Event()
+        resume = runtime._recover_active_job
+
+        async def _slow_recover(job_id: str, **kwargs: str) -> Job:
+            await gate.wait()
+            return await resume(job_id, **kwargs)
+
+        runtime._recover_active_job = _slow_recover  # type: ignore[method-assign]
+        await _create_db_job(session_factory, _make_job(repo=config.repos[0], state=JobState.running))
+
+        task = await runtime.start_recovery()
+        assert task is not None
+        progress = runtime.recovery_progress()
+        assert (progress.in_progress, progress.total, progress.recovered) == (True, 1, 0)
+
+        gate.set()
+        await task
+        assert (progress.in_progress, progress.recovered, progress.failed) == (False, 1, 0)
+
+    async def test_waiting_for_approval_jobs_recover_first_with_bounded_concurrency(
+        self, runtime: RuntimeService, session_factory: async_sessionmaker[AsyncSession], config: CPLConfig
+    ) -> None:
+        config.runtime.recovery_concurrency = 2
+        order: list[str] = []
+        running = 0
+        peak = 0
+
+        async def _recover(job_id: str) -> None:
+            nonlocal running, peak
+            order.append(job_id)
+            running += 1
+            peak = max(peak, running)
+            await asyncio.sleep(0.02)
+            running -= 1
+
+        runtime._recover_active_job = _recover  # type: ignore[method-assign,assignment]
+        for i in range(3):
+            await _create_db_job(
+                session_factory, _make_job(job_id=f"run-{i}", repo=config.repos[0], state=JobState.running)
+            )
+        await _create_db_job(
+            session_factory, _make_job(job_id="wait-1", repo=config.repos[0], state=JobState.waiting_for_approval)
+        )
+
+        await runtime.recover_on_startup()
+
+        assert order[0] == "wait-1"
+        assert sorted(order) == ["run-0", "run-1", "run-2", "wait-1"]
+        assert peak == 2
+
+    async def test_failed_job_does_not_stop_recovery(
+        self, runtime: RuntimeService, session_factory: async_sessionmaker[AsyncSession], config: CPLConfig
+    ) -> None:
+        recovered: list[str] = []
+
+        async def _recover(job_id: str) -> None:
+            if job_id == "bad":
+                raise StateConflictError("worktree could not be restored")
+            recovered.append(job_id)
+
+        runtime._recover_active_job = _recover  # type: ignore[method-assign,assignment]
+        for job_id in ("bad", "good"):
+            await _create_db_job(
+                session_factory, _make_job(job_id=job_id, repo=config.repos[0], state=JobState.running)
+            )
+
+        await runtime.recover_on_startup()
+
+        assert recovered == ["good"]
+        progress = runtime.recovery_progress()
+        assert (progress.total, progress.recovered, progress.failed) == (2, 1, 1)
+
+    async def test_nothing_to_recover(self, runtime: RuntimeService) -> None:
+        assert await runtime.start_recovery() is None
+        assert not runtime.recovery_progress().in_progress
+
+
 class TestJobStateChangedEvent:
     async def test_state_change_publishes_correct_event_kind(
         self,
@@ -0,0 +1,137 @@
+"""Tests for the SQLite connection profile, read/write engine split, maintenance loop and migration skip."""
+
+from __future__ import annotations
+
+import sqlite3
+from typing import TYPE_CHECKING
+
+import pytest
+from sqlalchemy import text
+from sqlalchemy.exc import OperationalError
+from structlog.testing import CapturingLogger
+
+from backend.config import DatabaseConfig
+from backend.persistence import sqlite_maintenance
+from backend.persistence.database import (
+    _alembic_head,
+    _sqlite_revision,
+    create_engine,
+    create_read_engine,
+    create_session_factory,
+    create_writer_engine,
+    run_migrations,
+)
+from backend.persistence.sqlite_maintenance import SqliteMaintenance
+
+if TYPE_CHECKING:
+    from pathlib import Path
+
+
+async def _pragma(engine: object, name: str) -> object:
+    async with engine.connect() as conn:  # type: ignore[attr-defined]
+        return (await conn.execute(text(f"PRAGMA {name}"))).scalar()
+
+
+@pytest.mark.asyncio
+async def test_connection_profile_applied(tmp_path: Path) -> None:
+    config = DatabaseConfig(cache_size_mb=8, mmap_size_mb=16)
+    engine = create_engine(tmp_path / "cp.db", config)
+    try:
+        assert await _pragma(engine, "journal_mode") == "wal"
+        assert await _pragma(engine, "synchronous") == 1  # NORMAL
+        assert await _pragma(engine, "temp_store") == 2  # MEMORY
+        assert await _pragma(engine, "cache_size") == -8 * 1024
+        assert await _pragma(engine, "mmap_size") == 16 * 1024 * 1024
+        assert await _pragma(engine, "foreign_keys") == 1
+    finally:
+        await engine.dispose()
+
+
+@pytest.mark.asyncio
+async def test_writer_commits_and_reader_rejects_writes(tmp_path: Path) -> None:
+    db = tmp_path / "cp.db"
+    writer = create_writer_engine(db)
+    reader = create_read_engine(db, DatabaseConfig(read_pool_size=2))
+    try:
+        async with create_session_factory(writer)() as session:
+            await session.execute(text("CREATE TABLE t (x INTEGER)"))
+            await session.execute(text("INSERT INTO t VALUES (1)"))
+            await session.commit()
+        # BEGIN IMMEDIATE: a rolled-back transaction leaves nothing behind
+        async with create_session_factory(writer)() as session:
+            await session.execute(text("INSERT INTO t VALUES (2)"))
+            await session.rollback()
+
+        async with create_session_factory(reader)() as session:
+            assert (await session.execute(text("SELECT COUNT(*) FROM t"))).scalar() == 1
+            with pytest.raises(OperationalError, match="readonly"):
+                await session.execute(text("INSERT INTO t VALUES (3)"))
+    finally:
+        await reader.dispose()
+        await writer.dispose()
+
+
+@pytest.mark.asyncio
+async def test_maintenance_checkpoint_and_wal_warning(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    captured = CapturingLogger()
+    monkeypatch.setattr(sqlite_maintenance, "log", captured)
+    db = tmp_path / "cp.db"
+    engine = create_engine(db)
+    maintenance = SqliteMaintenance(engine, db, DatabaseConfig(wal_warn_mb=1))
+    try:
+        async with engine.begin() as conn:
+            await conn.execute(text("CREATE TABLE t (x TEXT)"))
+            for i in range(30):
+                await conn.execute(text("INSERT INTO t VALUES (:x)"), {"x": str(i % 10) * 100_000})
+        assert maintenance.wal_bytes > 1024 * 1024
+
+        busy, frames, done = await maintenance.checkpoint()
+        assert busy == 0
+        assert frames == done
+
+        await maintenance.optimize(on_open=True)
+        await maintenance.optimize()
+        # A passive checkpoint does not shrink the file, so the WAL stays oversized
+        await maintenance.run_once()
+        await maintenance.run_once()
+    finally:
+        await engine.dispose()
+
+    warnings = [c for c in captured.calls if c.method_name == "warning"]
+    assert [c.args for c in warnings] == [("sqlite_wal_oversized",)]
+    assert warnings[0].kwargs["wal_mb"] >= 1
+
+    missing = SqliteMaintenance(engine, tmp_path / "absent.db", DatabaseConfig())
+    assert missing.wal_bytes == 0
+
+
+def test_migrations_skipped_when_database_is_at_head(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    from alembic import command
+
+    db_path = tmp_path / "cp.db"
+    assert _sqlite_revision(db_path) is None
+    run_migrations(db_path=db_path)
+    head = _alembic_head()
+    assert head is not None
+    assert _sqlite_revision(db_path) == head
+
+    upgrades: list[str] = []
+    monkeypatch.setattr(command, "upgrade", lambda cfg, rev: upgrades.append(rev))
+    run_migrations(db_path=db_path)
+    assert upgrades == []
+
+    # A database stamped at an older revision still goes through alembic
+    with sqlite3.connect(db_path) as conn:
+        conn.execute("UPDATE alembic_version SET version_num = '0001'")
+    run_migrations(db_path=db_path)
+    assert upgrades == ["head"]
+
+
+def test_alembic_head_requires_a_single_head(tmp_path: Path) -> None:
+    versions = tmp_path / "versions"
+    versions.mkdir()
+    (versions / "a.py").write_text('revision = "a"\ndown_revision = None\n')
+    (versions / "b.py").write_text('revision: str = "b"\ndown_revision = "a"\n')
+    assert _alembic_head(tmp_path) == "b"
+    (versions / "c.py").write_text('revision = "c"\ndown_revision = "a"\n')
+    assert _alembic_head(tmp_path) is None
@@ -2,6 +2,7 @@
 
 from __future__ import annotations
 
+import asyncio
 import json
 from datetime import UTC, datetime, timedelta
 from unittest.mock import AsyncMock
@@ -9,15 +10,19 @@ from unittest.mock import AsyncMock
 import pytest
 
 from backend.models.api_schemas import SnapshotPayload
-from backend.models.domain import Job
+from backend.models.domain import Job, JobSummary
 from backend.models.events import DomainEvent, DomainEventKind
+from backend.persistence.job_repo import decode_job_cursor
 from backend.services.sse_manager import (
+    KEEPALIVE_FRAME,
     MAX_REPLAY_AGE,
     MAX_REPLAY_EVENTS,
+    SNAPSHOT_CHUNK_JOBS,
     SSEConnection,
     SSEManager,
     _build_sse_data,
     _format_sse,
+    parse_sse_frame,
 )
 
 
@@ -455,7 +460,7 @@ class TestSSEManager:
         event_repo.list_latest_progress_previews.return_value = {}
 
         job_repo = AsyncMock()
-        job_repo.list.return_value = [_make_job_domain()]
+        job_repo.list_summaries.return_value = [JobSummary.from_job(_make_job_domain())]
 
         await mgr.replay_events(conn, event_repo, job_repo, last_event_id=0)
 
@@ -490,7 +495,7 @@ class TestSSEManager:
         event_repo.list_latest_progress_previews.return_value = {}
 
         job_repo = AsyncMock()
-        job_repo.list.return_value = [_make_job_domain()]
+        job_repo.list_summaries.return_value = [JobSummary.from_job(_make_job_domain())]
 
         await mgr.replay_events(conn, event_repo, job_repo, last_event_id=0)
 
@@ -631,8 +636,9 @@ class TestSSEManager:
 
         # First frame is a snapshot
         assert "event: snapshot" in frames[0]
-        # Snapshot should contain the scoped job
+        # Snapshot should contain the scoped job, and say it is scoped
         assert "job-1" in frames[0]
+        assert '"jobId":"job-1"' in frames[0]
 
     @pytest.mark.asyncio
     async def test_replay_scoped_connection_missing_job(self) -> None:
@@ -670,6 +676,51 @@ class TestSSEManager:
         assert "event: snapshot" in frames[0]
         assert '"jobs": []' in frames[0] or '"jobs":[]' in frames[0]
 
+    @pytest.mark.asyncio
+    async def test_global_snapshot_streams_compact_chunks(self) -> None:
+        """A large fleet arrives as several prompt-free frames; approvals come with the last."""
+        mgr = SSEManager()
+        conn = SSEConnection()
+        mgr.register(conn)
+
+        old = datetime.now(UTC) - MAX_REPLAY_AGE - timedelta(minutes=1)
+        event_repo = AsyncMock()
+        event_repo.list_after.return_value = [
+            DomainEvent(event_id="evt-old", job_id="job-1", timestamp=old, kind=DomainEventKind.job_created, payload={})
+        ]
+        event_repo.list_latest_progress_previews.return_value = {}
+
+        fleet = [JobSummary.from_job(_make_job_domain(f"job-{i}")) for i in range(SNAPSHOT_CHUNK_JOBS + 10)]
+
+        async def pages(limit: int, cursor: str | None, include_archived: bool | None) -> list[JobSummary]:
+            assert include_archived is False
+            after = decode_job_cursor(cursor) if cursor else None
+            start = 0 if after is None else next(i for i, j in enumerate(fleet) if j.id == after[1]) + 1
+            return fleet[start : start + limit]
+
+        job_repo = AsyncMock()
+        job_repo.list_summaries.side_effect = pages
+        approval_repo = AsyncMock()
+        approval_repo.list_pending.return_value = []
+
+        await mgr.replay_events(conn, event_repo, job_repo, last_event_id=0, approval_repo=approval_repo)
+
+        snapshots = []
+        while not conn.queue.empty():
+            frame = conn.queue.get_nowait()
+            if frame.startswith("event: snapshot"):
+                snapshots.append(json.loads(frame.split("data: ", 1)[1].split("\n")[0]))
+
+        assert [(s["chunk"], s["final"], len(s["jobs"])) for s in snapshots] == [
+            (0, False, SNAPSHOT_CHUNK_JOBS),
+            (1, True, 10),
+        ]
+        jobs = [job for s in snapshots for job in s["jobs"]]
+        assert all("prompt" not in job and job["promptPreview"] == "Fix the bug" for job in jobs)
+        assert [j["id"] for j in jobs] == [j.id for j in fleet]
+        approval_repo.list_pending.assert_called_once_with(job_id=None)
+        job_repo.list.assert_not_called()
+
     @pytest.mark.asyncio
     async def test_replay_snapshot_includes_pending_approvals(self) -> None:
         """Snapshot sent to a reconnecting client includes pending approvals."""
@@ -891,3 +942,103 @@ class TestReplayDerivedFrames:
         # rejected → failed
         assert '"failed"' in frames[1] or "failed" in frames[1]
         assert "id: 20\n" in frames[1]
+
+
+class TestHeartbeat:
+    @pytest.mark.asyncio
+    async def test_fleet_heartbeat_routing(self) -> None:
+        """One runtime-wide frame reaches global streams (even in selective mode) and listed jobs' streams."""
+        mgr = SSEManager()
+        mgr.set_active_job_count(25)
+        global_conn, listed, unlisted = SSEConnection(), SSEConnection(job_id="job-1"), SSEConnection(job_id="job-9")
+        for conn in (global_conn, listed, unlisted):
+            mgr.register(conn)
+
+        jobs = [
+            {"job_id": "job-1", "session_id": "sess-1", "idle_s": 2.5},
+            {"job_id": "job-2", "session_id": "", "idle_s": 0.0},
+        ]
+        await mgr.broadcast_domain_event(
+            _make_event(kind=DomainEventKind.session_heartbeat, job_id="", payload={"jobs": jobs})
+        )
+
+        assert unlisted.queue.empty()
+        frame = global_conn.queue.get_nowait()
+        assert frame == listed.queue.get_nowait()
+        assert frame.startswith("event: session_heartbeat\n")  # no id: — never persisted
+        parsed = json.loads(frame.split("data: ", 1)[1])
+        assert [j["jobId"] for j in parsed["jobs"]] == ["job-1", "job-2"]
+        assert parsed["jobs"][0]["idleS"] == 2.5
+        await mgr.close_all()
+
+    @pytest.mark.asyncio
+    async def test_keepalive_only_for_idle_connections(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        monkeypatch.setattr("backend.services.sse_manager.KEEPALIVE_IDLE_S", 0.04)
+        mgr = SSEManager()
+        idle, busy, closed = SSEConnection(), SSEConnection(), SSEConnection()
+        for conn in (idle, busy, closed):
+            mgr.register(conn)
+        closed.close()
+        for _ in range(6):
+            await busy.send("event: log_line\ndata: {}\n\n")
+            await asyncio.sleep(0.01)
+        await asyncio.sleep(0.03)
+
+        assert idle.queue.get_nowait() == KEEPALIVE_FRAME
+        assert all(busy.queue.get_nowait().startswith("event: log_line") for _ in range(6))
+        # A closed stream's reader is woken so it can exit
+        assert closed.queue.get_nowait() == KEEPALIVE_FRAME
+        await mgr.close_all()
+
+
+class TestCollectSince:
+    """Long-poll for clients that cannot hold an SSE stream (MCP ``events``)."""
+
+    @staticmethod
+    def _fake_replay(mgr: SSEManager, monkeypatch: pytest.MonkeyPatch, after: list[int]) -> dict[str, bool]:
+        state = {"ready": False}
+
+        async def _replay(conn: SSEConnection, _factory: object, last_event_id: int) -> None:
+            after.append(last_event_id)
+            if state["ready"]:
+                await conn.send(_format_sse("7", "log_line", '{"message": "hi"}'))
+
+        monkeypatch.setattr(mgr, "replay_from_factory", _replay)
+        return state
+
+    @pytest.mark.asyncio
+    async def test_returns_missed_frames_without_waiting(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        mgr = SSEManager()
+        after: list[int] = []
+        self._fake_replay(mgr, monkeypatch, after)["ready"] = True
+        frames = await mgr.collect_since(object(), 5, wait_s=30)
+        assert parse_sse_frame(frames[0]) == ("7", "log_line", '{"message": "hi"}')
+        assert after == [5]
+        assert mgr.connection_count == 0
+
+    @pytest.mark.asyncio
+    async def test_live_broadcast_wakes_the_wait(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        mgr = SSEManager()
+        after: list[int] = []
+        state = self._fake_replay(mgr, monkeypatch, after)
+        task = asyncio.create_task(mgr.collect_since(object(), 5, job_id="job-1", wait_s=30))
+        await asyncio.sleep(0.02)
+        assert not task.done()
+        state["ready"] = True
+        await mgr.broadcast_domain_event(_make_event(kind=DomainEventKind.log_line_emitted, db_id=7))
+        frames = await asyncio.wait_for(task, timeout=0.5)
+        assert len(frames) == 1
+        assert after == [5, 5]
+        await mgr.close_all()
+
+    @pytest.mark.asyncio
+    async def test_times_out_empty(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        mgr = SSEManager()
+        self._fake_replay(mgr, monkeypatch, [])
+        assert await mgr.collect_since(object(), 5, wait_s=0.05) == []
+        assert mgr.connection_count == 0
+        await mgr.close_all()
+
+    def test_parse_sse_frame(self) -> None:
+        assert parse_sse_frame(_format_sse(None, "snapshot", '{"a": "b: c"}')) == (None, "snapshot", '{"a": "b: c"}')
+        assert parse_sse_frame(": comment\n\n") is None
@@ -0,0 +1,164 @@
+"""Tests for the streaming (per-job) statistical analysis detectors."""
+
+from __future__ import annotations
+
+from datetime import UTC, datetime
+from typing import TYPE_CHECKING, Any
+
+import pytest
+from sqlalchemy import event as sa_event
+from sqlalchemy import text
+from sqlalchemy.ext.asyncio import AsyncSession, async_sessionmaker, create_async_engine
+
+if TYPE_CHECKING:
+    from collections.abc import AsyncGenerator
+
+from backend.models.db import Base, JobRow
+from backend.models.domain import JobState, PermissionMode
+from backend.persistence.analysis_counters_repo import AnalysisCountersRepo
+from backend.persistence.database import _set_sqlite_pragmas
+from backend.persistence.file_access_repo import FileAccessRepo
+from backend.persistence.observations_repo import ObservationsRepo
+from backend.persistence.telemetry_spans_repo import TelemetrySpansRepo
+from backend.persistence.telemetry_summary_repo import TelemetrySummaryRepo
+from backend.services.statistical_analysis import run_analysis, update_for_job
+
+_JOBS = ("job-1", "job-2", "job-3")
+
+
+@pytest.fixture
+async def session() -> AsyncGenerator[AsyncSession, None]:
+    engine = create_async_engine("sqlite+aiosqlite:///:memory:")
+    sa_event.listen(engine.sync_engine, "connect", _set_sqlite_pragmas)
+    async with engine.begin() as conn:
+        await conn.run_sync(Base.metadata.create_all)
+
+    factory = async_sessionmaker(engine, expire_on_commit=False)
+    async with factory() as sess:
+        now = datetime.now(UTC)
+        for job_id in _JOBS:
+            sess.add(
+                JobRow(
+                    id=job_id,
+                    repo="/repos/test",
+                    prompt="Fix the bug",
+                    state=JobState.running,
+                    base_ref="main",
+                    permission_mode=PermissionMode.full_auto,
+                    sdk="copilot",
+                    created_at=now,
+                    updated_at=now,
+                )
+            )
+        await sess.commit()
+        for job_id in _JOBS:
+            await TelemetrySummaryRepo(sess).init_job(job_id, sdk="copilot", model="gpt-4o")
+        await sess.commit()
+        yield sess
+
+    await engine.dispose()
+
+
+async def _tool_calls(session: AsyncSession, job_id: str, *, calls: int, failures: int) -> None:
+    repo = TelemetrySpansRepo(session)
+    for i in range(calls):
+        await repo.insert(
+            job_id=job_id,
+            span_type="tool",
+            name="bash",
+            started_at=float(i),
+            duration_ms=5.0,
+            attrs={"success": i >= failures},
+        )
+
+
+async def _observations(session: AsyncSession, category: str) -> list[dict[str, Any]]:
+    return await ObservationsRepo(session).list_active(category=category)
+
+
+@pytest.mark.asyncio
+async def test_tool_failure_builds_up_across_jobs(session: AsyncSession) -> None:
+    await _tool_calls(session, "job-1", calls=6, failures=3)
+    assert await update_for_job(session, "job-1") == 0  # below 10 calls
+
+    await _tool_calls(session, "job-2", calls=6, failures=0)
+    assert await update_for_job(session, "job-2") == 1
+
+    [obs] = await _observations(session, "tool_failure")
+    assert obs["evidence"] == {
+        "tool_name": "bash",
+        "total_calls": 12,
+        "failures": 3,
+        "failure_rate_pct": 25.0,
+        "job_count": 2,
+    }
+
+
+@pytest.mark.asyncio
+async def test_refolding_a_job_does_not_double_count(session: AsyncSession) -> None:
+    await _tool_calls(session, "job-1", calls=12, failures=6)
+    await update_for_job(session, "job-1")
+    # Resumed job: more spans, then finalized again.
+    await _tool_calls(session, "job-1", calls=2, failures=0)
+    await update_for_job(session, "job-1")
+
+    totals = await AnalysisCountersRepo(session).window_totals("tool_failure", "bash")
+    assert totals["events"] == 14
+    assert totals["hits"] == 6
+    assert totals["jobs"] == 1
+
+
+@pytest.mark.asyncio
+async def test_streaming_matches_full_rescan(session: AsyncSession) -> None:
+    files = FileAccessRepo(session)
+    for job_id in _JOBS:
+        for _ in range(4):
+            await files.record(job_id=job_id, file_path="src/app.py", access_type="read", byte_count=100)
+        await update_for_job(session, job_id)
+    streamed = await _observations(session, "file_reread")
+
+    await session.execute(text("DELETE FROM cost_observations"))
+    await run_analysis(session)
+    rescanned = await _observations(session, "file_reread")
+
+    assert len(streamed) == 1
+    assert streamed[0]["evidence"] == rescanned[0]["evidence"]
+    assert streamed[0]["evidence"]["total_reads"] == 12
+
+
+@pytest.mark.asyncio
+async def test_turn_escalation_needs_three_jobs(session: AsyncSession) -> None:
+    summaries = TelemetrySummaryRepo(session)
+    for n, job_id in enumerate(_JOBS):
+        await summaries.increment(job_id, total_turns=8)
+        await summaries.set_turn_stats(job_id, cost_first_half_usd=0.1, cost_second_half_usd=0.5 + n)
+        written = await update_for_job(session, job_id)
+
+    assert written == 1
+    [obs] = await _observations(session, "turn_escalation")
+    assert obs["job_count"] == 3
+    assert [j["job_id"] for j in obs["evidence"]["affected_jobs"]] == ["job-3", "job-2", "job-1"]
+
+
+@pytest.mark.asyncio
+async def test_prune_drops_days_outside_the_window(session: AsyncSession) -> None:
+    await _tool_calls(session, "job-1", calls=4, failures=1)
+    await update_for_job(session, "job-1")
+    await session.execute(
+        text("""
+            INSERT INTO analysis_counters (detector, key, day, events, hits, amount, jobs, updated_at)
+            VALUES ('tool_failure', 'bash', '2000-01-01', 9, 9, 0, 1, '2000-01-01')
+        """)
+    )
+    await session.execute(
+        text("""
+            INSERT INTO analysis_job_contributions (job_id, detector, key, day, events, hits, amount)
+            VALUES ('job-2', 'tool_failure', 'bash', '2000-01-01', 9, 9, 0)
+        """)
+    )
+
+    assert await AnalysisCountersRepo(session).prune_expired() == 1
+    days = (await session.execute(text("SELECT DISTINCT day FROM analysis_counters"))).scalars().all()
+    assert days == [datetime.now(UTC).date().isoformat()]
+    owners = (await session.execute(text("SELECT DISTINCT job_id FROM analysis_job_contributions"))).scalars().all()
+    assert owners == ["job-1"]
@@ -0,0 +1,139 @@
+"""Tests for StepDiffCache — persistent, content-addressed step diffs."""
+
+from __future__ import annotations
+
+import asyncio
+from datetime import UTC, datetime
+from typing import TYPE_CHECKING
+from unittest.mock import AsyncMock, MagicMock
+
+import pytest
+
+from backend.models.events import DomainEvent, DomainEventKind
+from backend.services.step_diff_cache import StepDiffCache, cache_key
+
+if TYPE_CHECKING:
+    from pathlib import Path
+
+_A = "a" * 40
+_B = "b" * 40
+_DIFF = (
+    "diff --git a/x.py b/x.py\n"
+    "--- a/x.py\n"
+    "+++ b/x.py\n"
+    "@@ -1,1 +1,1 @@\n"
+    "-old\n"
+    "+new\n"
+    "diff --git a/y.py b/y.py\n"
+    "new file mode 100644\n"
+    "--- /dev/null\n"
+    "+++ b/y.py\n"
+    "@@ -0,0 +1,1 @@\n"
+    "+added\n"
+)
+
+
+def _git_service(diff: str = _DIFF) -> MagicMock:
+    git = MagicMock()
+    git.diff_range = AsyncMock(return_value=diff)
+    return git
+
+
+def _cache(tmp_path: Path, git: MagicMock, session_factory: MagicMock | None = None) -> StepDiffCache:
+    return StepDiffCache(git, session_factory or MagicMock(), cache_dir=tmp_path / "cache")
+
+
+@pytest.mark.asyncio
+async def test_computes_once_and_persists(tmp_path: Path) -> None:
+    git = _git_service()
+    first = await _cache(tmp_path, git).get("/repo", "/wt", _A, _B)
+    assert first.files_changed == 2
+    assert [f.path for f in first.changed_files] == ["x.py", "y.py"]
+
+    # A fresh instance (i.e. after a restart) reads the stored result
+    again = await _cache(tmp_path, git).get("/repo", "/wt-other", _A, _B)
+    assert again == first
+    git.diff_range.assert_awaited_once_with(_A, _B, cwd="/wt", paths=())
+
+
+@pytest.mark.asyncio
+async def test_key_covers_repo_and_path_filter(tmp_path: Path) -> None:
+    git = _git_service()
+    cache = _cache(tmp_path, git)
+    await cache.get("/repo", "/wt", _A, _B)
+    await cache.get("/other", "/wt", _A, _B)
+    await cache.get("/repo", "/wt", _A, _B, paths=["x.py"])
+    assert git.diff_range.await_count == 3
+    assert cache_key("/repo", _A, _B, ["b", "a"]) == cache_key("/repo", _A, _B, ["a", "b"])
+
+
+@pytest.mark.asyncio
+async def test_concurrent_requests_share_one_git_call(tmp_path: Path) -> None:
+    gate = asyncio.Event()
+    git = _git_service()
+
+    async def slow_diff(*_args: object, **_kwargs: object) -> str:
+        await gate.wait()
+        return _DIFF
+
+    git.diff_range.side_effect = slow_diff
+    cache = _cache(tmp_path, git)
+    tasks = [asyncio.create_task(cache.get("/repo", "/wt", _A, _B)) for _ in range(3)]
+    await asyncio.sleep(0.01)
+    gate.set()
+    results = await asyncio.gather(*tasks)
+    assert git.diff_range.await_count == 1
+    assert all(r == results[0] for r in results)
+
+
+@pytest.mark.asyncio
+async def test_non_immutable_refs_bypass_cache(tmp_path: Path) -> None:
+    git = _git_service()
+    cache = _cache(tmp_path, git)
+    await cache.get("/repo", "/wt", "HEAD~1", "HEAD")
+    await cache.get("/repo", "/wt", "HEAD~1", "HEAD")
+    assert git.diff_range.await_count == 2
+    assert not (tmp_path / "cache").exists()
+    assert (await cache.get("/repo", "/wt", _A, _A)).diff == ""
+
+
+@pytest.mark.asyncio
+async def test_corrupt_entry_is_recomputed(tmp_path: Path) -> None:
+    git = _git_service()
+    cache = _cache(tmp_path, git)
+    await cache.get("/repo", "/wt", _A, _B)
+    key = cache_key("/repo", _A, _B)
+    (tmp_path / "cache" / key[:2] / f"{key}.json.gz").write_bytes(b"garbage")
+    result = await _cache(tmp_path, git).get("/repo", "/wt", _A, _B)
+    assert result.files_changed == 2
+    assert git.diff_range.await_count == 2
+
+
+@pytest.mark.asyncio
+async def test_completed_step_event_prefetches(tmp_path: Path) -> None:
+    git = _git_service()
+    session = AsyncMock()
+    job = MagicMock(repo="/repo", worktree_path="/wt")
+    session_factory = MagicMock()
+    session_factory.return_value.__aenter__ = AsyncMock(return_value=session)
+    session_factory.return_value.__aexit__ = AsyncMock(return_value=False)
+    cache = _cache(tmp_path, git, session_factory)
+
+    def _event(kind: DomainEventKind, **payload: object) -> DomainEvent:
+        return DomainEvent(event_id="evt-1", job_id="job-1", timestamp=datetime.now(UTC), kind=kind, payload=payload)
+
+    with pytest.MonkeyPatch.context() as mp:
+        mp.setattr(
+            "backend.services.step_diff_cache.JobRepository",
+            lambda _session: MagicMock(get=AsyncMock(return_value=job)),
+        )
+        await cache(_event(DomainEventKind.plan_step_updated, status="active", start_sha=_A, end_sha=_B))
+        await cache(_event(DomainEventKind.step_completed, start_sha=_A, end_sha=_A))
+        await cache(_event(DomainEventKind.step_completed, start_sha=_A, end_sha=_B))
+        await asyncio.sleep(0.05)
+        await cache.close()
+
+    git.diff_range.assert_awaited_once_with(_A, _B, cwd="/wt", paths=())
+    hit = await cache.get("/repo", "/elsewhere", _A, _B)
+    assert hit.files_changed == 2
+    assert git.diff_range.await_count == 1
@@ -10,7 +10,7 @@ if TYPE_CHECKING:
     from collections.abc import Generator
 
 import backend.services.auth as auth_mod
-from backend.services.auth import check_websocket_auth, set_password
+from backend.services.auth import check_websocket_auth, is_allowed_websocket_origin, set_password
 
 
 @pytest.fixture(autouse=True)
@@ -56,3 +56,17 @@ class TestCheckWebsocketAuth:
         token = auth_mod._create_session_token()
         assert check_websocket_auth(client_host=None, cookies={"cpl_session": token}) is True
         assert check_websocket_auth(client_host=None, cookies={}) is False
+
+
+class TestIsAllowedWebsocketOrigin:
+    def test_missing_and_local_origins_pass(self) -> None:
+        assert is_allowed_websocket_origin(None)
+        assert is_allowed_websocket_origin("http://localhost:5173")
+        assert is_allowed_websocket_origin("http://127.0.0.1:8080")
+
+    def test_foreign_origin_rejected_unless_configured(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        import backend.app_factory as app_factory
+
+        assert not is_allowed_websocket_origin("https://evil.example")
+        monkeypatch.setattr(app_factory, "_allowed_ws_origins", {"https://tunnel.example"})
+        assert is_allowed_websocket_origin("https://tunnel.example")
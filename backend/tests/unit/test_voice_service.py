@@ -2,9 +2,34 @@
 
 from __future__ import annotations
 
+import asyncio
+import io
+import json
+import sys
 from unittest.mock import MagicMock, patch
 
-from backend.services.voice_service import VoiceService
+import pytest
+
+from backend.config import VoiceConfig
+from backend.services.voice_service import VoiceBusyError, VoiceService
+from backend.services.voice_worker import _Request, _Worker, coalesce
+
+# Speaks the worker protocol without a model: echoes the audio back as text
+_FAKE_WORKER = """
+import json, sys
+out = sys.stdout.buffer
+out.write(b'{"ready": true}\\n'); out.flush()
+while header := sys.stdin.buffer.readline():
+    meta = json.loads(header)
+    audio = sys.stdin.buffer.read(meta["size"])
+    reply = {"id": meta["id"], "error": "bad audio"} if audio == b"bad" else {"id": meta["id"], "text": audio.decode()}
+    out.write(json.dumps(reply).encode() + b"\\n"); out.flush()
+"""
+
+
+def _frame(request_id: int, audio: bytes, *, stream: str | None = None, partial: bool = False) -> bytes:
+    header = {"id": request_id, "size": len(audio), "stream": stream, "partial": partial}
+    return json.dumps(header).encode() + b"\n" + audio
 
 
 class TestVoiceServiceInit:
@@ -52,3 +77,78 @@ class TestTranscribe:
         svc = VoiceService()
         result = svc.transcribe(b"")
         assert result == ""
+
+
+class TestWorker:
+    def test_coalesce_drops_superseded_partials_and_runs_finals_first(self) -> None:
+        pending = [
+            _Request(1, b"a", stream="s1", partial=True),
+            _Request(2, b"b", stream="s2", partial=True),
+            _Request(3, b"c", stream="s1", partial=True),
+            _Request(4, b"d"),
+        ]
+        keep, dropped = coalesce(pending)
+        assert [r.id for r in keep] == [4, 2, 3]
+        assert [r.id for r in dropped] == [1]
+
+    def test_serves_framed_requests(self) -> None:
+        service = MagicMock()
+        service.transcribe.side_effect = lambda audio: audio.decode().upper()
+        out = io.BytesIO()
+        stdin = io.BytesIO(_frame(1, b"hello") + _frame(2, b"world", stream="s", partial=True))
+        _Worker(service, 2, out).serve(stdin)
+        replies = {m["id"]: m for m in map(json.loads, out.getvalue().splitlines())}
+        assert replies == {1: {"id": 1, "text": "HELLO"}, 2: {"id": 2, "text": "WORLD"}}
+
+    def test_transcription_error_is_reported(self) -> None:
+        service = MagicMock()
+        service.transcribe.side_effect = ValueError("not audio")
+        out = io.BytesIO()
+        _Worker(service, 1, out).serve(io.BytesIO(_frame(7, b"x")))
+        assert json.loads(out.getvalue()) == {"id": 7, "error": "not audio"}
+
+
+class TestResidentWorkerClient:
+    @pytest.fixture
+    def fake_worker(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        spawn = asyncio.create_subprocess_exec
+
+        async def _spawn(*_args: object, **kwargs: object) -> asyncio.subprocess.Process:
+            return await spawn(sys.executable, "-c", _FAKE_WORKER, **kwargs)  # type: ignore[arg-type]
+
+        monkeypatch.setattr(asyncio, "create_subprocess_exec", _spawn)
+
+    @pytest.mark.asyncio
+    @pytest.mark.usefixtures("fake_worker")
+    async def test_concurrent_requests_share_one_worker(self) -> None:
+        svc = VoiceService(VoiceConfig())
+        await svc.start()
+        try:
+            proc = svc._proc
+            texts = await asyncio.gather(*(svc.submit(f"clip {i}".encode()) for i in range(5)))
+            assert texts == [f"clip {i}" for i in range(5)]
+            assert await svc.submit_partial("stream", b"so far") == "so far"
+            assert svc._proc is proc
+            with pytest.raises(RuntimeError, match="bad audio"):
+                await svc.submit(b"bad")
+        finally:
+            await svc.close()
+        assert proc is not None and proc.returncode is not None
+
+    @pytest.mark.asyncio
+    @pytest.mark.usefixtures("fake_worker")
+    async def test_started_on_first_request_without_preload(self) -> None:
+        svc = VoiceService(VoiceConfig(preload=False))
+        await svc.start()
+        assert svc._proc is None
+        try:
+            assert await svc.submit(b"late") == "late"
+        finally:
+            await svc.close()
+
+    @pytest.mark.asyncio
+    async def test_full_queue_is_refused(self) -> None:
+        svc = VoiceService(VoiceConfig(queue_limit=0))
+        with pytest.raises(VoiceBusyError):
+            await svc.submit(b"audio")
+        assert await svc.submit_partial("stream", b"audio") is None
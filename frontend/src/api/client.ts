@@ -299,6 +299,24 @@ export function fetchJobTelemetry(jobId: string): Promise<{
   return request(`/jobs/${encodeURIComponent(jobId)}/telemetry`);
 }
 
+export type WaterfallCategory = "approval" | "llm" | "tool" | "overhead" | "queue" | "idle";
+
+export interface JobWaterfall {
+  jobId: string;
+  startMs: number;
+  wallMs: number;
+  codeplaneMs: number;
+  codeplanePct: number;
+  breakdown: Record<WaterfallCategory, number>;
+  overheadStages: Record<string, number>;
+  bars: { name: string; category: WaterfallCategory; startMs: number; durationMs: number; criticalMs: number }[];
+  criticalPath: { category: WaterfallCategory; name: string; startMs: number; endMs: number }[];
+}
+
+export function fetchJobWaterfall(jobId: string): Promise<JobWaterfall> {
+  return request(`/jobs/${encodeURIComponent(jobId)}/telemetry/waterfall`);
+}
+
 // --- Analytics ---
 
 export interface AnalyticsOverview {
@@ -776,6 +794,22 @@ export interface ScorecardResponse {
   costTrend: { date: string; cost: number; jobs: number }[];
 }
 
+export interface BudgetLimitStatus {
+  sdk: string;
+  unit: "usd" | "premium_requests";
+  spent: number;
+  limit: number; // 0 = unlimited
+  status: "ok" | "soft" | "exhausted";
+}
+
+/** Live month-to-date spend from the server's in-memory cost ledger. */
+export interface BudgetSnapshot {
+  month: string;
+  totalCostUsd: number;
+  sdks: BudgetLimitStatus[];
+  repos: Record<string, number>;
+}
+
 export interface ModelComparisonRow {
   model: string;
   sdk: string;
@@ -853,6 +887,10 @@ export function fetchScorecard(period = 7): Promise<ScorecardResponse> {
   return request(`/analytics/scorecard?period=${period}`);
 }
 
+export function fetchBudget(): Promise<BudgetSnapshot> {
+  return request("/analytics/budget");
+}
+
 export function fetchModelComparison(
   period = 30,
   repo?: string,
@@ -1012,7 +1012,7 @@ export interface components {
         /** JobListResponse */
         JobListResponse: {
             /** Items */
-            items: components["schemas"]["JobResponse"][];
+            items: components["schemas"]["JobSummaryResponse"][];
             /** Cursor */
             cursor: string | null;
             /** Hasmore */
@@ -1079,6 +1079,72 @@ export interface components {
             /** Selfreviewprompt */
             selfReviewPrompt?: string | null;
         };
+        /**
+         * JobSummaryResponse
+         * @description A job as listed (``GET /jobs``, the fleet snapshot) — :class:`JobResponse` without prompt texts.
+         *
+         *     ``prompt_preview`` holds the first 200 characters of the prompt.
+         *     Clients fetch ``GET /api/jobs/{id}`` for the full job when it is opened.
+         */
+        JobSummaryResponse: {
+            /** Id */
+            id: string;
+            /** Repo */
+            repo: string;
+            /** Title */
+            title?: string | null;
+            /** State */
+            state: string;
+            /** Baseref */
+            baseRef: string;
+            /** Worktreepath */
+            worktreePath: string | null;
+            /** Branch */
+            branch: string | null;
+            permissionMode?: components["schemas"]["PermissionMode"] | null;
+            /**
+             * Createdat
+             * Format: date-time
+             */
+            createdAt: string;
+            /**
+             * Updatedat
+             * Format: date-time
+             */
+            updatedAt: string;
+            /** Completedat */
+            completedAt: string | null;
+            /** Prurl */
+            prUrl?: string | null;
+            /** Mergestatus */
+            mergeStatus?: string | null;
+            /** Resolution */
+            resolution?: string | null;
+            /** Archivedat */
+            archivedAt?: string | null;
+            /** Failurereason */
+            failureReason?: string | null;
+            /** Progressheadline */
+            progressHeadline?: string | null;
+            /** Progresssummary */
+            progressSummary?: string | null;
+            /** Model */
+            model?: string | null;
+            /**
+             * Sdk
+             * @default copilot
+             */
+            sdk: string;
+            /** Worktreename */
+            worktreeName?: string | null;
+            /** Parentjobid */
+            parentJobId?: string | null;
+            /**
+             * Promptpreview
+             * @default
+             */
+            promptPreview: string;
+        };
         /**
          * LogLevel
          * @enum {string}
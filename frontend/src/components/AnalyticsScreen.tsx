@@ -8,6 +8,7 @@ import {
 import { Tooltip } from "./ui/tooltip";
 import {
   fetchScorecard,
+  fetchBudget,
   fetchModelComparison,
   fetchAnalyticsTools,
   fetchAnalyticsRepos,
@@ -16,6 +17,7 @@ import {
   fetchObservations,
   dismissObservation,
   type ScorecardResponse,
+  type BudgetLimitStatus,
   type ModelComparisonResponse,
   type ModelComparisonRow,
   type AnalyticsTools,
@@ -24,6 +26,7 @@ import {
   type FleetCostDriversResponse,
   type Observation,
 } from "../api/client";
+import { useStore } from "../store";
 import { Badge } from "./ui/badge";
 import { Spinner } from "./ui/spinner";
 import {
@@ -111,10 +114,47 @@ function CollapsibleSection({
 // Budget card — adapts per SDK
 // ---------------------------------------------------------------------------
 
+function BudgetLimitBar({ limit }: { limit: BudgetLimitStatus }) {
+  const pct = (limit.spent / limit.limit) * 100;
+  const fmt = (n: number) => (limit.unit === "usd" ? formatUsd(n) : `${n.toFixed(0)} reqs`);
+  return (
+    <div>
+      <div className="flex items-center justify-between text-xs mb-1">
+        <span className="text-muted-foreground">{limit.sdk} monthly budget</span>
+        <span className={limit.status === "ok" ? "text-foreground" : "text-red-400 font-medium"}>
+          {fmt(limit.spent)} / {fmt(limit.limit)}
+        </span>
+      </div>
+      <div className="h-1.5 rounded-full bg-border overflow-hidden">
+        <div
+          className={`h-full rounded-full transition-all ${
+            limit.status === "exhausted" ? "bg-red-500" : limit.status === "soft" ? "bg-yellow-500" : "bg-green-500"
+          }`}
+          style={{ width: `${Math.min(pct, 100)}%` }}
+        />
+      </div>
+      {limit.status !== "ok" && (
+        <div className="flex items-center gap-1 mt-1 text-[11px] text-red-400">
+          <AlertTriangle size={11} />
+          {limit.status === "exhausted" ? "Budget exhausted — new jobs are held" : "Approaching budget limit"}
+        </div>
+      )}
+    </div>
+  );
+}
+
 function BudgetCard({ scorecard }: { scorecard: ScorecardResponse }) {
   const { budget, quotaJson } = scorecard;
   const totalCost = budget.reduce((s, b) => s + b.totalCostUsd, 0);
   const totalJobs = budget.reduce((s, b) => s + b.jobCount, 0);
+  // Live ledger state: seeded once, then kept current by budget_updated SSE events.
+  const live = useStore((s) => s.budget);
+  useEffect(() => {
+    fetchBudget()
+      .then((b) => useStore.setState({ budget: b }))
+      .catch(() => { /* budget endpoint optional */ });
+  }, []);
+  const limits = live?.sdks.filter((l) => l.limit > 0) ?? [];
 
   let quotaInfo: { pct: number } | null = null;
   if (quotaJson) {
@@ -168,6 +208,12 @@ function BudgetCard({ scorecard }: { scorecard: ScorecardResponse }) {
         ))}
       </div>
 
+      {limits.length > 0 && (
+        <div className="pt-2 border-t border-border space-y-2">
+          {limits.map((l) => <BudgetLimitBar key={l.sdk} limit={l} />)}
+        </div>
+      )}
+
       {quotaInfo && (
         <div className="pt-2 border-t border-border">
           <div className="flex items-center justify-between text-xs mb-1">
@@ -52,7 +52,7 @@ export function DashboardScreen() {
       .then((result) => {
         useStore.setState((state) => {
           const updated = { ...state.jobs };
-          for (const job of result.items) updated[job.id] = enrichJob(job as JobSummary);
+          for (const job of result.items) updated[job.id] = enrichJob({ ...updated[job.id], ...(job as JobSummary) });
           return { jobs: updated };
         });
       })
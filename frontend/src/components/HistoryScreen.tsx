@@ -35,7 +35,7 @@ export function HistoryScreen() {
       .then((result) => {
         useStore.setState((state) => {
           const updated = { ...state.jobs };
-          for (const job of result.items) updated[job.id] = enrichJob(job as JobSummary);
+          for (const job of result.items) updated[job.id] = enrichJob({ ...updated[job.id], ...(job as JobSummary) });
           return { jobs: updated };
         });
         setCursor(result.cursor);
@@ -51,7 +51,7 @@ export function HistoryScreen() {
       const result = await fetchJobs({ state: "succeeded,failed,canceled", limit: 50, cursor, archived: true } as Parameters<typeof fetchJobs>[0]);
       useStore.setState((state) => {
         const updated = { ...state.jobs };
-        for (const job of result.items) updated[job.id] = enrichJob(job as JobSummary);
+        for (const job of result.items) updated[job.id] = enrichJob({ ...updated[job.id], ...(job as JobSummary) });
         return { jobs: updated };
       });
       setCursor(result.cursor);
@@ -4,7 +4,7 @@ import {
   AlertTriangle, ArrowDownUp, ChevronDown, ChevronRight,
   BarChart3, BookOpen, CheckCircle, XCircle, Zap, TrendingUp,
 } from "lucide-react";
-import { fetchJobTelemetry, fetchArtifacts, fetchArtifactContent, fetchJobContext, fetchSisterSessionMetrics, type JobContextResponse, type SisterSessionMetrics } from "../api/client";
+import { fetchJobTelemetry, fetchJobWaterfall, fetchArtifacts, fetchArtifactContent, fetchJobContext, fetchSisterSessionMetrics, type JobContextResponse, type JobWaterfall, type SisterSessionMetrics, type WaterfallCategory } from "../api/client";
 import { Badge } from "./ui/badge";
 import { Progress } from "./ui/progress";
 import { Spinner } from "./ui/spinner";
@@ -1130,6 +1130,9 @@ export function MetricsPanel({ jobId, isRunning = false }: { jobId: string; isRu
                 </div>
               )}
 
+              {/* Where wall-clock time went: model vs tools vs approvals vs CodePlane */}
+              <ExecutionWaterfall jobId={jobId} />
+
               {/* Sister session (utility LLM) metrics for this job */}
               <SisterSessionJobMetrics jobId={jobId} />
             </>
@@ -1192,6 +1195,111 @@ function SisterSessionJobMetrics({ jobId }: { jobId: string }) {
   );
 }
 
+const WATERFALL_LANES: { category: WaterfallCategory; label: string; color: string }[] = [
+  { category: "llm", label: "LLM", color: "bg-blue-400" },
+  { category: "tool", label: "Tools", color: "bg-emerald-400" },
+  { category: "approval", label: "Approval", color: "bg-yellow-400" },
+  { category: "overhead", label: "CodePlane", color: "bg-red-400" },
+  { category: "queue", label: "Queue", color: "bg-orange-400" },
+];
+
+function ExecutionWaterfall({ jobId }: { jobId: string }) {
+  const [waterfall, setWaterfall] = useState<JobWaterfall | null>(null);
+  const [expanded, setExpanded] = useState(false);
+  const telemetryVersion = useStore((s) => s.telemetryVersions[jobId] ?? 0);
+  useEffect(() => {
+    let cancelled = false;
+    fetchJobWaterfall(jobId)
+      .then((w) => { if (!cancelled) setWaterfall(w); })
+      .catch(() => {});
+    return () => { cancelled = true; };
+  }, [jobId, telemetryVersion]);
+
+  if (!waterfall || waterfall.wallMs <= 0) return null;
+
+  const pct = (ms: number) => `${(ms / waterfall.wallMs) * 100}%`;
+  const at = (ms: number) => pct(ms - waterfall.startMs);
+  const lanes = WATERFALL_LANES.filter((lane) => waterfall.bars.some((b) => b.category === lane.category));
+  const stages = Object.entries(waterfall.overheadStages);
+  const overheadColor = waterfall.codeplanePct > 20
+    ? "text-red-400"
+    : waterfall.codeplanePct > 10
+      ? "text-yellow-400"
+      : "text-muted-foreground";
+
+  return (
+    <div className="rounded-md border border-border overflow-hidden">
+      <button
+        className="flex w-full items-center gap-2 px-3 py-2 bg-muted/30 hover:bg-muted/50 transition-colors text-left"
+        onClick={() => setExpanded((c) => !c)}
+      >
+        {expanded ? <ChevronDown size={11} className="text-muted-foreground shrink-0" /> : <ChevronRight size={11} className="text-muted-foreground shrink-0" />}
+        <Clock size={12} className="text-muted-foreground shrink-0" />
+        <span className="text-xs font-medium text-foreground">Execution Waterfall</span>
+        <span className="ml-auto flex items-center gap-3 text-xs text-muted-foreground tabular-nums">
+          <span className={overheadColor}>{waterfall.codeplanePct.toFixed(1)}% CodePlane</span>
+          <span>{formatDuration(waterfall.wallMs)}</span>
+        </span>
+      </button>
+      {expanded && (
+        <div className="px-3 py-2 space-y-3">
+          {/* Critical path — each instant attributed to exactly one category */}
+          <div className="space-y-1">
+            <p className="text-[10px] text-muted-foreground">Critical path</p>
+            <div className="relative h-3 rounded-sm bg-muted/40 overflow-hidden">
+              {waterfall.criticalPath.map((seg, i) => (
+                <div
+                  key={i}
+                  title={`${seg.name} · ${formatDuration(seg.endMs - seg.startMs)}`}
+                  className={cn("absolute inset-y-0", WATERFALL_LANES.find((l) => l.category === seg.category)?.color ?? "bg-transparent")}
+                  style={{ left: at(seg.startMs), width: pct(seg.endMs - seg.startMs) }}
+                />
+              ))}
+            </div>
+            <div className="flex flex-wrap gap-x-3 gap-y-1 text-[10px] text-muted-foreground tabular-nums">
+              {[...WATERFALL_LANES, { category: "idle" as const, label: "Idle", color: "bg-muted" }].map((lane) => (
+                (waterfall.breakdown[lane.category] ?? 0) > 0 && (
+                  <span key={lane.category} className="flex items-center gap-1">
+                    <span className={cn("inline-block h-2 w-2 rounded-sm", lane.color)} />
+                    {lane.label} {formatDuration(waterfall.breakdown[lane.category])}
+                  </span>
+                )
+              ))}
+            </div>
+          </div>
+
+          {/* One lane per category; faded spans were hidden behind other work */}
+          <div className="space-y-1">
+            {lanes.map((lane) => (
+              <div key={lane.category} className="flex items-center gap-2">
+                <span className="w-16 shrink-0 text-[10px] text-muted-foreground">{lane.label}</span>
+                <div className="relative h-2.5 flex-1 rounded-sm bg-muted/20 overflow-hidden">
+                  {waterfall.bars.filter((b) => b.category === lane.category).map((b, i) => (
+                    <div
+                      key={i}
+                      title={`${b.name} · ${formatDuration(b.durationMs)}${b.criticalMs > 0 ? ` (${formatDuration(b.criticalMs)} critical)` : ""}`}
+                      className={cn("absolute inset-y-0 min-w-px", lane.color, b.criticalMs > 0 ? "opacity-90" : "opacity-30")}
+                      style={{ left: at(b.startMs), width: pct(b.durationMs) }}
+                    />
+                  ))}
+                </div>
+              </div>
+            ))}
+          </div>
+
+          {stages.length > 0 && (
+            <div className="grid grid-cols-3 gap-2">
+              {stages.slice(0, 6).map(([name, ms]) => (
+                <CompactStat key={name} label={name.replace(/_/g, " ")} value={formatDuration(ms)} warn={ms > waterfall.wallMs * 0.1} />
+              ))}
+            </div>
+          )}
+        </div>
+      )}
+    </div>
+  );
+}
+
 function StatCard({ icon, label, value, color }: { icon: React.ReactNode; label: string; value: string; color: string }) {
   return (
     <div className="rounded-md border border-border bg-background p-3 text-center">
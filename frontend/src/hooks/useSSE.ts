@@ -108,6 +108,7 @@ export function useSSE(jobId?: string): { reconnect: () => void } {
         "merge_completed",
         "merge_conflict",
         "telemetry_updated",
+        "budget_updated",
         // Plan steps — the only step-level event the frontend handles
         "plan_step_updated",
       ];
@@ -269,6 +269,23 @@ describe("dispatchSSEEvent — additional events", () => {
     expect(Object.keys(selectJobs(useStore.getState()))).toHaveLength(0);
   });
 
+  it("handles budget_updated", () => {
+    useStore.getState().dispatchSSEEvent("budget_updated", {
+      jobId: "job-1",
+      month: "2025-01",
+      totalCostUsd: 12.5,
+      sdks: [{ sdk: "claude", unit: "usd", spent: 12.5, limit: 10, status: "exhausted" }],
+      repos: { "/repos/test": 12.5 },
+      jobCostUsd: 2,
+      jobLimitUsd: 0,
+      jobStatus: "ok",
+    });
+    const budget = useStore.getState().budget!;
+    expect(budget.month).toBe("2025-01");
+    expect(budget.sdks[0]!.status).toBe("exhausted");
+    expect(budget.repos["/repos/test"]).toBe(12.5);
+  });
+
   it("transcript_update deduplicates", () => {
     useStore.getState().dispatchSSEEvent("transcript_update", {
       jobId: "job-1",
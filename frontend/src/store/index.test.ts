@@ -253,6 +253,101 @@ describe("AppStore", () => {
       ).toHaveLength(2);
     });
 
+    it("merges snapshot chunks and keeps prompts it already has", () => {
+      useStore.setState({
+        jobs: {
+          "job-1": makeJob({ id: "job-1", prompt: "Fix the login bug" }),
+          "job-gone": makeJob({ id: "job-gone" }),
+        },
+      });
+      const compact: Partial<JobSummary> = makeJob({ id: "job-1", state: "review", promptPreview: "Fix the" });
+      delete compact.prompt;
+
+      useStore.getState().dispatchSSEEvent("snapshot", {
+        jobs: [compact],
+        pendingApprovals: [],
+        chunk: 0,
+        final: false,
+      });
+      let jobs = selectJobs(useStore.getState());
+      expect(jobs["job-1"]!.state).toBe("review");
+      expect(jobs["job-1"]!.prompt).toBe("Fix the login bug");
+      expect(jobs["job-gone"]).toBeDefined();
+
+      useStore.getState().dispatchSSEEvent("snapshot", {
+        jobs: [{ ...compact, id: "job-2" }],
+        pendingApprovals: [],
+        chunk: 1,
+        final: true,
+      });
+      jobs = selectJobs(useStore.getState());
+      expect(Object.keys(jobs).sort()).toEqual(["job-1", "job-2"]);
+      expect(jobs["job-2"]!.prompt).toBe("Fix the");
+    });
+
+    it("keeps jobs created live between snapshot chunks", () => {
+      useStore.setState({ jobs: { "job-gone": makeJob({ id: "job-gone" }) } });
+      useStore.getState().dispatchSSEEvent("snapshot", {
+        jobs: [makeJob({ id: "job-1", createdAt: "2025-01-02T00:00:00Z" })],
+        pendingApprovals: [],
+        chunk: 0,
+        final: false,
+      });
+      // Created after chunk 0 was read, so no chunk lists it
+      useStore.setState((s) => ({
+        jobs: { ...s.jobs, "job-new": makeJob({ id: "job-new", createdAt: "2025-01-03T00:00:00Z" }) },
+      }));
+      useStore.getState().dispatchSSEEvent("job_state_changed", {
+        jobId: "job-new",
+        newState: "running",
+        timestamp: "2025-01-03T00:00:01Z",
+      });
+
+      useStore.getState().dispatchSSEEvent("snapshot", {
+        jobs: [makeJob({ id: "job-0", createdAt: "2025-01-01T00:00:00Z" })],
+        pendingApprovals: [],
+        chunk: 1,
+        final: true,
+      });
+      expect(Object.keys(selectJobs(useStore.getState())).sort()).toEqual(["job-0", "job-1", "job-new"]);
+    });
+
+    it("merges a job-scoped snapshot without pruning the fleet", () => {
+      useStore.getState().dispatchSSEEvent("snapshot", {
+        jobs: [makeJob({ id: "job-1", createdAt: "2025-01-02T00:00:00Z" })],
+        pendingApprovals: [],
+        chunk: 0,
+        final: false,
+      });
+      // The job detail view's stream reconnects in the middle of the fleet snapshot
+      useStore.getState().dispatchSSEEvent("snapshot", {
+        jobs: [makeJob({ id: "job-0", createdAt: "2025-01-01T00:00:00Z", state: "waiting_for_approval" })],
+        pendingApprovals: [
+          {
+            id: "apr-1",
+            jobId: "job-0",
+            description: "Approve?",
+            proposedAction: null,
+            requestedAt: "2025-01-01T00:00:00Z",
+            resolvedAt: null,
+            resolution: null,
+            requiresExplicitApproval: false,
+          },
+        ],
+        jobId: "job-0",
+      });
+      expect(Object.keys(selectJobs(useStore.getState())).sort()).toEqual(["job-0", "job-1"]);
+      expect(selectApprovals(useStore.getState())["apr-1"]).toBeDefined();
+
+      useStore.getState().dispatchSSEEvent("snapshot", {
+        jobs: [makeJob({ id: "job-0", createdAt: "2025-01-01T00:00:00Z", state: "waiting_for_approval" })],
+        pendingApprovals: [],
+        chunk: 1,
+        final: true,
+      });
+      expect(Object.keys(selectJobs(useStore.getState())).sort()).toEqual(["job-0", "job-1"]);
+    });
+
     it("handles session_heartbeat sets connected", () => {
       expect(selectConnectionStatus(useStore.getState())).toBe(
         "disconnected"
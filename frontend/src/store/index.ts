@@ -16,6 +16,7 @@ import { create } from "zustand";
 
 import type { DiffFileModel, SDKInfo } from "../api/types";
 import { fetchSDKs, fetchModels } from "../api/client";
+import type { BudgetSnapshot } from "../api/client";
 
 function pickDefaultModelId(models: Array<{ value: string; isDefault: boolean }>): string | null {
   const flagged = models.find((m) => m.isDefault);
@@ -53,6 +54,8 @@ export interface JobSummary {
   requestedModel?: string | null;
   actualModel?: string | null;
   sdk?: string;
+  /** Head of the prompt, sent by listings in place of the full text. */
+  promptPreview?: string;
 }
 
 export interface ApprovalRequest {
@@ -121,10 +124,23 @@ export interface Step {
 // Helpers
 // ---------------------------------------------------------------------------
 
+/** Job ids listed by the chunks of the snapshot being received. */
+const snapshotJobIds = new Set<string>();
+/**
+ * Newest ``createdAt`` in the snapshot's first chunk.  Later chunks are read
+ * after live events resume, so a job created since then is in no chunk.
+ */
+let snapshotNewest = Number.POSITIVE_INFINITY;
+
 const MODEL_DOWNGRADE_RE = /^Model downgraded: requested (.+) but received (.+)$/;
 
-/** Enrich a job loaded from the REST API with parsed model downgrade info. */
+/**
+ * Enrich a job loaded from the REST API with parsed model downgrade info.
+ * Listed jobs carry only a prompt preview; it stands in for the prompt
+ * until the full job is fetched.
+ */
 export function enrichJob(job: JobSummary): JobSummary {
+  if (job.prompt === undefined) job = { ...job, prompt: job.promptPreview ?? "" };
   if (job.modelDowngraded) return job; // already enriched (e.g. from SSE)
   if (!job.failureReason) return job;
   const m = MODEL_DOWNGRADE_RE.exec(job.failureReason);
@@ -160,6 +176,8 @@ interface AppState {
   /** Monotonically-increasing counter per job, bumped on each telemetry_updated
    * SSE event. Components watching this trigger a telemetry re-fetch. */
   telemetryVersions: Record<string, number>; // keyed by jobId
+  /** Live month-to-date budget state, replaced on each budget_updated event. */
+  budget: BudgetSnapshot | null;
 
   // Terminal state
   terminalDrawerOpen: boolean;
@@ -236,6 +254,7 @@ export const useStore = create<AppState>((set, get) => ({
   transcriptByStep: {},
   streamingMessages: {},
   telemetryVersions: {},
+  budget: null,
   connectionStatus: "reconnecting",
   reconnectAttempt: 0,
 
@@ -639,10 +658,50 @@ export const useStore = create<AppState>((set, get) => ({
         }
 
         case "snapshot": {
+          // Large fleets arrive as several chunks, newest jobs first.  Each is
+          // merged as it lands so the board fills in immediately; jobs no chunk
+          // listed are dropped once the final one arrives — except those created
+          // after the first chunk was read, which only live events can know of.
+          // Snapshot jobs carry only a prompt preview, so a job already in the
+          // store keeps its prompt.
           const jobs = (payload.jobs as JobSummary[]) ?? [];
+          const scopedJobId = payload.jobId as string | undefined;
+          if (scopedJobId) {
+            // A job-scoped stream (the job detail view) covers only its own
+            // job: leave the rest of the fleet, and any fleet snapshot still
+            // arriving on the global stream, alone.
+            const scopedJobs = { ...state.jobs };
+            delete scopedJobs[scopedJobId];
+            for (const j of jobs) scopedJobs[j.id] = enrichJob({ ...state.jobs[j.id], ...j });
+            const scopedApprovals = Object.fromEntries(
+              Object.entries(state.approvals).filter(([, a]) => a.jobId !== scopedJobId),
+            );
+            for (const a of (payload.pendingApprovals as ApprovalRequest[]) ?? []) {
+              if (scopedJobs[a.jobId]?.state === "waiting_for_approval") scopedApprovals[a.id] = a;
+            }
+            return { jobs: scopedJobs, approvals: scopedApprovals };
+          }
+          if (((payload.chunk as number | undefined) ?? 0) === 0) {
+            snapshotJobIds.clear();
+            const times = jobs.map((j) => Date.parse(j.createdAt)).filter((t) => !Number.isNaN(t));
+            // An empty first chunk is the whole (empty) fleet: keep nothing unlisted
+            snapshotNewest = times.length > 0 ? Math.max(...times) : Number.POSITIVE_INFINITY;
+          }
+          const merged = { ...state.jobs };
+          for (const j of jobs) {
+            snapshotJobIds.add(j.id);
+            merged[j.id] = enrichJob({ ...state.jobs[j.id], ...j });
+          }
+          if (payload.final === false) {
+            return { jobs: merged };
+          }
           const rawApprovals =
             (payload.pendingApprovals as ApprovalRequest[]) ?? [];
-          const jobMap = Object.fromEntries(jobs.map((j) => [j.id, enrichJob(j)]));
+          const jobMap = Object.fromEntries(
+            Object.entries(merged).filter(
+              ([id, j]) => snapshotJobIds.has(id) || Date.parse(j.createdAt) > snapshotNewest,
+            ),
+          );
           // Drop approvals whose job is no longer in waiting_for_approval.
           // This covers the server-restart recovery path where the backend resets
           // the job to running without resolving its pending approval in the DB,
@@ -941,6 +1000,17 @@ export const useStore = create<AppState>((set, get) => ({
           };
         }
 
+        case "budget_updated": {
+          return {
+            budget: {
+              month: payload.month as string,
+              totalCostUsd: payload.totalCostUsd as number,
+              sdks: payload.sdks as BudgetSnapshot["sdks"],
+              repos: payload.repos as BudgetSnapshot["repos"],
+            },
+          };
+        }
+
         default:
           return null;
       }
@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+"""Benchmark per-job vs. batch (NumPy) cost attribution.
+
+Builds a throwaway SQLite database with synthetic span history, then times
+recomputing attribution for every job through both paths:
+
+    python tools/bench_cost_attribution.py --jobs 2000 --spans-per-job 150
+
+Requires the ``analytics`` extra (NumPy).
+"""
+
+from __future__ import annotations
+
+import argparse
+import asyncio
+import json
+import random
+import sys
+import tempfile
+import time
+from datetime import UTC, datetime
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+
+from sqlalchemy import text  # noqa: E402
+
+from backend.models.db import Base, JobRow  # noqa: E402
+from backend.models.domain import JobState, PermissionMode  # noqa: E402
+from backend.persistence.cost_attribution_repo import CostAttributionRepo  # noqa: E402
+from backend.persistence.database import create_engine, create_session_factory  # noqa: E402
+from backend.persistence.telemetry_summary_repo import TelemetrySummaryRepo  # noqa: E402
+from backend.services.cost_attribution import compute_attribution  # noqa: E402
+from backend.services.cost_attribution_batch import backfill_attribution  # noqa: E402
+
+TOOLS = ("read_file", "edit", "bash", "grep", "task", "view", "apply_patch", "mystery_tool")
+PHASES = (None, "agent_reasoning", "agent_reasoning", "verification", "environment_setup", "finalization")
+
+
+async def seed(session_factory, jobs: int, spans_per_job: int) -> None:  # type: ignore[no-untyped-def]
+    rng = random.Random(0)
+    now = datetime.now(UTC).isoformat()
+    async with session_factory() as session:
+        created = datetime.now(UTC)
+        session.add_all(
+            JobRow(
+                id=f"job-{j:06d}",
+                repo="/repo",
+                prompt="bench",
+                state=JobState.completed,
+                base_ref="main",
+                permission_mode=PermissionMode.full_auto,
+                sdk="copilot",
+                created_at=created,
+                updated_at=created,
+            )
+            for j in range(jobs)
+        )
+        await session.flush()
+        summaries = TelemetrySummaryRepo(session)
+        for j in range(jobs):
+            await summaries.init_job(f"job-{j:06d}", sdk="copilot", model="gpt-4o")
+        rows = []
+        for j in range(jobs):
+            for i in range(spans_per_job):
+                span_type = "llm" if rng.random() < 0.4 else "tool"
+                rows.append(
+                    {
+                        "job_id": f"job-{j:06d}",
+                        "span_type": span_type,
+                        "name": rng.choice(TOOLS) if span_type == "tool" else "gpt-4o",
+                        "started_at": float(i),
+                        "attrs_json": json.dumps({}),
+                        "turn_number": i // 4,
+                        "execution_phase": rng.choice(PHASES),
+                        "input_tokens": rng.randint(0, 8000),
+                        "output_tokens": rng.randint(0, 1000),
+                        "cost_usd": rng.uniform(0, 0.05),
+                        "now": now,
+                    }
+                )
+        await session.execute(
+            text("""
+                INSERT INTO job_telemetry_spans
+                    (job_id, span_type, name, started_at, duration_ms, attrs_json, turn_number, execution_phase,
+                     input_tokens, output_tokens, cost_usd, created_at)
+                VALUES
+                    (:job_id, :span_type, :name, :started_at, 1.0, :attrs_json, :turn_number, :execution_phase,
+                     :input_tokens, :output_tokens, :cost_usd, :now)
+            """),
+            rows,
+        )
+        await session.commit()
+
+
+async def per_job(session_factory, jobs: int) -> None:  # type: ignore[no-untyped-def]
+    async with session_factory() as session:
+        job_ids = [f"job-{j:06d}" for j in range(jobs)]
+        await CostAttributionRepo(session).delete_for_jobs(job_ids)
+        for job_id in job_ids:
+            await compute_attribution(session, job_id)
+        await session.commit()
+
+
+async def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--jobs", type=int, default=1000)
+    parser.add_argument("--spans-per-job", type=int, default=150)
+    parser.add_argument("--batch-size", type=int, default=500)
+    args = parser.parse_args()
+
+    import structlog
+
+    structlog.configure(wrapper_class=structlog.make_filtering_bound_logger(30))
+
+    with tempfile.TemporaryDirectory() as tmp:
+        engine = create_engine(Path(tmp) / "bench.db")
+        async with engine.begin() as conn:
+            await conn.run_sync(Base.metadata.create_all)
+        session_factory = create_session_factory(engine)
+        await seed(session_factory, args.jobs, args.spans_per_job)
+        total_spans = args.jobs * args.spans_per_job
+        print(f"{args.jobs} jobs, {total_spans} spans")
+
+        started = time.perf_counter()
+        await per_job(session_factory, args.jobs)
+        per_job_s = time.perf_counter() - started
+        print(f"per-job : {per_job_s:8.2f}s  ({total_spans / per_job_s:,.0f} spans/s)")
+
+        started = time.perf_counter()
+        await backfill_attribution(session_factory, batch_size=args.batch_size)
+        batch_s = time.perf_counter() - started
+        print(f"batch   : {batch_s:8.2f}s  ({total_spans / batch_s:,.0f} spans/s)  {per_job_s / batch_s:.1f}x")
+        await engine.dispose()
+
+
+if __name__ == "__main__":
+    asyncio.run(main())
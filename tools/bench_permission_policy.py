@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""Benchmark the permission gate that runs before every agent tool call.
+
+Replays a synthetic mix of permission requests through ``evaluate`` and
+prints per-call p50 / p99 / max latency, once with the shell classification
+cache cleared before each call (cold) and once with it warm:
+
+    python tools/bench_permission_policy.py --requests 200000 --distinct 500
+
+``--distinct`` sets how many different shell commands occur.  Agents repeat
+the same commands heavily, so a few hundred is realistic.
+"""
+
+from __future__ import annotations
+
+import argparse
+import random
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+
+from backend.services.permission_policy import _classify_shell_cached, evaluate  # noqa: E402
+
+MODES = ("full_auto", "observe_only", "review_and_approve")
+SHELL_TEMPLATES = (
+    "grep -rn '{w}' backend/",
+    "ls -la {w}",
+    "cat {w}.py | head -50",
+    "python -m pytest -q tests/test_{w}.py",
+    "cd /repo && git status && git diff {w}",
+    'git commit -am "fix {w}: do not git reset --hard"',
+    "npm run build -- --filter {w}",
+    "rg --json {w} . | jq .data",
+)
+
+
+def build_requests(workspace: str, n: int, distinct: int) -> list[tuple[str, dict[str, object]]]:
+    rng = random.Random(0)
+    commands = [rng.choice(SHELL_TEMPLATES).format(w=f"mod{i}") for i in range(distinct)]
+    requests: list[tuple[str, dict[str, object]]] = []
+    for _ in range(n):
+        mode = rng.choice(MODES)
+        roll = rng.random()
+        if roll < 0.6:
+            kw: dict[str, object] = {"kind": "shell", "full_command_text": rng.choice(commands)}
+        elif roll < 0.8:
+            kw = {"kind": "read", "file_name": f"{workspace}/src/mod{rng.randrange(distinct)}.py"}
+        elif roll < 0.95:
+            kw = {"kind": "write", "file_name": f"{workspace}/src/mod{rng.randrange(distinct)}.py"}
+        else:
+            kw = {"kind": "mcp", "read_only": rng.random() < 0.5}
+        requests.append((mode, kw))
+    return requests
+
+
+def run(workspace: str, requests: list[tuple[str, dict[str, object]]], *, cold: bool) -> list[float]:
+    timings: list[float] = []
+    clock = time.perf_counter_ns
+    for mode, kw in requests:
+        if cold:
+            _classify_shell_cached.cache_clear()
+        started = clock()
+        evaluate(mode, workspace_path=workspace, **kw)  # type: ignore[arg-type]
+        timings.append((clock() - started) / 1000)
+    return timings
+
+
+def report(label: str, timings: list[float]) -> None:
+    timings = sorted(timings)
+    n = len(timings)
+    p50 = timings[n // 2]
+    p99 = timings[min(n - 1, int(n * 0.99))]
+    print(f"{label:5}: p50 {p50:7.2f}µs  p99 {p99:7.2f}µs  max {timings[-1]:9.2f}µs  ({n} calls)")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--requests", type=int, default=100_000)
+    parser.add_argument("--distinct", type=int, default=500)
+    args = parser.parse_args()
+
+    import structlog
+
+    structlog.configure(wrapper_class=structlog.make_filtering_bound_logger(30))
+
+    with tempfile.TemporaryDirectory() as workspace:
+        requests = build_requests(workspace, args.requests, args.distinct)
+        report("cold", run(workspace, requests, cold=True))
+        _classify_shell_cached.cache_clear()
+        report("warm", run(workspace, requests, cold=False))
+        info = _classify_shell_cached.cache_info()
+        print(f"shell cache: {info.hits} hits, {info.misses} misses, {info.currsize} entries")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""Measure server time-to-first-request.
+
+Starts ``cpl up`` against a throwaway home directory, polls the health
+endpoint until it answers, then stops the server.  The first run creates
+the database from scratch; later runs reuse it, which is what a normal
+restart looks like.  The server's own phase breakdown
+(``--profile-startup``) is echoed after each run:
+
+    python tools/measure_cold_start.py --runs 3 --budget 15
+
+Exits non-zero when the last run takes longer than ``--budget`` seconds.
+"""
+
+from __future__ import annotations
+
+import argparse
+import os
+import signal
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+import urllib.error
+import urllib.request
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+
+
+def _free_port() -> int:
+    with socket.socket() as sock:
+        sock.bind(("127.0.0.1", 0))
+        return int(sock.getsockname()[1])
+
+
+def _responds(url: str) -> bool:
+    try:
+        with urllib.request.urlopen(url, timeout=1) as response:  # noqa: S310
+            return bool(response.status < 500)
+    except urllib.error.HTTPError as exc:
+        return exc.code < 500
+    except OSError:
+        return False
+
+
+def measure(home: Path, path: str, timeout: float) -> tuple[float, str]:
+    """Start the server once and return (seconds to first response, server stderr)."""
+    port = _free_port()
+    cmd = [
+        sys.executable,
+        "-m",
+        "backend.main",
+        "up",
+        "--dev",
+        "--skip-preflight",
+        "--no-password",
+        "--port",
+        str(port),
+        "--profile-startup",
+    ]
+    env = {**os.environ, "HOME": str(home), "PYTHONUNBUFFERED": "1"}
+    # A file rather than a pipe, so a chatty server never blocks on a full buffer
+    log_path = home / "server-stderr.log"
+    started = time.perf_counter()
+    with log_path.open("w") as log_file:
+        proc = subprocess.Popen(cmd, cwd=ROOT, env=env, stdout=subprocess.DEVNULL, stderr=log_file)  # noqa: S603
+        try:
+            url = f"http://127.0.0.1:{port}{path}"
+            while not _responds(url):
+                if proc.poll() is not None:
+                    raise RuntimeError(f"server exited with {proc.returncode}:\n{log_path.read_text()}")
+                if time.perf_counter() - started > timeout:
+                    raise TimeoutError(f"no response from {url} within {timeout:.0f}s")
+                time.sleep(0.05)
+            elapsed = time.perf_counter() - started
+            # Give the server a moment to print its profile table
+            time.sleep(0.5)
+        finally:
+            proc.send_signal(signal.SIGINT)
+            try:
+                proc.wait(timeout=30)
+            except subprocess.TimeoutExpired:
+                proc.kill()
+                proc.wait()
+    stderr = log_path.read_text()
+    return elapsed, stderr
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--runs", type=int, default=2, help="Server starts; the first one migrates an empty database")
+    parser.add_argument("--budget", type=float, default=None, help="Fail if the last run exceeds this many seconds")
+    parser.add_argument("--path", default="/api/health", help="Endpoint to poll")
+    parser.add_argument("--timeout", type=float, default=120.0, help="Give up on a run after this many seconds")
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory(prefix="cpl-cold-start-") as tmp:
+        home = Path(tmp)
+        elapsed = 0.0
+        for run in range(1, args.runs + 1):
+            elapsed, stderr = measure(home, args.path, args.timeout)
+            label = "fresh database" if run == 1 else "existing database"
+            print(f"run {run} ({label}): first response after {elapsed:.2f}s")
+            start = stderr.find("Startup profile")
+            table = stderr[start : stderr.find("\n\n", start)] if start >= 0 else ""
+            if table:
+                print("  " + table.strip().replace("\n", "\n  "))
+
+    if args.budget is not None and elapsed > args.budget:
+        print(f"FAIL: {elapsed:.2f}s exceeds the {args.budget:.2f}s budget", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())